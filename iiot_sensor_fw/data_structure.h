@@ -7,6 +7,39 @@ Date Created: 11/29/2014
 
 (NOTE: latest version is the top version)
 
+Author: Aalok Shah
+Changes: Key data of delta encoding is kept only for first MAX_KEY_SENSOR_COUNT sensor entries (SENSOR_KEY_STRUCT)
+
+Author: Aalok Shah
+Changes: Smart Sensor address of sensor entry (chSmartSensorAddress of SENSOR_CONFIG_STRUCT)
+
+Author: Aalok Shah
+Changes: MAX_COMM_PACKET_COUNT and MAX_COMM_PACKET_SIZE can be set at build time (Packets longer than FIFO of CC1125 are streamed)
+
+Author: Aalok Shah
+Changes: Response time estimate of RF exchange (lSmoothedRtt, lRttVariance, nResponseWait of SENSOR_COMM_MANAGER)
+
+Author: Aalok Shah
+Changes: Selective repeat of multi packet generations (chDownloadWindow of MASTER_CONTROLLER_STRUCT, chWindowPending of SENSOR_COMM_MANAGER)
+
+Author: Aalok Shah
+Changes: Modes of Data Download Task (DOWNLOAD_MODE_xxx) for store-and-forward log in SENSOR_COMM_MANAGER
+
+Author: Aalok Shah
+Changes: Bit packed encoding of data packet payload (PAYLOAD_ENCODING_PACKED) with width of measurement from sensor driver registry
+
+Author: Aalok Shah
+Changes: Delta encoding of data packet payload (PAYLOAD_ENCODING_DELTA) negotiated by Execution Table
+
+Author: Aalok Shah
+Changes: Packet builder (PACKET_BUILDER_STRUCT) to assemble data packets in place in gchSensorCommBuff
+
+Author: Aalok Shah
+Changes: Collection queue (COLLECTION_QUEUE_STRUCT) to keep collected packets while older ones are downloaded
+
+Author: Aalok Shah
+Changes: SMART_SENSORS_STRUCT is split in SENSOR_CONFIG_STRUCT (cold), SENSOR_SAMPLE_STRUCT (payload) and SENSOR_RUNTIME_STRUCT (hot parallel arrays)
+
 Author: Aalok Shah
 Changes: Initial version
 
@@ -62,16 +95,78 @@ Test Results:
 	//_________________________________________ M A C R O S ________________________________________________
 
 	#define MAX_SENSOR_DATA_LENGTH					5				//Maximum size of data bytes considered for particular sensor
-	#define MAX_COMM_PACKET_COUNT					8				//Maximum no of packets supported in SENSOR protocol
-	#define MAX_COMM_PACKET_SIZE					135				//Maximum bytes considered for individual packet: Data:128, Data Length:1, RSSI + CRC Status:2
+	//Packets up to 255 bytes (Variable length limit of CC1125) are streamed through 128 byte FIFOs of CC1125 so fewer and longer packets
+	//can be selected at build time, e.g. -DPACKET_LAST_DATA_BYTE_INDEX=252 -DMAX_COMM_PACKET_SIZE=255 -DMAX_COMM_PACKET_COUNT=4 (Same SRAM as default)
+	#ifndef MAX_COMM_PACKET_COUNT
+		#define MAX_COMM_PACKET_COUNT				8				//Maximum no of packets supported in SENSOR protocol
+	#endif
+	#ifndef MAX_COMM_PACKET_SIZE
+		#define MAX_COMM_PACKET_SIZE				135				//Maximum bytes considered for individual packet: Data:128, Data Length:1, RSSI + CRC Status:2
+	#endif
 	#define MAX_SENSOR_COUNT						127				//Maximum no of sensors supported in design
+	#define ACTIVE_SENSOR_MAP_SIZE					((MAX_SENSOR_COUNT + 7) >> 3)	//Bytes of bitmap to hold one bit per sensor entry
+	#define MAX_SCHEDULE_HYPERPERIOD				60				//Maximum LCM of sensor divisors compiled into divisor schedule (in clock ticks)
+	#define MAX_SCHEDULE_ENTRIES					240				//Maximum sensor entries due over the hyperperiod of divisor schedule
+	#define SAMPLE_CLOCK_SCHEDULE					0				//Divisor schedule of sample clock (chSampleClockDivisor)
+	#define RADIO_CLOCK_SCHEDULE					1				//Divisor schedule of radio clock (chRadioClockDivisor)
+	
+	//Collection queue: Packets of gchSensorCommBuff after the control packet (BASE_INDEX) are divided in slots of the size of busiest radio clock.
+	//Every radio clock collects its packets in a free slot while data download task drains the oldest one.
+	//If no slot is free than oldest generation waiting for download is dropped (the one being downloaded is never dropped).
+	#ifndef COLLECTION_QUEUE_DEPTH
+		#define COLLECTION_QUEUE_DEPTH				4				//Maximum no of radio clocks (generations) held in collection queue
+	#endif
+	#ifndef COLLECTION_PACKET_POOL
+		#define COLLECTION_PACKET_POOL				MAX_COMM_PACKET_COUNT	//Packets shared by slots of collection queue (must not be less than MAX_COMM_PACKET_COUNT)
+	#endif
+	#define COLLECTION_FIRST_PACKET_INDEX			1				//Packet 0 is kept for Execution Table request/reply and loop back
+	#define COMM_PACKET_POOL_SIZE					(COLLECTION_PACKET_POOL + COLLECTION_FIRST_PACKET_INDEX)
+	
+	//Payload encoding of data packets selected by Execution Table (PAYLOAD_ENCODING_BM of control byte 1).
+	//In delta encoding every sensor entry starts with Sensor ID (bit 0-4), key epoch (bit 5-6) and key flag (bit 7),
+	//followed by data words of sensor as zigzag varint of their difference from the key entry of sensor (key entry itself is encoded against 0).
+	//Key entry is sent every PAYLOAD_KEY_INTERVAL entries of sensor and again after a generation carrying key entries is not delivered,
+	//so receiver decodes delta entry only if it holds the key of same epoch and loss of a delta entry does not spoil the next ones.
+	#define PAYLOAD_ENCODING_RAW					0				//Sensor ID followed by data words as 2 bytes (MSB first)
+	#define PAYLOAD_ENCODING_DELTA					1				//Sensor entry header followed by data words as zigzag varint
+	#define PAYLOAD_ENCODING_PACKED					2				//Sensor ID and data words packed as bit stream (See below)
+	#define PAYLOAD_KEY_INTERVAL					16				//Entries of sensor after which key entry is sent again
+	#define PAYLOAD_SENSOR_ID_BM					0x1F			//Sensor ID in header of sensor entry
+	#define PAYLOAD_KEY_EPOCH_BM					0x60			//Key epoch in header of sensor entry
+	#define PAYLOAD_KEY_EPOCH_bp					5
+	#define PAYLOAD_KEY_FLAG_BM						0x80			//Header of key entry
+	#ifndef MAX_KEY_SENSOR_COUNT
+		#define MAX_KEY_SENSOR_COUNT				20				//First sensor entries of Execution Table with key data (Entries beyond it send key entries only)
+	#endif
+	#define PAYLOAD_VARINT_DATA_BM					0x7F			//7 bits of value in every varint byte (Least significant first)
+	#define PAYLOAD_VARINT_MORE_BM					0x80			//Set if more bytes of varint follow
+	#define PAYLOAD_VARINT_MAX_BYTES				3				//Bytes of varint for 16 bit value in worst case
+	
+	//In bit packed encoding data message of packet is a bit stream (Most significant bit first) which crosses byte boundaries.
+	//Every sensor entry is Sensor ID of PAYLOAD_PACKED_ID_BITS followed by data words of sensor, each one of the width declared in sensor driver registry.
+	//Sensor entry is never split over packets and unused bits of last byte are 0, so receiver stops at Sensor ID 0 or when less than Sensor ID is left.
+	#define PAYLOAD_PACKED_ID_BITS					5				//Bits of Sensor ID in bit packed sensor entry
+	
+	//Modes of Data Download Task: Generations are sent live, generation which retries out is stored in E2PROM log (sample_log.c)
+	//and backlog of log is replayed once uplink is back and collection queue is empty
+	#define DOWNLOAD_MODE_LIVE						0				//Generations of collection queue are sent over RF
+	#define DOWNLOAD_MODE_STORE						1				//Packets of generation which are not acknowledged are appended to log
+	#define DOWNLOAD_MODE_CATCH_UP					2				//Records of log are replayed back to back
+	
+	//Selective repeat of multi packet generation (DOWNLOAD_WINDOW_BM of control byte 1): Packets which are not acknowledged are sent back to back,
+	//last packet of burst carries PACKET_ACK_REQUEST_BM in descriptor and RFC Console answers the burst with one ACK_BITMAP_DATA_PACKETS.
+	//Bit n of bitmap is set if packet n of generation (sequence no n+1) is received, only the missing packets are sent again.
+	//Message sequence no (chMsgSeqNo of error control byte) moves ahead with every generation so RFC Console knows when to start new bitmap.
+	#define DOWNLOAD_WINDOW_OFF						0				//Stop-and-wait: Every packet waits for ACK_RECEIPT_LAST_DATA_PACKET
+	#define DOWNLOAD_WINDOW_ON						1				//Selective repeat of generations with more than one packet
+	
 	#define MAX_RF_COMM_RETRY						3				//Supported no of retry in case of NACK or Timeout in SENSOR to RFC communication
 	#define MIN_SAMPLE_CLOCK_VALUE_FOR_KEEP_5V_ON	1				//TBD-???
 	
 	#define MIN_RADIO_CLOCK_DIVISOR					3				//Minimum Radio sample clock divisor
 	#define MIN_COMM_WAIT_TIME_OUT					150				//Minimum Communication wait time out
 	#define MAX_MSG_SEQ_NO_VALUE					15				//Maximum message sequence value
-	#define CC1125_TX_COMPLETE_TIMEOUT_WAIT			500				//The maximum time considered for CC1125 to complete the transmission
+	#define CC1125_TX_COMPLETE_TIMEOUT_WAIT			700				//The maximum time considered for CC1125 to complete the transmission (255 byte packet lasts 532ms on air)
 	#define LOOPBACK_WAIT_TIMEOUT					15000			//The maximum time considered between consecutive loop back query
 	#define MAX_SAMPLE_AVERAGE_SUPPORTED			50				//The maximum samples supported for performing the averaging operations
 
@@ -105,24 +200,68 @@ Test Results:
 		uint8_t		chDataDownloadChannel;			//Radio Channel Identity
 		uint16_t	nSampleClock;					//SENSOR MC Sample clock frequency value
 		uint16_t	nCommTimeout;					//SENSOR to RF communication- Message response wait time (in ms)
+		uint8_t		chPayloadEncoding;				//Payload encoding of data packets (PAYLOAD_ENCODING_RAW/PAYLOAD_ENCODING_DELTA/PAYLOAD_ENCODING_PACKED)
+		uint8_t		chDownloadWindow;				//ARQ of multi packet generations (DOWNLOAD_WINDOW_OFF/DOWNLOAD_WINDOW_ON)
 	}MASTER_CONTROLLER_STRUCT;
 
-	//Fields related to sensor management and sensor tasking table
+	//Fields of sensor tasking table which are written only when Execution Table is accepted (cold)
 	typedef struct
 	{
 		uint8_t		chSensorID;								//Sensor ID
+		uint8_t		chSmartSensorAddress;					//Group (upper nibble) and sensor value (lower nibble) of Smart Sensor
 		uint8_t		chSensorCtrlByte;						//Sensor control byte (Specifically for smart sensor management)
 		uint8_t		chSampleClockDivisor;					//Sensor- Sample clock divisor value
-		uint8_t		chSampleClockCounter;					//Sequential counter to support sample clock generation
 		uint8_t		chRadioClockDivisor;					//Sensor- Radio clock divisor value
-		uint8_t		chRadioClockCounter;					//Sequential counter to support radio clock generation
-		uint8_t		chSensorStatusFlag;						//To hold the current state of sensor's operation
 		uint8_t		chSensorDataLength;						//Maximum length of data the sensor can have
-		uint16_t	nSensorData[MAX_SENSOR_DATA_LENGTH];	//Memory resources to store the sampled data of sensor
-		uint32_t	nSensorAvgData;							//Storage for Averaging value
+		uint8_t		chSensorDataBits;						//Significant bits of every data word (Width in bit packed payload)
 		uint8_t		chSensorSampleAvgTotalCount;			//No of samples include in average
-		uint8_t		chSensorSampleAvgCounter;				//Counter to manage average of samples
-	}SMART_SENSORS_STRUCT;
+	}SENSOR_CONFIG_STRUCT;
+
+	//Sampled data of sensor, accessed only when sensor is fetched or its data is collected
+	typedef struct
+	{
+		uint32_t	nSensorAvgData;							//Storage for Averaging value
+		uint16_t	nSensorData[MAX_SENSOR_DATA_LENGTH];	//Memory resources to store the sampled data of sensor
+	}SENSOR_SAMPLE_STRUCT;
+
+	//Key data of delta encoded sensor entry, indexed by sensor entry (Only first MAX_KEY_SENSOR_COUNT entries have it)
+	typedef struct
+	{
+		uint16_t	nKeyData[MAX_SENSOR_DATA_LENGTH];		//Data of last key entry of sensor (reference of delta encoding)
+		uint8_t		chKeyCountdown;							//Entries of sensor till next key entry (0: next entry is key entry)
+		uint8_t		chKeyEpoch;								//Epoch of last key entry of sensor
+	}SENSOR_KEY_STRUCT;
+
+	//Fields visited at every sample/radio clock (hot), kept as parallel arrays indexed by sensor entry so a scan walks dense bytes
+	typedef struct
+	{
+		uint8_t		chSampleClockCounter[MAX_SENSOR_COUNT];		//Sequential counter to support sample clock generation
+		uint8_t		chRadioClockCounter[MAX_SENSOR_COUNT];		//Sequential counter to support radio clock generation
+		uint8_t		chSensorStatusFlag[MAX_SENSOR_COUNT];		//To hold the current state of sensor's operation
+		uint8_t		chSensorSampleAvgCounter[MAX_SENSOR_COUNT];	//Counter to manage average of samples
+	}SENSOR_RUNTIME_STRUCT;
+
+	//Divisor schedule compiled from Execution Table: List of sensor entries due at every clock tick over the hyperperiod (LCM of divisors)
+	typedef struct
+	{
+		uint8_t		chHyperPeriod;									//Ticks in hyperperiod, 0 if schedule is not compiled (sequential counters of sensors are used)
+		uint8_t		chTickIndex;									//Tick of hyperperiod to serve at next clock
+		uint8_t		chPeakDueCount;									//Maximum no of sensors due at single tick
+		uint8_t		chTickStart[MAX_SCHEDULE_HYPERPERIOD + 1];		//Index of first entry of every tick in chEntries (Last one is total no of entries)
+		uint8_t		chEntries[MAX_SCHEDULE_ENTRIES];				//Index of sensor entry in ghSensorConfig
+	}DIVISOR_SCHEDULE_STRUCT;
+
+	//Collection queue: Generations of collected packets in order of radio clocks
+	typedef struct
+	{
+		uint8_t		chSlotOrder[COLLECTION_QUEUE_DEPTH];	//Slots of queued generations (oldest first)
+		uint8_t		chPacketCount[COLLECTION_QUEUE_DEPTH];	//Packets collected in slot (0 if slot is free)
+		uint8_t		chSlotPackets;							//Packets in every slot (Packets of busiest radio clock)
+		uint8_t		chSlotCount;							//Slots available for current Execution Table
+		uint8_t		chQueuedCount;							//No of generations in queue
+		uint8_t		chInFlight;								//SET_FLAG when oldest generation is being downloaded
+		uint8_t		chKeyEntries[COLLECTION_QUEUE_DEPTH];	//SET_FLAG if generation in slot carries key entries of delta encoding
+	}COLLECTION_QUEUE_STRUCT;
 
 	//Fields required for packet based communication over RF
 	typedef struct
@@ -132,7 +271,8 @@ Test Results:
 			uint8_t chPacketDescriptor;
 			struct
 			{
-				uint8_t chReserved:2;
+				uint8_t chReserved:1;
+				uint8_t chAckRequest:1;				//Set in last packet of burst when generation is sent with selective repeat (Reply is bitmap ACK)
 				uint8_t chPacketSeqNo:3;			//Indicate packet sequence no when query for communication is divided in multi packet scenario
 				uint8_t chTransmitterID:2;			//Radio channel identity
 				uint8_t chLastPacket:1;				//Flag to indicate the last packet in multi packet query (Value will be 1 for last packet)
@@ -157,8 +297,25 @@ Test Results:
 		uint8_t		chPacketSendRetryCounter;		//Sequential counter to manage the retry count
 		uint8_t		chTotalPacketCount;				//Holds the value of total no of packets to send in multi packet query
 		uint8_t		chPacketCounter;				//Sequential counter to manage the multi packet  query
+		uint8_t		chFirstPacketIndex;				//Index of first packet of query in gchSensorCommBuff
+		uint8_t		chDownloadMode;					//Mode of Data Download Task (DOWNLOAD_MODE_LIVE/DOWNLOAD_MODE_STORE/DOWNLOAD_MODE_CATCH_UP)
+		uint8_t		chUplinkDown;					//SET_FLAG from retry out till a packet is acknowledged again
+		uint8_t		chProbeCountdown;				//Generations stored in log till next one is sent to probe the uplink
+		uint8_t		chWindowPending;				//Bit n set till packet n of generation is acknowledged (0 if generation is sent with stop-and-wait)
+		uint32_t	lSmoothedRtt;					//Smoothed response time of RF exchange (ms scaled by 8, 0 till first sample)
+		uint32_t	lRttVariance;					//Variance of response time of RF exchange (ms scaled by 4)
+		uint16_t	nResponseWait;					//Time to wait for reply of RF exchange (ms, nCommTimeout of Execution Table is upper bound)
 	}SENSOR_COMM_MANAGER;
 
+	//Data packet being assembled in place in gchSensorCommBuff, the same buffer is handed to radio for transmission and retries
+	typedef struct
+	{
+		uint8_t		*pchPacket;						//Packet of gchSensorCommBuff being filled
+		uint8_t		chPacketSeqNo;					//Sequence no of packet in its generation
+		uint8_t		chDataIndex;					//Next free byte of data message
+		uint8_t		chFreeBits;						//Unused bits of last byte of data message filled by fnPacketBuilderPackBits
+	}PACKET_BUILDER_STRUCT;
+
 	//Data structure to manage the power functionality
 	typedef struct
 	{
@@ -0,0 +1,492 @@
+/* -------------------------------------------------------------------------
+Filename: hal_sim_benchmark.c
+
+Job#: 20473
+Date Created: 10/16/2026
+
+Purpose: Host benchmark of the memory layout of sensor entries (See hal_simulation.h, enabled with SIM_LAYOUT_BENCHMARK)
+		 Per clock scans of data sampling and data collection tasks are executed over MAX_SENSOR_COUNT entries on
+		 the legacy layout (single volatile SMART_SENSORS_STRUCT array) and on the current layout of data_structure.h
+		 (cold SENSOR_CONFIG_STRUCT, SENSOR_SAMPLE_STRUCT payload and hot SENSOR_RUNTIME_STRUCT parallel arrays).
+		 Host time only gives the relative cost of both layouts, bytes spanned per scan is the figure which carries to target.
+		 Smart Sensor acquisition benchmark (SIM_SMART_SENSOR_BENCHMARK) fetches all the Smart Sensors of SPID, SPIE and SPIF groups
+		 one at a time and all the groups at once, it is measured on virtual clock.
+
+Functions:
+fnSimBenchmarkTime					Host monotonic time in nano seconds
+fnSimBenchmarkFill					Same pseudo random Execution Table in both layouts
+fnSimLegacyClockScan				Sample/radio clock counter scan on legacy layout
+fnSimLegacyStateScan				Sampling state scan on legacy layout
+fnSimLegacyCollect					Data collection of due sensors on legacy layout
+fnSimCurrentClockScan				Sample/radio clock counter scan on current layout
+fnSimCurrentStateScan				Sampling state scan on current layout
+fnSimCurrentCollect					Data collection of due sensors on current layout
+fnSimLayoutBenchmark				Executes all the scans on both layouts and prints comparison
+fnSimSmartSensorBenchmark			Fetches all the Smart Sensors one at a time and all the groups at once and prints comparison
+
+Interrupts:
+-NA-
+
+
+Author: Aalok Shah
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+--------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+//_____  I N C L U D E S ______________________________________________________________
+
+#include <time.h>						// Host monotonic clock
+#include "system_globals.h"				// Sensor entry structures of current layout
+#include "hal_simulation.h"				// Simulated AVR-AXMEGAA1U Peripherals for host build
+#include "sensor_management.h"			// Smart Sensor acquisition
+
+//_____ M A C R O S ____________________________________________________________________
+
+//Default no of passes of every scan when SIM_LAYOUT_BENCHMARK is set to 1
+#define SIM_BENCHMARK_DEFAULT_PASSES		200000
+
+//Divisors and sample average counts of generated Execution Table are kept in this range
+#define SIM_BENCHMARK_MAX_DIVISOR			10
+#define SIM_BENCHMARK_MAX_AVERAGE			4
+
+//Total scans compared in report
+#define SIM_BENCHMARK_TOTAL_SCANS			3
+
+//Smart Sensors on SENSOR MC hardware (SPID0-SPID4, SPIE0-SPIE4 and SPIF0-SPIF5) and longest frame of Smart Sensor model
+#define SIM_BENCHMARK_SMART_SENSORS			16
+#define SIM_BENCHMARK_SMART_FRAME_SIZE		64
+
+//_____ S T R U C T U R E S ____________________________________________________________
+
+//Sensor entry before hot/cold split (copy of SMART_SENSORS_STRUCT of earlier data_structure.h)
+typedef struct
+{
+	uint8_t		chSensorID;
+	uint8_t		chSensorCtrlByte;
+	uint8_t		chSampleClockDivisor;
+	uint8_t		chSampleClockCounter;
+	uint8_t		chRadioClockDivisor;
+	uint8_t		chRadioClockCounter;
+	uint8_t		chSensorStatusFlag;
+	uint8_t		chSensorDataLength;
+	uint16_t	nSensorData[MAX_SENSOR_DATA_LENGTH];
+	uint32_t	nSensorAvgData;
+	uint8_t		chSensorSampleAvgTotalCount;
+	uint8_t		chSensorSampleAvgCounter;
+}SIM_LEGACY_SENSORS_STRUCT;
+
+//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+//Legacy layout is volatile same as ghSensorControl used to be
+static volatile SIM_LEGACY_SENSORS_STRUCT	ghSimLegacySensor[MAX_SENSOR_COUNT];
+
+//Private instances of current layout (firmware globals are not disturbed)
+static SENSOR_CONFIG_STRUCT					ghSimBenchConfig[MAX_SENSOR_COUNT];
+static SENSOR_SAMPLE_STRUCT					ghSimBenchSample[MAX_SENSOR_COUNT];
+static SENSOR_RUNTIME_STRUCT				ghSimBenchRuntime;
+
+//Collection packet filled by both layouts
+static uint8_t								gchSimBenchPacket[MAX_SENSOR_COUNT * ((MAX_SENSOR_DATA_LENGTH * 2) + 1)];
+
+//Names of scans in report
+static const char							*gszSimBenchScan[SIM_BENCHMARK_TOTAL_SCANS] = {"Clock counter scan","Sampling state scan","Data collection"};
+
+//Sample slots of Smart Sensors
+static uint8_t								gchSimBenchSmartSample[SIM_BENCHMARK_SMART_SENSORS][SIM_BENCHMARK_SMART_FRAME_SIZE];
+
+//_____ fnSimBenchmarkTime ____________________________________________________________________
+//
+// @brief	Host monotonic time
+// @return	Time in nano seconds
+
+static uint64_t fnSimBenchmarkTime(void)
+{
+	struct timespec hTime;
+	
+	clock_gettime(CLOCK_MONOTONIC,&hTime);
+	
+	return ((uint64_t)hTime.tv_sec * SIM_NSEC_PER_SEC) + (uint64_t)hTime.tv_nsec;
+}
+
+//_____ fnSimBenchmarkFill ____________________________________________________________________
+//
+// @brief	Fills the same pseudo random Execution Table of MAX_SENSOR_COUNT entries in both layouts
+
+static void fnSimBenchmarkFill(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chLoopIndex = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		ghSimBenchConfig[chSensorCounter].chSensorID					= chSensorCounter;
+		ghSimBenchConfig[chSensorCounter].chSensorCtrlByte				= RESET_VALUE;
+		ghSimBenchConfig[chSensorCounter].chSampleClockDivisor			= (fnSimRandom() % SIM_BENCHMARK_MAX_DIVISOR) + 1;
+		ghSimBenchConfig[chSensorCounter].chRadioClockDivisor			= (fnSimRandom() % SIM_BENCHMARK_MAX_DIVISOR) + 1;
+		ghSimBenchConfig[chSensorCounter].chSensorDataLength			= (fnSimRandom() % MAX_SENSOR_DATA_LENGTH) + 1;
+		ghSimBenchConfig[chSensorCounter].chSensorSampleAvgTotalCount	= (fnSimRandom() % SIM_BENCHMARK_MAX_AVERAGE) + 1;
+		ghSimBenchRuntime.chSampleClockCounter[chSensorCounter]			= ghSimBenchConfig[chSensorCounter].chSampleClockDivisor;
+		ghSimBenchRuntime.chRadioClockCounter[chSensorCounter]			= RESET_VALUE;
+		ghSimBenchRuntime.chSensorStatusFlag[chSensorCounter]			= SAMPLE_STATE_OFF;
+		ghSimBenchRuntime.chSensorSampleAvgCounter[chSensorCounter]		= RESET_VALUE;
+		ghSimBenchSample[chSensorCounter].nSensorAvgData				= RESET_VALUE;
+		
+		ghSimLegacySensor[chSensorCounter].chSensorID					= ghSimBenchConfig[chSensorCounter].chSensorID;
+		ghSimLegacySensor[chSensorCounter].chSensorCtrlByte				= ghSimBenchConfig[chSensorCounter].chSensorCtrlByte;
+		ghSimLegacySensor[chSensorCounter].chSampleClockDivisor			= ghSimBenchConfig[chSensorCounter].chSampleClockDivisor;
+		ghSimLegacySensor[chSensorCounter].chRadioClockDivisor			= ghSimBenchConfig[chSensorCounter].chRadioClockDivisor;
+		ghSimLegacySensor[chSensorCounter].chSensorDataLength			= ghSimBenchConfig[chSensorCounter].chSensorDataLength;
+		ghSimLegacySensor[chSensorCounter].chSensorSampleAvgTotalCount	= ghSimBenchConfig[chSensorCounter].chSensorSampleAvgTotalCount;
+		ghSimLegacySensor[chSensorCounter].chSampleClockCounter			= ghSimBenchConfig[chSensorCounter].chSampleClockDivisor;
+		ghSimLegacySensor[chSensorCounter].chRadioClockCounter			= RESET_VALUE;
+		ghSimLegacySensor[chSensorCounter].chSensorStatusFlag			= SAMPLE_STATE_OFF;
+		ghSimLegacySensor[chSensorCounter].chSensorSampleAvgCounter		= RESET_VALUE;
+		ghSimLegacySensor[chSensorCounter].nSensorAvgData				= RESET_VALUE;
+		
+		for(chLoopIndex = RESET_COUNTER; chLoopIndex < MAX_SENSOR_DATA_LENGTH; chLoopIndex++)
+		{
+			ghSimBenchSample[chSensorCounter].nSensorData[chLoopIndex]	= ((uint16_t)chSensorCounter << BIT_8_bp) | chLoopIndex;
+			ghSimLegacySensor[chSensorCounter].nSensorData[chLoopIndex]	= ghSimBenchSample[chSensorCounter].nSensorData[chLoopIndex];
+		}
+	}
+	
+	return;
+}
+
+//_____ fnSimLegacyClockScan ____________________________________________________________________
+//
+// @brief	Sample and radio clock counters of all the entries are advanced (sequential counter path of fnFetchDueSensors)
+// @return	No of entries due
+
+static uint32_t __attribute__((noinline)) fnSimLegacyClockScan(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint32_t lDueCount = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		if(++ghSimLegacySensor[chSensorCounter].chSampleClockCounter >= ghSimLegacySensor[chSensorCounter].chSampleClockDivisor)
+		{
+			ghSimLegacySensor[chSensorCounter].chSampleClockCounter = RESET_COUNTER;
+			lDueCount++;
+		}
+		
+		if(++ghSimLegacySensor[chSensorCounter].chRadioClockCounter >= ghSimLegacySensor[chSensorCounter].chRadioClockDivisor)
+		{
+			ghSimLegacySensor[chSensorCounter].chRadioClockCounter = RESET_COUNTER;
+			lDueCount++;
+		}
+	}
+	
+	return lDueCount;
+}
+
+//_____ fnSimLegacyStateScan ____________________________________________________________________
+//
+// @brief	Entries which are OFF and need more samples are started and started entries are put back to OFF
+//			(state checks of data sampling task)
+// @return	No of entries started
+
+static uint32_t __attribute__((noinline)) fnSimLegacyStateScan(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint32_t lStartCount = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		if(ghSimLegacySensor[chSensorCounter].chSensorStatusFlag != SAMPLE_STATE_OFF)
+		{
+			ghSimLegacySensor[chSensorCounter].chSensorStatusFlag = SAMPLE_STATE_OFF;
+		}
+		else if(ghSimLegacySensor[chSensorCounter].chSensorSampleAvgCounter < ghSimLegacySensor[chSensorCounter].chSensorSampleAvgTotalCount)
+		{
+			ghSimLegacySensor[chSensorCounter].chSensorStatusFlag = SAMPLE_STATE_START;
+			lStartCount++;
+		}
+	}
+	
+	return lStartCount;
+}
+
+//_____ fnSimLegacyCollect ____________________________________________________________________
+//
+// @brief	Sensor ID and data of every entry are packed in collection packet and averages are reset (data collection task)
+// @return	Bytes packed
+
+static uint32_t __attribute__((noinline)) fnSimLegacyCollect(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chLoopIndex = RESET_COUNTER;
+	uint16_t nDataIndex = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		gchSimBenchPacket[nDataIndex++] = ghSimLegacySensor[chSensorCounter].chSensorID;
+		
+		for(chLoopIndex = RESET_COUNTER; chLoopIndex < ghSimLegacySensor[chSensorCounter].chSensorDataLength; chLoopIndex++)
+		{
+			gchSimBenchPacket[nDataIndex++] = ghSimLegacySensor[chSensorCounter].nSensorData[chLoopIndex] >> BIT_8_bp;
+			gchSimBenchPacket[nDataIndex++] = ghSimLegacySensor[chSensorCounter].nSensorData[chLoopIndex];
+		}
+		
+		ghSimLegacySensor[chSensorCounter].chSensorSampleAvgCounter = RESET_COUNTER;
+		ghSimLegacySensor[chSensorCounter].nSensorAvgData = RESET_VALUE;
+	}
+	
+	return nDataIndex;
+}
+
+//_____ fnSimCurrentClockScan ____________________________________________________________________
+//
+// @brief	Same as fnSimLegacyClockScan on current layout
+// @return	No of entries due
+
+static uint32_t __attribute__((noinline)) fnSimCurrentClockScan(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint32_t lDueCount = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		if(++ghSimBenchRuntime.chSampleClockCounter[chSensorCounter] >= ghSimBenchConfig[chSensorCounter].chSampleClockDivisor)
+		{
+			ghSimBenchRuntime.chSampleClockCounter[chSensorCounter] = RESET_COUNTER;
+			lDueCount++;
+		}
+		
+		if(++ghSimBenchRuntime.chRadioClockCounter[chSensorCounter] >= ghSimBenchConfig[chSensorCounter].chRadioClockDivisor)
+		{
+			ghSimBenchRuntime.chRadioClockCounter[chSensorCounter] = RESET_COUNTER;
+			lDueCount++;
+		}
+	}
+	
+	return lDueCount;
+}
+
+//_____ fnSimCurrentStateScan ____________________________________________________________________
+//
+// @brief	Same as fnSimLegacyStateScan on current layout
+// @return	No of entries started
+
+static uint32_t __attribute__((noinline)) fnSimCurrentStateScan(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint32_t lStartCount = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		if(ghSimBenchRuntime.chSensorStatusFlag[chSensorCounter] != SAMPLE_STATE_OFF)
+		{
+			ghSimBenchRuntime.chSensorStatusFlag[chSensorCounter] = SAMPLE_STATE_OFF;
+		}
+		else if(ghSimBenchRuntime.chSensorSampleAvgCounter[chSensorCounter] < ghSimBenchConfig[chSensorCounter].chSensorSampleAvgTotalCount)
+		{
+			ghSimBenchRuntime.chSensorStatusFlag[chSensorCounter] = SAMPLE_STATE_START;
+			lStartCount++;
+		}
+	}
+	
+	return lStartCount;
+}
+
+//_____ fnSimCurrentCollect ____________________________________________________________________
+//
+// @brief	Same as fnSimLegacyCollect on current layout
+// @return	Bytes packed
+
+static uint32_t __attribute__((noinline)) fnSimCurrentCollect(void)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chLoopIndex = RESET_COUNTER;
+	uint16_t nDataIndex = RESET_COUNTER;
+	
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < MAX_SENSOR_COUNT; chSensorCounter++)
+	{
+		gchSimBenchPacket[nDataIndex++] = ghSimBenchConfig[chSensorCounter].chSensorID;
+		
+		for(chLoopIndex = RESET_COUNTER; chLoopIndex < ghSimBenchConfig[chSensorCounter].chSensorDataLength; chLoopIndex++)
+		{
+			gchSimBenchPacket[nDataIndex++] = ghSimBenchSample[chSensorCounter].nSensorData[chLoopIndex] >> BIT_8_bp;
+			gchSimBenchPacket[nDataIndex++] = ghSimBenchSample[chSensorCounter].nSensorData[chLoopIndex];
+		}
+		
+		ghSimBenchRuntime.chSensorSampleAvgCounter[chSensorCounter] = RESET_COUNTER;
+		ghSimBenchSample[chSensorCounter].nSensorAvgData = RESET_VALUE;
+	}
+	
+	return nDataIndex;
+}
+
+//_____ fnSimLayoutBenchmark ____________________________________________________________________
+//
+// @brief	Executes every scan on both layouts for the given no of passes and prints host time per pass,
+//			bytes spanned by the fields which the scan reads (distance between first and last byte touched) and SRAM of both layouts.
+//			Results of both layouts are compared so a mismatch in scans is reported as well.
+// @param	lPasses		No of passes of every scan
+
+void fnSimLayoutBenchmark(uint32_t lPasses)
+{
+	uint32_t (*pfnLegacyScan[SIM_BENCHMARK_TOTAL_SCANS])(void) = {fnSimLegacyClockScan,fnSimLegacyStateScan,fnSimLegacyCollect};
+	uint32_t (*pfnCurrentScan[SIM_BENCHMARK_TOTAL_SCANS])(void) = {fnSimCurrentClockScan,fnSimCurrentStateScan,fnSimCurrentCollect};
+	
+	//Bytes spanned by one scan: legacy scans stride over whole entries, current scans walk hot arrays (and config/payload where read)
+	uint32_t lLegacySpan[SIM_BENCHMARK_TOTAL_SCANS] = {
+		sizeof(ghSimLegacySensor),
+		sizeof(ghSimLegacySensor),
+		sizeof(ghSimLegacySensor)};
+	uint32_t lCurrentSpan[SIM_BENCHMARK_TOTAL_SCANS] = {
+		(2 * MAX_SENSOR_COUNT) + sizeof(ghSimBenchConfig),
+		(2 * MAX_SENSOR_COUNT) + sizeof(ghSimBenchConfig),
+		MAX_SENSOR_COUNT + sizeof(ghSimBenchConfig) + sizeof(ghSimBenchSample)};
+	
+	uint64_t lStartTime = RESET_VALUE;
+	uint64_t lLegacyTime = RESET_VALUE;
+	uint64_t lCurrentTime = RESET_VALUE;
+	uint64_t lLegacyResult = RESET_VALUE;
+	uint64_t lCurrentResult = RESET_VALUE;
+	uint32_t lPass = RESET_COUNTER;
+	uint8_t chScan = RESET_COUNTER;
+	
+	if(lPasses == RESET_VALUE)
+	{
+		lPasses = SIM_BENCHMARK_DEFAULT_PASSES;
+	}
+	
+	fnSimBenchmarkFill();
+	
+	fprintf(stderr,"\n-------- Sensor Entry Layout Benchmark (%u entries, %u passes) --------\n",MAX_SENSOR_COUNT,lPasses);
+	fprintf(stderr,"SRAM of sensor entries  : legacy %u bytes, current %u bytes (config %u, sample %u, runtime %u)\n",
+			(uint32_t)sizeof(ghSimLegacySensor),
+			(uint32_t)(sizeof(ghSimBenchConfig) + sizeof(ghSimBenchSample) + sizeof(ghSimBenchRuntime)),
+			(uint32_t)sizeof(ghSimBenchConfig),(uint32_t)sizeof(ghSimBenchSample),(uint32_t)sizeof(ghSimBenchRuntime));
+	
+	for(chScan = RESET_COUNTER; chScan < SIM_BENCHMARK_TOTAL_SCANS; chScan++)
+	{
+		lLegacyResult = RESET_VALUE;
+		lCurrentResult = RESET_VALUE;
+		
+		lStartTime = fnSimBenchmarkTime();
+		for(lPass = RESET_COUNTER; lPass < lPasses; lPass++)
+		{
+			lLegacyResult += pfnLegacyScan[chScan]();
+		}
+		lLegacyTime = fnSimBenchmarkTime() - lStartTime;
+		
+		lStartTime = fnSimBenchmarkTime();
+		for(lPass = RESET_COUNTER; lPass < lPasses; lPass++)
+		{
+			lCurrentResult += pfnCurrentScan[chScan]();
+		}
+		lCurrentTime = fnSimBenchmarkTime() - lStartTime;
+		
+		fprintf(stderr,"%-24s: legacy %7.1f ns/pass %5u bytes, current %7.1f ns/pass %5u bytes (%.2fx)%s\n",gszSimBenchScan[chScan],
+				(double)lLegacyTime / lPasses,lLegacySpan[chScan],
+				(double)lCurrentTime / lPasses,lCurrentSpan[chScan],
+				(lCurrentTime > 0) ? ((double)lLegacyTime / lCurrentTime) : 0.0,
+				(lLegacyResult == lCurrentResult) ? "" : " RESULT MISMATCH");
+	}
+	
+	return;
+}
+
+//_____ fnSimSmartSensorBenchmark ____________________________________________________________________
+//
+// @brief	Fetches all the 16 Smart Sensors with fnSmartSensorsDataCollection (one sensor at a time, as the sensors used to be fetched)
+//			and with fnSmartSensorsAcquisitionAdd/Run (all the groups at once) and prints virtual time of both.
+// @param	chFrameLength	Bytes fetched from every Smart Sensor
+
+void fnSimSmartSensorBenchmark(uint8_t chFrameLength)
+{
+	const uint8_t chGroupSensors[MAX_SMART_SENSOR_GROUPS] = {SMART_SENSOR_SPID4,SMART_SENSOR_SPIE4,SMART_SENSOR_SPIF5};
+	SIM_TIME lStartTime = RESET_VALUE;
+	SIM_TIME lSequentialTime = RESET_VALUE;
+	SIM_TIME lConcurrentTime = RESET_VALUE;
+	uint8_t chGroup = RESET_COUNTER;
+	uint8_t chSensorValue = RESET_COUNTER;
+	uint8_t chSensor = RESET_COUNTER;
+	uint8_t chFailed = RESET_COUNTER;
+	uint8_t chComplete = RESET_VALUE;
+	
+	if(chFrameLength > SIM_BENCHMARK_SMART_FRAME_SIZE)
+	{
+		chFrameLength = SIM_BENCHMARK_SMART_FRAME_SIZE;
+	}
+	
+	fprintf(stderr,"\n-------- Smart Sensor Acquisition Benchmark (%u sensors, %u bytes per frame) --------\n",SIM_BENCHMARK_SMART_SENSORS,chFrameLength);
+	
+	//One sensor at a time
+	lStartTime = fnSimGetTime();
+	for(chGroup = RESET_COUNTER, chSensor = RESET_COUNTER; chGroup < MAX_SMART_SENSOR_GROUPS; chGroup++)
+	{
+		for(chSensorValue = SMART_SENSOR_SPID0; chSensorValue <= chGroupSensors[chGroup]; chSensorValue++, chSensor++)
+		{
+			if(fnSmartSensorsDataCollection(chGroup,chSensorValue,gchSimBenchSmartSample[chSensor],chFrameLength) == RETURN_FALSE)
+			{
+				chFailed++;
+			}
+		}
+	}
+	lSequentialTime = fnSimGetTime() - lStartTime;
+	
+	//All the groups at once
+	lStartTime = fnSimGetTime();
+	for(chGroup = RESET_COUNTER, chSensor = RESET_COUNTER; chGroup < MAX_SMART_SENSOR_GROUPS; chGroup++)
+	{
+		for(chSensorValue = SMART_SENSOR_SPID0; chSensorValue <= chGroupSensors[chGroup]; chSensorValue++, chSensor++)
+		{
+			if(fnSmartSensorsAcquisitionAdd(chGroup,chSensorValue,gchSimBenchSmartSample[chSensor],chFrameLength) == RETURN_FALSE)
+			{
+				chFailed++;
+			}
+		}
+	}
+	chComplete = fnSmartSensorsAcquisitionRun();
+	lConcurrentTime = fnSimGetTime() - lStartTime;
+	
+	fprintf(stderr,"One sensor at a time    : %7.1f us\n",(double)lSequentialTime / SIM_NSEC_PER_USEC);
+	fprintf(stderr,"All groups at once      : %7.1f us (%.2fx, groups complete 0x%02X)%s\n",(double)lConcurrentTime / SIM_NSEC_PER_USEC,
+			(lConcurrentTime > 0) ? ((double)lSequentialTime / lConcurrentTime) : 0.0,chComplete,
+			(chFailed == RESET_COUNTER) ? "" : " SENSOR REJECTED");
+	
+	return;
+}
@@ -0,0 +1,1362 @@
+/* -------------------------------------------------------------------------
+Filename: hal_sim_devices.c
+
+Job#: 20473
+Date Created: 10/16/2026
+
+Purpose: Behavioral models of the chips connected to SENSOR MC for host simulation (See hal_simulation.h)
+		 CC1125 radio (registers, FIFOs, strobes and over the air timing), RFC Console at the other end of RF link,
+		 I2C slaves (Chamber Pressure Sensor, Gyrometer, E2PROM), ADC inputs and Smart Sensors.
+
+Functions:
+fnSimDevicesInit					Power on state of all the simulated devices
+fnSimRadioReset						Reset state of CC1125 model
+fnSimRadioPowered					Tracks power and reset lines of CC1125
+fnSimRadioStatusByte				Chip status byte of CC1125
+fnSimRadioAirTime					Over the air time of packet
+fnSimRadioTxSent					Bytes of packet sent over air
+fnSimRadioRxReceived				Bytes of packet received from air
+fnSimRadioFifoThrArm				Schedules next FIFO threshold interrupt of CC1125
+fnSimRadioFifoError					TX FIFO underflow and RX FIFO overflow of CC1125
+fnSimRadioStrobe					Executes command strobe of CC1125
+fnSimRadioSpiAccess					SPI transaction with CC1125
+fnSimRadioEvent						Timed events of CC1125 and RFC Console
+fnSimAirLoss						Loss of RF packet in the air (random loss and link outage window)
+fnSimRfcReceive						RFC Console handling of packet sent by SENSOR MC
+fnSimRfcBuildExecutionTable			Execution Table sent by RFC Console on request
+fnSimRfcUnpackBits					Extracts field of bit packed data message
+fnSimRfcUnpackSamples				Unpacks sensor samples carried by bit packed data packet
+fnSimRfcDecodeSamples				Decodes sensor samples carried by data packet (raw, delta or bit packed encoding)
+fnSimI2cTransaction					I2C transaction with the addressed slave
+fnSimAdcSample						Conversion result of ADC input
+fnSimSmartSensorTransfer			SPI transfer with Smart Sensor (Configuration frame and measurement word)
+
+Interrupts:
+-NA- (Falling edge of CC1125 GPIO0/GPIO2/GPIO3 is reported by fnSimPortHFallingEdge)
+
+
+Author: Aalok Shah
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+--------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+//_____  I N C L U D E S ______________________________________________________________
+
+#include <string.h>						// Block copy of FIFO and packet data
+#include "sensor_protocol.h"			// Packet headers, Execution Table layout and Sensor IDs
+#include "hal_sim_devices.h"			// Models of the chips connected to SENSOR MC
+
+//_____ M A C R O S ____________________________________________________________________
+
+//CC1125 register map
+#define SIM_RADIO_REG_SPACE					0x2F		//Configuration registers (0x00 - 0x2E)
+#define SIM_RADIO_FIFO_ADDR					0x3F		//TX FIFO on write and RX FIFO on read
+#define SIM_RADIO_EXT_ADDR(nAddress)		((nAddress) & CC1125_ADDR_BYTE_BM)
+
+//Chip status byte: STATE field (bit 6:4)
+#define SIM_STATUS_IDLE						0x00
+#define SIM_STATUS_RX						0x10
+#define SIM_STATUS_TX						0x20
+#define SIM_STATUS_CALIBRATE				0x40
+#define SIM_STATUS_RXFIFO_ERROR				0x60
+#define SIM_STATUS_TXFIFO_ERROR				0x70
+
+//Results of frequency synthesizer calibration (FS_VCO2, FS_VCO4 and FS_CHP)
+#define SIM_RADIO_FS_VCO2_VALUE				0x4A
+#define SIM_RADIO_FS_VCO4_VALUE				0x13
+#define SIM_RADIO_FS_CHP_VALUE				0x28
+
+//RSSI0: RSSI_VALID bit
+#define SIM_RADIO_RSSI_VALID				0x01
+
+//Appended status byte: CRC_OK bit
+#define SIM_RADIO_CRC_OK					0x80
+
+//Bytes of packet header which are not part of data payload
+#define SIM_PACKET_HEADER_BYTES				4
+
+//Packet descriptor of single packet message (Sequence no 1 with last packet indicator)
+#define SIM_SINGLE_PACKET_DESCRIPTOR		0x81
+
+//Packet descriptor of data packet: Sequence no (bit 2-4) and last packet indicator (bit 7)
+#define SIM_PACKET_SEQ_NO_BM				0x1C
+#define SIM_PACKET_SEQ_NO_bp				2
+#define SIM_LAST_PACKET_BM					0x80
+
+//Error control byte of data packet: Message sequence no (bit 0-2)
+#define SIM_MSG_SEQ_NO_BM					0x07
+
+//Execution Table sent by RFC Console
+#define SIM_ET_SENSOR_ENTRIES				4			//Sensor entries of base table (Repeated when SIM_ET_SENSORS asks for more)
+#define SIM_ET_MAX_SENSOR_ENTRIES			((255 - SENSORS_START_INDEX) / SENSOR_ENTRY_OFFSET)		//Execution table within variable length limit of CC1125
+#define SIM_MAX_SMART_SENSORS				(PAYLOAD_SENSOR_ID_BM + 1 - SMART_SENSOR_ID_FIRST)			//Smart Sensor IDs within 5 bit header of delta and bit packed entries
+
+//Gyrometer registers
+#define SIM_GYRO_DEVICE_ID_VALUE			0xB1
+#define SIM_GYRO_NORMAL_MODE				0x0F
+#define SIM_GYRO_DATA_READY					0x01
+#define SIM_GYRO_DATA_BYTES					6
+#define SIM_GYRO_REG_SPACE					0x100
+
+//Chamber pressure sensor returns 2 bytes of pressure followed by 2 bytes of temperature
+#define SIM_PRESSURE_TEMPERATURE_VALUE		0x6000
+
+//Smart Sensors of each group (Addressed by select code S2:S1:S0)
+#define SIM_SMART_SENSOR_GROUPS				3
+#define SIM_SMART_SENSOR_SELECT_CODES		8
+#define SIM_SMART_SENSOR_MEASUREMENT		0x4000		//Measurement of configured Smart Sensor before its address and sample count are added
+#define SIM_SMART_SENSOR_CTRL				0x01		//Control byte of Smart Sensor entries of execution table
+
+//_____ S T R U C T U R E S ____________________________________________________________
+
+//State of CC1125 radio chip
+typedef struct
+{
+	uint8_t  chRegister[SIM_RADIO_REG_SPACE];				//Configuration registers
+	uint8_t  chExtRegister[SIM_RADIO_EXT_REG_SPACE];		//Extended register space
+	uint8_t  chTxPacket[SIM_RADIO_PACKET_SIZE];				//Bytes written in TX FIFO since it was flushed
+	uint8_t  chRxPacket[SIM_RADIO_PACKET_SIZE];				//Packet in RX FIFO (Length byte, payload, RSSI and LQI)
+	uint16_t nTxCount;										//Bytes written in TX FIFO since it was flushed
+	uint16_t nTxLength;										//Bytes of packet being sent (Length byte and payload)
+	uint16_t nRxCount;										//Bytes of packet in chRxPacket
+	uint16_t nRxIndex;										//Next byte to read from RX FIFO
+	SIM_TIME lTxDataStart;									//Length byte of packet being sent starts on air (After preamble and sync word)
+	SIM_TIME lRxDataStart;									//Length byte of packet being received starts on air
+	uint8_t  chRxStreaming;									//Packet is being received (Bytes arrive in RX FIFO at air rate)
+	uint8_t  chMarcState;									//Main radio control state
+	uint8_t  chPowered;										//Chip is powered and out of reset
+	uint8_t  chInitPending;									//SRES is received and chip is not used yet
+	uint32_t lInitTransactions;								//SPI transactions counter at SRES
+	SIM_TIME lInitStart;									//Time of SRES
+}SIM_RADIO_MODEL;
+
+//Packet travelling over air between SENSOR MC and RFC Console
+typedef struct
+{
+	uint8_t  chBuff[SIM_RADIO_PACKET_SIZE];					//Length byte followed by payload
+	uint8_t  chValid;										//Packet is in air
+	uint8_t  chReplayAck;									//Packet acknowledges record replayed from store-and-forward log
+}SIM_AIR_PACKET;
+
+//State of Gyrometer (MAX21000)
+typedef struct
+{
+	uint8_t  chRegister[SIM_GYRO_REG_SPACE];
+	uint8_t  chRegPointer;
+	SIM_TIME lLastDataRead;
+}SIM_GYRO_MODEL;
+
+//State of E2PROM
+typedef struct
+{
+	uint8_t  chMemory[SIM_E2PROM_SIZE];
+	uint16_t nAddress;
+	SIM_TIME lWriteCycleEnd;				//Address is not acknowledged till write cycle of last page write is over
+}SIM_E2PROM_MODEL;
+
+//Smart Sensor configured by SENSOR MC
+typedef struct
+{
+	uint8_t  chConfig[SMART_SENSOR_CONFIG_FRAME_SIZE];		//Last configuration frame
+	uint8_t  chConfigured;									//Configuration frame is received
+	uint16_t nSampleCount;									//Measurements fetched since configuration
+}SIM_SMART_SENSOR_MODEL;
+
+//Delta decoding state of RFC Console for every Sensor ID
+typedef struct
+{
+	uint16_t nKeyData[MAX_SENSOR_DATA_LENGTH];				//Data of last key entry of sensor
+	uint8_t  chKeyEpoch;									//Key epoch bits of last key entry
+	uint8_t  chKeyValid;									//Key entry of sensor is received
+}SIM_RFC_DECODER;
+
+//Bit stream reader of RFC Console for bit packed data message (Most significant bit first)
+typedef struct
+{
+	uint8_t  *pchPacket;									//Data packet received over air
+	uint16_t nDataIndex;									//Next byte to load in bit buffer
+	uint16_t nLastIndex;									//Index of last data byte
+	uint32_t lBitBuffer;									//Loaded bits which are not extracted yet (Least significant chBitCount bits)
+	uint8_t  chBitCount;									//No of bits held by lBitBuffer
+}SIM_RFC_BIT_READER;
+
+//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+static SIM_RADIO_MODEL		ghSimRadio;
+static SIM_AIR_PACKET		ghSimRfcReply;
+static SIM_GYRO_MODEL		ghSimGyro;
+static SIM_E2PROM_MODEL		ghSimE2prom;
+static SIM_SMART_SENSOR_MODEL	ghSimSmartSensor[SIM_SMART_SENSOR_GROUPS][SIM_SMART_SENSOR_SELECT_CODES];
+static SIM_RFC_DECODER		ghSimRfcDecoder[PAYLOAD_SENSOR_ID_BM + 1];						//Smart Sensor IDs follow driver registry
+static SIM_RFC_DECODER		ghSimRfcBacklogDecoder[PAYLOAD_SENSOR_ID_BM + 1];				//Delta decoding of packets replayed from store-and-forward log
+static uint8_t				gchSimRfcWindowBitmap;							//Packets of generation received in selective repeat
+static uint8_t				gchSimRfcWindowMessage;							//Message sequence no of generation held in gchSimRfcWindowBitmap
+static uint8_t				gchSimRfcDeliveredBitmap;						//Packets of generation counted as delivered (Packet sent again after lost ACK is not counted)
+static uint8_t				gchSimRfcDeliveredMessage;						//Message sequence no of generation held in gchSimRfcDeliveredBitmap
+static uint8_t				gchSimRfcReplayUnacked;							//Replayed record is counted but SENSOR MC did not hear its ACK (Record is replayed again)
+
+//_____ fnSimRadioReset ____________________________________________________________________
+//
+// @brief	State of CC1125 after power on or SRES strobe. All the pending radio events are canceled.
+
+static void fnSimRadioReset(void)
+{
+	memset(ghSimRadio.chRegister,0,sizeof(ghSimRadio.chRegister));
+	memset(ghSimRadio.chExtRegister,0,sizeof(ghSimRadio.chExtRegister));
+	
+	ghSimRadio.nTxCount			= RESET_COUNTER;
+	ghSimRadio.nRxCount			= RESET_COUNTER;
+	ghSimRadio.nRxIndex			= RESET_COUNTER;
+	ghSimRadio.chRxStreaming	= RESET_FLAG;
+	ghSimRadio.chMarcState		= SIM_MARCSTATE_IDLE;
+	
+	fnSimCancelEvent(SIM_EVENT_RADIO_CALIBRATION);
+	fnSimCancelEvent(SIM_EVENT_RADIO_TX_END);
+	fnSimCancelEvent(SIM_EVENT_RADIO_RX_END);
+	fnSimCancelEvent(SIM_EVENT_RADIO_TX_FIFO_THR);
+	fnSimCancelEvent(SIM_EVENT_RADIO_RX_FIFO_THR);
+	
+	return;
+}
+
+//_____ fnSimDevicesInit ____________________________________________________________________
+//
+// @brief	Power on state of all the simulated devices
+
+void fnSimDevicesInit(void)
+{
+	fnSimRadioReset();
+	ghSimRadio.chPowered = RESET_FLAG;
+	ghSimRadio.chInitPending = RESET_FLAG;
+	ghSimRfcReply.chValid = RESET_FLAG;
+	
+	memset(&ghSimGyro,0,sizeof(ghSimGyro));
+	ghSimGyro.chRegister[GYRO_MAX21000_DEVICE_ID] = SIM_GYRO_DEVICE_ID_VALUE;
+	
+	memset(ghSimE2prom.chMemory,0xFF,sizeof(ghSimE2prom.chMemory));		//Erased state
+	ghSimE2prom.nAddress = RESET_VALUE;
+	
+	memset(ghSimSmartSensor,0,sizeof(ghSimSmartSensor));
+	
+	return;
+}
+
+//_____ fnSimRadioPowered ____________________________________________________________________
+//
+// @brief	CC1125 is powered from 5V source (RADIO_PWR_EN) and kept in reset while RADIO_RESET is low
+// @return	TRUE if chip is powered and out of reset. Chip is reset when it comes out of power down.
+
+static uint8_t fnSimRadioPowered(void)
+{
+	if(!(PORTH.OUT & PH_RADIO_PWR_EN) || !(PORTC.OUT & PC_RADIO_RESET))
+	{
+		if(ghSimRadio.chPowered)
+		{
+			fnSimRadioReset();
+			ghSimRadio.chPowered = RESET_FLAG;
+		}
+		
+		return RESET_FLAG;
+	}
+	
+	ghSimRadio.chPowered = SET_FLAG;
+	return SET_FLAG;
+}
+
+//_____ fnSimRadioStatusByte ____________________________________________________________________
+//
+// @brief	Chip status byte returned by CC1125 on every address byte (CHIP_RDYn is always low once chip is powered)
+// @return	Chip status byte
+
+static uint8_t fnSimRadioStatusByte(void)
+{
+	switch(ghSimRadio.chMarcState)
+	{
+		case SIM_MARCSTATE_RX:				return SIM_STATUS_RX;
+		case SIM_MARCSTATE_TX:				return SIM_STATUS_TX;
+		case SIM_MARCSTATE_CALIBRATE:		return SIM_STATUS_CALIBRATE;
+		case SIM_MARCSTATE_RXFIFO_ERROR:	return SIM_STATUS_RXFIFO_ERROR;
+		case SIM_MARCSTATE_TXFIFO_ERROR:	return SIM_STATUS_TXFIFO_ERROR;
+		default:							return SIM_STATUS_IDLE;
+	}
+}
+
+//_____ fnSimRadioAirTime ____________________________________________________________________
+//
+// @brief	Over the air time of variable length packet (preamble, sync word, length byte, payload and CRC)
+// @param	chLength	Payload length (value of length byte)
+// @return	Time in nano seconds
+
+static SIM_TIME fnSimRadioAirTime(uint8_t chLength)
+{
+	SIM_TIME lBits = (SIM_TIME)(SIM_RADIO_PREAMBLE_BYTES + SIM_RADIO_SYNC_BYTES + 1 + chLength + SIM_RADIO_CRC_BYTES) * 8;
+	
+	return (lBits * SIM_NSEC_PER_SEC) / SIM_RADIO_BIT_RATE;
+}
+
+//_____ fnSimRadioTxSent ____________________________________________________________________
+//
+// @brief	Bytes of packet being sent which are already shifted out on air (Length byte is the first one)
+// @return	No of bytes (0 if chip is not in TX)
+
+static uint16_t fnSimRadioTxSent(void)
+{
+	SIM_TIME lNow = fnSimGetTime();
+	SIM_TIME lBytes = RESET_VALUE;
+	
+	if(ghSimRadio.chMarcState != SIM_MARCSTATE_TX || lNow <= ghSimRadio.lTxDataStart)
+	{
+		return RESET_VALUE;
+	}
+	
+	lBytes = (lNow - ghSimRadio.lTxDataStart) / SIM_RADIO_BYTE_TIME;
+	return (lBytes < ghSimRadio.nTxLength) ? (uint16_t)lBytes : ghSimRadio.nTxLength;
+}
+
+//_____ fnSimRadioRxReceived ____________________________________________________________________
+//
+// @brief	Bytes of packet which are placed in RX FIFO so far. Length byte, payload, RSSI and LQI arrive at air rate while packet is received.
+// @return	No of bytes
+
+static uint16_t fnSimRadioRxReceived(void)
+{
+	SIM_TIME lNow = fnSimGetTime();
+	SIM_TIME lBytes = RESET_VALUE;
+	
+	if(!ghSimRadio.chRxStreaming)
+	{
+		return ghSimRadio.nRxCount;
+	}
+	
+	if(lNow <= ghSimRadio.lRxDataStart)
+	{
+		return RESET_VALUE;
+	}
+	
+	lBytes = (lNow - ghSimRadio.lRxDataStart) / SIM_RADIO_BYTE_TIME;
+	return (lBytes < ghSimRadio.nRxCount) ? (uint16_t)lBytes : ghSimRadio.nRxCount;
+}
+
+//_____ fnSimRadioFifoThrArm ____________________________________________________________________
+//
+// @brief	Schedules next falling edge of FIFO threshold signals when GPIO2 is TXFIFO_THR and GPIO3 is inverted RXFIFO_THR:
+//				1> GPIO2 falls when TX FIFO is drained below 127-FIFO_THR bytes (only if it is filled up to there)
+//				2> GPIO3 falls when RX FIFO is filled above FIFO_THR bytes (only if it is drained below there)
+
+static void fnSimRadioFifoThrArm(void)
+{
+	uint16_t nThreshold = ghSimRadio.chRegister[CC112X_FIFO_CFG] & SIM_RADIO_FIFO_THR_BM;
+	uint16_t nSent = fnSimRadioTxSent();
+	uint16_t nReceived = fnSimRadioRxReceived();
+	SIM_TIME lNow = fnSimGetTime();
+	SIM_TIME lEdge = RESET_VALUE;
+	
+	if(ghSimRadio.chRegister[CC112X_IOCFG2] == CC112X_GPIO_TXFIFO_THR && ghSimRadio.chMarcState == SIM_MARCSTATE_TX &&
+	   (ghSimRadio.nTxCount - nSent) >= (SIM_RADIO_FIFO_SIZE - 1 - nThreshold))
+	{
+		lEdge = ghSimRadio.lTxDataStart + (SIM_TIME)(ghSimRadio.nTxCount - (SIM_RADIO_FIFO_SIZE - 1 - nThreshold) + 1) * SIM_RADIO_BYTE_TIME;
+		fnSimScheduleEvent(SIM_EVENT_RADIO_TX_FIFO_THR,(lEdge > lNow) ? (lEdge - lNow) : 0);
+	}
+	
+	if(ghSimRadio.chRegister[CC112X_IOCFG3] == CC112X_GPIO_RXFIFO_THR_INV && ghSimRadio.chRxStreaming &&
+	   (nReceived - ghSimRadio.nRxIndex) <= nThreshold && (ghSimRadio.nRxIndex + nThreshold + 1) <= ghSimRadio.nRxCount)
+	{
+		lEdge = ghSimRadio.lRxDataStart + (SIM_TIME)(ghSimRadio.nRxIndex + nThreshold + 1) * SIM_RADIO_BYTE_TIME;
+		fnSimScheduleEvent(SIM_EVENT_RADIO_RX_FIFO_THR,(lEdge > lNow) ? (lEdge - lNow) : 0);
+	}
+	
+	return;
+}
+
+//_____ fnSimRadioFifoError ____________________________________________________________________
+//
+// @brief	TX FIFO underflow or RX FIFO overflow: Packet is aborted and GPIO0 (PKT_SYNC_RXTX) goes low as at the end of packet
+// @param	chMarcState		SIM_MARCSTATE_TXFIFO_ERROR or SIM_MARCSTATE_RXFIFO_ERROR
+
+static void fnSimRadioFifoError(uint8_t chMarcState)
+{
+	fnSimCancelEvent(SIM_EVENT_RADIO_TX_END);
+	fnSimCancelEvent(SIM_EVENT_RADIO_RX_END);
+	fnSimCancelEvent(SIM_EVENT_RADIO_TX_FIFO_THR);
+	fnSimCancelEvent(SIM_EVENT_RADIO_RX_FIFO_THR);
+	
+	if(chMarcState == SIM_MARCSTATE_RXFIFO_ERROR)
+	{
+		ghSimRadio.nRxCount = fnSimRadioRxReceived();
+		ghSimRadio.chRxStreaming = RESET_FLAG;
+		ghSimRfcReply.chValid = RESET_FLAG;
+	}
+	
+	ghSimRadio.chMarcState = chMarcState;
+	ghSimStatistics.lRadioFifoErrors++;
+	fnSimPortHFallingEdge(PH_CC1125_GPIO0);
+	
+	return;
+}
+
+//_____ fnSimRadioStrobe ____________________________________________________________________
+//
+// @brief	Executes command strobe of CC1125
+// @param	chStrobe	Command strobe (CC112X_SRES ... CC112X_SNOP)
+
+static void fnSimRadioStrobe(uint8_t chStrobe)
+{
+	//Initialization of firmware (register setup and calibration or write back of cached calibration) is over at first strobe which uses the chip
+	if(ghSimRadio.chInitPending && (chStrobe != CC112X_SRES) && (chStrobe != CC112X_SCAL))
+	{
+		ghSimRadio.chInitPending = RESET_FLAG;
+		ghSimStatistics.lRadioInits++;
+		ghSimStatistics.lRadioInitTransactions += ghSimStatistics.lRadioSpiTransactions - ghSimRadio.lInitTransactions;
+		ghSimStatistics.lRadioInitTime += fnSimGetTime() - ghSimRadio.lInitStart;
+	}
+	
+	switch(chStrobe)
+	{
+		case CC112X_SRES:
+			fnSimRadioReset();
+			ghSimRadio.chInitPending		= SET_FLAG;
+			ghSimRadio.lInitTransactions	= ghSimStatistics.lRadioSpiTransactions;
+			ghSimRadio.lInitStart			= fnSimGetTime();
+		break;
+		
+		case CC112X_SIDLE:
+		case CC112X_SPWD:
+		case CC112X_SXOFF:
+			fnSimCancelEvent(SIM_EVENT_RADIO_CALIBRATION);
+			fnSimCancelEvent(SIM_EVENT_RADIO_TX_END);
+			fnSimCancelEvent(SIM_EVENT_RADIO_RX_END);
+			fnSimCancelEvent(SIM_EVENT_RADIO_TX_FIFO_THR);
+			fnSimCancelEvent(SIM_EVENT_RADIO_RX_FIFO_THR);
+			ghSimRadio.nRxCount = fnSimRadioRxReceived();		//Reception is aborted
+			ghSimRadio.chRxStreaming = RESET_FLAG;
+			ghSimRadio.chMarcState = SIM_MARCSTATE_IDLE;
+		break;
+		
+		case CC112X_SFTX:
+			fnSimCancelEvent(SIM_EVENT_RADIO_TX_FIFO_THR);
+			ghSimRadio.nTxCount = RESET_COUNTER;
+			if(ghSimRadio.chMarcState == SIM_MARCSTATE_TXFIFO_ERROR)
+			{
+				ghSimRadio.chMarcState = SIM_MARCSTATE_IDLE;
+			}
+		break;
+		
+		case CC112X_SFRX:
+			fnSimCancelEvent(SIM_EVENT_RADIO_RX_FIFO_THR);
+			ghSimRadio.nRxCount = RESET_COUNTER;
+			ghSimRadio.nRxIndex = RESET_COUNTER;
+			ghSimRadio.chRxStreaming = RESET_FLAG;
+			if(ghSimRadio.chMarcState == SIM_MARCSTATE_RXFIFO_ERROR)
+			{
+				ghSimRadio.chMarcState = SIM_MARCSTATE_IDLE;
+			}
+		break;
+		
+		case CC112X_SCAL:
+		case CC112X_SFSTXON:
+			ghSimRadio.chMarcState = SIM_MARCSTATE_CALIBRATE;
+			fnSimScheduleEvent(SIM_EVENT_RADIO_CALIBRATION,SIM_RADIO_CALIBRATION_TIME);
+		break;
+		
+		case CC112X_SRX:
+			if(ghSimRadio.chMarcState == SIM_MARCSTATE_IDLE)
+			{
+				ghSimRadio.chMarcState = SIM_MARCSTATE_RX;
+			}
+		break;
+		
+		case CC112X_STX:
+			//Length byte must be available in TX FIFO otherwise chip ends in TX FIFO underflow
+			//Rest of the packet may be written while it is sent, TX FIFO must not run dry before last byte (Checked on write and at end of packet)
+			if(ghSimRadio.nTxCount == RESET_COUNTER)
+			{
+				ghSimRadio.chMarcState = SIM_MARCSTATE_TXFIFO_ERROR;
+				break;
+			}
+			
+			ghSimRadio.chMarcState	= SIM_MARCSTATE_TX;
+			ghSimRadio.nTxLength	= ghSimRadio.chTxPacket[CC1125_DATA_PACKET_LENGTH] + 1;
+			ghSimRadio.lTxDataStart	= fnSimGetTime() + (SIM_RADIO_PREAMBLE_BYTES + SIM_RADIO_SYNC_BYTES) * SIM_RADIO_BYTE_TIME;
+			fnSimScheduleEvent(SIM_EVENT_RADIO_TX_END,fnSimRadioAirTime(ghSimRadio.chTxPacket[CC1125_DATA_PACKET_LENGTH]));
+			fnSimRadioFifoThrArm();
+		break;
+		
+		default:
+		break;
+	}
+	
+	return;
+}
+
+//_____ fnSimRadioSpiAccess ____________________________________________________________________
+//
+// @brief	Single SPI transaction (CS low to CS high) with CC1125. Access type is decided from address as per CC112x SPI protocol.
+//			Registers and FIFOs are accessed in burst mode, strobes are executed when chCommType is RADIO_COMMAND_STROBE.
+// @param	nAddress	Register address (0x2Fxx for extended register space) or strobe command
+//			chCommType	RADIO_COMMAND_STROBE, RADIO_TRANSMIT_BYTES or RADIO_RECEIVE_BYTES
+//			pchBuff		Data bytes to write or memory to hold the read bytes
+//			nCount		No of data bytes after the address bytes
+//			pchStatus	Chip status byte returned by CC1125 in response of address byte
+// @return	FALSE if chip is not powered (MISO never goes low) otherwise returns TRUE
+
+int8_t fnSimRadioSpiAccess(uint16_t nAddress,uint8_t chCommType,uint8_t *pchBuff,uint16_t nCount,uint8_t *pchStatus)
+{
+	uint16_t nCounter = RESET_COUNTER;
+	uint16_t nLevel = RESET_VALUE;
+	uint8_t  chRegAddr = RESET_VALUE;
+	
+	if(!fnSimRadioPowered())
+	{
+		return RETURN_FALSE;
+	}
+	
+	*pchStatus = fnSimRadioStatusByte();
+	
+	if(chCommType == RADIO_COMMAND_STROBE)
+	{
+		fnSimRadioStrobe((uint8_t)(nAddress & CC1125_ADDR_BYTE_BM));
+		return RETURN_TRUE;
+	}
+	
+	//Extended register space
+	if((nAddress >> BIT_8_bp) == CC1125_EXT_ADDR_BM)
+	{
+		for(nCounter = RESET_COUNTER; nCounter < nCount; nCounter++)
+		{
+			chRegAddr = (uint8_t)(SIM_RADIO_EXT_ADDR(nAddress) + nCounter);
+			
+			if(chCommType == RADIO_TRANSMIT_BYTES)
+			{
+				ghSimRadio.chExtRegister[chRegAddr] = pchBuff[nCounter];
+				continue;
+			}
+			
+			//Status registers are generated from the chip state
+			if(chRegAddr == SIM_RADIO_EXT_ADDR(CC112X_MARCSTATE))
+			{
+				pchBuff[nCounter] = ghSimRadio.chMarcState;
+			}
+			else if(chRegAddr == SIM_RADIO_EXT_ADDR(CC112X_NUM_RXBYTES))
+			{
+				nLevel = fnSimRadioRxReceived() - ghSimRadio.nRxIndex;
+				pchBuff[nCounter] = (nLevel > SIM_RADIO_FIFO_SIZE) ? SIM_RADIO_FIFO_SIZE : (uint8_t)nLevel;
+			}
+			else if(chRegAddr == SIM_RADIO_EXT_ADDR(CC112X_NUM_TXBYTES))
+			{
+				pchBuff[nCounter] = (uint8_t)(ghSimRadio.nTxCount - fnSimRadioTxSent());
+			}
+			else if(chRegAddr == SIM_RADIO_EXT_ADDR(CC112X_RSSI0))
+			{
+				pchBuff[nCounter] = (ghSimRadio.chMarcState == SIM_MARCSTATE_RX) ? SIM_RADIO_RSSI_VALID : RESET_VALUE;
+			}
+			else if(chRegAddr == SIM_RADIO_EXT_ADDR(CC112X_RSSI1))
+			{
+				pchBuff[nCounter] = SIM_RADIO_RSSI_VALUE;
+			}
+			else
+			{
+				pchBuff[nCounter] = ghSimRadio.chExtRegister[chRegAddr];
+			}
+		}
+		
+		return RETURN_TRUE;
+	}
+	
+	chRegAddr = (uint8_t)(nAddress & SIM_RADIO_FIFO_ADDR);
+	
+	//TX FIFO: Bytes which are already sent over air leave the FIFO
+	if(chRegAddr == SIM_RADIO_FIFO_ADDR && chCommType == RADIO_TRANSMIT_BYTES)
+	{
+		nLevel = fnSimRadioTxSent();
+		
+		//Air needed the byte which is being written now
+		if(ghSimRadio.chMarcState == SIM_MARCSTATE_TX && nLevel >= ghSimRadio.nTxCount && nLevel < ghSimRadio.nTxLength)
+		{
+			fnSimRadioFifoError(SIM_MARCSTATE_TXFIFO_ERROR);		//TX FIFO underflow
+			return RETURN_TRUE;
+		}
+		
+		for(nCounter = RESET_COUNTER; nCounter < nCount; nCounter++)
+		{
+			if((ghSimRadio.nTxCount - nLevel) >= SIM_RADIO_FIFO_SIZE || ghSimRadio.nTxCount >= SIM_RADIO_PACKET_SIZE)
+			{
+				ghSimRadio.chMarcState = SIM_MARCSTATE_TXFIFO_ERROR;		//TX FIFO overflow
+				break;
+			}
+			
+			ghSimRadio.chTxPacket[ghSimRadio.nTxCount++] = pchBuff[nCounter];
+		}
+		
+		fnSimRadioFifoThrArm();
+		return RETURN_TRUE;
+	}
+	
+	//RX FIFO: Bytes of packet being received are available as they arrive from air
+	if(chRegAddr == SIM_RADIO_FIFO_ADDR)
+	{
+		nLevel = fnSimRadioRxReceived();
+		
+		if(ghSimRadio.chRxStreaming && (nLevel - ghSimRadio.nRxIndex) > SIM_RADIO_FIFO_SIZE)
+		{
+			fnSimRadioFifoError(SIM_MARCSTATE_RXFIFO_ERROR);		//RX FIFO overflow
+			return RETURN_TRUE;
+		}
+		
+		for(nCounter = RESET_COUNTER; nCounter < nCount; nCounter++)
+		{
+			if(ghSimRadio.nRxIndex >= nLevel)
+			{
+				ghSimRadio.chMarcState = SIM_MARCSTATE_RXFIFO_ERROR;		//RX FIFO underflow
+				break;
+			}
+			
+			pchBuff[nCounter] = ghSimRadio.chRxPacket[ghSimRadio.nRxIndex++];
+		}
+		
+		if(!ghSimRadio.chRxStreaming && ghSimRadio.nRxIndex >= ghSimRadio.nRxCount)
+		{
+			ghSimRadio.nRxCount = RESET_COUNTER;
+			ghSimRadio.nRxIndex = RESET_COUNTER;
+		}
+		
+		fnSimRadioFifoThrArm();
+		return RETURN_TRUE;
+	}
+	
+	//Configuration registers
+	for(nCounter = RESET_COUNTER; nCounter < nCount && (chRegAddr + nCounter) < SIM_RADIO_REG_SPACE; nCounter++)
+	{
+		if(chCommType == RADIO_TRANSMIT_BYTES)
+		{
+			ghSimRadio.chRegister[chRegAddr + nCounter] = pchBuff[nCounter];
+		}
+		else
+		{
+			pchBuff[nCounter] = ghSimRadio.chRegister[chRegAddr + nCounter];
+		}
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSimRfcBuildExecutionTable ____________________________________________________________________
+//
+// @brief	Execution Table of RFC Console as per layout expected by fnET_Upload_Task.
+//			Sample clock, radio divisor and wait time are taken from simulation configuration.
+//			Smart Sensor entries (SIM_SMART_SENSORS) follow the other entries, their sensors are spread over SPID, SPIE and SPIF groups.
+// @param	pchBuff		Memory to hold the packet (length byte followed by payload)
+
+static void fnSimRfcBuildExecutionTable(uint8_t *pchBuff)
+{
+	static const uint8_t chSensorEntry[SIM_ET_SENSOR_ENTRIES][SENSOR_ENTRY_OFFSET] =
+	{
+		//ID,					Address,	Control,	Sample Divisor,	Samples in Average,	Radio Divisor
+		{CHAMBER_TEMPERATURE,	0,	0,			1,				4,					1},
+		{CHAMBER_PRESSURE,		0,	0,			1,				4,					1},
+		{GYRO_METER,			0,	0,			2,				1,					1},
+		{UPLINK_RADIO_RSSI,		0,	0,			10,				1,					1}
+	};
+	uint8_t chEntries = ghSimConfig.chSensorEntries;
+	uint8_t chSmartSensors = ghSimConfig.chSmartSensors;
+	uint8_t chCounter = RESET_COUNTER;
+	uint8_t chLength = RESET_VALUE;
+	uint8_t *pchEntry = NULL;
+	
+	if(chEntries == RESET_VALUE || chEntries > SIM_ET_MAX_SENSOR_ENTRIES)
+	{
+		chEntries = (chEntries == RESET_VALUE) ? SIM_ET_SENSOR_ENTRIES : SIM_ET_MAX_SENSOR_ENTRIES;
+	}
+	if(chSmartSensors > SIM_MAX_SMART_SENSORS)
+	{
+		chSmartSensors = SIM_MAX_SMART_SENSORS;
+	}
+	if(chEntries + chSmartSensors > SIM_ET_MAX_SENSOR_ENTRIES)
+	{
+		chEntries = SIM_ET_MAX_SENSOR_ENTRIES - chSmartSensors;
+	}
+	chLength = SENSORS_START_INDEX + ((chEntries + chSmartSensors) * SENSOR_ENTRY_OFFSET);
+	
+	memset(pchBuff,0,chLength);
+	
+	pchBuff[CC1125_DATA_PACKET_LENGTH]		= chLength - 1;
+	pchBuff[PACKET_HEADER_INDEX]			= NEW_EXECUTION_TABLE_PACKET;
+	pchBuff[PACKET_LENGTH_INDEX]			= chLength;
+	pchBuff[PACKET_DESCRIPTOR_INDEX]		= SIM_SINGLE_PACKET_DESCRIPTOR;
+	pchBuff[PACKET_MASTER_ID_INDEX]			= ID_MASTER_CONTROLLER;
+	pchBuff[PACKET_SAMPLE_CLOCK_FREQ_BYTE1]	= ghSimConfig.nSampleClock >> BIT_8_bp;
+	pchBuff[PACKET_SAMPLE_CLOCK_FREQ_BYTE2]	= ghSimConfig.nSampleClock & CC1125_ADDR_BYTE_BM;
+	pchBuff[PACKET_CONTROL_BYTE1]			= (ghSimConfig.nRadioDivisor >> BIT_8_bp) & BIT_0_bm;		//Slow down link (CC1125)
+	
+	pchBuff[PACKET_CONTROL_BYTE1]			|= (ghSimConfig.chPayloadEncoding << PAYLOAD_ENCODING_bp) & PAYLOAD_ENCODING_BM;
+	
+	if(ghSimConfig.chDownloadWindow)
+	{
+		pchBuff[PACKET_CONTROL_BYTE1]		|= DOWNLOAD_WINDOW_BM;
+	}
+	
+	pchBuff[PACKET_CONTROL_BYTE2]			= ghSimConfig.nRadioDivisor & CC1125_ADDR_BYTE_BM;
+	pchBuff[PACKET_WAIT_TIME_BYTE1]			= ghSimConfig.nCommWaitTime >> BIT_8_bp;
+	pchBuff[PACKET_WAIT_TIME_BYTE2]			= ghSimConfig.nCommWaitTime & CC1125_ADDR_BYTE_BM;
+	
+	for(chCounter = RESET_COUNTER; chCounter < chEntries; chCounter++)
+	{
+		memcpy(&pchBuff[SENSORS_START_INDEX + (chCounter * SENSOR_ENTRY_OFFSET)],chSensorEntry[chCounter % SIM_ET_SENSOR_ENTRIES],SENSOR_ENTRY_OFFSET);
+	}
+	
+	//Smart Sensor n is sensor value n/3 + 1 of group n%3 (SPID1, SPIE1, SPIF1, SPID2, ...)
+	for(chCounter = RESET_COUNTER; chCounter < chSmartSensors; chCounter++)
+	{
+		pchEntry = &pchBuff[SENSORS_START_INDEX + ((chEntries + chCounter) * SENSOR_ENTRY_OFFSET)];
+		pchEntry[SENSOR_EXECUTION_TABLE_ID_OFFSET]	= SMART_SENSOR_ID_FIRST + chCounter;
+		pchEntry[SMART_SENSOR_ADDRESS_OFFSET]		= ((chCounter % MAX_SMART_SENSOR_GROUPS) << 4) | ((chCounter / MAX_SMART_SENSOR_GROUPS) + 1);
+		pchEntry[SENSOR_CONTROL_BYTE_OFFSET]		= SIM_SMART_SENSOR_CTRL;
+		pchEntry[SAMPLE_CLOCK_DIVISOR_OFFSET]		= 1;
+		pchEntry[SAMPLES_IN_AVERAGE_OFFSET]			= 4;
+		pchEntry[RADIO_CLOCK_DIVISOR_OFFSET]		= 1;
+	}
+	
+	return;
+}
+
+//_____ fnSimRfcUnpackBits ____________________________________________________________________
+//
+// @brief	Extracts next field of bit packed data message. Bit buffer is refilled a byte at a time only when it holds less than 25 bits,
+//			so every field (at most 16 bits) is extracted with single shift and mask instead of walking it bit by bit.
+// @param	phReader	Bit stream reader of data message
+//			chBits		Width of field (1 to 16)
+//			pnValue		Returns the field
+// @return	FALSE if data message does not hold chBits any more otherwise TRUE
+
+static int8_t fnSimRfcUnpackBits(SIM_RFC_BIT_READER *phReader,uint8_t chBits,uint16_t *pnValue)
+{
+	while((phReader->chBitCount <= 24) && (phReader->nDataIndex <= phReader->nLastIndex))
+	{
+		phReader->lBitBuffer = (phReader->lBitBuffer << 8) | phReader->pchPacket[phReader->nDataIndex++];
+		phReader->chBitCount += 8;
+	}
+	
+	if(phReader->chBitCount < chBits)
+	{
+		return RETURN_FALSE;
+	}
+	
+	phReader->chBitCount -= chBits;
+	*pnValue = (phReader->lBitBuffer >> phReader->chBitCount) & ((1UL << chBits) - 1);
+	return RETURN_TRUE;
+}
+
+//_____ fnSimRfcUnpackSamples ____________________________________________________________________
+//
+// @brief	Unpacks the sensor samples carried by bit packed data message (See PAYLOAD_ENCODING_PACKED).
+//			Width of every data word is taken from sensor driver registry, unpacking stops at Sensor ID 0 (padding of last byte).
+//			Entry of unknown Sensor ID or entry cut by end of data message is counted as undecodable.
+// @param	pchPacket	Data packet received over air (length byte followed by payload)
+// @return	No of sensor samples unpacked from packet
+
+static uint32_t fnSimRfcUnpackSamples(uint8_t *pchPacket)
+{
+	SIM_RFC_BIT_READER hReader;
+	uint32_t lSamples = RESET_COUNTER;
+	uint16_t nData[MAX_SENSOR_DATA_LENGTH];
+	uint16_t nSensorID = RESET_VALUE;
+	int8_t chDataLength = RESET_VALUE;
+	uint8_t chDataBits = RESET_VALUE;
+	uint8_t chWord = RESET_COUNTER;
+	
+	hReader.pchPacket	= pchPacket;
+	hReader.nDataIndex	= PACKET_DATA_MESSAGE_INDEX;
+	hReader.nLastIndex	= pchPacket[CC1125_DATA_PACKET_LENGTH];		//Length byte holds the index of last data byte
+	hReader.lBitBuffer	= RESET_VALUE;
+	hReader.chBitCount	= RESET_COUNTER;
+	
+	while((fnSimRfcUnpackBits(&hReader,PAYLOAD_PACKED_ID_BITS,&nSensorID) == RETURN_TRUE) && (nSensorID != RESET_VALUE))
+	{
+		chDataLength = fnFetchSensorDataLength(nSensorID);
+		if(chDataLength <= RESET_VALUE)
+		{
+			ghSimStatistics.lDataSamplesUndecodable++;
+			break;
+		}
+		
+		chDataBits = fnFetchSensorDataBits(nSensorID);
+		for(chWord = RESET_COUNTER; chWord < chDataLength; chWord++)
+		{
+			if(fnSimRfcUnpackBits(&hReader,chDataBits,&nData[chWord]) == RETURN_FALSE)
+			{
+				ghSimStatistics.lDataSamplesUndecodable++;
+				return lSamples;
+			}
+		}
+		
+		lSamples++;
+	}
+	
+	return lSamples;
+}
+
+//_____ fnSimRfcDecodeSamples ____________________________________________________________________
+//
+// @brief	Walks data message of data packet to decode the sensor samples it carries as per payload encoding of Execution Table
+//				Raw encoding: Sensor ID followed by data words of sensor (MSB first)
+//				Delta encoding: Header of sensor entry followed by zigzag varint of every data word (See PAYLOAD_ENCODING_DELTA)
+//				Bit packed encoding: Unpacked by fnSimRfcUnpackSamples
+//			Delta entry is decoded only if key entry of same epoch is received for the sensor, otherwise it is counted as undecodable.
+// @param	pchPacket	Data packet received over air (length byte followed by payload)
+//			phDecoders	Delta decoding state of every Sensor ID (Live packets and replayed packets of log are separate streams)
+// @return	No of sensor samples decoded from packet
+
+static uint32_t fnSimRfcDecodeSamples(uint8_t *pchPacket,SIM_RFC_DECODER *phDecoders)
+{
+	SIM_RFC_DECODER *phDecoder = NULL;
+	uint32_t lSamples = RESET_COUNTER;
+	uint16_t nDataIndex = PACKET_DATA_MESSAGE_INDEX;
+	uint16_t nLastIndex = pchPacket[CC1125_DATA_PACKET_LENGTH];		//Length byte holds the index of last data byte
+	uint16_t nData[MAX_SENSOR_DATA_LENGTH];
+	uint16_t nZigzag = RESET_VALUE;
+	int8_t chDataLength = RESET_VALUE;
+	uint8_t chHeader = RESET_VALUE;
+	uint8_t chWord = RESET_COUNTER;
+	uint8_t chShift = RESET_COUNTER;
+	uint8_t chByte = RESET_VALUE;
+	
+	if(ghSimConfig.chPayloadEncoding == PAYLOAD_ENCODING_PACKED)
+	{
+		return fnSimRfcUnpackSamples(pchPacket);
+	}
+	
+	while(nDataIndex <= nLastIndex)
+	{
+		chHeader = pchPacket[nDataIndex++];
+		
+		if(ghSimConfig.chPayloadEncoding == PAYLOAD_ENCODING_RAW)
+		{
+			chDataLength = fnFetchSensorDataLength(chHeader);
+			if(chDataLength <= RESET_VALUE)
+			{
+				break;
+			}
+			
+			lSamples++;
+			nDataIndex += chDataLength * 2;
+			continue;
+		}
+		
+		chDataLength = fnFetchSensorDataLength(chHeader & PAYLOAD_SENSOR_ID_BM);
+		if(chDataLength <= RESET_VALUE)
+		{
+			break;
+		}
+		
+		for(chWord = RESET_COUNTER; chWord < chDataLength; chWord++)
+		{
+			nZigzag = RESET_VALUE;
+			chShift = RESET_COUNTER;
+			do
+			{
+				chByte = pchPacket[nDataIndex++];
+				nZigzag |= (uint16_t)(chByte & PAYLOAD_VARINT_DATA_BM) << chShift;
+				chShift += 7;
+			}while((chByte & PAYLOAD_VARINT_MORE_BM) && (nDataIndex <= nLastIndex));
+			
+			nData[chWord] = (nZigzag >> 1) ^ (uint16_t)(-(nZigzag & 1));
+		}
+		
+		phDecoder = &phDecoders[chHeader & PAYLOAD_SENSOR_ID_BM];
+		
+		if(chHeader & PAYLOAD_KEY_FLAG_BM)
+		{
+			//Key entry is encoded against 0 and becomes reference of next entries
+			memcpy(phDecoder->nKeyData,nData,sizeof(nData));
+			phDecoder->chKeyEpoch = chHeader & PAYLOAD_KEY_EPOCH_BM;
+			phDecoder->chKeyValid = SET_FLAG;
+		}
+		else if((phDecoder->chKeyValid == SET_FLAG) && (phDecoder->chKeyEpoch == (chHeader & PAYLOAD_KEY_EPOCH_BM)))
+		{
+			for(chWord = RESET_COUNTER; chWord < chDataLength; chWord++)
+			{
+				nData[chWord] += phDecoder->nKeyData[chWord];
+			}
+		}
+		else
+		{
+			ghSimStatistics.lDataSamplesUndecodable++;
+			continue;
+		}
+		
+		lSamples++;
+	}
+	
+	return lSamples;
+}
+
+//_____ fnSimRfcReceive ____________________________________________________________________
+//
+// @brief	RFC Console handling of the packet sent by SENSOR MC. Reply (if any) starts after SIM_RFC_TURNAROUND_TIME.
+//				1> Request for Execution Table is answered with the Execution Table built from configuration
+//				2> Data packets are acknowledged (Packets replayed from store-and-forward log are counted apart)
+//				   Packet sent again because its ACK was lost is acknowledged again but counted only once
+//				   In selective repeat packets of burst are only noted and last one of burst (PACKET_ACK_REQUEST_BM) is answered with bitmap ACK
+//				3> ACK/NACK of Execution Table does not require any reply
+// @param	pchPacket	Packet received over air (length byte followed by payload)
+
+static void fnSimRfcReceive(uint8_t *pchPacket)
+{
+	uint8_t chDescriptor = pchPacket[PACKET_DESCRIPTOR_INDEX];
+	uint8_t chReply = SET_FLAG;
+	uint8_t chPacketBit = RESET_VALUE;
+	
+	ghSimRfcReply.chReplayAck = RESET_FLAG;
+	
+	switch(pchPacket[PACKET_HEADER_INDEX])
+	{
+		case REQUEST_NEW_EXECUTION_TABLE:
+			fnSimRfcBuildExecutionTable(ghSimRfcReply.chBuff);
+			memset(ghSimRfcDecoder,0,sizeof(ghSimRfcDecoder));		//Sensors send key entries again with new Execution Table
+			memset(ghSimRfcBacklogDecoder,0,sizeof(ghSimRfcBacklogDecoder));
+			ghSimStatistics.lExecutionTablesSent++;
+		break;
+		
+		case SLOW_DL_DATA_PACKET:
+		case FAST_DL_DATA_PACKET:
+		case LOGGED_DL_DATA_PACKET:
+			ghSimRfcReply.chBuff[CC1125_DATA_PACKET_LENGTH]		= SIM_PACKET_HEADER_BYTES;
+			ghSimRfcReply.chBuff[PACKET_HEADER_INDEX]			= ACK_RECEIPT_LAST_DATA_PACKET;
+			ghSimRfcReply.chBuff[PACKET_DATA_LENGTH_INDEX]		= SIM_PACKET_HEADER_BYTES;
+			ghSimRfcReply.chBuff[PACKET_DESCRIPTOR_INDEX]		= SIM_SINGLE_PACKET_DESCRIPTOR;
+			ghSimRfcReply.chBuff[PACKET_ERROR_CONTROL_INDEX]	= RESET_VALUE;
+			
+			//Record is released from log only when SENSOR MC hears its ACK, so record replayed while ACK is not heard is the same record
+			if(pchPacket[PACKET_HEADER_INDEX] == LOGGED_DL_DATA_PACKET)
+			{
+				ghSimRfcReply.chReplayAck = SET_FLAG;
+				if(gchSimRfcReplayUnacked == SET_FLAG)
+				{
+					break;
+				}
+				
+				gchSimRfcReplayUnacked = SET_FLAG;
+				ghSimStatistics.lDataPacketsReplayed++;
+				if(pchPacket[CC1125_DATA_PACKET_LENGTH] > SIM_PACKET_HEADER_BYTES)
+				{
+					ghSimStatistics.lDataSamplesReplayed += fnSimRfcDecodeSamples(pchPacket,ghSimRfcBacklogDecoder);
+				}
+				break;
+			}
+			
+			//Selective repeat: Bit n of bitmap is packet of sequence no n+1, new message sequence no starts new bitmap
+			if((chDescriptor & PACKET_ACK_REQUEST_BM) || (ghSimConfig.chDownloadWindow && !(chDescriptor & SIM_LAST_PACKET_BM)))
+			{
+				if(gchSimRfcWindowMessage != (pchPacket[PACKET_ERROR_CONTROL_INDEX] & SIM_MSG_SEQ_NO_BM))
+				{
+					gchSimRfcWindowMessage = pchPacket[PACKET_ERROR_CONTROL_INDEX] & SIM_MSG_SEQ_NO_BM;
+					gchSimRfcWindowBitmap = RESET_VALUE;
+				}
+				
+				gchSimRfcWindowBitmap |= 1 << ((((chDescriptor & SIM_PACKET_SEQ_NO_BM) >> SIM_PACKET_SEQ_NO_bp) - 1) & 0x07);
+				
+				if(chDescriptor & PACKET_ACK_REQUEST_BM)
+				{
+					ghSimRfcReply.chBuff[CC1125_DATA_PACKET_LENGTH]		= SIM_PACKET_HEADER_BYTES + 1;
+					ghSimRfcReply.chBuff[PACKET_HEADER_INDEX]			= ACK_BITMAP_DATA_PACKETS;
+					ghSimRfcReply.chBuff[PACKET_DATA_LENGTH_INDEX]		= SIM_PACKET_HEADER_BYTES + 1;
+					ghSimRfcReply.chBuff[PACKET_ACK_BITMAP_INDEX]		= gchSimRfcWindowBitmap;
+					ghSimStatistics.lBitmapAcksSent++;
+				}
+				else
+				{
+					chReply = RESET_FLAG;			//Rest of burst follows back to back
+				}
+			}
+			
+			//Packet is delivered once per sequence no of its generation
+			if(gchSimRfcDeliveredMessage != (pchPacket[PACKET_ERROR_CONTROL_INDEX] & SIM_MSG_SEQ_NO_BM))
+			{
+				gchSimRfcDeliveredMessage = pchPacket[PACKET_ERROR_CONTROL_INDEX] & SIM_MSG_SEQ_NO_BM;
+				gchSimRfcDeliveredBitmap = RESET_VALUE;
+			}
+			
+			chPacketBit = 1 << ((((chDescriptor & SIM_PACKET_SEQ_NO_BM) >> SIM_PACKET_SEQ_NO_bp) - 1) & 0x07);
+			if(gchSimRfcDeliveredBitmap & chPacketBit)
+			{
+				break;
+			}
+			gchSimRfcDeliveredBitmap |= chPacketBit;
+			
+			ghSimStatistics.lDataPacketsAcked++;
+			if(pchPacket[CC1125_DATA_PACKET_LENGTH] > SIM_PACKET_HEADER_BYTES)
+			{
+				ghSimStatistics.lDataBytesDelivered += pchPacket[CC1125_DATA_PACKET_LENGTH] - SIM_PACKET_HEADER_BYTES;
+				ghSimStatistics.lDataSamplesDelivered += fnSimRfcDecodeSamples(pchPacket,ghSimRfcDecoder);
+			}
+		break;
+		
+		default:
+			return;
+		break;
+	}
+	
+	if(chReply == RESET_FLAG)
+	{
+		return;
+	}
+	
+	ghSimRfcReply.chValid = SET_FLAG;
+	fnSimScheduleEvent(SIM_EVENT_RFC_REPLY,SIM_RFC_TURNAROUND_TIME);
+	return;
+}
+
+//_____ fnSimAirLoss ____________________________________________________________________
+//
+// @brief	Decides whether RF packet is lost in the air: Every packet is lost in link outage window, otherwise packet is lost with SIM_PACKET_LOSS probability
+// @return	TRUE if packet is lost otherwise FALSE
+
+static int8_t fnSimAirLoss(void)
+{
+	SIM_TIME lTime = fnSimGetTime();
+	
+	if((lTime >= ghSimConfig.lOutageStart) && (lTime < ghSimConfig.lOutageEnd))
+	{
+		return RETURN_TRUE;
+	}
+	
+	if(fnSimRandom() < ghSimConfig.chPacketLossPercent)
+	{
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnSimRadioEvent ____________________________________________________________________
+//
+// @brief	Handles timed events of CC1125 and RFC Console (calibration done, end of TX/RX and reply of RFC Console)
+//			GPIO0 of CC1125 (PKT_SYNC_RXTX) goes low at the end of every transmitted and received packet.
+// @param	chEventId	Event from SIM_EVENT_ID
+
+void fnSimRadioEvent(uint8_t chEventId)
+{
+	uint8_t chLength = RESET_VALUE;
+	
+	switch(chEventId)
+	{
+		case SIM_EVENT_RADIO_CALIBRATION:
+			ghSimRadio.chExtRegister[SIM_RADIO_EXT_ADDR(CC112X_FS_VCO2)]	= SIM_RADIO_FS_VCO2_VALUE;
+			ghSimRadio.chExtRegister[SIM_RADIO_EXT_ADDR(CC112X_FS_VCO4)]	= SIM_RADIO_FS_VCO4_VALUE;
+			ghSimRadio.chExtRegister[SIM_RADIO_EXT_ADDR(CC112X_FS_CHP)]		= SIM_RADIO_FS_CHP_VALUE;
+			ghSimRadio.chMarcState = SIM_MARCSTATE_IDLE;
+		break;
+		
+		case SIM_EVENT_RADIO_TX_END:
+			//Part of packet which was not written in TX FIFO in time
+			if(ghSimRadio.nTxCount < ghSimRadio.nTxLength)
+			{
+				fnSimRadioFifoError(SIM_MARCSTATE_TXFIFO_ERROR);
+				break;
+			}
+			
+			chLength = ghSimRadio.chTxPacket[CC1125_DATA_PACKET_LENGTH];
+			fnSimCancelEvent(SIM_EVENT_RADIO_TX_FIFO_THR);
+			ghSimRadio.nTxCount = RESET_COUNTER;
+			ghSimRadio.chMarcState = ((ghSimRadio.chRegister[CC112X_RFEND_CFG0] & SIM_RADIO_TXOFF_MODE_BM) == SIM_RADIO_TXOFF_MODE_RX) ? SIM_MARCSTATE_RX : SIM_MARCSTATE_IDLE;	//TXOFF_MODE of RFEND_CFG0
+			ghSimStatistics.lRadioPacketsSent++;
+			ghSimStatistics.lRadioAirTime += fnSimRadioAirTime(chLength);
+			fnSimPortHFallingEdge(PH_CC1125_GPIO0);
+			
+			if(fnSimAirLoss() == RETURN_TRUE)
+			{
+				ghSimStatistics.lRadioPacketsLost++;
+			}
+			else if(chLength >= PACKET_HEADER_INDEX)
+			{
+				fnSimRfcReceive(ghSimRadio.chTxPacket);
+			}
+		break;
+		
+		//GPIO2 (TXFIFO_THR) goes low
+		case SIM_EVENT_RADIO_TX_FIFO_THR:
+			ghSimStatistics.lRadioFifoThresholds++;
+			fnSimPortHFallingEdge(PH_CC1125_GPIO2);
+		break;
+		
+		//GPIO3 (RXFIFO_THR inverted) goes low, RX FIFO overflows if it is not drained in time
+		case SIM_EVENT_RADIO_RX_FIFO_THR:
+			if((fnSimRadioRxReceived() - ghSimRadio.nRxIndex) > SIM_RADIO_FIFO_SIZE)
+			{
+				fnSimRadioFifoError(SIM_MARCSTATE_RXFIFO_ERROR);
+				break;
+			}
+			
+			ghSimStatistics.lRadioFifoThresholds++;
+			fnSimPortHFallingEdge(PH_CC1125_GPIO3);
+		break;
+		
+		case SIM_EVENT_RFC_REPLY:
+			//SENSOR MC hears the reply only if CC1125 is in RX when the packet starts
+			if(ghSimRadio.chPowered && ghSimRadio.chMarcState == SIM_MARCSTATE_RX && fnSimAirLoss() == RETURN_FALSE)
+			{
+				//Length byte, payload, RSSI and LQI with CRC_OK arrive in RX FIFO at air rate
+				chLength = ghSimRfcReply.chBuff[CC1125_DATA_PACKET_LENGTH];
+				memcpy(ghSimRadio.chRxPacket,ghSimRfcReply.chBuff,chLength + 1);
+				ghSimRadio.chRxPacket[chLength + 1]	= SIM_RADIO_RSSI_VALUE;
+				ghSimRadio.chRxPacket[chLength + 2]	= SIM_RADIO_LQI_VALUE | SIM_RADIO_CRC_OK;
+				ghSimRadio.nRxCount					= chLength + 3;
+				ghSimRadio.nRxIndex					= RESET_COUNTER;
+				ghSimRadio.lRxDataStart				= fnSimGetTime() + (SIM_RADIO_PREAMBLE_BYTES + SIM_RADIO_SYNC_BYTES) * SIM_RADIO_BYTE_TIME;
+				ghSimRadio.chRxStreaming			= SET_FLAG;
+				
+				fnSimScheduleEvent(SIM_EVENT_RADIO_RX_END,fnSimRadioAirTime(chLength));
+				fnSimRadioFifoThrArm();
+				
+				if(ghSimRfcReply.chReplayAck == SET_FLAG)
+				{
+					gchSimRfcReplayUnacked = RESET_FLAG;		//Next replayed record is a new one
+				}
+			}
+			else
+			{
+				ghSimRfcReply.chValid = RESET_FLAG;
+				ghSimStatistics.lRadioPacketsLost++;
+			}
+		break;
+		
+		case SIM_EVENT_RADIO_RX_END:
+			if(!ghSimRfcReply.chValid)
+			{
+				break;
+			}
+			
+			//Last byte of packet is in RX FIFO, part of it which was not drained in time overflows the FIFO
+			if((ghSimRadio.nRxCount - ghSimRadio.nRxIndex) > SIM_RADIO_FIFO_SIZE)
+			{
+				fnSimRadioFifoError(SIM_MARCSTATE_RXFIFO_ERROR);
+				break;
+			}
+			
+			fnSimCancelEvent(SIM_EVENT_RADIO_RX_FIFO_THR);
+			ghSimRadio.chRxStreaming = RESET_FLAG;
+			ghSimRfcReply.chValid = RESET_FLAG;
+			ghSimRadio.chMarcState = SIM_MARCSTATE_IDLE;					//RXOFF_MODE: IDLE
+			ghSimStatistics.lRadioPacketsReceived++;
+			ghSimStatistics.lRadioAirTime += fnSimRadioAirTime(ghSimRadio.chRxPacket[CC1125_DATA_PACKET_LENGTH]);
+			fnSimPortHFallingEdge(PH_CC1125_GPIO0);
+		break;
+		
+		default:
+		break;
+	}
+	
+	return;
+}
+
+//_____ fnSimI2cTransaction ____________________________________________________________________
+//
+// @brief	Complete I2C transaction with the addressed slave. Write bytes are taken from pchBuff and read bytes are placed from index 0 of pchBuff.
+// @param	chAddr			7-bit slave address
+//			pchBuff			Communication buffer of I2C driver
+//			chWriteCount	No of bytes to write
+//			chReadCount		No of bytes to read (after repeated start if write bytes are available)
+// @return	FALSE if no slave acknowledges the address otherwise returns TRUE
+
+int8_t fnSimI2cTransaction(uint8_t chAddr,uint8_t *pchBuff,uint8_t chWriteCount,uint8_t chReadCount)
+{
+	uint8_t  chCounter = RESET_COUNTER;
+	uint16_t nPressure = SIM_CHAMBER_PRESSURE_VALUE;
+	
+	switch(chAddr)
+	{
+		//Chamber pressure sensor: Read only device (status bits of first byte are zero on valid data)
+		case PRESSURE_SENSOR_I2C_ADDR:
+			if(chReadCount > 0)	pchBuff[0] = (nPressure >> BIT_8_bp) & 0x3F;
+			if(chReadCount > 1)	pchBuff[1] = nPressure & 0xFF;
+			if(chReadCount > 2)	pchBuff[2] = SIM_PRESSURE_TEMPERATURE_VALUE >> BIT_8_bp;
+			if(chReadCount > 3)	pchBuff[3] = SIM_PRESSURE_TEMPERATURE_VALUE & 0xFF;
+		break;
+		
+		//Gyrometer: First write byte is register address followed by register values
+		case GYRO_METER_I2C_ADDR:
+			if(chWriteCount > 0)
+			{
+				ghSimGyro.chRegPointer = pchBuff[0];
+				
+				for(chCounter = 1; chCounter < chWriteCount; chCounter++)
+				{
+					ghSimGyro.chRegister[ghSimGyro.chRegPointer++] = pchBuff[chCounter];
+				}
+			}
+			
+			//New data is available on every output data rate interval in normal mode
+			if(ghSimGyro.chRegister[GYRO_MAX21000_SENSE_CNFG0] == SIM_GYRO_NORMAL_MODE && (fnSimGetTime() - ghSimGyro.lLastDataRead) >= SIM_GYRO_DATA_READY_INTERVAL)
+			{
+				ghSimGyro.chRegister[GYRO_MAX21000_SYS_STATUS] |= SIM_GYRO_DATA_READY;
+			}
+			
+			if(chReadCount > 0 && ghSimGyro.chRegPointer == GYRO_MAX21000_DATA_START_ADDR)
+			{
+				for(chCounter = RESET_COUNTER; chCounter < SIM_GYRO_DATA_BYTES; chCounter++)
+				{
+					ghSimGyro.chRegister[GYRO_MAX21000_DATA_START_ADDR + chCounter] = fnSimRandom();		//Small angular rate around zero
+				}
+				
+				ghSimGyro.chRegister[GYRO_MAX21000_SYS_STATUS] &= (~SIM_GYRO_DATA_READY);
+				ghSimGyro.lLastDataRead = fnSimGetTime();
+			}
+			
+			for(chCounter = RESET_COUNTER; chCounter < chReadCount; chCounter++)
+			{
+				pchBuff[chCounter] = ghSimGyro.chRegister[ghSimGyro.chRegPointer++];
+			}
+		break;
+		
+		//E2PROM: 2 bytes of memory address followed by data bytes (Data bytes roll over within the page and start write cycle)
+		case E2PROM_MEMORY_I2C_ADDR:
+			if(fnSimGetTime() < ghSimE2prom.lWriteCycleEnd)
+			{
+				ghSimStatistics.lE2promBusyNacks++;
+				return RETURN_FALSE;
+			}
+			
+			if(chWriteCount >= 2)
+			{
+				ghSimE2prom.nAddress = ((uint16_t)pchBuff[0] << BIT_8_bp) | pchBuff[1];
+				
+				if(chWriteCount > 2)
+				{
+					ghSimStatistics.lE2promWrites++;
+					ghSimStatistics.lE2promWriteBytes += chWriteCount - 2;
+					ghSimE2prom.lWriteCycleEnd = fnSimGetTime() + SIM_E2PROM_WRITE_CYCLE_TIME;
+				}
+				
+				for(chCounter = 2; chCounter < chWriteCount; chCounter++)
+				{
+					ghSimE2prom.chMemory[ghSimE2prom.nAddress] = pchBuff[chCounter];
+					ghSimE2prom.nAddress = (ghSimE2prom.nAddress & (~(SIM_E2PROM_PAGE_SIZE - 1))) | ((ghSimE2prom.nAddress + 1) & (SIM_E2PROM_PAGE_SIZE - 1));
+				}
+			}
+			
+			if(chReadCount > 0)
+			{
+				ghSimStatistics.lE2promReads++;
+			}
+			
+			for(chCounter = RESET_COUNTER; chCounter < chReadCount; chCounter++)
+			{
+				pchBuff[chCounter] = ghSimE2prom.chMemory[ghSimE2prom.nAddress++];
+			}
+		break;
+		
+		//No slave acknowledges the address
+		default:
+			return RETURN_FALSE;
+		break;
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSimAdcSample ____________________________________________________________________
+//
+// @brief	Conversion result of ADC input (nominal value with few counts of noise)
+// @param	chSensorEntryIndex	ADC input index (See mc_adc.h)
+// @return	ADC resolution value
+
+int16_t fnSimAdcSample(uint8_t chSensorEntryIndex)
+{
+	if(chSensorEntryIndex == CHAMBER_TEMPERATURE_ADC_INDEX)
+	{
+		return SIM_CHAMBER_TEMPERATURE_ADC_VALUE + (fnSimRandom() % 8);
+	}
+	
+	return RESET_VALUE;
+}
+
+//_____ fnSimSmartSensorTransfer ____________________________________________________________________
+//
+// @brief	Full duplex SPI transfer with the Smart Sensor selected on the group.
+//			Frame starting with SMART_SENSOR_CONFIG_COMMAND configures the sensor, configured sensor samples on its own
+//			and shifts out its measurement word (MSB first) on every frame, unconfigured sensor shifts out zeros.
+// @param	chSensorGroup	SMART_SENSOR_SPID_GROUP, SMART_SENSOR_SPIE_GROUP or SMART_SENSOR_SPIF_GROUP
+//			chSelectCode	S2:S1:S0 of select lines of the group
+//			pchTxBuff		Data bytes sent to sensor
+//			pchRxBuff		Memory for the received bytes (NULL if they are discarded, may be same as pchTxBuff)
+//			chLength		No of bytes to transfer
+
+void fnSimSmartSensorTransfer(uint8_t chSensorGroup,uint8_t chSelectCode,uint8_t *pchTxBuff,uint8_t *pchRxBuff,uint8_t chLength)
+{
+	SIM_SMART_SENSOR_MODEL *phSensor = NULL;
+	uint16_t nMeasurement = RESET_VALUE;
+	
+	if((chSensorGroup >= SIM_SMART_SENSOR_GROUPS) || (chSelectCode >= SIM_SMART_SENSOR_SELECT_CODES))
+	{
+		return;
+	}
+	
+	phSensor = &ghSimSmartSensor[chSensorGroup][chSelectCode];
+	
+	if(phSensor->chConfigured)
+	{
+		nMeasurement = SIM_SMART_SENSOR_MEASUREMENT + (chSensorGroup << 8) + (chSelectCode << 4) + (phSensor->nSampleCount++ & 0x0F);
+	}
+	
+	if((chLength >= SMART_SENSOR_CONFIG_FRAME_SIZE) && (pchTxBuff[SMART_SENSOR_CONFIG_COMMAND_INDEX] == SMART_SENSOR_CONFIG_COMMAND))
+	{
+		memcpy(phSensor->chConfig,pchTxBuff,SMART_SENSOR_CONFIG_FRAME_SIZE);
+		phSensor->chConfigured = SET_FLAG;
+		phSensor->nSampleCount = RESET_COUNTER;
+		ghSimStatistics.lSmartSensorConfigFrames++;
+	}
+	else if(phSensor->chConfigured)
+	{
+		ghSimStatistics.lSmartSensorFetches++;
+	}
+	
+	if(pchRxBuff != NULL)
+	{
+		memset(pchRxBuff,0,chLength);
+		pchRxBuff[0] = nMeasurement >> BIT_8_bp;
+		if(chLength > 1)
+		{
+			pchRxBuff[1] = nMeasurement & CC1125_ADDR_BYTE_BM;
+		}
+	}
+	
+	return;
+}
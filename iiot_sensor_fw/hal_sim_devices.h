@@ -0,0 +1,165 @@
+/* -------------------------------------------------------------------------
+Filename: hal_sim_devices.h
+
+Job#: 20473
+Purpose: Behavioral models of the chips connected to SENSOR MC for host simulation build (See hal_simulation.h)
+		 CC1125 radio (register space, FIFOs, strobes, air time), RFC Console at the other end of the RF link,
+		 I2C slaves (Pressure Sensor, Gyroscope, E2PROM), ADC inputs and Smart Sensors on SPID/SPIE/SPIF
+Date Created: 10/16/2026
+
+(NOTE: latest version is the top version)
+
+Author: Aalok Shah
+Changes: Initial version
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+Note: See document 000xxxx for complete project requirements
+Input: None
+Output: None
+
+-----------------------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+#ifndef HAL_SIM_DEVICES_H_
+#define HAL_SIM_DEVICES_H_
+
+	//_____  I N C L U D E S ______________________________________________________________
+
+	#include "hal_simulation.h"			// Simulated AVR-AXMEGAA1U Peripherals for host build
+
+	//_____ M A C R O S ____________________________________________________________________
+
+	//CC1125 RF link as configured in hRegSet (radio_communication.c): 4ksps with 1 bit per symbol
+	#define SIM_RADIO_BIT_RATE					4000
+	#define SIM_RADIO_PREAMBLE_BYTES			4			//PREAMBLE_CFG1 default: 4 bytes
+	#define SIM_RADIO_SYNC_BYTES				4			//SYNC_CFG0 default: 32 bits sync word
+	#define SIM_RADIO_CRC_BYTES					2
+	#define SIM_RADIO_FIFO_SIZE					128
+	#define SIM_RADIO_PACKET_SIZE				260			//Longest packet with appended status bytes (Length byte 255)
+	#define SIM_RADIO_BYTE_TIME					((8 * SIM_NSEC_PER_SEC) / SIM_RADIO_BIT_RATE)
+	#define SIM_RADIO_FIFO_THR_BM				0x7F		//FIFO_THR field of FIFO_CFG
+	#define SIM_RADIO_TXOFF_MODE_BM				0x30		//TXOFF_MODE field of RFEND_CFG0
+	#define SIM_RADIO_TXOFF_MODE_RX				0x30		//Chip enters RX at the end of transmission
+	#define SIM_RADIO_EXT_REG_SPACE				0x100		//Extended register space (0x2F00 - 0x2FFF)
+	#define SIM_RADIO_CALIBRATION_TIME			(750 * SIM_NSEC_PER_USEC)
+	#define SIM_RADIO_RSSI_VALUE				0xD0		//Appended RSSI (-48dBm)
+	#define SIM_RADIO_LQI_VALUE					0x2F		//Appended LQI (CRC_OK bit is added on good reception)
+
+	//CC1125 MARCSTATE values (MARC_2PIN_STATE | MARC_STATE)
+	#define SIM_MARCSTATE_SETTLING				0x00
+	#define SIM_MARCSTATE_IDLE					0x41
+	#define SIM_MARCSTATE_CALIBRATE				0x05
+	#define SIM_MARCSTATE_RX					0x6D
+	#define SIM_MARCSTATE_TX					0x33
+	#define SIM_MARCSTATE_RXFIFO_ERROR			0x11
+	#define SIM_MARCSTATE_TXFIFO_ERROR			0x36
+
+	//RFC Console behavior
+	#define SIM_RFC_TURNAROUND_TIME				(20 * SIM_NSEC_PER_MSEC)	//Time taken by RFC Console to start reply after reception
+
+	//Nominal readings of simulated sensors
+	#define SIM_CHAMBER_TEMPERATURE_ADC_VALUE	1200		//ADC resolution of chamber temperature input
+	#define SIM_CHAMBER_PRESSURE_VALUE			8192		//14bit resolution (50% of range)
+	#define SIM_GYRO_DATA_READY_INTERVAL		(200 * SIM_NSEC_PER_USEC)	//Output data rate configured by fnInitializeGyrometer
+	#define SIM_E2PROM_SIZE						0x10000
+	#define SIM_E2PROM_PAGE_SIZE				256							//Page write rolls over within the page
+	#define SIM_E2PROM_WRITE_CYCLE_TIME			(5 * SIM_NSEC_PER_MSEC)		//Internal write cycle (tW) after stop condition of page write
+
+	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
+
+	//_____ fnSimDevicesInit ____________________________________________________________________
+	//
+	// @brief	Power on state of all the simulated devices
+
+	void fnSimDevicesInit(void);
+
+	//_____ fnSimRadioSpiAccess ____________________________________________________________________
+	//
+	// @brief	Single SPI transaction (CS low to CS high) with CC1125. Access type is decided from address as per CC112x SPI protocol.
+	//			Registers and FIFOs are accessed in burst mode, strobes are executed when chCommType is RADIO_COMMAND_STROBE.
+	// @param	nAddress	Register address (0x2Fxx for extended register space) or strobe command
+	//			chCommType	RADIO_COMMAND_STROBE, RADIO_TRANSMIT_BYTES or RADIO_RECEIVE_BYTES
+	//			pchBuff		Data bytes to write or memory to hold the read bytes
+	//			nCount		No of data bytes after the address bytes
+	//			pchStatus	Chip status byte returned by CC1125 in response of address byte
+	// @return	FALSE if chip is not powered (MISO never goes low) otherwise returns TRUE
+
+	int8_t fnSimRadioSpiAccess(uint16_t nAddress,uint8_t chCommType,uint8_t *pchBuff,uint16_t nCount,uint8_t *pchStatus);
+
+	//_____ fnSimRadioEvent ____________________________________________________________________
+	//
+	// @brief	Handles timed events of CC1125 and RFC Console (calibration done, end of TX/RX and reply of RFC Console)
+	// @param	chEventId	Event from SIM_EVENT_ID
+
+	void fnSimRadioEvent(uint8_t chEventId);
+
+	//_____ fnSimI2cTransaction ____________________________________________________________________
+	//
+	// @brief	Complete I2C transaction with the addressed slave. Write bytes are taken from pchBuff and read bytes are placed from index 0 of pchBuff.
+	// @param	chAddr			7-bit slave address
+	//			pchBuff			Communication buffer of I2C driver
+	//			chWriteCount	No of bytes to write
+	//			chReadCount		No of bytes to read (after repeated start if write bytes are available)
+	// @return	FALSE if no slave acknowledges the address otherwise returns TRUE
+
+	int8_t fnSimI2cTransaction(uint8_t chAddr,uint8_t *pchBuff,uint8_t chWriteCount,uint8_t chReadCount);
+
+	//_____ fnSimAdcSample ____________________________________________________________________
+	//
+	// @brief	Conversion result of ADC input
+	// @param	chSensorEntryIndex	ADC input index (See mc_adc.h)
+	// @return	ADC resolution value
+
+	int16_t fnSimAdcSample(uint8_t chSensorEntryIndex);
+
+	//_____ fnSimSmartSensorTransfer ____________________________________________________________________
+	//
+	// @brief	Full duplex SPI transfer with the Smart Sensor selected on the group.
+	//			Frame starting with SMART_SENSOR_CONFIG_COMMAND configures the sensor, configured sensor shifts out its measurement word (MSB first).
+	// @param	chSensorGroup	SMART_SENSOR_SPID_GROUP, SMART_SENSOR_SPIE_GROUP or SMART_SENSOR_SPIF_GROUP
+	//			chSelectCode	S2:S1:S0 of select lines of the group
+	//			pchTxBuff		Data bytes sent to sensor
+	//			pchRxBuff		Memory for the received bytes (NULL if they are discarded, may be same as pchTxBuff)
+	//			chLength		No of bytes to transfer
+
+	void fnSimSmartSensorTransfer(uint8_t chSensorGroup,uint8_t chSelectCode,uint8_t *pchTxBuff,uint8_t *pchRxBuff,uint8_t chLength);
+
+#endif /* HAL_SIM_DEVICES_H_ */
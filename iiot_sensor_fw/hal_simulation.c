@@ -0,0 +1,1478 @@
+/* -------------------------------------------------------------------------
+Filename: hal_simulation.c
+
+Job#: 20473
+Date Created: 10/16/2026
+
+Purpose: Host (PC) simulation of the ATXMEGA peripherals used by SENSOR MC firmware.
+		 It takes the place of mc_spi.c, mc_i2c.c, mc_adc.c, mc_timer.c and mc_uart.c in host build (See hal_simulation.h for build command)
+		 and drives the interrupt routines of firmware (RTC_OVF_vect, PORTH_INT0_vect, PORTH_INT1_vect) from a virtual clock.
+		 Discrete event engine keeps pending peripheral events in a binary heap ordered by due time and moves the virtual clock
+		 straight to the earliest one, so the idle time between RTC phases and sleep periods costs nothing on host.
+
+Functions:
+fnSimConfigure						Reads simulation configuration from environment at program start up
+fnSimGetTime						Returns current virtual time
+fnSimHeapSiftUp/SiftDown/Remove		Maintains heap of pending events
+fnSimRtcSync						Derives RTC counter and overflow event from registers written by firmware
+fnSimServiceInterrupts				Executes pending interrupt routines once interrupts are enabled
+fnSimRun							Discrete event engine
+fnSimAdvanceTime					Advances virtual clock for the time CPU is busy in blocking operations
+fnSimSleep							Replacement of SLEEP instruction
+fnSimScheduleEvent					Schedules timed peripheral event
+fnSimCancelEvent					Cancels pending peripheral event
+fnSimRandom							Pseudo random generator for simulated RF channel
+fnSimReport							Prints statistics of simulation run (and task profile when TASK_PROFILER_ENABLE is set)
+fnTimersInit						Simulated mc_timer.c API
+fnStartSystemDelayTimer				Simulated mc_timer.c API (busy wait of CPU)
+fnStartCommunicationTimer			Simulated mc_timer.c API
+fnStartVolStableTimer				Simulated mc_timer.c API
+fnReadCycleCounter					Simulated mc_timer.c API (Virtual time in CPU cycles)
+fnReadCommunicationTimer			Simulated mc_timer.c API (Virtual time since communication timer was started)
+fnUartSendData						Simulated mc_uart.c API (Debug UART is echoed on console)
+fnSpiRadioSendReceiveData			Simulated mc_spi.c API (CC1125 model in hal_sim_devices.c)
+fnSpiRadioQueueAdd/Start/Status		Simulated mc_spi.c API (Queue is executed by SIM_EVENT_RADIO_SPI_COMPLETE)
+fnSimSmartSensorSelectCode			Select code driven on select lines of Smart Sensor group
+fnSPID/E/F_SendReceiveOperation		Simulated mc_spi.c API (Smart Sensor model in hal_sim_devices.c)
+fnSpiSmartSensorQueueAdd/Run		Simulated mc_spi.c API (Groups are shifted in parallel, run takes bus time of the longest group)
+fnI2cSendReceiveOperation			Simulated mc_i2c.c API (I2C slave models in hal_sim_devices.c)
+fnADCStartConversion				Simulated mc_adc.c API
+fnADCFetchSampledData				Simulated mc_adc.c API
+
+Interrupts:
+-NA- (Interrupt routines of firmware are invoked by fnSimServiceInterrupts)
+
+
+Author: Aalok Shah
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+--------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+//_____  I N C L U D E S ______________________________________________________________
+
+#include <time.h>								// Host CPU time used to compute simulation speed
+#include "hardware_abstraction_layer.h"			// Contains headers of hardware dependent programming functionality
+#include "sensor_management.h"					// Smart Sensor group definitions
+#include "hal_sim_devices.h"					// Models of the chips connected to SENSOR MC
+#include "system_profiler.h"					// Task profile printed in simulation report
+
+//_____ M A C R O S ____________________________________________________________________
+
+//Transfer and conversion times of simulated peripherals (as configured by target drivers)
+#define SIM_RTC_TICK_TIME					SIM_NSEC_PER_MSEC				//RTC Clock: 32KHZ ULP / 32 (1KHZ)
+#define SIM_RADIO_SPI_BYTE_TIME				(8 * SIM_NSEC_PER_USEC)			//SPIC at 1MHZ
+#define SIM_RADIO_SPI_ISR_TIME				2500ULL							//CPU time of SPIC_INT_vect per byte (40 cycles)
+#define SIM_SMART_SENSOR_SPI_BYTE_TIME		SIM_NSEC_PER_USEC				//SPID/SPIE/SPIF at 8MHZ
+#define SIM_RADIO_READY_TIME_OUT			(10 * SIM_NSEC_PER_MSEC)		//MISO wait when CC1125 is not powered
+#define SIM_I2C_BYTE_TIME					22500ULL						//9 bits at 400KHZ
+#define SIM_I2C_START_STOP_TIME				5000ULL							//START, Repeated START and STOP conditions
+#define SIM_ADC_CONVERSION_TIME				(7 * SIM_NSEC_PER_USEC)			//12 bit conversion at 1MHZ ADC clock
+#define SIM_UART_BYTE_TIME					1041667ULL						//10 bits at 9600 baud
+#define SIM_VOL_STABLE_5V_TIME				(80060 * SIM_NSEC_PER_USEC)		//80ms + 60us
+#define SIM_VOL_STABLE_3V_TIME				(60 * SIM_NSEC_PER_USEC)		//60us
+#define SIM_CPU_CLOCK_MHZ					16ULL							//CPU clock (See fnInitializeClock)
+
+//Deadline of an event which is not scheduled
+#define SIM_EVENT_IDLE						UINT64_MAX
+
+//RTC overflow interrupt flag
+#define SIM_RTC_OVFIF_bm					0x01
+
+//States of ADC inputs
+#define SIM_ADC_IDLE						0
+#define SIM_ADC_RUNNING						1
+#define SIM_ADC_COMPLETE					2
+
+//Events of MCU peripherals wait for interrupts to get enabled where as RTC and external devices are independent of MCU
+#define SIM_MCU_EVENT(chEventId)			((chEventId) >= SIM_EVENT_COMM_TIMER && (chEventId) < SIM_EVENT_RADIO_CALIBRATION)
+
+//Position of event which is not available in heap
+#define SIM_HEAP_NONE						0xFF
+
+//Counter range of 16 bit RTC
+#define SIM_RTC_COUNTER_RANGE				0x10000
+
+//Low level interrupts must be enabled in PMIC as well as globally to execute any interrupt routine
+#define SIM_INTERRUPTS_ENABLED				(gchSimInterruptEnable && (PMIC.CTRL & PMIC_LOLVLEN_bm))
+
+//Default run time configuration
+#define SIM_DEFAULT_RUN_TIME				60				//Seconds
+#define SIM_DEFAULT_SAMPLE_CLOCK			10				//HZ
+#define SIM_DEFAULT_RADIO_DIVISOR			10
+#define SIM_DEFAULT_COMM_WAIT				500				//ms
+#define SIM_DEFAULT_SEED					1
+#define SIM_DEFAULT_ET_SENSORS				4
+
+//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+//Simulated register instances
+PORT_t		ghSimPortA, ghSimPortB, ghSimPortC, ghSimPortD, ghSimPortE, ghSimPortF;
+PORT_t		ghSimPortH, ghSimPortJ, ghSimPortK, ghSimPortQ, ghSimPortR;
+RTC_t		ghSimRtc;
+OSC_t		ghSimOsc;
+CLK_t		ghSimClk;
+WDT_t		ghSimWdt;
+SLEEP_t		ghSimSleep;
+PMIC_t		ghSimPmic;
+RST_t		ghSimRst;
+register8_t	gchSimCcp;
+
+//Global interrupt enable (I-bit of SREG)
+volatile uint8_t		gchSimInterruptEnable;
+
+//Run time configuration and statistics of simulation
+SIM_CONFIGURATION		ghSimConfig;
+SIM_STATISTICS			ghSimStatistics;
+
+//Definitions of replaced target drivers which are accessed by upper layers
+volatile UART_COMM_DATA_HANDLE		ghUartCommData;
+volatile RADIO_COMM_DATA_HANDLE		ghRadioSpiCommData;
+volatile RADIO_SPI_QUEUE			ghRadioSpiQueue;
+SMART_SENSOR_SPI_QUEUE				ghSmartSensorSpiQueue[SMART_SENSOR_SPI_CHANNELS];
+volatile I2C_COMM_DATA_HANDLE		ghI2cCommData;
+volatile uint8_t					gchI2cOccupiedFlag;
+volatile uint8_t					gchCounterDelayTimeOut;
+volatile uint8_t					gchVoltageStableTimerFlag;
+
+//Virtual clock and deadlines of pending events
+static SIM_TIME				glSimTime;
+static SIM_TIME				glSimEventTime[SIM_TOTAL_EVENTS];
+
+//Start of communication timer and time it was disabled (0 while running)
+static SIM_TIME				glSimCommTimerStart;
+static SIM_TIME				glSimCommTimerStop;
+
+//Pending events ordered by deadline (binary min heap of event ids) and position of every event in heap
+static uint8_t				gchSimEventHeap[SIM_TOTAL_EVENTS];
+static uint8_t				gchSimHeapPosition[SIM_TOTAL_EVENTS];
+static uint8_t				gchSimHeapCount;
+
+//Events of MCU peripherals which became due while interrupts were disabled (bit per event) and their due time
+static uint16_t				gnSimPendingInterrupts;
+static SIM_TIME				glSimPendingSince[SIM_TOTAL_EVENTS];
+
+//RTC: Count known at tick glSimRtcBaseTick and register values seen at last synchronization
+static SIM_TIME				glSimRtcBaseTick;
+static uint16_t				gnSimRtcBaseCount;
+static uint8_t				gchSimRtcCtrl;
+static uint16_t				gnSimRtcPer;
+static uint16_t				gnSimRtcCnt;
+
+//Pin change of PORTH which is waiting for interrupt routine (INTFLAGS is write one to clear on target so it is not used)
+static volatile uint8_t		gchSimPortHIntPending;
+
+//Set whenever an interrupt routine is executed (wake up condition from sleep)
+static volatile uint8_t		gchSimIsrFired;
+
+//State of pseudo random generator
+static uint32_t				glSimRandomState;
+
+//Host CPU time at start of simulation
+static clock_t				glSimHostStartTime;
+
+//States of simulated drivers
+static volatile uint8_t		gchAckError;
+static volatile uint8_t		gchTxCompleteFlag;
+static uint8_t				gchSimAdcState[MAX_SAHRED_RESOURCES_ON_ADC];
+static int16_t				gnSimAdcResult[MAX_SAHRED_RESOURCES_ON_ADC];
+
+//_____ fnSimEnvValue ____________________________________________________________________
+//
+// @brief	Reads numeric value of environment variable
+// @param	szName		Name of environment variable
+//			lDefault	Value used when variable is not available
+// @return	Value of environment variable
+
+static uint32_t fnSimEnvValue(const char *szName,uint32_t lDefault)
+{
+	char *szValue = getenv(szName);
+	
+	if(szValue == NULL || *szValue == NULL_CHAR)
+	{
+		return lDefault;
+	}
+	
+	return (uint32_t)strtoul(szValue,NULL,10);
+}
+
+//_____ fnSimConfigure ____________________________________________________________________
+//
+// @brief	Executed by host before main(). It prepares power on state of simulated MCU and devices:
+//				1> Read simulation configuration from environment variables
+//				2> Put all pending events in idle state with empty event heap
+//				3> Set status bits which firmware polls during initialization (Oscillator ready, Power on reset)
+
+static void __attribute__((constructor)) fnSimConfigure(void)
+{
+	uint8_t chEventId = RESET_VALUE;
+	
+	ghSimConfig.lRunTime			= (SIM_TIME)fnSimEnvValue("SIM_RUN_TIME",SIM_DEFAULT_RUN_TIME) * SIM_NSEC_PER_SEC;
+	ghSimConfig.chQuiet				= (uint8_t)fnSimEnvValue("SIM_QUIET",RESET_VALUE);
+	ghSimConfig.nSampleClock		= (uint16_t)fnSimEnvValue("SIM_SAMPLE_CLOCK",SIM_DEFAULT_SAMPLE_CLOCK);
+	ghSimConfig.nRadioDivisor		= (uint16_t)fnSimEnvValue("SIM_RADIO_DIVISOR",SIM_DEFAULT_RADIO_DIVISOR);
+	ghSimConfig.nCommWaitTime		= (uint16_t)fnSimEnvValue("SIM_COMM_WAIT",SIM_DEFAULT_COMM_WAIT);
+	ghSimConfig.chPayloadEncoding	= (uint8_t)fnSimEnvValue("SIM_PAYLOAD_ENCODING",RESET_VALUE);
+	ghSimConfig.chDownloadWindow	= (uint8_t)fnSimEnvValue("SIM_DOWNLOAD_WINDOW",RESET_VALUE);
+	ghSimConfig.chSensorEntries		= (uint8_t)fnSimEnvValue("SIM_ET_SENSORS",SIM_DEFAULT_ET_SENSORS);
+	ghSimConfig.chSmartSensors		= (uint8_t)fnSimEnvValue("SIM_SMART_SENSORS",RESET_VALUE);
+	ghSimConfig.chPacketLossPercent	= (uint8_t)fnSimEnvValue("SIM_PACKET_LOSS",RESET_VALUE);
+	ghSimConfig.lOutageStart		= (SIM_TIME)fnSimEnvValue("SIM_LINK_OUTAGE_START",RESET_VALUE) * SIM_NSEC_PER_SEC;
+	ghSimConfig.lOutageEnd			= ghSimConfig.lOutageStart + (SIM_TIME)fnSimEnvValue("SIM_LINK_OUTAGE_TIME",RESET_VALUE) * SIM_NSEC_PER_SEC;
+	ghSimConfig.lSeed				= fnSimEnvValue("SIM_SEED",SIM_DEFAULT_SEED);
+	ghSimConfig.lLayoutBenchmarkPasses	= fnSimEnvValue("SIM_LAYOUT_BENCHMARK",RESET_VALUE);
+	ghSimConfig.chSmartSensorBenchmark	= (uint8_t)fnSimEnvValue("SIM_SMART_SENSOR_BENCHMARK",RESET_VALUE);
+	
+	glSimRandomState = (ghSimConfig.lSeed) ? ghSimConfig.lSeed : SIM_DEFAULT_SEED;		//xorshift can not start from zero
+	
+	//Benchmark runs in place of firmware
+	if(ghSimConfig.lLayoutBenchmarkPasses != RESET_VALUE)
+	{
+		fnSimLayoutBenchmark((ghSimConfig.lLayoutBenchmarkPasses == SET_VALUE) ? RESET_VALUE : ghSimConfig.lLayoutBenchmarkPasses);
+		exit(EXIT_SUCCESS);
+	}
+	
+	for(chEventId = RESET_VALUE; chEventId < SIM_TOTAL_EVENTS; chEventId++)
+	{
+		glSimEventTime[chEventId] = SIM_EVENT_IDLE;
+		gchSimHeapPosition[chEventId] = SIM_HEAP_NONE;
+	}
+	
+	glSimTime = RESET_VALUE;
+	gchSimHeapCount = RESET_COUNTER;
+	
+	OSC.STATUS = OSC_RC32MRDY_bm;
+	RST.STATUS = RESET_BY_PWRON;
+	
+	fnSimDevicesInit();
+	
+	//Benchmark runs in place of firmware (On virtual clock, so it needs event heap and device models)
+	if(ghSimConfig.chSmartSensorBenchmark != RESET_VALUE)
+	{
+		fnSimSmartSensorBenchmark(ghSimConfig.chSmartSensorBenchmark);
+		exit(EXIT_SUCCESS);
+	}
+	
+	glSimHostStartTime = clock();
+	
+	return;
+}
+
+//_____ fnSimGetTime ____________________________________________________________________
+//
+// @brief	Current value of virtual clock
+// @return	Virtual time in nano seconds elapsed since power on
+
+SIM_TIME fnSimGetTime(void)
+{
+	return glSimTime;
+}
+
+//_____ fnSimReport ____________________________________________________________________
+//
+// @brief	Prints statistics collected during simulation on stderr
+
+static void fnSimReport(void)
+{
+	SIM_TIME lSleepTime = RESET_VALUE;
+	double fHostTime = (double)(clock() - glSimHostStartTime) / CLOCKS_PER_SEC;
+	double fRunTime = (double)glSimTime / SIM_NSEC_PER_SEC;
+	uint8_t chCounter = RESET_COUNTER;
+	
+	for(chCounter = SIM_MODE_IDLE; chCounter < SIM_TOTAL_MODES; chCounter++)
+	{
+		lSleepTime += ghSimStatistics.lModeResidency[chCounter];
+	}
+	ghSimStatistics.lModeResidency[SIM_MODE_ACTIVE] = glSimTime - lSleepTime;
+	
+	fprintf(stderr,"\n-------- SENSOR MC Host Simulation Report --------\n");
+	fprintf(stderr,"Virtual time            : %.3f s (host %.3f s, %.0fx real time)\n",fRunTime,fHostTime,(fHostTime > 0) ? (fRunTime / fHostTime) : 0.0);
+	fprintf(stderr,"Power mode residency    : Active %.2f%%  Idle %.2f%%  Power Save %.2f%%  Power Down %.2f%%\n",
+			100.0 * ghSimStatistics.lModeResidency[SIM_MODE_ACTIVE] / glSimTime,
+			100.0 * ghSimStatistics.lModeResidency[SIM_MODE_IDLE] / glSimTime,
+			100.0 * ghSimStatistics.lModeResidency[SIM_MODE_POWER_SAVE] / glSimTime,
+			100.0 * ghSimStatistics.lModeResidency[SIM_MODE_POWER_DOWN] / glSimTime);
+	fprintf(stderr,"Events processed        : %llu (max interrupt latency %.3f us)\n",(unsigned long long)ghSimStatistics.lEventsProcessed,(double)ghSimStatistics.lMaxInterruptLatency / SIM_NSEC_PER_USEC);
+	fprintf(stderr,"RTC overflows           : %u\n",ghSimStatistics.lRtcOverflows);
+	fprintf(stderr,"CC1125 SPI              : %u transactions, %u bytes\n",ghSimStatistics.lRadioSpiTransactions,ghSimStatistics.lRadioSpiBytes);
+	fprintf(stderr,"CC1125 SPI queue        : %u queues, %u bytes shifted by interrupt\n",ghSimStatistics.lRadioSpiQueues,ghSimStatistics.lRadioSpiQueuedBytes);
+	
+	if(ghSimStatistics.lRadioInits)
+	{
+		fprintf(stderr,"CC1125 initialization   : %u times, %.1f SPI transactions and %.1f us each\n",ghSimStatistics.lRadioInits,
+				(double)ghSimStatistics.lRadioInitTransactions / ghSimStatistics.lRadioInits,(double)ghSimStatistics.lRadioInitTime / ghSimStatistics.lRadioInits / SIM_NSEC_PER_USEC);
+	}
+	fprintf(stderr,"RF packets              : %u sent, %u received, %u lost\n",ghSimStatistics.lRadioPacketsSent,ghSimStatistics.lRadioPacketsReceived,ghSimStatistics.lRadioPacketsLost);
+	fprintf(stderr,"RF air time             : %.2f%% (%u FIFO threshold interrupts, %u FIFO errors)\n",100.0 * ghSimStatistics.lRadioAirTime / glSimTime,
+			ghSimStatistics.lRadioFifoThresholds,ghSimStatistics.lRadioFifoErrors);
+	fprintf(stderr,"Execution tables sent   : %u\n",ghSimStatistics.lExecutionTablesSent);
+	fprintf(stderr,"Data packets acked      : %u (%u bytes, %u samples, %.2f bytes per sample)\n",ghSimStatistics.lDataPacketsAcked,ghSimStatistics.lDataBytesDelivered,ghSimStatistics.lDataSamplesDelivered,
+			ghSimStatistics.lDataSamplesDelivered ? ((double)ghSimStatistics.lDataBytesDelivered / ghSimStatistics.lDataSamplesDelivered) : 0.0);
+	
+	if(ghSimConfig.chPayloadEncoding)
+	{
+		fprintf(stderr,"Undecodable samples     : %u\n",ghSimStatistics.lDataSamplesUndecodable);
+	}
+	if(ghSimStatistics.lDataBytesDelivered)
+	{
+		fprintf(stderr,"Download goodput        : %.1f bytes per radio clock, %.1f bytes per data packet, %.2f ms air time per data byte\n",
+				(double)ghSimStatistics.lDataBytesDelivered * ghSimConfig.nRadioDivisor / ghSimConfig.nSampleClock / fRunTime,
+				(double)ghSimStatistics.lDataBytesDelivered / ghSimStatistics.lDataPacketsAcked,
+				(double)ghSimStatistics.lRadioAirTime / SIM_NSEC_PER_MSEC / ghSimStatistics.lDataBytesDelivered);
+	}
+	if(ghSimConfig.chDownloadWindow || ghSimConfig.chPacketLossPercent)
+	{
+		fprintf(stderr,"Download throughput     : %.1f bytes/s, %.2f RF packets sent per data packet acked, %u bitmap ACKs\n",(double)ghSimStatistics.lDataBytesDelivered / fRunTime,
+				ghSimStatistics.lDataPacketsAcked ? ((double)ghSimStatistics.lRadioPacketsSent / ghSimStatistics.lDataPacketsAcked) : 0.0,ghSimStatistics.lBitmapAcksSent);
+	}
+	if(ghSimConfig.lOutageEnd > ghSimConfig.lOutageStart)
+	{
+		fprintf(stderr,"Data packets replayed   : %u (%u samples)\n",ghSimStatistics.lDataPacketsReplayed,ghSimStatistics.lDataSamplesReplayed);
+	}
+	if(ghSimConfig.chSmartSensors)
+	{
+		fprintf(stderr,"Smart Sensors           : %u configuration frames, %u measurements fetched\n",ghSimStatistics.lSmartSensorConfigFrames,ghSimStatistics.lSmartSensorFetches);
+	}
+	fprintf(stderr,"I2C transactions        : %u\n",ghSimStatistics.lI2cTransactions);
+	fprintf(stderr,"E2PROM transactions     : %u writes (%u bytes), %u reads, %u NACKs in write cycle\n",ghSimStatistics.lE2promWrites,ghSimStatistics.lE2promWriteBytes,ghSimStatistics.lE2promReads,ghSimStatistics.lE2promBusyNacks);
+	fprintf(stderr,"ADC conversions         : %u\n",ghSimStatistics.lAdcConversions);
+	fprintf(stderr,"Debug UART bytes        : %u\n",ghSimStatistics.lUartBytes);
+	
+	for(chCounter = RESET_COUNTER; chCounter < (sizeof(ghSimStatistics.lErrorCodes)/sizeof(ghSimStatistics.lErrorCodes[0])); chCounter++)
+	{
+		if(ghSimStatistics.lErrorCodes[chCounter])
+		{
+			fprintf(stderr,"Error code E%02u          : %u\n",chCounter,ghSimStatistics.lErrorCodes[chCounter]);
+		}
+	}
+	
+	#if TASK_PROFILER_ENABLE
+	{
+		char chLineBuff[UART_COMM_BUF_SIZE];
+		uint8_t chLine = RESET_COUNTER;
+		
+		fprintf(stderr,"Sample bytes copied     : %u (%.2f per delivered sample)\n",glPacketBytesCopied,
+				ghSimStatistics.lDataSamplesDelivered ? ((double)glPacketBytesCopied / ghSimStatistics.lDataSamplesDelivered) : 0.0);
+		fprintf(stderr,"Task profile (CPU cycles at %lluMHZ, C/L: min/avg/max/p99 of call cycles/activation latency):\n",SIM_CPU_CLOCK_MHZ);
+		for(chCounter = RESET_COUNTER; chCounter < TOTAL_PROFILED_TASKS; chCounter++)
+		{
+			for(chLine = RESET_COUNTER; chLine < TASK_PROFILER_TOTAL_LINES; chLine++)
+			{
+				if(fnTaskProfilerFormat(chCounter,chLine,chLineBuff) == RETURN_TRUE)
+				{
+					fprintf(stderr,"  %s",chLineBuff);
+				}
+			}
+		}
+		
+		#if PHASE_ANALYZER_ENABLE
+			fprintf(stderr,"Phase budget (max sample clock %u HZ for current execution table):\n",fnPhaseAnalyzerMaxSampleClock());
+			for(chLine = RESET_COUNTER; chLine < PHASE_ANALYZER_TOTAL_LINES; chLine++)
+			{
+				if(fnPhaseAnalyzerFormat(chLine,chLineBuff) == RETURN_TRUE)
+				{
+					fprintf(stderr,"  %s",chLineBuff);
+				}
+			}
+		#endif
+	}
+	#endif
+	
+	return;
+}
+
+//_____ fnSimHeapEarlier ____________________________________________________________________
+//
+// @brief	Ordering of pending events. Events due at same time are ordered by event id to keep runs repeatable.
+// @return	TRUE (non zero) if chFirst is due before chSecond
+
+static uint8_t fnSimHeapEarlier(uint8_t chFirst,uint8_t chSecond)
+{
+	if(glSimEventTime[chFirst] != glSimEventTime[chSecond])
+	{
+		return (glSimEventTime[chFirst] < glSimEventTime[chSecond]);
+	}
+	
+	return (chFirst < chSecond);
+}
+
+//_____ fnSimHeapSwap ____________________________________________________________________
+//
+// @brief	Exchange two entries of event heap along with their position index
+
+static void fnSimHeapSwap(uint8_t chFirstPos,uint8_t chSecondPos)
+{
+	uint8_t chEventId = gchSimEventHeap[chFirstPos];
+	
+	gchSimEventHeap[chFirstPos] = gchSimEventHeap[chSecondPos];
+	gchSimEventHeap[chSecondPos] = chEventId;
+	
+	gchSimHeapPosition[gchSimEventHeap[chFirstPos]] = chFirstPos;
+	gchSimHeapPosition[gchSimEventHeap[chSecondPos]] = chSecondPos;
+	
+	return;
+}
+
+//_____ fnSimHeapSiftUp ____________________________________________________________________
+//
+// @brief	Moves the entry towards root of the heap till its parent is due earlier
+
+static void fnSimHeapSiftUp(uint8_t chPos)
+{
+	uint8_t chParent = RESET_VALUE;
+	
+	while(chPos > RESET_VALUE)
+	{
+		chParent = (chPos - 1) >> 1;
+		
+		if(!fnSimHeapEarlier(gchSimEventHeap[chPos],gchSimEventHeap[chParent]))
+		{
+			break;
+		}
+		
+		fnSimHeapSwap(chPos,chParent);
+		chPos = chParent;
+	}
+	
+	return;
+}
+
+//_____ fnSimHeapSiftDown ____________________________________________________________________
+//
+// @brief	Moves the entry towards leaves of the heap till both children are due later
+
+static void fnSimHeapSiftDown(uint8_t chPos)
+{
+	uint8_t chChild = RESET_VALUE;
+	
+	while((chChild = (chPos << 1) + 1) < gchSimHeapCount)
+	{
+		if((chChild + 1) < gchSimHeapCount && fnSimHeapEarlier(gchSimEventHeap[chChild + 1],gchSimEventHeap[chChild]))
+		{
+			chChild++;
+		}
+		
+		if(!fnSimHeapEarlier(gchSimEventHeap[chChild],gchSimEventHeap[chPos]))
+		{
+			break;
+		}
+		
+		fnSimHeapSwap(chPos,chChild);
+		chPos = chChild;
+	}
+	
+	return;
+}
+
+//_____ fnSimHeapRemove ____________________________________________________________________
+//
+// @brief	Removes the event from heap (if scheduled). Last entry takes its place and is moved to its right position.
+
+static void fnSimHeapRemove(uint8_t chEventId)
+{
+	uint8_t chPos = gchSimHeapPosition[chEventId];
+	
+	if(chPos == SIM_HEAP_NONE)
+	{
+		return;
+	}
+	
+	gchSimHeapPosition[chEventId] = SIM_HEAP_NONE;
+	glSimEventTime[chEventId] = SIM_EVENT_IDLE;
+	
+	if(chPos != --gchSimHeapCount)
+	{
+		chEventId = gchSimEventHeap[gchSimHeapCount];
+		gchSimEventHeap[chPos] = chEventId;
+		gchSimHeapPosition[chEventId] = chPos;
+		
+		fnSimHeapSiftUp(chPos);
+		fnSimHeapSiftDown(gchSimHeapPosition[chEventId]);
+	}
+	
+	return;
+}
+
+//_____ fnSimCheckRunTime ____________________________________________________________________
+//
+// @brief	Terminates the simulation with report when configured run time is over
+
+static void fnSimCheckRunTime(void)
+{
+	if(glSimTime >= ghSimConfig.lRunTime)
+	{
+		glSimTime = ghSimConfig.lRunTime;
+		fflush(stdout);
+		fnSimReport();
+		exit(EXIT_SUCCESS);
+	}
+	
+	return;
+}
+
+//_____ fnSimRtcSync ____________________________________________________________________
+//
+// @brief	RTC is not clocked on every tick. Counter value is derived from the tick at which it was last known and
+//			overflow is kept as a pending event. Firmware writes CTRL, PER and CNT directly so registers are compared with
+//			the values seen at last synchronization:
+//				1> Prescaler is turned off: Overflow event is canceled and CNT keeps the value
+//				2> Prescaler is turned on or PER/CNT is modified: Counting restarts from CNT on next RTC clock
+//				3> Current count is published in CNT
+
+static void fnSimRtcSync(void)
+{
+	SIM_TIME lTick = glSimTime / SIM_RTC_TICK_TIME;
+	SIM_TIME lTicksToOverflow = RESET_VALUE;
+	
+	if(!(RTC.CTRL & RTC_PRESCALER_DIV1_gc))
+	{
+		if(gchSimRtcCtrl & RTC_PRESCALER_DIV1_gc)
+		{
+			fnSimCancelEvent(SIM_EVENT_RTC_OVERFLOW);
+		}
+		
+		gchSimRtcCtrl = RTC.CTRL;
+		return;
+	}
+	
+	if(!(gchSimRtcCtrl & RTC_PRESCALER_DIV1_gc) || RTC.PER != gnSimRtcPer || RTC.CNT != gnSimRtcCnt)
+	{
+		gchSimRtcCtrl = RTC.CTRL;
+		gnSimRtcPer = RTC.PER;
+		gnSimRtcBaseCount = RTC.CNT;
+		glSimRtcBaseTick = lTick;
+		
+		//Overflow occurs on the clock after counter reaches PER (counter above PER runs till 0xFFFF first)
+		if(gnSimRtcBaseCount <= gnSimRtcPer)
+		{
+			lTicksToOverflow = (SIM_TIME)(gnSimRtcPer - gnSimRtcBaseCount) + 1;
+		}
+		else
+		{
+			lTicksToOverflow = (SIM_TIME)(SIM_RTC_COUNTER_RANGE - gnSimRtcBaseCount) + gnSimRtcPer + 1;
+		}
+		
+		fnSimScheduleEvent(SIM_EVENT_RTC_OVERFLOW,((lTick + lTicksToOverflow) * SIM_RTC_TICK_TIME) - glSimTime);
+	}
+	
+	gnSimRtcCnt = (uint16_t)(gnSimRtcBaseCount + (lTick - glSimRtcBaseTick));
+	RTC.CNT = gnSimRtcCnt;
+	return;
+}
+
+//_____ fnSimExecuteEvent ____________________________________________________________________
+//
+// @brief	Performs the work of the peripheral whose event is due along with its interrupt routine
+// @param	chEventId	Event from SIM_EVENT_ID
+
+static void fnSimExecuteEvent(uint8_t chEventId)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	
+	switch(chEventId)
+	{
+		//RTC overflow: Flag is set here and interrupt routine is executed by fnSimServiceInterrupts
+		case SIM_EVENT_RTC_OVERFLOW:
+			RTC.INTFLAGS |= SIM_RTC_OVFIF_bm;
+			ghSimStatistics.lRtcOverflows++;
+			
+			glSimRtcBaseTick = glSimTime / SIM_RTC_TICK_TIME;
+			gnSimRtcBaseCount = RESET_COUNTER;
+			gnSimRtcCnt = RESET_COUNTER;
+			RTC.CNT = RESET_COUNTER;
+			fnSimScheduleEvent(SIM_EVENT_RTC_OVERFLOW,((SIM_TIME)gnSimRtcPer + 1) * SIM_RTC_TICK_TIME);
+		break;
+		
+		//TCC1 overflow: Communication wait time out
+		case SIM_EVENT_COMM_TIMER:
+			gchCommunicationTimeOut = SET_FLAG;
+			POST_SYSTEM_EVENT(EVENT_COMM_TIMEOUT,RESET_VALUE);
+			gchSimIsrFired = SET_FLAG;
+		break;
+		
+		//TCE1 overflow: Voltage regulator is stable
+		case SIM_EVENT_VOL_STABLE_TIMER:
+			gchVoltageStableTimerFlag = SET_FLAG;
+			POST_SYSTEM_EVENT(EVENT_VOL_STABLE,RESET_VALUE);
+			gchSimIsrFired = SET_FLAG;
+		break;
+		
+		//TWIF: Last byte of transaction is transferred
+		case SIM_EVENT_I2C_COMPLETE:
+			if(fnSimI2cTransaction(ghI2cCommData.chCommAddress,(uint8_t*)ghI2cCommData.chCommBuff,ghI2cCommData.chCommWriteCount,ghI2cCommData.chCommReadCount) == RETURN_FALSE)
+			{
+				gchAckError = SET_FLAG;
+				POST_SYSTEM_EVENT(EVENT_I2C_COMPLETE,(uint8_t)RETURN_FALSE);
+			}
+			else
+			{
+				ghI2cCommData.chCommComplete = SET_FLAG;
+				POST_SYSTEM_EVENT(EVENT_I2C_COMPLETE,RETURN_TRUE);
+			}
+			
+			ghSimStatistics.lI2cTransactions++;
+			gchSimIsrFired = SET_FLAG;
+		break;
+		
+		//ADCA/ADCB: Conversion complete on all running channels
+		case SIM_EVENT_ADC_COMPLETE:
+			for(chIndex = RESET_COUNTER; chIndex < MAX_SAHRED_RESOURCES_ON_ADC; chIndex++)
+			{
+				if(gchSimAdcState[chIndex] == SIM_ADC_RUNNING)
+				{
+					gnSimAdcResult[chIndex] = fnSimAdcSample(chIndex);
+					gchSimAdcState[chIndex] = SIM_ADC_COMPLETE;
+					ghSimStatistics.lAdcConversions++;
+					POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,chIndex);
+				}
+			}
+			
+			gchSimIsrFired = SET_FLAG;
+		break;
+		
+		//SPIC: Queued transactions are performed with CC1125 model once their bus time is over
+		case SIM_EVENT_RADIO_SPI_COMPLETE:
+			ghRadioSpiQueue.chResult = RETURN_TRUE;
+			
+			for(chIndex = RESET_COUNTER; chIndex < ghRadioSpiQueue.chCount; chIndex++)
+			{
+				if(fnSimRadioSpiAccess(ghRadioSpiQueue.hDescriptor[chIndex].nCommAddress,ghRadioSpiQueue.hDescriptor[chIndex].chCommType,
+									   ghRadioSpiQueue.hDescriptor[chIndex].pchCommBuff,ghRadioSpiQueue.hDescriptor[chIndex].chCommCount,(uint8_t*)&ghRadioSpiQueue.chStatusByte) == RETURN_FALSE)
+				{
+					ghRadioSpiQueue.chResult = (uint8_t)RETURN_FALSE;
+					break;
+				}
+				
+				ghSimStatistics.lRadioSpiTransactions++;
+			}
+			
+			ghRadioSpiQueue.chCount = RESET_COUNTER;
+			ghRadioSpiQueue.chState = RADIO_SPI_QUEUE_IDLE;
+			POST_SYSTEM_EVENT(EVENT_RADIO_SPI_COMPLETE,ghRadioSpiQueue.chResult);
+			gchSimIsrFired = SET_FLAG;
+		break;
+		
+		//CC1125 and RFC Console
+		default:
+			fnSimRadioEvent(chEventId);
+		break;
+	}
+	
+	return;
+}
+
+//_____ fnSimServiceInterrupts ____________________________________________________________________
+//
+// @brief	Executes the interrupts which are waiting for global/PMIC enable:
+//				1> Events of MCU peripherals which became due while interrupts were disabled
+//				2> RTC overflow
+//				3> Pin change of PORTH (CC1125 GPIO0 on INT0, GPIO2/GPIO3 on INT1)
+
+static void fnSimServiceInterrupts(void)
+{
+	uint8_t  chEventId = RESET_VALUE;
+	SIM_TIME lLatency = RESET_VALUE;
+	
+	for(chEventId = SIM_EVENT_COMM_TIMER; gnSimPendingInterrupts && chEventId < SIM_EVENT_RADIO_CALIBRATION; chEventId++)
+	{
+		if(gnSimPendingInterrupts & (1 << chEventId))
+		{
+			gnSimPendingInterrupts &= ~(1 << chEventId);
+			
+			lLatency = glSimTime - glSimPendingSince[chEventId];
+			if(lLatency > ghSimStatistics.lMaxInterruptLatency)
+			{
+				ghSimStatistics.lMaxInterruptLatency = lLatency;
+			}
+			
+			fnSimExecuteEvent(chEventId);
+		}
+	}
+	
+	if((RTC.INTFLAGS & SIM_RTC_OVFIF_bm) && (RTC.INTCTRL & RTC_OVFINTLVL0_bm))
+	{
+		RTC.INTFLAGS &= (~SIM_RTC_OVFIF_bm);
+		RTC_OVF_vect();
+		gchSimIsrFired = SET_FLAG;
+	}
+	
+	if((gchSimPortHIntPending & PORTH.INT0MASK) && (PORTH.INTCTRL & PORT_INT0LVL_LO_gc))
+	{
+		gchSimPortHIntPending &= ~PORTH.INT0MASK;
+		PORTH_INT0_vect();
+		gchSimIsrFired = SET_FLAG;
+	}
+	
+	if((gchSimPortHIntPending & PORTH.INT1MASK) && (PORTH.INTCTRL & PORT_INT1LVL_LO_gc))
+	{
+		gchSimPortHIntPending &= ~PORTH.INT1MASK;
+		PORTH_INT1_vect();
+		gchSimIsrFired = SET_FLAG;
+	}
+	
+	return;
+}
+
+//_____ fnSimRun ____________________________________________________________________
+//
+// @brief	Discrete event engine. Virtual clock jumps from one pending event to the next till lEndTime:
+//				1> Synchronize RTC with the registers modified by firmware
+//				2> If interrupts are enabled than execute the pending interrupt routines
+//				3> Return on first interrupt routine if requested (wake up from sleep)
+//				4> Move virtual clock to the earliest event and execute it. Events of MCU peripherals remain pending while interrupts are disabled.
+//				5> Terminate the simulation with report when configured run time is over
+// @param	lEndTime		Virtual time till which to run
+//			chStopOnIsr		Return as soon as any interrupt routine is executed
+
+static void fnSimRun(SIM_TIME lEndTime,uint8_t chStopOnIsr)
+{
+	uint8_t chEventId = RESET_VALUE;
+	
+	while(1)
+	{
+		fnSimRtcSync();
+		
+		if(SIM_INTERRUPTS_ENABLED)
+		{
+			fnSimServiceInterrupts();
+		}
+		
+		if(chStopOnIsr && gchSimIsrFired)
+		{
+			return;
+		}
+		
+		if(gchSimHeapCount == RESET_COUNTER || glSimEventTime[gchSimEventHeap[0]] > lEndTime)
+		{
+			break;
+		}
+		
+		chEventId = gchSimEventHeap[0];
+		glSimTime = glSimEventTime[chEventId];
+		fnSimCheckRunTime();
+		
+		fnSimHeapRemove(chEventId);
+		ghSimStatistics.lEventsProcessed++;
+		
+		if(SIM_MCU_EVENT(chEventId) && !SIM_INTERRUPTS_ENABLED)
+		{
+			gnSimPendingInterrupts |= (1 << chEventId);
+			glSimPendingSince[chEventId] = glSimTime;
+		}
+		else
+		{
+			fnSimExecuteEvent(chEventId);
+		}
+	}
+	
+	if(lEndTime > glSimTime)
+	{
+		glSimTime = lEndTime;
+	}
+	
+	fnSimCheckRunTime();
+	return;
+}
+
+//_____ fnSimAdvanceTime ____________________________________________________________________
+//
+// @brief	Moves the virtual clock ahead for the time spent by CPU in blocking operations (wait loops, SPI, UART)
+//			All the peripheral events falling in between are executed along with their interrupt routines
+// @param	lDuration	Time in nano seconds for which CPU is busy
+
+void fnSimAdvanceTime(SIM_TIME lDuration)
+{
+	fnSimRun(glSimTime + lDuration,RESET_FLAG);
+	return;
+}
+
+//_____ fnSimSleep ____________________________________________________________________
+//
+// @brief	Replacement of SLEEP instruction. Virtual clock skips to the next event which executes an interrupt routine.
+//			Sleep mode selected in SLEEP.CTRL is used to account the power mode residency.
+
+void fnSimSleep(void)
+{
+	uint8_t  chMode = SIM_MODE_IDLE;
+	SIM_TIME lStartTime = glSimTime;
+	
+	//SLEEP instruction is ignored if sleep is not enabled
+	if(!(SLEEP.CTRL & SLEEP_SEN_bm))
+	{
+		return;
+	}
+	
+	switch(SLEEP.CTRL & SLEEP_SMODE_gm)
+	{
+		case SLEEP_SMODE_PSAVE_gc:
+			chMode = SIM_MODE_POWER_SAVE;
+		break;
+		
+		case SLEEP_SMODE_PDOWN_gc:
+			chMode = SIM_MODE_POWER_DOWN;
+		break;
+		
+		default:
+			chMode = SIM_MODE_IDLE;
+		break;
+	}
+	
+	gchSimIsrFired = RESET_FLAG;
+	fnSimRun(SIM_EVENT_IDLE,SET_FLAG);
+	
+	ghSimStatistics.lModeResidency[chMode] += glSimTime - lStartTime;
+	return;
+}
+
+//_____ fnSimScheduleEvent ____________________________________________________________________
+//
+// @brief	Raise the event after specified duration. Scheduling the same event again will overwrite the previous time.
+// @param	chEventId	Event from SIM_EVENT_ID
+//			lDelay		Time in nano seconds after which event needs to be raised
+
+void fnSimScheduleEvent(uint8_t chEventId,SIM_TIME lDelay)
+{
+	fnSimHeapRemove(chEventId);
+	gnSimPendingInterrupts &= ~(1 << chEventId);
+	
+	glSimEventTime[chEventId] = glSimTime + lDelay;
+	gchSimEventHeap[gchSimHeapCount] = chEventId;
+	gchSimHeapPosition[chEventId] = gchSimHeapCount;
+	fnSimHeapSiftUp(gchSimHeapCount++);
+	
+	return;
+}
+
+//_____ fnSimCancelEvent ____________________________________________________________________
+//
+// @brief	Cancel the pending event
+// @param	chEventId	Event from SIM_EVENT_ID
+
+void fnSimCancelEvent(uint8_t chEventId)
+{
+	fnSimHeapRemove(chEventId);
+	gnSimPendingInterrupts &= ~(1 << chEventId);
+	return;
+}
+
+//_____ fnSimPortHFallingEdge ____________________________________________________________________
+//
+// @brief	Falling edge on PORTH pin driven by external device. PORTH_INT0_vect/PORTH_INT1_vect is executed by fnSimServiceInterrupts if pin is configured for interrupt.
+// @param	chPinMask	Bit mask of the pin
+
+void fnSimPortHFallingEdge(uint8_t chPinMask)
+{
+	gchSimPortHIntPending |= chPinMask;
+	return;
+}
+
+//_____ fnSimRandom ____________________________________________________________________
+//
+// @brief	Pseudo random generator (xorshift) with the seed available in configuration to keep runs repeatable
+// @return	Random value in range of 0 to 99
+
+uint8_t fnSimRandom(void)
+{
+	glSimRandomState ^= glSimRandomState << 13;
+	glSimRandomState ^= glSimRandomState >> 17;
+	glSimRandomState ^= glSimRandomState << 5;
+	
+	return (uint8_t)(glSimRandomState % 100);
+}
+
+//_____ T I M E R   (mc_timer.c) ____________________________________________________________________
+
+void fnTimersInit(void)
+{
+	fnSimCancelEvent(SIM_EVENT_COMM_TIMER);
+	fnSimCancelEvent(SIM_EVENT_VOL_STABLE_TIMER);
+	return;
+}
+
+void fnUartDelayTimerEnable(void)
+{
+	return;						//UART reception is not simulated
+}
+
+void fnUartDelayTimerDisable(void)
+{
+	return;
+}
+
+void fnRadioCommunicationTimerEnable(void)
+{
+	return;						//Timer is started by fnStartCommunicationTimer
+}
+
+void fnRadioCommunicationTimerDisable(void)
+{
+	if(glSimCommTimerStop == RESET_VALUE)
+	{
+		glSimCommTimerStop = glSimTime;
+	}
+	fnSimCancelEvent(SIM_EVENT_COMM_TIMER);
+	return;
+}
+
+void fnDisableSystemDelayTimer(void)
+{
+	return;
+}
+
+void fnEnableSystemDelayTimer(void)
+{
+	return;
+}
+
+//_____fnStartSystemDelayTimer_______________________________________________________________
+//
+// @brief	Delay timer is always followed by busy wait on gchCounterDelayTimeOut (fnWait_uSecond) so CPU time is consumed here
+// @param	fDelayCount		Delay in micro seconds
+
+void fnStartSystemDelayTimer(float fDelayCount)
+{
+	gchCounterDelayTimeOut = RESET_VALUE;
+	fnSimAdvanceTime((SIM_TIME)(fDelayCount * SIM_NSEC_PER_USEC));
+	gchCounterDelayTimeOut = SET_FLAG;
+	return;
+}
+
+void fnStartCommunicationTimer(float fDelayCount)
+{
+	glSimCommTimerStart = glSimTime;
+	glSimCommTimerStop = RESET_VALUE;
+	gchCommunicationTimeOut = RESET_FLAG;
+	fnSimScheduleEvent(SIM_EVENT_COMM_TIMER,(SIM_TIME)(fDelayCount * SIM_NSEC_PER_MSEC));
+	return;
+}
+
+void fnStartVolStableTimer(uint8_t chVal)
+{
+	gchVoltageStableTimerFlag = RESET_FLAG;
+	fnSimScheduleEvent(SIM_EVENT_VOL_STABLE_TIMER,(chVal == WAIT_5_VOL_TIMER) ? SIM_VOL_STABLE_5V_TIME : SIM_VOL_STABLE_3V_TIME);
+	return;
+}
+
+//_____fnReadCycleCounter_______________________________________________________________
+//
+// @brief	CPU time is not modeled so cycle counter advances only with the virtual time consumed by blocking operations and sleep
+// @return	Virtual time in CPU cycles
+
+uint32_t fnReadCycleCounter(void)
+{
+	return (uint32_t)((glSimTime * SIM_CPU_CLOCK_MHZ) / SIM_NSEC_PER_USEC);
+}
+
+//_____fnReadCommunicationTimer_______________________________________________________________
+//
+// @brief	Time elapsed since fnStartCommunicationTimer (Frozen once the timer is disabled as on target)
+// @return	Elapsed time in ms
+
+uint16_t fnReadCommunicationTimer(void)
+{
+	SIM_TIME lElapsed = ((glSimCommTimerStop != RESET_VALUE) ? glSimCommTimerStop : glSimTime) - glSimCommTimerStart;
+	
+	lElapsed /= SIM_NSEC_PER_MSEC;
+	return (lElapsed > 0xFFFF) ? 0xFFFF : (uint16_t)lElapsed;
+}
+
+//_____ U A R T   (mc_uart.c) ____________________________________________________________________
+
+void fnUartInitialization(void)
+{
+	gchTxCompleteFlag = SET_FLAG;
+	return;
+}
+
+//_____ fnUartSendData ____________________________________________________________________
+//
+// @brief	Debug UART bytes are echoed on console and error codes (See fnSendErrorCode) are counted for the report.
+//			Debug functions busy wait for the transmission so CPU time of all the bytes is consumed here.
+
+void fnUartSendData(void)
+{
+	uint16_t nTxCount = ghUartCommData.nTxCount;
+	uint8_t  chErrorCode = RESET_VALUE;
+	
+	gchTxCompleteFlag = RESET_FLAG;
+	
+	if(!ghSimConfig.chQuiet)
+	{
+		fwrite((const void*)ghUartCommData.chCommBuff,1,nTxCount,stdout);
+	}
+	
+	if(nTxCount == 4 && ghUartCommData.chCommBuff[0] == ERR_CODE_CHAR && ghUartCommData.chCommBuff[3] == NEWLINE_CHAR)
+	{
+		chErrorCode = ((ghUartCommData.chCommBuff[1] - CONVERT_TO_ASCII) * 10) + (ghUartCommData.chCommBuff[2] - CONVERT_TO_ASCII);
+		
+		if(chErrorCode < (sizeof(ghSimStatistics.lErrorCodes)/sizeof(ghSimStatistics.lErrorCodes[0])))
+		{
+			ghSimStatistics.lErrorCodes[chErrorCode]++;
+		}
+	}
+	
+	ghSimStatistics.lUartBytes += nTxCount;
+	fnSimAdvanceTime(nTxCount * SIM_UART_BYTE_TIME);
+	
+	gchTxCompleteFlag = SET_FLAG;
+	return;
+}
+
+uint16_t fnUartReceiveData(void)
+{
+	return RESET_VALUE;			//No reception on simulated UART
+}
+
+void fnUartSetTx(void)
+{
+	return;
+}
+
+void fnUartSetRx(void)
+{
+	return;
+}
+
+int8_t fnUartSendComplete(void)
+{
+	if(gchTxCompleteFlag)
+	{
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ S P I   (mc_spi.c) ____________________________________________________________________
+
+void fnResetSpiResources(void)
+{
+	fnSimCancelEvent(SIM_EVENT_RADIO_SPI_COMPLETE);
+	ghRadioSpiQueue.chState = RADIO_SPI_QUEUE_IDLE;
+	ghRadioSpiQueue.chCount = RESET_COUNTER;
+	return;
+}
+
+void fnSpiInitialization(void)
+{
+	uint8_t chChannel = RESET_COUNTER;
+	
+	ghRadioSpiCommData.nCommCount = RESET_COUNTER;
+	ghRadioSpiQueue.chCount = RESET_COUNTER;
+	ghRadioSpiQueue.chState = RADIO_SPI_QUEUE_IDLE;
+	
+	for(chChannel = RESET_COUNTER; chChannel < SMART_SENSOR_SPI_CHANNELS; chChannel++)
+	{
+		ghSmartSensorSpiQueue[chChannel].chCount = RESET_COUNTER;
+	}
+	
+	return;
+}
+
+//_____ fnSpiRadioSendReceiveData ____________________________________________________________________
+//
+// @brief	Transaction is performed with the CC1125 model and CPU time of address and data bytes is consumed
+// @return	FALSE	If chip does not respond (not powered or in reset)
+
+int8_t fnSpiRadioSendReceiveData(void)
+{
+	uint16_t nCount = RESET_COUNTER;
+	uint16_t nBytes = RESET_COUNTER;
+	uint8_t  chStatusByte = RESET_VALUE;
+	
+	if(ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if(ghRadioSpiCommData.chCommOperation == RADIO_TRANSMIT_BYTES || ghRadioSpiCommData.chCommOperation == RADIO_RECEIVE_BYTES)
+	{
+		nCount = ghRadioSpiCommData.nCommCount;
+	}
+	
+	if(fnSimRadioSpiAccess(ghRadioSpiCommData.nCommAddress,ghRadioSpiCommData.chCommType,ghRadioSpiCommData.pchCommBuff,nCount,&chStatusByte) == RETURN_FALSE)
+	{
+		fnSimAdvanceTime(SIM_RADIO_READY_TIME_OUT);
+		return RETURN_FALSE;
+	}
+	
+	//Address byte, extended address byte and data bytes
+	nBytes = 1 + (((ghRadioSpiCommData.nCommAddress >> BIT_8_bp) == CC1125_EXT_ADDR_BM) ? 1 : 0) + nCount;
+	
+	ghRadioSpiCommData.chStatusByte = chStatusByte;
+	ghSimStatistics.lRadioSpiTransactions++;
+	ghSimStatistics.lRadioSpiBytes += nBytes;
+	fnSimAdvanceTime(nBytes * SIM_RADIO_SPI_BYTE_TIME);
+	
+	return RETURN_TRUE;
+}
+
+int8_t fnSpiRadioQueueAdd(uint8_t chCommType,uint16_t nCommAddress,uint8_t chCommCount,uint8_t *pchCommBuff)
+{
+	volatile RADIO_SPI_DESCRIPTOR *phDescriptor = NULL;
+	
+	if((ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING) || (ghRadioSpiQueue.chCount >= RADIO_SPI_QUEUE_SIZE))
+	{
+		return RETURN_FALSE;
+	}
+	
+	phDescriptor = &ghRadioSpiQueue.hDescriptor[ghRadioSpiQueue.chCount++];
+	phDescriptor->chCommType	= chCommType;
+	phDescriptor->nCommAddress	= nCommAddress;
+	phDescriptor->chCommCount	= (chCommType == RADIO_COMMAND_STROBE) ? RESET_COUNTER : chCommCount;
+	phDescriptor->pchCommBuff	= pchCommBuff;
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSpiRadioQueueStart ____________________________________________________________________
+//
+// @brief	Queue is executed by SIM_EVENT_RADIO_SPI_COMPLETE after bus time of all the bytes.
+//			CPU time of SPIC_INT_vect is consumed up front as it steals the same cycles from the task which is executed meanwhile.
+// @return	FALSE if queue is empty or running
+
+int8_t fnSpiRadioQueueStart(void)
+{
+	uint8_t  chIndex = RESET_COUNTER;
+	uint32_t lBytes = RESET_COUNTER;
+	
+	if((ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING) || (ghRadioSpiQueue.chCount == RESET_COUNTER))
+	{
+		return RETURN_FALSE;
+	}
+	
+	for(chIndex = RESET_COUNTER; chIndex < ghRadioSpiQueue.chCount; chIndex++)
+	{
+		lBytes += 1 + (((ghRadioSpiQueue.hDescriptor[chIndex].nCommAddress >> BIT_8_bp) == CC1125_EXT_ADDR_BM) ? 1 : 0) + ghRadioSpiQueue.hDescriptor[chIndex].chCommCount;
+	}
+	
+	ghRadioSpiQueue.chResult = (uint8_t)RETURN_FALSE;
+	ghRadioSpiQueue.chState = RADIO_SPI_QUEUE_RUNNING;
+	ghSimStatistics.lRadioSpiQueues++;
+	ghSimStatistics.lRadioSpiQueuedBytes += lBytes;
+	ghSimStatistics.lRadioSpiBytes += lBytes;
+	
+	fnSimScheduleEvent(SIM_EVENT_RADIO_SPI_COMPLETE,lBytes * SIM_RADIO_SPI_BYTE_TIME);
+	fnSimAdvanceTime(lBytes * SIM_RADIO_SPI_ISR_TIME);
+	return RETURN_TRUE;
+}
+
+int8_t fnSpiRadioQueueStatus(void)
+{
+	if(ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING)
+	{
+		return RADIO_SPI_QUEUE_BUSY;
+	}
+	else if(ghRadioSpiQueue.chResult == RETURN_TRUE)
+	{
+		return RADIO_SPI_QUEUE_COMPLETE;
+	}
+	
+	return RADIO_SPI_QUEUE_ERROR;
+}
+
+int8_t fnSpiSmartSensorQueueAdd(uint8_t chChannel,uint8_t chCommType,uint8_t chSelectCode,uint8_t *pchBuff,uint8_t chLength)
+{
+	SMART_SENSOR_SPI_DESCRIPTOR *phDescriptor = NULL;
+	
+	if((chChannel >= SMART_SENSOR_SPI_CHANNELS) || (ghSmartSensorSpiQueue[chChannel].chCount >= SMART_SENSOR_SPI_QUEUE_SIZE) ||
+	   (pchBuff == NULL) || (chLength == RESET_VALUE))
+	{
+		return RETURN_FALSE;
+	}
+	
+	phDescriptor = &ghSmartSensorSpiQueue[chChannel].hDescriptor[ghSmartSensorSpiQueue[chChannel].chCount++];
+	phDescriptor->chCommType	= chCommType;
+	phDescriptor->chSelectCode	= chSelectCode;
+	phDescriptor->chLength		= chLength;
+	phDescriptor->pchBuff		= pchBuff;
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSpiSmartSensorQueueRun ____________________________________________________________________
+//
+// @brief	Frames are exchanged with Smart Sensor model of their group, dummy bytes are sent while measurements are shifted in
+//			and received bytes of sent frames are discarded.
+//			Groups shift in parallel so CPU is busy for bus time of the group with most bytes.
+// @return	Bit mask (SMART_SENSOR_CHANNEL_BM) of groups whose frames are complete
+
+uint8_t fnSpiSmartSensorQueueRun(void)
+{
+	SMART_SENSOR_SPI_QUEUE *phQueue = NULL;
+	SMART_SENSOR_SPI_DESCRIPTOR *phDescriptor = NULL;
+	uint16_t nBytes = RESET_COUNTER;
+	uint16_t nLongestGroup = RESET_COUNTER;
+	uint8_t  chChannel = RESET_COUNTER;
+	uint8_t  chIndex = RESET_COUNTER;
+	uint8_t  chComplete = RESET_VALUE;
+	
+	for(chChannel = RESET_COUNTER; chChannel < SMART_SENSOR_SPI_CHANNELS; chChannel++)
+	{
+		phQueue = &ghSmartSensorSpiQueue[chChannel];
+		nBytes = RESET_COUNTER;
+		
+		for(chIndex = RESET_COUNTER; chIndex < phQueue->chCount; chIndex++)
+		{
+			phDescriptor = &phQueue->hDescriptor[chIndex];
+			
+			if(phDescriptor->chCommType == SMART_SENSOR_SPI_TRANSMIT)
+			{
+				fnSimSmartSensorTransfer(chChannel,phDescriptor->chSelectCode,phDescriptor->pchBuff,NULL,phDescriptor->chLength);
+			}
+			else
+			{
+				memset(phDescriptor->pchBuff,SMART_SENSOR_SPI_DUMMY_BYTE,phDescriptor->chLength);
+				fnSimSmartSensorTransfer(chChannel,phDescriptor->chSelectCode,phDescriptor->pchBuff,phDescriptor->pchBuff,phDescriptor->chLength);
+			}
+			nBytes += phDescriptor->chLength;
+		}
+		
+		if(phQueue->chCount != RESET_COUNTER)
+		{
+			chComplete |= SMART_SENSOR_CHANNEL_BM(chChannel);
+		}
+		
+		phQueue->chCount = RESET_COUNTER;
+		nLongestGroup = (nBytes > nLongestGroup) ? nBytes : nLongestGroup;
+	}
+	
+	fnSimAdvanceTime(nLongestGroup * SIM_SMART_SENSOR_SPI_BYTE_TIME);
+	return chComplete;
+}
+
+//_____ fnSimSmartSensorSelectCode ____________________________________________________________________
+//
+// @brief	Select code driven on select lines of Smart Sensor group by fnSetResetSmartSensorSelectlines
+// @param	phPort		Port of select lines
+//			chS0		Pin of S0
+//			chS1		Pin of S1
+//			chS2		Pin of S2
+// @return	S2:S1:S0 (SMART_SENSOR_SELECT_Sx_bm)
+
+static uint8_t fnSimSmartSensorSelectCode(PORT_t *phPort,uint8_t chS0,uint8_t chS1,uint8_t chS2)
+{
+	uint8_t chSelectCode = RESET_VALUE;
+	
+	chSelectCode |= (phPort->OUT & chS0) ? SMART_SENSOR_SELECT_S0_bm : RESET_VALUE;
+	chSelectCode |= (phPort->OUT & chS1) ? SMART_SENSOR_SELECT_S1_bm : RESET_VALUE;
+	chSelectCode |= (phPort->OUT & chS2) ? SMART_SENSOR_SELECT_S2_bm : RESET_VALUE;
+	
+	return chSelectCode;
+}
+
+void fnSPID_SendReceiveOperation(uint8_t *pchBuff, uint8_t chLength)
+{
+	fnSimSmartSensorTransfer(SMART_SENSOR_SPID_GROUP,fnSimSmartSensorSelectCode(&PORTD,PD_SPID_S0,PD_SPID_S1,PD_SPID_S2),pchBuff,pchBuff,chLength);
+	fnSimAdvanceTime(chLength * SIM_SMART_SENSOR_SPI_BYTE_TIME);
+	return;
+}
+
+void fnSPIE_SendReceiveOperation(uint8_t *pchBuff, uint8_t chLength)
+{
+	fnSimSmartSensorTransfer(SMART_SENSOR_SPIE_GROUP,fnSimSmartSensorSelectCode(&PORTE,PE_SPIE_S0,PE_SPIE_S1,PE_SPIE_S2),pchBuff,pchBuff,chLength);
+	fnSimAdvanceTime(chLength * SIM_SMART_SENSOR_SPI_BYTE_TIME);
+	return;
+}
+
+void fnSPIF_SendReceiveOperation(uint8_t *pchBuff, uint8_t chLength)
+{
+	fnSimSmartSensorTransfer(SMART_SENSOR_SPIF_GROUP,fnSimSmartSensorSelectCode(&PORTJ,PJ_SPIF_S0,PJ_SPIF_S1,PJ_SPIF_S2),pchBuff,pchBuff,chLength);
+	fnSimAdvanceTime(chLength * SIM_SMART_SENSOR_SPI_BYTE_TIME);
+	return;
+}
+
+//_____ I 2 C   (mc_i2c.c) ____________________________________________________________________
+
+void fnI2cInitialization(void)
+{
+	gchAckError = RESET_FLAG;
+	return;
+}
+
+void fnResetI2cResources(void)
+{
+	gchAckError = RESET_FLAG;
+	RELEASE_I2C_INTERFACE;
+	return;
+}
+
+int8_t fnCheckI2CStatus(void)
+{
+	if(gchI2cOccupiedFlag)
+	{
+		return RETURN_FALSE;
+	}
+	
+	return RETURN_TRUE;
+}
+
+int8_t fnI2cFreeForOperation(void)
+{
+	if(gchAckError == SET_FLAG)
+	{
+		return I2C_ERROR;
+	}
+	else if(ghI2cCommData.chCommComplete)
+	{
+		ghI2cCommData.chCommComplete = RESET_FLAG;
+		return I2C_OP_COMPLETE;
+	}
+	
+	return I2C_RUNNING;
+}
+
+//_____ fnI2cSendReceiveOperation ____________________________________________________________________
+//
+// @brief	Same parameter checks as target driver. Transaction is completed by SIM_EVENT_I2C_COMPLETE after bus time of all the bytes.
+// @return	FALSE if parameters are not within the boundary otherwise returns TRUE
+
+int8_t fnI2cSendReceiveOperation(uint8_t chI2cAddr,uint8_t chWriteCount, uint8_t chReadCount)
+{
+	SIM_TIME lBusTime = SIM_I2C_START_STOP_TIME;
+	
+	ghI2cCommData.chCommAddress=chI2cAddr;
+	ghI2cCommData.chCommReadCount=chReadCount;
+	ghI2cCommData.chCommWriteCount=chWriteCount;
+	
+	gchAckError = RESET_FLAG;
+	ghI2cCommData.chCommComplete = RESET_FLAG;
+	ghI2cCommData.chCommIndexCounter = RESET_COUNTER;
+	
+	if(chWriteCount>I2C_COMM_BUFFER_SIZE || chReadCount>I2C_COMM_BUFFER_SIZE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if(chWriteCount> RESET_COUNTER && chReadCount> RESET_COUNTER)
+	{
+		ghI2cCommData.chOperationMode=I2C_READ_WRITE_MODE;
+		lBusTime += SIM_I2C_START_STOP_TIME + ((2 + chWriteCount + chReadCount) * SIM_I2C_BYTE_TIME);
+	}
+	else if(chWriteCount > RESET_COUNTER)
+	{
+		ghI2cCommData.chOperationMode=I2C_WRITE_MODE;
+		lBusTime += (1 + chWriteCount) * SIM_I2C_BYTE_TIME;
+	}
+	else if(chReadCount > RESET_COUNTER)
+	{
+		ghI2cCommData.chOperationMode=I2C_READ_MODE;
+		lBusTime += (1 + chReadCount) * SIM_I2C_BYTE_TIME;
+	}
+	else
+	{
+		return RETURN_FALSE;
+	}
+	
+	fnSimScheduleEvent(SIM_EVENT_I2C_COMPLETE,lBusTime);
+	return RETURN_TRUE;
+}
+
+//_____ A D C   (mc_adc.c) ____________________________________________________________________
+
+void fnInitializeADC(void)
+{
+	fnResetAdcResources();
+	return;
+}
+
+void fnResetAdcResources(void)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	
+	for(chIndex = RESET_COUNTER; chIndex < MAX_SAHRED_RESOURCES_ON_ADC; chIndex++)
+	{
+		gchSimAdcState[chIndex] = SIM_ADC_IDLE;
+	}
+	
+	return;
+}
+
+//_____ fnADCStartConversion ____________________________________________________________________
+//
+// @brief	Starts conversion of ADC input if any of the 8 ADC channels (ADCA and ADCB) is free
+// @param	chSensorEntryIndex	Index of ADC input
+// @return	FALSE if all ADC channels are occupied
+
+int8_t fnADCStartConversion(uint8_t chSensorEntryIndex)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	uint8_t chOccupied = RESET_COUNTER;
+	
+	for(chIndex = RESET_COUNTER; chIndex < MAX_SAHRED_RESOURCES_ON_ADC; chIndex++)
+	{
+		if(gchSimAdcState[chIndex] != SIM_ADC_IDLE)
+		{
+			chOccupied++;
+		}
+	}
+	
+	if(chOccupied >= MAX_AVAILABLE_ADC_CHANNELS || chSensorEntryIndex >= MAX_SAHRED_RESOURCES_ON_ADC)
+	{
+		return RETURN_FALSE;
+	}
+	
+	gchSimAdcState[chSensorEntryIndex] = SIM_ADC_RUNNING;
+	fnSimScheduleEvent(SIM_EVENT_ADC_COMPLETE,SIM_ADC_CONVERSION_TIME);
+	return RETURN_TRUE;
+}
+
+//_____ fnADCFetchSampledData ____________________________________________________________________
+//
+// @brief	Returns the converted data and releases the ADC channel
+// @return	Sampled data if conversion is completed otherwise returns RETURN_ADC_DATA_COLLECTION_RUNNING
+//			RETURN_ADC_DATA_COLLECTION_MISMATCH if conversion was never started
+
+int16_t fnADCFetchSampledData(uint8_t chSensorEntryIndex)
+{
+	if(chSensorEntryIndex >= MAX_SAHRED_RESOURCES_ON_ADC || gchSimAdcState[chSensorEntryIndex] == SIM_ADC_IDLE)
+	{
+		return RETURN_ADC_DATA_COLLECTION_MISMATCH;
+	}
+	
+	if(gchSimAdcState[chSensorEntryIndex] == SIM_ADC_RUNNING)
+	{
+		return RETURN_ADC_DATA_COLLECTION_RUNNING;
+	}
+	
+	gchSimAdcState[chSensorEntryIndex] = SIM_ADC_IDLE;
+	return gnSimAdcResult[chSensorEntryIndex];
+}
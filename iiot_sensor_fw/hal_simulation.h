@@ -0,0 +1,515 @@
+/* -------------------------------------------------------------------------
+Filename: hal_simulation.h
+
+Job#: 20473
+Purpose: Host (PC) replacement of the AVR-XMEGA device headers. When firmware is compiled with HOST_SIMULATION defined,
+		 this file is included instead of <avr/io.h> and <avr/interrupt.h> so that the upper layers of SENSOR MC firmware
+		 (task manager, sample collection, sensor protocol) can be compiled and executed unchanged on a Linux machine.
+		 Peripheral drivers which talk to the silicon (mc_spi.c, mc_i2c.c, mc_adc.c, mc_timer.c, mc_uart.c) are replaced by
+		 hal_simulation.c and the external chips (CC1125, RFC Console, I2C sensors, ADC inputs) are modeled in hal_sim_devices.c.
+Date Created: 10/16/2026
+
+(NOTE: latest version is the top version)
+
+Author: Aalok Shah
+Changes: Smart Sensor entries in execution table of RFC Console (SIM_SMART_SENSORS), Smart Sensor model keeps configuration frame and returns measurement word
+
+Author: Aalok Shah
+Changes: Concurrent acquisition of Smart Sensor groups (fnSpiSmartSensorQueueAdd/Run) and its benchmark (SIM_SMART_SENSOR_BENCHMARK)
+
+Author: Aalok Shah
+Changes: FIFO threshold interrupts of CC1125 on PORTH INT1 (PORTH_INT1_vect), FIFO error and air time of RF link in simulation report,
+		 size of execution table sent by RFC Console (SIM_ET_SENSORS)
+
+Author: Aalok Shah
+Changes: Initialization of CC1125 (SRES till first strobe other than SCAL) replaces register setup in simulation report as cached calibration skips SCAL
+
+Author: Aalok Shah
+Changes: Register setup of CC1125 (SRES till first SCAL strobe) in simulation report
+
+Author: Aalok Shah
+Changes: Selective repeat of multi packet generations (SIM_DOWNLOAD_WINDOW) answered with bitmap ACK, download throughput in simulation report
+
+Author: Aalok Shah
+Changes: E2PROM write cycle (address is not acknowledged till it is over) and page roll over modeled, ACK polls not acknowledged in simulation report
+
+Author: Aalok Shah
+Changes: Link outage window (SIM_LINK_OUTAGE_START/TIME), packets replayed from store-and-forward log and E2PROM transactions in simulation report
+
+Author: Aalok Shah
+Changes: Bit packed encoding of data packet payload selected by SIM_PAYLOAD_ENCODING 2 and its unpacker
+
+Author: Aalok Shah
+Changes: Delta encoding of data packet payload in execution table of RFC Console (SIM_PAYLOAD_ENCODING) and its decoder
+
+Author: Aalok Shah
+Changes: Sensor samples delivered to RFC Console and sample bytes copied per delivered sample in simulation report
+
+Author: Aalok Shah
+Changes: Layout benchmark of sensor entries (hal_sim_benchmark.c, SIM_LAYOUT_BENCHMARK)
+
+Author: Aalok Shah
+Changes: Simulated interrupts post events of system_scheduler.c instead of setting gchNewInterrupt
+
+Author: Aalok Shah
+Changes: Cycle counter of task profiler (fnReadCycleCounter) and task profile in simulation report
+
+Author: Aalok Shah
+Changes: Discrete event engine (heap of pending events) replaces fixed quantum stepping of virtual clock
+
+Author: Aalok Shah
+Changes: Initial version
+
+Host Build:
+	gcc -std=gnu99 -fgnu89-inline -fcommon -DHOST_SIMULATION -o sensor_mc_sim
+		main.c system_init.c system_timing.c sample_collection.c sensor_protocol.c sensor_management.c
+		radio_communication.c mc_system.c mc_gpio.c hal_simulation.c hal_sim_devices.c hal_sim_benchmark.c system_profiler.c system_scheduler.c sample_log.c
+
+	Add -DTASK_PROFILER_ENABLE=1 to get the cost of every task of task manager in simulation report.
+	Add -DPHASE_ANALYZER_ENABLE=1 to get phase budget (overruns and maximum sustainable sample clock) as well.
+
+	Simulation is controlled by environment variables (all are optional):
+	SIM_RUN_TIME		Virtual time in seconds after which simulation terminates with report			(Default: 60)
+	SIM_QUIET			If set to 1 debug UART prints of firmware are not echoed on console				(Default: 0)
+	SIM_SAMPLE_CLOCK	Sample clock (Hz) sent by simulated RFC Console in execution table				(Default: 10)
+	SIM_RADIO_DIVISOR	Master radio clock divisor sent by simulated RFC Console in execution table		(Default: 10)
+	SIM_COMM_WAIT		Communication wait time (ms) sent by simulated RFC Console in execution table	(Default: 500)
+	SIM_PACKET_LOSS		Percentage of RF packets lost in the air (both directions)						(Default: 0)
+	SIM_SEED			Seed for the pseudo random generator used by simulated RF channel				(Default: 1)
+	SIM_PAYLOAD_ENCODING	Payload encoding of data packets selected by execution table					(Default: 0)
+							(0: raw, 1: delta, 2: bit packed)
+	SIM_DOWNLOAD_WINDOW	If set to 1 execution table selects selective repeat of multi packet generations	(Default: 0, stop-and-wait)
+							(Build with -DPACKET_LAST_DATA_BYTE_INDEX=14 to get generations of 3 packets)
+							(Build with -DPACKET_LAST_DATA_BYTE_INDEX=252 -DMAX_COMM_PACKET_SIZE=255 -DMAX_COMM_PACKET_COUNT=4
+							 to get packets longer than FIFO of CC1125)
+	SIM_ET_SENSORS		No of sensor entries in execution table, entries after the first 4 repeat them	(Default: 4, max 40)
+							(Execution table longer than 4 entries is longer than RX FIFO of CC1125 after 19 entries)
+	SIM_SMART_SENSORS	No of Smart Sensor entries added to execution table (IDs from 24, SPID1, SPIE1, SPIF1, SPID2, ...)	(Default: 0, max 8)
+	SIM_LINK_OUTAGE_START	Virtual time (seconds) at which RF link goes down (every packet is lost)		(Default: 0, no outage)
+	SIM_LINK_OUTAGE_TIME	Duration (seconds) of RF link outage											(Default: 0)
+	SIM_LAYOUT_BENCHMARK	No of passes of sensor entry layout benchmark, executed instead of firmware	(Default: 0, 1 uses 200000 passes)
+							(Build with -O2 to compare the layouts the way target compiler sees them)
+	SIM_SMART_SENSOR_BENCHMARK	Bytes per frame of Smart Sensor acquisition benchmark, executed instead of firmware	(Default: 0, max 64)
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+Note: See document 000xxxx for complete project requirements
+Input: None
+Output: None
+
+-----------------------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+#ifndef HAL_SIMULATION_H_
+#define HAL_SIMULATION_H_
+
+	//_____  I N C L U D E S ______________________________________________________________
+
+	#include <stdint.h>					// Fixed width integer types (provided by avr-libc on target)
+	#include <stdio.h>					// Console output of simulation
+	#include <stdlib.h>					// Environment and exit handling of simulation
+
+	//_____ M A C R O S ____________________________________________________________________
+
+	//Virtual time base of simulation (1 tick = 1 nano second)
+	#define SIM_NSEC_PER_USEC					1000ULL
+	#define SIM_NSEC_PER_MSEC					1000000ULL
+	#define SIM_NSEC_PER_SEC					1000000000ULL
+
+	//Virtual clock is moved from one pending peripheral event to the next one (discrete event engine of hal_simulation.c)
+
+	//CPU clock of SENSOR MC (32MHZ RC / 2) used to convert virtual time in cycles
+	#define SIM_CPU_CLOCK_HZ					16000000ULL
+
+	//Instruction level definitions replaced for host build (See mc_system.h for target versions)
+	#define _NOP								((void)0)
+	#define _SLEEP								fnSimSleep()
+	#define RESET_WDT							((void)0)
+
+	//Global interrupt control
+	#define sei()								(gchSimInterruptEnable = 1)
+	#define cli()								(gchSimInterruptEnable = 0)
+
+	//Interrupt routines become plain functions which simulation invokes when peripheral event occurs
+	#define ISR(vector)							void vector(void)
+
+	//Single register of 8 and 16 bits
+	typedef volatile uint8_t	register8_t;
+	typedef volatile uint16_t	register16_t;
+
+	//_____ R E G I S T E R   S T R U C T U R E S __________________________________________
+	//Only registers accessed by the firmware files compiled for host are modeled here
+
+	//I/O Ports
+	typedef struct
+	{
+		register8_t DIR;
+		register8_t DIRSET;
+		register8_t DIRCLR;
+		register8_t DIRTGL;
+		register8_t OUT;
+		register8_t OUTSET;
+		register8_t OUTCLR;
+		register8_t OUTTGL;
+		register8_t IN;
+		register8_t INTCTRL;
+		register8_t INT0MASK;
+		register8_t INT1MASK;
+		register8_t INTFLAGS;
+		register8_t REMAP;
+		register8_t PIN0CTRL;
+		register8_t PIN1CTRL;
+		register8_t PIN2CTRL;
+		register8_t PIN3CTRL;
+		register8_t PIN4CTRL;
+		register8_t PIN5CTRL;
+		register8_t PIN6CTRL;
+		register8_t PIN7CTRL;
+	}PORT_t;
+
+	//Real Time Counter
+	typedef struct
+	{
+		register8_t  CTRL;
+		register8_t  STATUS;
+		register8_t  INTCTRL;
+		register8_t  INTFLAGS;
+		register8_t  TEMP;
+		register16_t CNT;
+		register16_t PER;
+		register16_t COMP;
+	}RTC_t;
+
+	//Oscillator
+	typedef struct
+	{
+		register8_t CTRL;
+		register8_t STATUS;
+	}OSC_t;
+
+	//Clock System
+	typedef struct
+	{
+		register8_t CTRL;
+		register8_t PSCTRL;
+		register8_t LOCK;
+		register8_t RTCCTRL;
+	}CLK_t;
+
+	//Watchdog Timer
+	typedef struct
+	{
+		register8_t CTRL;
+		register8_t WINCTRL;
+		register8_t STATUS;
+	}WDT_t;
+
+	//Sleep Controller
+	typedef struct
+	{
+		register8_t CTRL;
+	}SLEEP_t;
+
+	//Programmable Multi-level Interrupt Controller
+	typedef struct
+	{
+		register8_t STATUS;
+		register8_t INTPRI;
+		register8_t CTRL;
+	}PMIC_t;
+
+	//Reset Controller
+	typedef struct
+	{
+		register8_t STATUS;
+		register8_t CTRL;
+	}RST_t;
+
+	//_____ R E G I S T E R   B I T   D E F I N I T I O N S __________________________________
+	//Values are same as the one available in device header of ATXMEGA128A1U
+
+	#define CCP_IOREG_gc						0xD8
+
+	#define OSC_RC32MEN_bm						0x02
+	#define OSC_RC32MRDY_bm						0x02
+
+	#define CLK_SCLKSEL_RC32M_gc				0x01
+	#define CLK_PSADIV0_bm						0x04
+	#define CLK_RTCSRC_ULP_gc					0x00
+	#define CLK_RTCEN_bm						0x01
+
+	#define WDT_ENABLE_bm						0x02
+	#define WDT_CEN_bm							0x01
+	#define WDT_PER_4KCLK_gc					0x24
+	#define WDT_SYNCBUSY_bm						0x01
+
+	#define PMIC_LOLVLEN_bm						0x01
+	#define PMIC_MEDLVLEN_bm					0x02
+	#define PMIC_HILVLEN_bm						0x04
+
+	#define SLEEP_SEN_bm						0x01
+	#define SLEEP_SMODE_gm						0x0E
+	#define SLEEP_SMODE_IDLE_gc					0x00
+	#define SLEEP_SMODE_PDOWN_gc				0x04
+	#define SLEEP_SMODE_PSAVE_gc				0x06
+
+	#define RTC_PRESCALER_OFF_gc				0x00
+	#define RTC_PRESCALER_DIV1_gc				0x01
+	#define RTC_OVFINTLVL0_bm					0x01
+	#define RTC_OVFINTLVL_OFF_gc				0x00
+
+	#define PORT_OPC_PULLUP_gc					0x18
+	#define PORT_OPC_WIREDAND_gc				0x28
+	#define PORT_ISC_FALLING_gc					0x02
+	#define PORT_INT0LVL_LO_gc					0x01
+	#define PORT_INT1LVL_LO_gc					0x04
+	#define PORT_INT0IF_bm						0x01
+	#define PORT_INT1IF_bm						0x02
+
+	//_____ R E G I S T E R   I N S T A N C E S ____________________________________________
+
+	#define PORTA								ghSimPortA
+	#define PORTB								ghSimPortB
+	#define PORTC								ghSimPortC
+	#define PORTD								ghSimPortD
+	#define PORTE								ghSimPortE
+	#define PORTF								ghSimPortF
+	#define PORTH								ghSimPortH
+	#define PORTJ								ghSimPortJ
+	#define PORTK								ghSimPortK
+	#define PORTQ								ghSimPortQ
+	#define PORTR								ghSimPortR
+	#define RTC									ghSimRtc
+	#define OSC									ghSimOsc
+	#define CLK									ghSimClk
+	#define WDT									ghSimWdt
+	#define SLEEP								ghSimSleep
+	#define PMIC								ghSimPmic
+	#define RST									ghSimRst
+	#define CCP									gchSimCcp
+
+	//_____ E N U M E R A T I O N S ____________________________________________________________________
+
+	//Timed events which can be raised by simulated peripherals and external devices
+	typedef enum
+	{
+		SIM_EVENT_RTC_OVERFLOW=0,			// RTC: Counter overflow (phase clock of task manager)
+		SIM_EVENT_COMM_TIMER,				// TCC1 overflow: Communication wait timer
+		SIM_EVENT_VOL_STABLE_TIMER,			// TCE1 overflow: Voltage stabilization timer
+		SIM_EVENT_I2C_COMPLETE,				// TWIF: Completion of I2C transaction
+		SIM_EVENT_ADC_COMPLETE,				// ADCA/ADCB: Completion of conversion
+		SIM_EVENT_RADIO_SPI_COMPLETE,		// SPIC: Last byte of queued CC1125 transactions shifted
+		SIM_EVENT_RADIO_CALIBRATION,		// CC1125: Frequency synthesizer calibration complete
+		SIM_EVENT_RADIO_TX_FIFO_THR,		// CC1125: TX FIFO drained below threshold (GPIO2)
+		SIM_EVENT_RADIO_RX_FIFO_THR,		// CC1125: RX FIFO filled above threshold (GPIO3)
+		SIM_EVENT_RADIO_TX_END,				// CC1125: Last bit of packet sent over air
+		SIM_EVENT_RADIO_RX_END,				// CC1125: Last bit of packet received from air
+		SIM_EVENT_RFC_REPLY,				// RFC Console: Start of reply transmission
+		SIM_TOTAL_EVENTS
+	}SIM_EVENT_ID;
+
+	//Sleep modes for which residency is accounted
+	typedef enum
+	{
+		SIM_MODE_ACTIVE=0,
+		SIM_MODE_IDLE,
+		SIM_MODE_POWER_SAVE,
+		SIM_MODE_POWER_DOWN,
+		SIM_TOTAL_MODES
+	}SIM_POWER_MODE;
+
+	//_____ S T R U C T U R E S ____________________________________________________________
+
+	//Virtual time in nano seconds
+	typedef uint64_t SIM_TIME;
+
+	//Run time configuration of simulation
+	typedef struct
+	{
+		SIM_TIME lRunTime;					//Virtual time after which simulation terminates
+		uint8_t  chQuiet;					//Suppress console echo of debug UART
+		uint8_t  chPacketLossPercent;		//Air loss applied on every RF packet
+		uint16_t nSampleClock;				//Execution table: Sample clock
+		uint16_t nRadioDivisor;				//Execution table: Radio clock divisor
+		uint16_t nCommWaitTime;				//Execution table: Communication wait time
+		uint8_t  chPayloadEncoding;			//Execution table: Payload encoding of data packets (PAYLOAD_ENCODING_RAW/DELTA/PACKED)
+		uint8_t  chDownloadWindow;			//Execution table: Selective repeat of multi packet generations
+		uint8_t  chSensorEntries;			//Execution table: No of sensor entries
+		uint8_t  chSmartSensors;			//Execution table: No of Smart Sensor entries
+		SIM_TIME lOutageStart;				//Start of link outage window (Every RF packet is lost in the window)
+		SIM_TIME lOutageEnd;				//End of link outage window
+		uint32_t lSeed;						//Seed for pseudo random generator
+		uint32_t lLayoutBenchmarkPasses;	//Passes of sensor entry layout benchmark (0: firmware is executed)
+		uint8_t  chSmartSensorBenchmark;	//Bytes per frame of Smart Sensor acquisition benchmark (0: firmware is executed)
+	}SIM_CONFIGURATION;
+
+	//Counters collected during simulation and printed with the final report
+	typedef struct
+	{
+		SIM_TIME lModeResidency[SIM_TOTAL_MODES];		//Time spent in each power mode
+		uint64_t lEventsProcessed;						//Events executed by discrete event engine
+		SIM_TIME lMaxInterruptLatency;					//Longest time an event of MCU peripheral waited for interrupts to get enabled
+		uint32_t lRtcOverflows;							//RTC phase interrupts
+		uint32_t lRadioSpiTransactions;					//SPI transactions with CC1125
+		uint32_t lRadioSpiBytes;						//Bytes exchanged over SPI with CC1125
+		uint32_t lRadioSpiQueues;						//Descriptor queues executed by SPIC interrupt
+		uint32_t lRadioSpiQueuedBytes;					//Bytes of descriptor queues (Shifted while CPU is free)
+		uint32_t lRadioInits;							//Initializations of CC1125 (SRES strobe till chip is used)
+		uint32_t lRadioInitTransactions;				//SPI transactions of initializations
+		SIM_TIME lRadioInitTime;						//Time of initializations
+		uint32_t lRadioPacketsSent;						//Packets sent over air by CC1125
+		uint32_t lRadioPacketsReceived;					//Packets received by CC1125
+		uint32_t lRadioPacketsLost;						//Packets dropped by simulated RF channel
+		uint32_t lRadioFifoThresholds;					//FIFO threshold interrupts of CC1125 (Packets longer than FIFO)
+		uint32_t lRadioFifoErrors;						//TX FIFO underflow and RX FIFO overflow of CC1125
+		SIM_TIME lRadioAirTime;							//Time CC1125 spent sending and receiving packets over air
+		uint32_t lDataPacketsAcked;						//Data packets acknowledged by RFC Console (Packet sent again after lost ACK is counted once)
+		uint32_t lDataBytesDelivered;					//Payload bytes of data packets acknowledged by RFC Console
+		uint32_t lDataSamplesDelivered;					//Sensor samples decoded from data packets acknowledged by RFC Console
+		uint32_t lDataSamplesUndecodable;				//Delta encoded samples received without key entry of their epoch or bit packed samples cut or of unknown Sensor ID
+		uint32_t lBitmapAcksSent;						//Bitmap ACKs sent by RFC Console for bursts of selective repeat
+		uint32_t lDataPacketsReplayed;					//Data packets replayed from store-and-forward log and acknowledged by RFC Console (Counted once per record)
+		uint32_t lDataSamplesReplayed;					//Sensor samples decoded from replayed data packets
+		uint32_t lExecutionTablesSent;					//Execution tables sent by RFC Console
+		uint32_t lSmartSensorConfigFrames;				//Configuration frames received by Smart Sensors
+		uint32_t lSmartSensorFetches;					//Measurements fetched from configured Smart Sensors
+		uint32_t lI2cTransactions;						//I2C transactions
+		uint32_t lE2promWrites;							//Write transactions of E2PROM
+		uint32_t lE2promWriteBytes;						//Data bytes written in E2PROM
+		uint32_t lE2promReads;							//Read transactions of E2PROM
+		uint32_t lE2promBusyNacks;						//Transactions not acknowledged by E2PROM in write cycle (ACK polls)
+		uint32_t lAdcConversions;						//ADC conversions
+		uint32_t lUartBytes;							//Bytes sent over debug UART
+		uint32_t lErrorCodes[64];						//Error codes reported over debug UART
+	}SIM_STATISTICS;
+
+	//_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
+
+	extern PORT_t		ghSimPortA, ghSimPortB, ghSimPortC, ghSimPortD, ghSimPortE, ghSimPortF;
+	extern PORT_t		ghSimPortH, ghSimPortJ, ghSimPortK, ghSimPortQ, ghSimPortR;
+	extern RTC_t		ghSimRtc;
+	extern OSC_t		ghSimOsc;
+	extern CLK_t		ghSimClk;
+	extern WDT_t		ghSimWdt;
+	extern SLEEP_t		ghSimSleep;
+	extern PMIC_t		ghSimPmic;
+	extern RST_t		ghSimRst;
+	extern register8_t	gchSimCcp;
+
+	//Global interrupt enable (I-bit of SREG)
+	extern volatile uint8_t		gchSimInterruptEnable;
+
+	//Run time configuration and statistics of simulation
+	extern SIM_CONFIGURATION	ghSimConfig;
+	extern SIM_STATISTICS		ghSimStatistics;
+
+	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
+
+	//_____ Interrupt routines available in firmware compiled for host ______________________________
+	void RTC_OVF_vect(void);
+	void PORTH_INT0_vect(void);
+	void PORTH_INT1_vect(void);
+
+	//_____ fnSimGetTime ____________________________________________________________________
+	//
+	// @brief	Current value of virtual clock
+	// @return	Virtual time in nano seconds elapsed since power on
+
+	SIM_TIME fnSimGetTime(void);
+
+	//_____ fnSimAdvanceTime ____________________________________________________________________
+	//
+	// @brief	Moves the virtual clock ahead for the time spent by CPU in blocking operations (wait loops, SPI, UART)
+	//			All the peripheral events falling in between are executed along with their interrupt routines
+	// @param	lDuration	Time in nano seconds for which CPU is busy
+
+	void fnSimAdvanceTime(SIM_TIME lDuration);
+
+	//_____ fnSimSleep ____________________________________________________________________
+	//
+	// @brief	Replacement of SLEEP instruction. Virtual clock keeps running till any interrupt occurs.
+	//			Sleep mode selected in SLEEP.CTRL is used to account the power mode residency.
+
+	void fnSimSleep(void);
+
+	//_____ fnSimScheduleEvent ____________________________________________________________________
+	//
+	// @brief	Raise the event after specified duration. Scheduling the same event again will overwrite the previous time.
+	// @param	chEventId	Event from SIM_EVENT_ID
+	//			lDelay		Time in nano seconds after which event needs to be raised
+
+	void fnSimScheduleEvent(uint8_t chEventId,SIM_TIME lDelay);
+
+	//_____ fnSimCancelEvent ____________________________________________________________________
+	//
+	// @brief	Cancel the pending event
+	// @param	chEventId	Event from SIM_EVENT_ID
+
+	void fnSimCancelEvent(uint8_t chEventId);
+
+	//_____ fnSimPortHFallingEdge ____________________________________________________________________
+	//
+	// @brief	Falling edge on PORTH pin driven by external device. PORTH_INT0_vect is executed by discrete event engine if pin is configured for interrupt.
+	// @param	chPinMask	Bit mask of the pin
+
+	void fnSimPortHFallingEdge(uint8_t chPinMask);
+
+	//_____ fnSimRandom ____________________________________________________________________
+	//
+	// @brief	Pseudo random generator (xorshift) with the seed available in configuration to keep runs repeatable
+	// @return	Random value in range of 0 to 99
+
+	uint8_t fnSimRandom(void);
+
+	//_____ fnSimLayoutBenchmark ____________________________________________________________________
+	//
+	// @brief	Compares per clock scans of sensor entries on legacy and current layout (hal_sim_benchmark.c)
+	// @param	lPasses		No of passes of every scan
+
+	void fnSimLayoutBenchmark(uint32_t lPasses);
+
+	//_____ fnSimSmartSensorBenchmark ____________________________________________________________________
+	//
+	// @brief	Compares virtual time of fetching all the Smart Sensors one at a time and all the groups at once (hal_sim_benchmark.c)
+	// @param	chFrameLength	Bytes fetched from every Smart Sensor
+
+	void fnSimSmartSensorBenchmark(uint8_t chFrameLength);
+
+#endif /* HAL_SIMULATION_H_ */
@@ -80,6 +80,13 @@ Some of the major points are listed below which help to understand this firmware
 		On every interrupt it will notify one or another task to perform their execution so it can be considered as base for all the task.
 		In firmware this unit is implemented under the name of System Timing task in system_timing.c.
 	
+	Event Scheduling:
+		Interrupt routines post typed events (ADC, I2C, CC1125 GPIO, timers) into the event ring of system_scheduler.c.
+		Task manager executes an active task only when an event subscribed by it is collected (gchTasks_Ready), task is just activated or other task is completed.
+		Task which moves its state machine without starting any hardware operation wakes itself with WAKE_TASKS.
+		Only the highest priority ready task (lower bit in gchTasks_Active) is executed in one pass so Data Sampling is never delayed by more than one task step.
+		Data Download and ET Request tasks give way to higher priority tasks at preemption points of radio handler (fnHigherPriorityTaskReady).
+	
 	Power Saving System:
 		During execution of task manager firmware is designed to spend as much time as possible in task manager. 
 		Firmware is using all the XMEGA supported power saving modes in this design.
@@ -145,72 +152,91 @@ int main()
 	//Main loop of full flange SENSOR MC firmware
 	while(1)
 	{
-		gchNewInterrupt = SET_NEW_ISR_FLAG;							//Set new interrupt flag
+		fnCollectSystemEvents();									//Make the tasks subscribed to posted events ready
 
-		//Exit the execution of task list only when: Any enabled task is still active (not done) and There were no new interrupts on last pass through task list
-		while (((gchTasks_Enable & gchTasks_Active) != ALL_TASK_DONE) && (gchNewInterrupt == SET_NEW_ISR_FLAG))
+		//Exit the execution of task list only when: No enabled and active task is ready (no event is pending for it)
+		//Task list is ordered by priority, every pass executes only the first ready task
+		while ((gchTasks_Enable & gchTasks_Active & gchTasks_Ready) != ALL_TASK_DONE)
 		{
-			gchNewInterrupt = CLEAR_NEW_ISR_FLAG;						//Clear new interrupt flag
-
 			// Data Sampling Task
-			if (gchTasks_Active & DATA_SAMPLING_TASK)
+			if (gchTasks_Active & gchTasks_Ready & DATA_SAMPLING_TASK)
 			{
+				gchTasks_Ready &= ~DATA_SAMPLING_TASK;					//Consume the events of task
+				
 				//If task is executing and returns TRUE it means task is done with the operations otherwise it is blocking (waiting for something)
-				if (RETURN_TRUE==fnData_Sampling_Task())
+				if (RETURN_TRUE==PROFILE_TASK(DATA_SAMPLING_TASK,fnData_Sampling_Task))
 				{
 					gchTasks_Active &= ~DATA_SAMPLING_TASK;					//Set Done bit
+					WAKE_TASKS(gchTasks_Active);				//Completion of task can unblock rest of the active tasks
 				}
 			}
 
 			// Data Collection Task
-			if (gchTasks_Active & DATA_COLLECTION_TASK)
+			else if (gchTasks_Active & gchTasks_Ready & DATA_COLLECTION_TASK)
 			{
+				gchTasks_Ready &= ~DATA_COLLECTION_TASK;					//Consume the events of task
+				
 				//If task is executing and returns TRUE it means task is done with the operations otherwise it is blocking (waiting for something)
-				if (RETURN_TRUE==fnData_Collection_Task())
+				if (RETURN_TRUE==PROFILE_TASK(DATA_COLLECTION_TASK,fnData_Collection_Task))
 				{
 					gchTasks_Active &= ~DATA_COLLECTION_TASK;			//Set Done bit
+					WAKE_TASKS(gchTasks_Active);				//Completion of task can unblock rest of the active tasks
 				}
 			}
 			
 			// Data Download Task
-			if (gchTasks_Active & DATA_DOWNLOAD_TASK)
+			else if (gchTasks_Active & gchTasks_Ready & DATA_DOWNLOAD_TASK)
 			{
+				gchTasks_Ready &= ~DATA_DOWNLOAD_TASK;					//Consume the events of task
+				
 				//If task is executing and returns TRUE it means task is done with the operations otherwise it is blocking (waiting for something)
-				if (RETURN_TRUE==fnData_Download_Task())
+				if (RETURN_TRUE==PROFILE_TASK(DATA_DOWNLOAD_TASK,fnData_Download_Task))
 				{
 					gchTasks_Active &= ~DATA_DOWNLOAD_TASK;			//Set Done bit
+					WAKE_TASKS(gchTasks_Active);				//Completion of task can unblock rest of the active tasks
 				}
 			}
 			
 			// Execution Table Request Task
-			if (gchTasks_Active & EXECUTION_TABLE_REQ_TASK)
+			else if (gchTasks_Active & gchTasks_Ready & EXECUTION_TABLE_REQ_TASK)
 			{
+				gchTasks_Ready &= ~EXECUTION_TABLE_REQ_TASK;					//Consume the events of task
+				
 				//If task is executing and returns TRUE it means task is done with the operations otherwise it is blocking (waiting for something)
-				if (RETURN_TRUE == fnData_ET_Request_Task())
+				if (RETURN_TRUE == PROFILE_TASK(EXECUTION_TABLE_REQ_TASK,fnData_ET_Request_Task))
 				{
 					gchTasks_Active &= ~EXECUTION_TABLE_REQ_TASK;			//Set Done bit
+					WAKE_TASKS(gchTasks_Active);				//Completion of task can unblock rest of the active tasks
 				}
 			}
 
 			// Debug Serial Communication Task
-			if (gchTasks_Active & DEBUG_SERIAL_TASK)
+			else if (gchTasks_Active & gchTasks_Ready & DEBUG_SERIAL_TASK)
 			{
+				gchTasks_Ready &= ~DEBUG_SERIAL_TASK;					//Consume the events of task
+				
 				//If task is executing and returns TRUE it means task is done with the operations otherwise it is blocking (waiting for something)
-				if (RETURN_TRUE == fnDebug_Serial_Task())
+				if (RETURN_TRUE == PROFILE_TASK(DEBUG_SERIAL_TASK,fnDebug_Serial_Task))
 				{
 					gchTasks_Active &= ~DEBUG_SERIAL_TASK;			//Set Done bit
+					WAKE_TASKS(gchTasks_Active);				//Completion of task can unblock rest of the active tasks
 				}
 			}
 
 			// Watch Dog Timer Task
-			if (gchTasks_Active & WATCHDOG_MANAGEMENT_TASK)
+			else if (gchTasks_Active & gchTasks_Ready & WATCHDOG_MANAGEMENT_TASK)
 			{
+				gchTasks_Ready &= ~WATCHDOG_MANAGEMENT_TASK;					//Consume the events of task
+				
 				//If task is executing and returns TRUE it means task is done with the operations otherwise it is blocking (waiting for something)
-				if (RETURN_TRUE==fnWatch_Dog_Manage_Task())
+				if (RETURN_TRUE==PROFILE_TASK(WATCHDOG_MANAGEMENT_TASK,fnWatch_Dog_Manage_Task))
 				{
 					gchTasks_Active &= ~WATCHDOG_MANAGEMENT_TASK;			//Set Done bit
+					WAKE_TASKS(gchTasks_Active);				//Completion of task can unblock rest of the active tasks
 				}
 			}
+			
+			fnCollectSystemEvents();								//Events posted during this task, re-evaluate priorities
 		}  //End loop processing of active and unblocked tasks
 
 		//Disable interrupts to lock out New Interrupts
@@ -236,8 +262,8 @@ int main()
 			DISABLE_POWER_SAVING_SLEEP_MODE;		//Will wake up on RTC interrupt
 		}
 
-		//If no new interrupt just came in: Nap (Idle Power mode)
-		else if (gchNewInterrupt == CLEAR_NEW_ISR_FLAG)
+		//If no new event just came in: Nap (Idle Power mode)
+		else if (fnSystemEventPending() == RETURN_FALSE)
 		{
 			ENABLE_GLOBAL_INTERRUPTS;
 			ENABLE_IDLE_POWER_SLEEP_MODE;
@@ -245,7 +271,7 @@ int main()
 			DISABLE_IDLE_POWER_SLEEP_MODE;			//Will wake up on any interrupt
 		}
 		
-		//New interrupt crept in, repeat Task Loop
+		//New event crept in, repeat Task Loop
 		else
 		{
 			ENABLE_GLOBAL_INTERRUPTS;
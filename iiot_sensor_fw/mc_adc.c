@@ -360,8 +360,8 @@ int16_t fnADCFetchSampledData(uint8_t chSensorEntryIndex)
 
 ISR(ADCA_CH0_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH1);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH1);
 }
 
 //_____ I S R - A D C A : C H 1  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -370,8 +370,8 @@ ISR(ADCA_CH0_vect)
 
 ISR(ADCA_CH1_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH2);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH2);
 }
 
 //_____ I S R - A D C A : C H 2  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -380,8 +380,8 @@ ISR(ADCA_CH1_vect)
 
 ISR(ADCA_CH2_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH3);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH3);
 }
 
 //_____ I S R - A D C A : C H 3  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -390,8 +390,8 @@ ISR(ADCA_CH2_vect)
 
 ISR(ADCA_CH3_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH4);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH4);
 }
 
 //_____ I S R - A D C B : C H 0  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -400,8 +400,8 @@ ISR(ADCA_CH3_vect)
 
 ISR(ADCB_CH0_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH5);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH5);
 }
 
 //_____ I S R - A D C B : C H 1  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -410,8 +410,8 @@ ISR(ADCB_CH0_vect)
 
 ISR(ADCB_CH1_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH6);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH6);
 }
 
 //_____ I S R - A D C B : C H 2  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -420,8 +420,8 @@ ISR(ADCB_CH1_vect)
 
 ISR(ADCB_CH2_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH7);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH7);
 }
 
 //_____ I S R - A D C B : C H 3  C O N V E R S I O N   C O M P L E T E ____________________________________________________________________
@@ -430,8 +430,8 @@ ISR(ADCB_CH2_vect)
 
 ISR(ADCB_CH3_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchAdcOpeartingState &= ~(ADC_CH_CONVERSATION_RUNNING << ADC_VIRTUAL_CH8);
+	POST_SYSTEM_EVENT(EVENT_ADC_COMPLETE,ADC_VIRTUAL_CH8);
 }
 
 
@@ -10,6 +10,7 @@ fnInitializeGPIO		Perform initialization procedures on all the MCU pins for thei
 
 Interrupts:
 PORTH_INT0_vect			ISR for PORTH-PIN2 falling edge (Configured for CC1125-GPIO0: Transmit/Receive Complete Interrupt)
+PORTH_INT1_vect			ISR for PORTH-PIN4/PIN5 falling edge (Configured for CC1125-GPIO2/GPIO3: TX FIFO drained/RX FIFO filled up to threshold)
 
 
 Author: Aalok Shah
@@ -68,6 +69,10 @@ Test Results:
 //It needs to get reset from firmware.
 volatile uint8_t		gchDataCommFlagCC1125;
 
+//It will get set when CC1125-GPIO2/GPIO3 FIFO threshold interrupt arise (Packets longer than FIFO are streamed).
+//It needs to get reset from firmware.
+volatile uint8_t		gchFifoFlagCC1125;
+
 //_____ fnInitializeGPIO ____________________________________________________________________
 //
 // @brief	Function initialize all the port pins as per hardware requirement.
@@ -197,21 +202,27 @@ void fnInitializeGPIO(void)
 	//	1		EEPROM_E2_ADDR_BIT			OUTPUT-HIGH
 	//	2		CC1125_GPIO0				INPUT (Falling Edge Interrupt)
 	//	3		CC1125_GPIO1				INPUT
-	//	4		CC1125_GPIO2				INPUT
-	//	5		CC1125_GPIO3				INPUT
+	//	4		CC1125_GPIO2				INPUT (Falling Edge Interrupt)
+	//	5		CC1125_GPIO3				INPUT (Falling Edge Interrupt)
 	//	6		3V3_25MA_PWR				OUTPUT-LOW
 	//	7		RADIO_PWR_EN				OUTPUT-LOW
 	*****************************************************/
 	
-	SET_PINS_INPUT(PORTH,PH_CC1125_GPIO0);// | PH_CC1125_GPIO1 | PH_CC1125_GPIO2 | PH_CC1125_GPIO3);
+	SET_PINS_INPUT(PORTH,PH_CC1125_GPIO0 | PH_CC1125_GPIO2 | PH_CC1125_GPIO3);// | PH_CC1125_GPIO1);
 	SET_PINS_OUTPUT(PORTH,PH_EEPROM_WR_CONTROL | PH_EEPROM_E2_ADDR_BIT | PH_RADIO_PWR_EN | PH_3V3_25MA_PWR);
 	SET_PINS_HIGH(PORTH,PH_EEPROM_WR_CONTROL | PH_EEPROM_E2_ADDR_BIT);
 	SET_PINS_LOW(PORTH, PH_RADIO_PWR_EN  | PH_3V3_25MA_PWR);
 	
 	PORTH.INT0MASK = PH_CC1125_GPIO0;
 	PORTH.PIN2CTRL= PORT_ISC_FALLING_gc;	//Configure falling edge interrupt
-	PORTH.INTFLAGS |= PH_CC1125_GPIO0;		//Clear interrupt flag
-	PORTH.INTCTRL = PORT_INT0LVL_LO_gc;		//Configure interrupt for low level
+	PORTH.INTFLAGS = PORT_INT0IF_bm;		//Clear interrupt flag
+	
+	PORTH.INT1MASK = PH_CC1125_GPIO2 | PH_CC1125_GPIO3;
+	PORTH.PIN4CTRL= PORT_ISC_FALLING_gc;	//TXFIFO_THR: Falling edge when TX FIFO is drained below threshold
+	PORTH.PIN5CTRL= PORT_ISC_FALLING_gc;	//RXFIFO_THR (inverted): Falling edge when RX FIFO is filled above threshold
+	PORTH.INTFLAGS = PORT_INT1IF_bm;		//Clear interrupt flag
+	
+	PORTH.INTCTRL = PORT_INT0LVL_LO_gc | PORT_INT1LVL_LO_gc;		//Configure interrupts for low level
 
 	/****************************************************
 	//			PORT-J Pins
@@ -268,7 +279,20 @@ void fnInitializeGPIO(void)
 
 ISR(PORTH_INT0_vect)
 {
-	PORTH.INTFLAGS |= PH_CC1125_GPIO0;		//Reset Interrupt Flag
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
+	PORTH.INTFLAGS = PORT_INT0IF_bm;		//Reset Interrupt Flag
 	gchDataCommFlagCC1125=1;				//Flag to indicate the completion of transmit/receive operation in CC1125
+	POST_SYSTEM_EVENT(EVENT_RADIO_GPIO,RESET_VALUE);
+}
+
+//_____ I S R - P O R T H - F A L L I N G  E D G E   ( F I F O ) ____________________________________________________________________
+//
+// @brief	ISR for PORTH (PIN-4/PIN-5) Falling Edge:
+//			CC112x signals FIFO thresholds on GPIO2 (TX FIFO drained) and GPIO3 (RX FIFO filled) so packets longer than its 128 byte FIFO
+//			are refilled/drained while they are on air.
+
+ISR(PORTH_INT1_vect)
+{
+	PORTH.INTFLAGS = PORT_INT1IF_bm;		//Reset Interrupt Flag
+	gchFifoFlagCC1125=1;					//Flag to indicate FIFO threshold of CC1125
+	POST_SYSTEM_EVENT(EVENT_RADIO_FIFO_THRESHOLD,RESET_VALUE);
 }
\ No newline at end of file
@@ -6,6 +6,9 @@ Date Created: 10/08/2014
 
 (NOTE: latest version is the top version)
 
+Author: Aalok Shah
+Changes: CC1125 GPIO2/GPIO3 FIFO threshold interrupt on PORTH INT1 (gchFifoFlagCC1125)
+
 Author: Aalok Shah
 Changes: Initial version
 
@@ -167,8 +170,14 @@ Test Results:
 
 	#define SET_PINS_INPUT(PORT_VALUE,PIN_NOS)			PORT_VALUE.DIRCLR = PIN_NOS
 	#define SET_PINS_OUTPUT(PORT_VALUE,PIN_NOS)			PORT_VALUE.DIRSET = PIN_NOS
-	#define SET_PINS_HIGH(PORT_VALUE,PIN_NOS)			PORT_VALUE.OUTSET = PIN_NOS
-	#define SET_PINS_LOW(PORT_VALUE,PIN_NOS)			PORT_VALUE.OUTCLR = PIN_NOS
+	#ifdef HOST_SIMULATION
+		//Simulated port has no hardware behind OUTSET/OUTCLR so pin state is maintained directly in OUT
+		#define SET_PINS_HIGH(PORT_VALUE,PIN_NOS)		PORT_VALUE.OUT |= (PIN_NOS)
+		#define SET_PINS_LOW(PORT_VALUE,PIN_NOS)		PORT_VALUE.OUT &= ~(PIN_NOS)
+	#else
+		#define SET_PINS_HIGH(PORT_VALUE,PIN_NOS)		PORT_VALUE.OUTSET = PIN_NOS
+		#define SET_PINS_LOW(PORT_VALUE,PIN_NOS)		PORT_VALUE.OUTCLR = PIN_NOS
+	#endif
 	#define GET_PIN_VALUE(PORT_VALUE,PIN_NO)			(PORT_VALUE.IN & PIN_NO)
 
 	// General Purpose LEDs
@@ -247,6 +256,7 @@ Test Results:
 
 	//Declared in mc_gpio.c
 	extern volatile uint8_t		gchDataCommFlagCC1125;
+	extern volatile uint8_t		gchFifoFlagCC1125;
 
 	//_____ F U N C T I O N   D E F I N I T I O N S ____________________________________________
 
@@ -265,7 +265,6 @@ ISR(TWIF_TWIM_vect)
 	volatile int8_t chDiffValue;
 	
 	gchI2cStatus=I2C_MASTER_STATUS;
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	
 	//If Arbitration Lost or Bus Error
 	if (gchI2cStatus & TWI_MASTER_ARBLOST_bm)
@@ -331,6 +330,16 @@ ISR(TWIF_TWIM_vect)
 		
 		I2C_MASTER_STATUS |= TWI_MASTER_RIF_bm;
 	}
+	
+	//Notify task manager only when transaction is terminated (not on every byte)
+	if(gchAckError == SET_FLAG)
+	{
+		POST_SYSTEM_EVENT(EVENT_I2C_COMPLETE,(uint8_t)RETURN_FALSE);
+	}
+	else if(ghI2cCommData.chCommComplete == SET_FLAG)
+	{
+		POST_SYSTEM_EVENT(EVENT_I2C_COMPLETE,RETURN_TRUE);
+	}
 }
 
 
@@ -9,13 +9,22 @@ Functions:
 fnSpiInitialization				Responsible for initialization of all the SPI interfaces (Calls fnSpiRadioInitialization and fnSpiSmartSensorInitialization)
 fnSpiRadioInitialization		Initialize SPI interface dedicated to CC1125/CC2520
 fnSpiSmartSensorInitialization	Initialize SPI interfaces dedicated to Smart Sensors
+fnSpiRadioAddressBytes			Composes address byte(s) of CC1125 transaction
 fnSpiRadioSendReceiveData		Function which handles communication operations with CC1125/CC2520 over SPI
+fnSpiRadioQueueAdd				Appends descriptor of CC1125 transaction into the queue
+fnSpiRadioQueueBegin			Asserts chip select and sends address byte of descriptor in progress
+fnSpiRadioQueueStart			Starts the queue of CC1125 transactions
+fnSpiRadioQueueStatus			Status of the queue of CC1125 transactions
+fnSpiSmartSensorSelect			Moves select lines of Smart Sensor group to the sensor and asserts chip select of group
+fnSpiSmartSensorDeselect		De-asserts chip select of Smart Sensor group
+fnSpiSmartSensorQueueAdd		Appends frame of Smart Sensor into the queue of its group
+fnSpiSmartSensorQueueRun		Shifts queued frames of all the Smart Sensor groups in lock step
 fnSPID_SendReceiveOperation		Function handles communication with the Smart Sensors connected on SPID interface
 fnSPIE_SendReceiveOperation		Function handles communication with the Smart Sensors connected on SPIE interface
 fnSPIF_SendReceiveOperation		Function handles communication with the Smart Sensors connected on SPIF interface
 
 Interrupts:
--NA-
+SPIC_INT_vect					Shifts bytes and descriptors of CC1125 transaction queue
 
 
 Author: Aalok Shah
@@ -71,6 +80,12 @@ Test Results:
 //Object of SPI-CC112X communication data structure
 volatile RADIO_COMM_DATA_HANDLE		ghRadioSpiCommData;
 
+//Descriptor queue of CC1125 transactions executed by SPIC ISR
+volatile RADIO_SPI_QUEUE			ghRadioSpiQueue;
+
+//Frames queued on every Smart Sensor group (Executed in task context by fnSpiSmartSensorQueueRun)
+SMART_SENSOR_SPI_QUEUE				ghSmartSensorSpiQueue[SMART_SENSOR_SPI_CHANNELS];
+
 //____ fnSpiRadioInitialization  _________________________________________________________________
 //
 // @brief	Initialize the SPI interface to effectively communicate with CC1125/CC2520 radio chip by following steps:
@@ -86,8 +101,10 @@ inline void fnSpiRadioInitialization(void)
 	
 	//Reset necessary definitions
 	ghRadioSpiCommData.nCommCount=RESET_COUNTER;
+	ghRadioSpiQueue.chCount=RESET_COUNTER;
+	ghRadioSpiQueue.chState=RADIO_SPI_QUEUE_IDLE;
 
-	//Disable SPI interrupts (designed polling based)
+	//Disable SPI interrupts (Polling based, interrupt is enabled only while descriptor queue is running)
 	DISABLE_RADIO_SPI_COMM_INTERRUPT;				
 	
 	//Enable SPI interfaces for communication
@@ -105,12 +122,20 @@ inline void fnSpiRadioInitialization(void)
 
 inline void fnSpiSmartSensorInitialization(void)
 {
+	uint8_t chChannel = RESET_COUNTER;
+	
 	//At 16MHZ Clock Setting: SPI is configured to communicate at 8MHZ with the scalar of value 4 and setting the clock doubling
 	//Configured as Master with MODE-0 and MSB transmit first
 	SPID.CTRL = (SPI_MASTER_bm | SPI_MODE_0_gc | SPI_PRESCALER_DIV4_gc | SPI_CLK2X_bm);
 	SPIE.CTRL = (SPI_MASTER_bm | SPI_MODE_0_gc | SPI_PRESCALER_DIV4_gc | SPI_CLK2X_bm);
 	SPIF.CTRL = (SPI_MASTER_bm | SPI_MODE_0_gc | SPI_PRESCALER_DIV4_gc | SPI_CLK2X_bm);
 	
+	//Reset necessary definitions
+	for(chChannel = RESET_COUNTER; chChannel < SMART_SENSOR_SPI_CHANNELS; chChannel++)
+	{
+		ghSmartSensorSpiQueue[chChannel].chCount = RESET_COUNTER;
+	}
+	
 	//Disable SPI interrupts (designed polling based)
 	DISABLE_SMART_SENSOR_SPID_COMM_INTERRUPT;
 	DISABLE_SMART_SENSOR_SPIE_COMM_INTERRUPT;
@@ -142,10 +167,55 @@ void fnSpiInitialization(void)
 
 void fnResetSpiResources(void)
 {
-	//TBD (Currently Not Required)
+	//Abort the queue of CC1125 transactions if any
+	DISABLE_RADIO_SPI_COMM_INTERRUPT;
+	
+	if(ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING)
+	{
+		STOP_SPI_COMMUNICATION;
+	}
+	
+	ghRadioSpiQueue.chState=RADIO_SPI_QUEUE_IDLE;
+	ghRadioSpiQueue.chCount=RESET_COUNTER;
 	return;
 }
 
+//____ fnSpiRadioAddressBytes  _________________________________________________________________
+//
+// @brief	Includes SPI communication mode and read/write operation flag with address byte (As per CC112x communication protocol)
+// @param	nCommAddress	Address of CC1125 register
+//			chCommType		RADIO_COMMAND_STROBE, RADIO_TRANSMIT_BYTES or RADIO_RECEIVE_BYTES
+//			pchExtAddrByte	Returns extended address byte
+// @return	Address byte to be sent first
+
+static inline uint8_t fnSpiRadioAddressBytes(uint16_t nCommAddress,uint8_t chCommType,uint8_t *pchExtAddrByte)
+{
+	uint8_t chCheckAddrByte = nCommAddress >> BIT_8_bp;
+	uint8_t chAddrByte = nCommAddress & CC1125_ADDR_BYTE_BM;
+	
+	//Check if current address comes under extended address space??
+	if(chCheckAddrByte == CC1125_EXT_ADDR_BM)
+	{
+		*pchExtAddrByte=chAddrByte;
+		chAddrByte=chCheckAddrByte;
+	}
+	
+	if(chCommType == RADIO_TRANSMIT_BYTES)
+	{
+		chAddrByte |= (RADIO_BURST_ACCESS | RADIO_WRITE_ACCESS);
+	}
+	else if(chCommType == RADIO_RECEIVE_BYTES)
+	{
+		chAddrByte |= (RADIO_BURST_ACCESS | RADIO_READ_ACCESS);
+	}
+	else
+	{
+		chAddrByte |= RADIO_SINGLE_ACCESS;
+	}
+	
+	return chAddrByte;
+}
+
 //____ fnSpiRadioSendReceiveData  _________________________________________________________________
 //
 // @brief	This function is design to communicate with CC1125 Radio chip over SPI.
@@ -163,31 +233,16 @@ int8_t fnSpiRadioSendReceiveData(void)
 	uint8_t  chCheckAddrByte = RESET_FLAG;
 	uint8_t  chDummyByte = RESET_VALUE;
 	
-	//Split address in to multiple bytes
-	chCheckAddrByte=(ghRadioSpiCommData.nCommAddress) >> BIT_8_bp;
-	chAddrByte=(ghRadioSpiCommData.nCommAddress) & CC1125_ADDR_BYTE_BM;
-	
-	//Check if current address comes under extended address space??
-	if(chCheckAddrByte == CC1125_EXT_ADDR_BM)
+	//SPIC is owned by SPIC ISR till queue of transactions is complete
+	if(ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING)
 	{
-		chExtAddrByte=chAddrByte;
-		chAddrByte=chCheckAddrByte;
+		return RETURN_FALSE;
 	}
 	
-	//Include SPI communication mode and read/write operation flag with address byte (As per CC112x communication protocol)
+	//Split address in to multiple bytes
 	//Upper level must manage the value of chCommType***
-	if(ghRadioSpiCommData.chCommType == RADIO_TRANSMIT_BYTES)
-	{
-		chAddrByte |= (RADIO_BURST_ACCESS | RADIO_WRITE_ACCESS);
-	}
-	else if(ghRadioSpiCommData.chCommType == RADIO_RECEIVE_BYTES)
-	{
-		chAddrByte |= (RADIO_BURST_ACCESS | RADIO_READ_ACCESS);
-	}
-	else
-	{
-		chAddrByte |= RADIO_SINGLE_ACCESS;
-	}
+	chCheckAddrByte=(ghRadioSpiCommData.nCommAddress) >> BIT_8_bp;
+	chAddrByte=fnSpiRadioAddressBytes(ghRadioSpiCommData.nCommAddress,ghRadioSpiCommData.chCommType,&chExtAddrByte);
 	
 	//Start SPI communication by asserting the chip select
 	START_SPI_COMMUNICATION;
@@ -244,6 +299,366 @@ int8_t fnSpiRadioSendReceiveData(void)
 	return RETURN_TRUE;							//Success
 }
 
+//____ fnSpiRadioQueueAdd  _________________________________________________________________
+//
+// @brief	Appends the descriptor of CC1125 transaction into the queue. Queue is flushed by next fnSpiRadioQueueStart.
+// @param	chCommType		RADIO_COMMAND_STROBE, RADIO_TRANSMIT_BYTES or RADIO_RECEIVE_BYTES
+//			nCommAddress	Register, FIFO or command strobe address of CC1125
+//			chCommCount		No of data bytes to send or receive
+//			pchCommBuff		Memory resources of data which must remain valid till queue is complete
+// @return	FALSE if queue is running or full
+
+int8_t fnSpiRadioQueueAdd(uint8_t chCommType,uint16_t nCommAddress,uint8_t chCommCount,uint8_t *pchCommBuff)
+{
+	volatile RADIO_SPI_DESCRIPTOR *phDescriptor = NULL;
+	
+	if((ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING) || (ghRadioSpiQueue.chCount >= RADIO_SPI_QUEUE_SIZE))
+	{
+		return RETURN_FALSE;
+	}
+	
+	phDescriptor = &ghRadioSpiQueue.hDescriptor[ghRadioSpiQueue.chCount++];
+	phDescriptor->chCommType	= chCommType;
+	phDescriptor->nCommAddress	= nCommAddress;
+	phDescriptor->chCommCount	= (chCommType == RADIO_COMMAND_STROBE) ? RESET_COUNTER : chCommCount;
+	phDescriptor->pchCommBuff	= pchCommBuff;
+	
+	return RETURN_TRUE;
+}
+
+//____ fnSpiRadioQueueBegin  _________________________________________________________________
+//
+// @brief	Asserts chip select for the descriptor in progress and sends its address byte (Called from task context for first descriptor and from SPIC ISR for rest)
+// @return	FALSE if MISO does not get low within RADIO_QUEUE_READY_WAIT_COUNT
+
+static int8_t fnSpiRadioQueueBegin(void)
+{
+	volatile RADIO_SPI_DESCRIPTOR *phDescriptor = &ghRadioSpiQueue.hDescriptor[ghRadioSpiQueue.chIndex];
+	uint16_t nRadioReadyDelayCounter = RADIO_QUEUE_READY_WAIT_COUNT;
+	uint8_t  chExtAddrByte = RESET_VALUE;
+	uint8_t  chAddrByte = fnSpiRadioAddressBytes(phDescriptor->nCommAddress,phDescriptor->chCommType,&chExtAddrByte);
+	
+	ghRadioSpiQueue.chHeaderLength = ((phDescriptor->nCommAddress >> BIT_8_bp) == CC1125_EXT_ADDR_BM) ? 2 : 1;
+	ghRadioSpiQueue.chExtAddrByte = chExtAddrByte;
+	ghRadioSpiQueue.chByteIndex = RESET_COUNTER;
+	
+	START_SPI_COMMUNICATION;
+	
+	while(RADIO_NOT_READY_FOR_COMM)
+	{
+		if(!(--nRadioReadyDelayCounter))
+		{
+			STOP_SPI_COMMUNICATION;
+			return RETURN_FALSE;
+		}
+	}
+	
+	//Rest of the frame is shifted by SPIC ISR
+	SPIC.DATA=chAddrByte;
+	return RETURN_TRUE;
+}
+
+//____ fnSpiRadioQueueStart  _________________________________________________________________
+//
+// @brief	Asserts chip select of first descriptor and sends its address byte, rest of the bytes and descriptors are shifted by SPIC ISR.
+//			EVENT_RADIO_SPI_COMPLETE is posted once last descriptor is complete. fnSpiRadioSendReceiveData must not be called in between.
+// @return	FALSE if queue is empty or chip does not respond
+
+int8_t fnSpiRadioQueueStart(void)
+{
+	if((ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING) || (ghRadioSpiQueue.chCount == RESET_COUNTER))
+	{
+		return RETURN_FALSE;
+	}
+	
+	ghRadioSpiQueue.chIndex = RESET_COUNTER;
+	ghRadioSpiQueue.chResult = (uint8_t)RETURN_FALSE;
+	
+	//Flag of last polled byte must not trigger the interrupt
+	RADIO_CLEAR_SPI_STATUS;
+	
+	if(fnSpiRadioQueueBegin() == RETURN_FALSE)
+	{
+		ghRadioSpiQueue.chCount = RESET_COUNTER;
+		return RETURN_FALSE;
+	}
+	
+	ghRadioSpiQueue.chState = RADIO_SPI_QUEUE_RUNNING;
+	ENABLE_RADIO_SPI_COMM_INTERRUPT;
+	return RETURN_TRUE;
+}
+
+//____ fnSpiRadioQueueStatus  _________________________________________________________________
+//
+// @return	RADIO_SPI_QUEUE_BUSY while descriptors are shifted, RADIO_SPI_QUEUE_COMPLETE if all of them are done
+//			and RADIO_SPI_QUEUE_ERROR if chip did not respond to one of them
+
+int8_t fnSpiRadioQueueStatus(void)
+{
+	if(ghRadioSpiQueue.chState == RADIO_SPI_QUEUE_RUNNING)
+	{
+		return RADIO_SPI_QUEUE_BUSY;
+	}
+	else if(ghRadioSpiQueue.chResult == RETURN_TRUE)
+	{
+		return RADIO_SPI_QUEUE_COMPLETE;
+	}
+	
+	return RADIO_SPI_QUEUE_ERROR;
+}
+
+//____ SPIC_INT_vect  _________________________________________________________________
+//
+// @brief	ISR for queue of CC1125 transactions. It gets executed once for every byte shifted in/out of SPIC:
+//				1> First byte of frame returns status byte of CC1125, data bytes of read are stored in buffer of descriptor
+//				2> Next byte of frame is sent (Extended address, data byte or dummy byte of read)
+//				3> At the end of frame chip select is de-asserted and next descriptor is started
+//				4> At the end of queue (or if chip does not respond) interrupt is disabled and EVENT_RADIO_SPI_COMPLETE is posted
+
+ISR(SPIC_INT_vect)
+{
+	volatile RADIO_SPI_DESCRIPTOR *phDescriptor = &ghRadioSpiQueue.hDescriptor[ghRadioSpiQueue.chIndex];
+	uint8_t chDataByte = SPIC.DATA;
+	uint8_t chByteIndex = ghRadioSpiQueue.chByteIndex;
+	
+	if(chByteIndex == RESET_COUNTER)
+	{
+		ghRadioSpiQueue.chStatusByte = chDataByte;
+	}
+	else if((chByteIndex >= ghRadioSpiQueue.chHeaderLength) && (phDescriptor->chCommType == RADIO_RECEIVE_BYTES))
+	{
+		phDescriptor->pchCommBuff[chByteIndex - ghRadioSpiQueue.chHeaderLength] = chDataByte;
+	}
+	
+	ghRadioSpiQueue.chByteIndex = ++chByteIndex;
+	
+	//Next byte of the same frame
+	if(chByteIndex < (ghRadioSpiQueue.chHeaderLength + phDescriptor->chCommCount))
+	{
+		if(chByteIndex < ghRadioSpiQueue.chHeaderLength)
+		{
+			SPIC.DATA = ghRadioSpiQueue.chExtAddrByte;
+		}
+		else if(phDescriptor->chCommType == RADIO_TRANSMIT_BYTES)
+		{
+			SPIC.DATA = phDescriptor->pchCommBuff[chByteIndex - ghRadioSpiQueue.chHeaderLength];
+		}
+		else
+		{
+			SPIC.DATA = RESET_VALUE;
+		}
+		
+		return;
+	}
+	
+	//Frame is over
+	_NOP;
+	STOP_SPI_COMMUNICATION;
+	
+	//Next descriptor
+	if(++ghRadioSpiQueue.chIndex < ghRadioSpiQueue.chCount)
+	{
+		if(fnSpiRadioQueueBegin() == RETURN_TRUE)
+		{
+			return;
+		}
+	}
+	else
+	{
+		ghRadioSpiQueue.chResult = RETURN_TRUE;
+	}
+	
+	DISABLE_RADIO_SPI_COMM_INTERRUPT;
+	ghRadioSpiQueue.chCount = RESET_COUNTER;
+	ghRadioSpiQueue.chState = RADIO_SPI_QUEUE_IDLE;
+	POST_SYSTEM_EVENT(EVENT_RADIO_SPI_COMPLETE,ghRadioSpiQueue.chResult);
+}
+
+//____ fnSpiSmartSensorSelect  _________________________________________________________________
+//
+// @brief	Moves select lines of the group to the sensor and asserts chip select of the group
+// @param	chChannel		SMART_SENSOR_SPID_CHANNEL, SMART_SENSOR_SPIE_CHANNEL or SMART_SENSOR_SPIF_CHANNEL
+//			chSelectCode	S2:S1:S0 of select lines of the sensor
+
+static inline void fnSpiSmartSensorSelect(uint8_t chChannel,uint8_t chSelectCode)
+{
+	switch(chChannel)
+	{
+		case SMART_SENSOR_SPID_CHANNEL:
+			SET_PINS_LOW(PORTD,PD_SPID_S0 | PD_SPID_S1 | PD_SPID_S2);
+			SET_PINS_HIGH(PORTD,((chSelectCode & SMART_SENSOR_SELECT_S0_bm) ? PD_SPID_S0 : 0) |
+								((chSelectCode & SMART_SENSOR_SELECT_S1_bm) ? PD_SPID_S1 : 0) |
+								((chSelectCode & SMART_SENSOR_SELECT_S2_bm) ? PD_SPID_S2 : 0));
+			START_SPID_COMMUNICATION;
+		break;
+		
+		case SMART_SENSOR_SPIE_CHANNEL:
+			SET_PINS_LOW(PORTE,PE_SPIE_S0 | PE_SPIE_S1 | PE_SPIE_S2);
+			SET_PINS_HIGH(PORTE,((chSelectCode & SMART_SENSOR_SELECT_S0_bm) ? PE_SPIE_S0 : 0) |
+								((chSelectCode & SMART_SENSOR_SELECT_S1_bm) ? PE_SPIE_S1 : 0) |
+								((chSelectCode & SMART_SENSOR_SELECT_S2_bm) ? PE_SPIE_S2 : 0));
+			START_SPIE_COMMUNICATION;
+		break;
+		
+		case SMART_SENSOR_SPIF_CHANNEL:
+			SET_PINS_LOW(PORTJ,PJ_SPIF_S0 | PJ_SPIF_S1 | PJ_SPIF_S2);
+			SET_PINS_HIGH(PORTJ,((chSelectCode & SMART_SENSOR_SELECT_S0_bm) ? PJ_SPIF_S0 : 0) |
+								((chSelectCode & SMART_SENSOR_SELECT_S1_bm) ? PJ_SPIF_S1 : 0) |
+								((chSelectCode & SMART_SENSOR_SELECT_S2_bm) ? PJ_SPIF_S2 : 0));
+			START_SPIF_COMMUNICATION;
+		break;
+		
+		default:
+		break;
+	}
+	
+	return;
+}
+
+//____ fnSpiSmartSensorDeselect  _________________________________________________________________
+//
+// @brief	De-asserts chip select of the group
+// @param	chChannel		SMART_SENSOR_SPID_CHANNEL, SMART_SENSOR_SPIE_CHANNEL or SMART_SENSOR_SPIF_CHANNEL
+
+static inline void fnSpiSmartSensorDeselect(uint8_t chChannel)
+{
+	_NOP;
+	
+	if(chChannel == SMART_SENSOR_SPID_CHANNEL)
+	{
+		STOP_SPID_COMMUNICATION;
+	}
+	else if(chChannel == SMART_SENSOR_SPIE_CHANNEL)
+	{
+		STOP_SPIE_COMMUNICATION;
+	}
+	else
+	{
+		STOP_SPIF_COMMUNICATION;
+	}
+	
+	return;
+}
+
+//____ fnSpiSmartSensorQueueAdd  _________________________________________________________________
+//
+// @brief	Appends frame of Smart Sensor into the queue of its group. Queues are flushed by next fnSpiSmartSensorQueueRun.
+// @param	chChannel		SMART_SENSOR_SPID_CHANNEL, SMART_SENSOR_SPIE_CHANNEL or SMART_SENSOR_SPIF_CHANNEL
+//			chCommType		SMART_SENSOR_SPI_TRANSMIT or SMART_SENSOR_SPI_RECEIVE
+//			chSelectCode	S2:S1:S0 of select lines of the sensor
+//			pchBuff			Bytes to send or memory resources where measurements are shifted in (No intermediate buffer is used),
+//							must remain valid till fnSpiSmartSensorQueueRun
+//			chLength		No of bytes of frame
+// @return	FALSE if channel is invalid or its queue is full
+
+int8_t fnSpiSmartSensorQueueAdd(uint8_t chChannel,uint8_t chCommType,uint8_t chSelectCode,uint8_t *pchBuff,uint8_t chLength)
+{
+	SMART_SENSOR_SPI_DESCRIPTOR *phDescriptor = NULL;
+	
+	if((chChannel >= SMART_SENSOR_SPI_CHANNELS) || (ghSmartSensorSpiQueue[chChannel].chCount >= SMART_SENSOR_SPI_QUEUE_SIZE) ||
+	   (pchBuff == NULL) || (chLength == RESET_VALUE))
+	{
+		return RETURN_FALSE;
+	}
+	
+	phDescriptor = &ghSmartSensorSpiQueue[chChannel].hDescriptor[ghSmartSensorSpiQueue[chChannel].chCount++];
+	phDescriptor->chCommType	= chCommType;
+	phDescriptor->chSelectCode	= chSelectCode;
+	phDescriptor->chLength		= chLength;
+	phDescriptor->pchBuff		= pchBuff;
+	
+	return RETURN_TRUE;
+}
+
+//____ fnSpiSmartSensorQueueRun  _________________________________________________________________
+//
+// @brief	Shifts queued frames of all the groups at once. At 8MHZ byte is shifted in 16 CPU cycles, which is less than entry and exit of
+//			an interrupt routine, so groups are driven in lock step from single loop instead of SPID/SPIE/SPIF interrupts:
+//				1> Next byte of frame (dummy byte while receiving) is written on every group which has frame in progress (All of them shift in parallel)
+//				2> Received bytes are collected in the same order and stored directly in buffer of the frame which is received
+//				3> At the end of frame chip select of group is de-asserted and select lines are moved to next frame of the group
+//			So three groups take the time of the longest group instead of sum of all the groups.
+// @return	Bit mask (SMART_SENSOR_CHANNEL_BM) of groups whose frames are complete
+
+uint8_t fnSpiSmartSensorQueueRun(void)
+{
+	SPI_t *phSpi[SMART_SENSOR_SPI_CHANNELS] = {&SPID, &SPIE, &SPIF};
+	SMART_SENSOR_SPI_QUEUE *phQueue = NULL;
+	SMART_SENSOR_SPI_DESCRIPTOR *phDescriptor = NULL;
+	uint8_t chChannel = RESET_COUNTER;
+	uint8_t chActive = RESET_VALUE;
+	uint8_t chComplete = RESET_VALUE;
+	uint8_t chDataByte = RESET_VALUE;
+	
+	//First frame of every group
+	for(chChannel = RESET_COUNTER; chChannel < SMART_SENSOR_SPI_CHANNELS; chChannel++)
+	{
+		phQueue = &ghSmartSensorSpiQueue[chChannel];
+		phQueue->chIndex = RESET_COUNTER;
+		phQueue->chByteIndex = RESET_COUNTER;
+		
+		if(phQueue->chCount != RESET_COUNTER)
+		{
+			fnSpiSmartSensorSelect(chChannel,phQueue->hDescriptor[RESET_COUNTER].chSelectCode);
+			chActive |= SMART_SENSOR_CHANNEL_BM(chChannel);
+		}
+	}
+	
+	while(chActive)
+	{
+		for(chChannel = RESET_COUNTER; chChannel < SMART_SENSOR_SPI_CHANNELS; chChannel++)
+		{
+			if(chActive & SMART_SENSOR_CHANNEL_BM(chChannel))
+			{
+				phQueue = &ghSmartSensorSpiQueue[chChannel];
+				phDescriptor = &phQueue->hDescriptor[phQueue->chIndex];
+				phSpi[chChannel]->DATA = (phDescriptor->chCommType == SMART_SENSOR_SPI_TRANSMIT) ? phDescriptor->pchBuff[phQueue->chByteIndex] : SMART_SENSOR_SPI_DUMMY_BYTE;
+			}
+		}
+		
+		for(chChannel = RESET_COUNTER; chChannel < SMART_SENSOR_SPI_CHANNELS; chChannel++)
+		{
+			if(!(chActive & SMART_SENSOR_CHANNEL_BM(chChannel)))
+			{
+				continue;
+			}
+			
+			phQueue = &ghSmartSensorSpiQueue[chChannel];
+			phDescriptor = &phQueue->hDescriptor[phQueue->chIndex];
+			
+			while(!(phSpi[chChannel]->STATUS & SPI_IF_bm));			//Wait for byte to shifted in/out
+			chDataByte = phSpi[chChannel]->DATA;
+			
+			if(phDescriptor->chCommType == SMART_SENSOR_SPI_RECEIVE)
+			{
+				phDescriptor->pchBuff[phQueue->chByteIndex] = chDataByte;
+			}
+			
+			if(++phQueue->chByteIndex < phDescriptor->chLength)
+			{
+				continue;
+			}
+			
+			//Frame is over
+			fnSpiSmartSensorDeselect(chChannel);
+			phQueue->chByteIndex = RESET_COUNTER;
+			
+			if(++phQueue->chIndex < phQueue->chCount)
+			{
+				fnSpiSmartSensorSelect(chChannel,phQueue->hDescriptor[phQueue->chIndex].chSelectCode);
+			}
+			else
+			{
+				phQueue->chCount = RESET_COUNTER;
+				chActive &= ~SMART_SENSOR_CHANNEL_BM(chChannel);
+				chComplete |= SMART_SENSOR_CHANNEL_BM(chChannel);
+			}
+		}
+	}
+	
+	return chComplete;
+}
+
 //____ fnSPID_SendReceiveOperation  _________________________________________________________________
 //
 // @brief	This function performs send-receive operations with the connected Smart Sensors on this SPI interface
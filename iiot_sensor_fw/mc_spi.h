@@ -6,6 +6,15 @@ Date Created: 10/08/2014
 
 (NOTE: latest version is the top version)
 
+Author: Aalok Shah
+Changes: Smart Sensor frames are either sent (configuration) or shifted in (measurements), chCommType of SMART_SENSOR_SPI_DESCRIPTOR
+
+Author: Aalok Shah
+Changes: Smart Sensor frames of SPID, SPIE and SPIF groups are queued per group and shifted on all three groups in lock step (fnSpiSmartSensorQueueAdd/Run)
+
+Author: Aalok Shah
+Changes: Descriptor queue of CC1125 transactions driven by SPIC interrupt (fnSpiRadioQueueAdd/Start/Status), completion is posted as EVENT_RADIO_SPI_COMPLETE
+
 Author: Aalok Shah
 Changes: Initial version
 
@@ -66,6 +75,7 @@ Test Results:
 
 	//MACROs to support communication with CC1125 chip over SPI
 	#define RADIO_READY_WAIT_DELAY_COUNT				0xffffff
+	#define RADIO_QUEUE_READY_WAIT_COUNT				0x0fff		//MISO wait of queued transaction inside SPIC ISR (Chip is already awake)
 	#define CC1125_ADDR_BYTE_BM							0x00ff		//Bit mask for CC1125 address
 	#define CC1125_EXT_ADDR_BM							0x2f		//Bit mask for CC1125 extended address
 
@@ -74,6 +84,16 @@ Test Results:
 	#define RADIO_TRANSMIT_BYTES						2
 	#define RADIO_RECEIVE_BYTES							3
 
+	//Descriptor queue of CC112x transactions executed by SPIC interrupt
+	#define RADIO_SPI_QUEUE_SIZE						4			//Descriptors of one queued sequence
+	#define RADIO_SPI_QUEUE_IDLE						0
+	#define RADIO_SPI_QUEUE_RUNNING						1
+
+	//Return values of fnSpiRadioQueueStatus (Same as fnI2cFreeForOperation)
+	#define RADIO_SPI_QUEUE_ERROR						1
+	#define RADIO_SPI_QUEUE_COMPLETE					0
+	#define RADIO_SPI_QUEUE_BUSY						(-1)
+
 	//Radio mechanism controlling
 	#define ENABLE_RADIO_SPI_COMM						SPIC.CTRL |= SPI_ENABLE_bm			//Enable radio communication
 	#define DISABLE_RADIO_SPI_COMM						SPIC.CTRL &= (~SPI_ENABLE_bm)		//Disable radio communication
@@ -101,6 +121,22 @@ Test Results:
 	#define RADIO_READ_ACCESS							0x80
 	#define RADIO_WRITE_ACCESS							0x00
 
+	//Smart Sensor groups: One SPI interface per group, sensor of group is selected with 3 select lines (S2:S1:S0)
+	#define SMART_SENSOR_SPI_CHANNELS					3
+	#define SMART_SENSOR_SPID_CHANNEL					0
+	#define SMART_SENSOR_SPIE_CHANNEL					1
+	#define SMART_SENSOR_SPIF_CHANNEL					2
+	#define SMART_SENSOR_SPI_QUEUE_SIZE					6			//Frames of one group per run (SPIF group has 6 sensors)
+	#define SMART_SENSOR_SPI_DUMMY_BYTE					0x00		//Sent while measurements are shifted in
+	#define SMART_SENSOR_SPI_TRANSMIT					1			//Frame is sent, received bytes are discarded
+	#define SMART_SENSOR_SPI_RECEIVE					2			//Dummy bytes are sent, received bytes are stored in frame
+	#define SMART_SENSOR_CHANNEL_BM(chChannel)			(1 << (chChannel))
+
+	//Bits of select code, mapped on select line pins of the group (PORTD, PORTE or PORTJ) by fnSpiSmartSensorSelect
+	#define SMART_SENSOR_SELECT_S0_bm					(1 << 0)
+	#define SMART_SENSOR_SELECT_S1_bm					(1 << 1)
+	#define SMART_SENSOR_SELECT_S2_bm					(1 << 2)
+
 	//Controlling MACRO for various SPI interfaces connected to Smart Sensors
 	#define ENABLE_SMART_SENSOR_SPID_COMM				SPID.CTRL |= SPI_ENABLE_bm
 	#define DISABLE_SMART_SENSOR_SPID_COMM				SPID.CTRL &= (~SPI_ENABLE_bm)
@@ -172,11 +208,58 @@ Test Results:
 		uint8_t	 *pchCommBuff;
 	}RADIO_COMM_DATA_HANDLE;
 
+	//Descriptor of queued CC1125 transaction (Command strobe, burst/single write or read)
+	typedef struct
+	{
+		uint16_t nCommAddress;
+		uint8_t	 chCommType;						//RADIO_COMMAND_STROBE, RADIO_TRANSMIT_BYTES or RADIO_RECEIVE_BYTES
+		uint8_t	 chCommCount;						//Data bytes (Not used by command strobe)
+		uint8_t	 *pchCommBuff;						//Must stay valid till queue is complete
+	}RADIO_SPI_DESCRIPTOR;
+
+	//Queue of descriptors and state of the transaction being shifted by SPIC ISR
+	typedef struct
+	{
+		RADIO_SPI_DESCRIPTOR hDescriptor[RADIO_SPI_QUEUE_SIZE];
+		uint8_t	 chCount;							//Descriptors queued
+		uint8_t	 chIndex;							//Descriptor in progress
+		uint8_t	 chByteIndex;						//Byte of frame in progress (Address, extended address, data)
+		uint8_t	 chHeaderLength;					//Address bytes of descriptor in progress
+		uint8_t	 chExtAddrByte;
+		uint8_t	 chState;							//RADIO_SPI_QUEUE_IDLE/RUNNING
+		uint8_t	 chResult;							//RETURN_TRUE or RETURN_FALSE of last queue
+		uint8_t	 chStatusByte;						//Status byte in response to address byte of last descriptor
+	}RADIO_SPI_QUEUE;
+
+	//Frame of Smart Sensor queued on its SPI group
+	typedef struct
+	{
+		uint8_t	 chCommType;						//SMART_SENSOR_SPI_TRANSMIT or SMART_SENSOR_SPI_RECEIVE
+		uint8_t	 chSelectCode;						//S2:S1:S0 of sensor (SMART_SENSOR_SELECT_Sx_bm)
+		uint8_t	 chLength;							//Bytes of frame
+		uint8_t	 *pchBuff;							//Bytes to send or destination of measurements (Sample slot of sensor)
+	}SMART_SENSOR_SPI_DESCRIPTOR;
+
+	//Frames queued on SPI group and progress of the group during fnSpiSmartSensorQueueRun
+	typedef struct
+	{
+		SMART_SENSOR_SPI_DESCRIPTOR hDescriptor[SMART_SENSOR_SPI_QUEUE_SIZE];
+		uint8_t	 chCount;							//Frames queued
+		uint8_t	 chIndex;							//Frame in progress
+		uint8_t	 chByteIndex;						//Byte of frame in progress
+	}SMART_SENSOR_SPI_QUEUE;
+
 	//_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
 	
 	//Object of data structure designed to manage resources during communication with CC1125
 	extern volatile RADIO_COMM_DATA_HANDLE	ghRadioSpiCommData;
 
+	//Descriptor queue of CC1125 transactions
+	extern volatile RADIO_SPI_QUEUE			ghRadioSpiQueue;
+
+	//Frames queued on every Smart Sensor group (Indexed by SMART_SENSOR_SPIx_CHANNEL)
+	extern SMART_SENSOR_SPI_QUEUE			ghSmartSensorSpiQueue[SMART_SENSOR_SPI_CHANNELS];
+
 	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
 
 	//____ fnResetSpiResource  _________________________________________________________________
@@ -201,6 +284,54 @@ Test Results:
 
 	int8_t fnSpiRadioSendReceiveData(void);
 
+	//____ fnSpiRadioQueueAdd  _________________________________________________________________
+	//
+	// @brief	Appends the descriptor of CC1125 transaction into the queue. Queue is flushed by next fnSpiRadioQueueStart.
+	// @param	chCommType		RADIO_COMMAND_STROBE, RADIO_TRANSMIT_BYTES or RADIO_RECEIVE_BYTES
+	//			nCommAddress	Register, FIFO or command strobe address of CC1125
+	//			chCommCount		No of data bytes to send or receive
+	//			pchCommBuff		Memory resources of data which must remain valid till queue is complete
+	// @return	FALSE if queue is running or full
+
+	int8_t fnSpiRadioQueueAdd(uint8_t chCommType,uint16_t nCommAddress,uint8_t chCommCount,uint8_t *pchCommBuff);
+
+	//____ fnSpiRadioQueueStart  _________________________________________________________________
+	//
+	// @brief	Asserts chip select of first descriptor and sends its address byte, rest of the bytes and descriptors are shifted by SPIC ISR.
+	//			EVENT_RADIO_SPI_COMPLETE is posted once last descriptor is complete. fnSpiRadioSendReceiveData must not be called in between.
+	// @return	FALSE if queue is empty or chip does not respond
+
+	int8_t fnSpiRadioQueueStart(void);
+
+	//____ fnSpiRadioQueueStatus  _________________________________________________________________
+	//
+	// @return	RADIO_SPI_QUEUE_BUSY while descriptors are shifted, RADIO_SPI_QUEUE_COMPLETE if all of them are done
+	//			and RADIO_SPI_QUEUE_ERROR if chip did not respond to one of them
+
+	int8_t fnSpiRadioQueueStatus(void);
+
+	//____ fnSpiSmartSensorQueueAdd  _________________________________________________________________
+	//
+	// @brief	Appends frame of Smart Sensor into the queue of its group. Queues are flushed by next fnSpiSmartSensorQueueRun.
+	// @param	chChannel		SMART_SENSOR_SPID_CHANNEL, SMART_SENSOR_SPIE_CHANNEL or SMART_SENSOR_SPIF_CHANNEL
+	//			chCommType		SMART_SENSOR_SPI_TRANSMIT or SMART_SENSOR_SPI_RECEIVE
+	//			chSelectCode	S2:S1:S0 of select lines of the sensor
+	//			pchBuff			Bytes to send or memory resources where measurements are shifted in (No intermediate buffer is used),
+	//							must remain valid till fnSpiSmartSensorQueueRun
+	//			chLength		No of bytes of frame
+	// @return	FALSE if channel is invalid or its queue is full
+
+	int8_t fnSpiSmartSensorQueueAdd(uint8_t chChannel,uint8_t chCommType,uint8_t chSelectCode,uint8_t *pchBuff,uint8_t chLength);
+
+	//____ fnSpiSmartSensorQueueRun  _________________________________________________________________
+	//
+	// @brief	Shifts queued frames of all the groups at once: Every pass sends one byte on each group which has frame in progress and
+	//			then collects all of them (stored only for SMART_SENSOR_SPI_RECEIVE), so three groups take the time of the longest group instead of sum of all the groups.
+	//			At the end of frame chip select of group is de-asserted and select lines are moved to its next frame.
+	// @return	Bit mask (SMART_SENSOR_CHANNEL_BM) of groups whose frames are complete
+
+	uint8_t fnSpiSmartSensorQueueRun(void);
+
 	//____ fnSPID_SendReceiveOperation  _________________________________________________________________
 	//
 	// @brief	This function performs send-receive operations with the connected Smart Sensors on this SPI interface
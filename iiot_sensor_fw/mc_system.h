@@ -61,12 +61,16 @@ Test Results:
 	//_____  I N C L U D E S ______________________________________________________________
 
 	#include "system_debug.h"			// Functionality for System Debug Support
+	#include "system_scheduler.h"		// Event ring used by ISRs to notify task manager
 	
 	//_____ I N L I N E  A S S E M B L Y ________________________________________________________________
 
-	#define _NOP			asm("NOP")
-	#define _SLEEP			asm("SLEEP")
-	#define RESET_WDT		asm("wdr")		//Reset Watchdog timer
+	//Host build takes these definitions from hal_simulation.h
+	#ifndef HOST_SIMULATION
+		#define _NOP			asm("NOP")
+		#define _SLEEP			asm("SLEEP")
+		#define RESET_WDT		asm("wdr")		//Reset Watchdog timer
+	#endif
 	
 	//_____ M A C R O S ____________________________________________________________________
 
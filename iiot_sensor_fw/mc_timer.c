@@ -16,6 +16,9 @@ fnRadioCommunicationTimerEnable			It will start communication timer
 fnRadioCommunicationTimerDisable		It will stop communication timer
 fnStartCommunicationTimer				Function to start communication timer
 fnStartVolStableTimer					Function to start voltage stability timer
+fnInitializeCycleCounter				Initialization of 32 bit CPU cycle counter (Task profiler)
+fnReadCycleCounter						Function to read CPU cycle counter
+fnReadCommunicationTimer				Function to read time elapsed since communication timer was started
 
 Interrupts:
 TCE0_OVF_vect							ISR for TIMER-CE0 overflow (UART frame delay)
@@ -208,6 +211,46 @@ inline void fnInitializeWaitTimer(void)
 	return;
 }
 
+//_________ fnInitializeCycleCounter ___________________________________________________________
+//
+// @brief	Timers TCD0 and TCD1 are cascaded to count CPU cycles for task profiler:
+//				1> TCD0 counts CPU clock (No prescalar) for full 16 bit range
+//				2> Overflow of TCD0 is routed to event channel 0
+//				3> TCD1 counts event channel 0 so it holds upper 16 bits of counter
+//			No interrupt is used. Counter wraps after 2^32 cycles (268 seconds).
+
+inline void fnInitializeCycleCounter(void)
+{
+	DISABLE_CYCLE_COUNTER;
+	
+	//Normal mode of timer operation
+	TCD0.CTRLB = RESET_VALUE;
+	TCD0.CTRLD = RESET_VALUE;
+	TCD0.CTRLE = RESET_VALUE;
+	TCD1.CTRLB = RESET_VALUE;
+	TCD1.CTRLD = RESET_VALUE;
+	TCD1.CTRLE = RESET_VALUE;
+	
+	//No interrupts
+	TCD0.INTCTRLA = RESET_VALUE;
+	TCD0.INTCTRLB = RESET_VALUE;
+	TCD1.INTCTRLA = RESET_VALUE;
+	TCD1.INTCTRLB = RESET_VALUE;
+	
+	//Full 16 bit range of both the timers
+	TCD0.PER = 0xFFFF;
+	TCD1.PER = 0xFFFF;
+	TCD0.CNT = RESET_COUNTER;
+	TCD1.CNT = RESET_COUNTER;
+	
+	//Overflow of lower timer clocks the upper timer
+	EVSYS.CH0MUX = EVSYS_CHMUX_TCD0_OVF_gc;
+	
+	ENABLE_CYCLE_COUNTER;
+	
+	return;
+}
+
 //_________ fnTimersInit ___________________________________________________________
 //
 //	@brief	This function is called from fnHardwareInit function
@@ -227,6 +270,11 @@ void fnTimersInit(void)
 	//Initialize wait timer
 	fnInitializeWaitTimer();
 	
+	#if TASK_PROFILER_ENABLE
+		//Initialize cycle counter used by task profiler
+		fnInitializeCycleCounter();
+	#endif
+	
 	return;
 }
 
@@ -395,6 +443,59 @@ void fnStartVolStableTimer(uint8_t chVal)
 	return;
 }
 
+//_____fnReadCycleCounter_______________________________________________________________
+//
+// @brief	Reads free running 32 bit counter of CPU clock cycles.
+//			Upper half is read again to detect overflow of lower half in between the two reads.
+//			Interrupts are locked during the read because 16 bit access uses TEMP register of timer which is shared with ISRs reading the counter.
+// @return	Current value of cycle counter
+
+uint32_t fnReadCycleCounter(void)
+{
+	uint8_t chStatus = SREG;
+	uint16_t nHigh = RESET_VALUE;
+	uint16_t nLow = RESET_VALUE;
+	
+	DISABLE_GLOBAL_INTERRUPTS;
+	do
+	{
+		nHigh = TCD1.CNT;
+		nLow = TCD0.CNT;
+	}while(nHigh != TCD1.CNT);
+	SREG = chStatus;						//Restore interrupt state of caller
+	
+	return (((uint32_t)nHigh) << 16) | nLow;
+}
+
+//_____fnReadCommunicationTimer_______________________________________________________________
+//
+// @brief	Reads time elapsed since fnStartCommunicationTimer (Response time of RF exchange).
+//			Elapsed count is overflows of internal period counter plus current count. Pending overflow which is not yet served by ISR is added as well.
+//			Value remains frozen once the timer is disabled.
+// @return	Elapsed time in ms (Limited to 65535)
+
+uint16_t fnReadCommunicationTimer(void)
+{
+	uint8_t chStatus = SREG;
+	uint32_t lCount = RESET_VALUE;
+	uint16_t nCount = RESET_VALUE;
+	
+	DISABLE_GLOBAL_INTERRUPTS;
+	nCount = TCC1.CNT;
+	lCount = (uint32_t)(gchCommunicationCurrentDelayValue - SET_COUNTER) * TCC1.PER;
+	if(TCC1.INTFLAGS & TC1_OVFIF_bm)
+	{
+		nCount = TCC1.CNT;
+		lCount += TCC1.PER;
+	}
+	SREG = chStatus;						//Restore interrupt state of caller
+	
+	//15625 count in 1 second
+	lCount = ((lCount + nCount) * 8) / 125;
+	
+	return (lCount > 0xFFFF) ? 0xFFFF : (uint16_t)lCount;
+}
+
 //_____ I S R - U A R T  T I M E R ____________________________________________________________________
 //
 // @brief	ISR for UART Frame Delay Timer:
@@ -405,9 +506,9 @@ ISR(TCE0_OVF_vect)
 {
 	if(++gchCurrentDelayValue > gchMaxDelayValue)
 	{
-		gchNewInterrupt = SET_NEW_ISR_FLAG;
 		gchRxAvail=SET_FLAG;						//Set this flag to indicate successful reception
 		DISABLE_UART_DELAY_TIMER;
+		POST_SYSTEM_EVENT(EVENT_UART_RX_FRAME,RESET_VALUE);
 	}
 }
 
@@ -421,9 +522,9 @@ ISR(TCC1_OVF_vect)
 {
 	if(++gchCommunicationCurrentDelayValue > gchCommunicationMaxDelayValue)
 	{
-		gchNewInterrupt = SET_NEW_ISR_FLAG;
 		gchCommunicationTimeOut = SET_FLAG;				//Set this flag to indicate communication time out
 		DISABLE_COMMUNICATION_TIMER;				
+		POST_SYSTEM_EVENT(EVENT_COMM_TIMEOUT,RESET_VALUE);
 	}
 }
 
@@ -434,9 +535,9 @@ ISR(TCC1_OVF_vect)
 
 ISR(TCE1_OVF_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	gchVoltageStableTimerFlag=SET_FLAG;					//Set this flag to indicate voltage regulator is stable
 	DISABLE_VOL_STABLE_TIMER;				
+	POST_SYSTEM_EVENT(EVENT_VOL_STABLE,RESET_VALUE);
 }
 
 //_____ I S R - C O U N T E R  D E L A Y____________________________________________________
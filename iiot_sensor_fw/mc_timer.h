@@ -88,6 +88,16 @@ Test Results:
 	#define ENABLE_WAIT_TIMER						TCF1.CTRLA = TC_CLKSEL_DIV8_gc				//Enable Timer with the Prescalar of 8
 	#define DISABLE_WAIT_TIMER						TCF1.CTRLA = TC_CLKSEL_OFF_gc
 
+	//Cycle Counter related definitions (TCD0 counts CPU clock and its overflow clocks TCD1 through event channel 0 to make 32 bit counter)
+	#define ENABLE_CYCLE_COUNTER					do{\
+													TCD1.CTRLA = TC_CLKSEL_EVCH0_gc;\
+													TCD0.CTRLA = TC_CLKSEL_DIV1_gc;\
+													}while(0)
+	#define DISABLE_CYCLE_COUNTER					do{\
+													TCD0.CTRLA = TC_CLKSEL_OFF_gc;\
+													TCD1.CTRLA = TC_CLKSEL_OFF_gc;\
+													}while(0)
+
 	//Scenarios supported by Voltage Stabilize Timer
 	#define WAIT_5_VOL_TIMER						0		//Voltage Stability Timer will execute for 80ms + 60us
 	#define WAIT_3_VOL_TIMER						1		//Voltage Stability Timer will execute for 60us
@@ -168,4 +178,19 @@ Test Results:
 	
 	void fnStartVolStableTimer(uint8_t chVal);
 
+	//_____fnReadCycleCounter_______________________________________________________________
+	//
+	// @brief	Reads free running 32 bit counter of CPU clock cycles (16MHZ, wraps after 268 seconds).
+	//			Counter runs only when TASK_PROFILER_ENABLE is set. Difference of two readings gives the cycles elapsed between them.
+	// @return	Current value of cycle counter
+	
+	uint32_t fnReadCycleCounter(void);
+
+	//_____fnReadCommunicationTimer_______________________________________________________________
+	//
+	// @brief	Reads time elapsed since fnStartCommunicationTimer (Response time of RF exchange). Value remains frozen once the timer is disabled.
+	// @return	Elapsed time in ms (Limited to 65535)
+	
+	uint16_t fnReadCommunicationTimer(void);
+
 #endif /* MC_TIMER_H_ */
@@ -219,7 +219,6 @@ uint16_t fnUartReceiveData(void)
 
 ISR(USARTC0_RXC_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	ghUartCommData.chCommBuff[ghUartCommData.nRxCount++] = USARTC0.DATA;
 	
 	if(ghUartCommData.nRxCount >= UART_COMM_BUF_SIZE)
@@ -241,7 +240,6 @@ ISR(USARTC0_RXC_vect)
 //
 ISR(USARTC0_TXC_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	if(gnDataTxRxCounter >= ghUartCommData.nTxCount)
 	{
 		gnDataTxRxCounter = RESET_COUNTER;
@@ -7,12 +7,27 @@ Purpose: CC112X- Radio chip communication driver with functionality and easy int
 
 Functions:
 fnCC112xSendReceiveHandler			Manages communication with CC112x over SPI
+fnCC112xTxFifoLoadStart				Starts loading TX FIFO in background over SPIC interrupt
+fnCC112xTxFifoLoadStatus			Result of TX FIFO load
+fnCC112xFifoThresholdReached		Checks FIFO threshold interrupt of CC112x
+fnCC112xTxFifoRefill				Writes next part of packet longer than TX FIFO
+fnCC112xRxFifoDrain					Reads received part of packet longer than RX FIFO
+fnCC112xRxFifoRead					Reads rest of received packet
 fnRegisterConfigurationCC112X		Configures CC112x register settings
+fnRadioCalibrationChecksum			XOR of calibration record
+fnRadioCalibrationApply				Writes VCO calibration results to CC112x
+fnRadioCalibrationStore				Caches VCO calibration results with frequency and temperature
+fnRadioCalibrationUsable			Checks cached calibration against frequency and temperature
 fnManualConfigurationCC112X			Perform calibration on CC112x radio chip
 fnCC112xSendDataComplete			To check end of transmission in CC112x
 fnCC112xReceiveDataAvail			To check possible reception in CC112x
 fnRead8BitRssi						To fetch the valid RSSI value
 fnRadioCC1125Initialization			Calls fnRegisterConfigurationCC112X and fnManualConfigurationCC112X
+fnRadioSessionOpen					Wakes up retained CC112x or initializes it if configuration is lost
+fnRadioSessionClose					Puts CC112x in SLEEP with configuration retained
+fnRadioSessionInvalidate			Marks configuration of CC112x as lost (5V source disabled)
+fnRadioCalibrationSync				Loads and saves calibration record in E2PROM
+fnRadioCalibrationCrcResult			Drops cached calibration on rising CRC errors
 
 Interrupts:
 -NA-
@@ -66,19 +81,23 @@ Test Results:
 
 //_____  I N C L U D E S ______________________________________________________________
 
+#include "system_globals.h"						//Contains definitions related to various system level task
 #include "radio_communication.h"				//Contains scenarios to manage the RF communication
+#include "sensor_management.h"					//E2PROM operations and chamber temperature
 
 //______ M A C R O S  ___________________________________________________________
 
 #define	 VERIFY_CC1125_REGISTERS		1		//To perform CC112X-Register configuration checking (Extended Debugging) 
+#define	 CC112X_BURST_MAX_LENGTH		8		//Longest run of hRegSet written in one burst access (Longer run is split)
+#define	 CC112X_REGSET_ENTRIES			(sizeof(hRegSet)/sizeof(CC112X_REGSET))
 
 //_____  G L O B A L   C O N S T A N T S ______________________________________________________________
 
-//Contains value with which to initialize the CC112x configuration registers
+//Contains value with which to initialize the CC112x configuration registers (Must be kept in address order, consecutive addresses are written in one burst access)
 const CC112X_REGSET hRegSet[]=
 {
-	{CC112X_IOCFG3,            0xB0},
-	{CC112X_IOCFG2,            0xB0},	
+	{CC112X_IOCFG3,            0x40},		//RXFIFO_THR (inverted): Interrupt when RX FIFO is filled above threshold
+	{CC112X_IOCFG2,            0x02},		//TXFIFO_THR: Interrupt when TX FIFO is drained below threshold
 	{CC112X_IOCFG1,            0xB0},
 	{CC112X_IOCFG0,            0x06},		//Configure to take interrupt from CC112x- At Tx and Rx event
 	{CC112X_DEVIATION_M,       0x26},
@@ -97,11 +116,12 @@ const CC112X_REGSET hRegSet[]=
 	{CC112X_AGC_CFG2,          0x20},
 	{CC112X_AGC_CFG1,          0x2D},
 	{CC112X_AGC_CFG0,          0x5F},
-	{CC112X_FIFO_CFG,          0x00},
+	{CC112X_FIFO_CFG,          0x3F},		//FIFO_THR=63 (CC112X_FIFO_THR)
 	{CC112X_SETTLING_CFG,      0x03},
 	{CC112X_FS_CFG,            0x1B},
 	{CC112X_PKT_CFG1,          0x05},		//Append CRC,RSSI in received data and variable length mode is selected
 	{CC112X_PKT_CFG0,          0x20},
+	{CC112X_RFEND_CFG0,        0x30},		//TXOFF_MODE=RX: Chip is in RX for the reply as soon as packet is sent (Reply is not missed while CPU is busy)
 	{CC112X_PA_CFG2,           0x7C},
 	{CC112X_PA_CFG0,           0x7E},
 	{CC112X_PKT_LEN,           0xFF},
@@ -128,6 +148,20 @@ const CC112X_REGSET hRegSet[]=
 	{CC112X_XOSC1,             0x07},
 };
 
+//_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
+
+//State of CC1125 session (RADIO_SESSION_INVALID till chip is configured after power on)
+static volatile uint8_t gchRadioSessionState;
+
+//VCO calibration results of CC1125 (RADIO_CAL_STATE_LOAD till record is read from E2PROM after reset)
+static CC112X_CALIBRATION ghRadioCalibration;
+
+//MARCSTATE read back at the end of TX FIFO load
+static uint8_t gchRadioTxMarcState;
+
+//Packet being streamed through FIFOs of CC1125
+static CC112X_FIFO_STREAM ghRadioFifoStream;
+
 //____ fnCC112xSendReceiveHandler  _________________________________________________________________
 //
 // @brief	Main CC112X middle ware driver function which manages all the communication with chip over SPI interface
@@ -165,46 +199,204 @@ int8_t fnCC112xSendReceiveHandler(uint8_t chOperationType,uint16_t nRadioAddress
 	return RETURN_FALSE;	//Invalid operation mode (Programmer's Error)
 }
 
+//____ fnCC112xTxFifoLoadStart  _________________________________________________________________
+//
+// @brief	Queues the packet for TX FIFO followed by read of MARCSTATE and starts the queue on SPIC interrupt.
+//			EVENT_RADIO_SPI_COMPLETE is posted when both are done, no other SPI access to CC112x is allowed till than.
+//			Only first CC112X_FIFO_SIZE bytes of longer packet are loaded, rest is written by fnCC112xTxFifoRefill while packet is sent.
+// @param	pchPacket		Packet including length byte (Must remain unchanged till end of transmission)
+//			chLength		No of bytes to write in TX FIFO
+// @return	FALSE if chip does not respond
+
+int8_t fnCC112xTxFifoLoadStart(uint8_t *pchPacket,uint8_t chLength)
+{
+	gchRadioTxMarcState = RESET_VALUE;
+	gchFifoFlagCC1125 = RESET_FLAG;
+	
+	ghRadioFifoStream.pchTxPacket	= pchPacket;
+	ghRadioFifoStream.chTxLength	= chLength;
+	ghRadioFifoStream.chTxLoaded	= (chLength > CC112X_FIFO_SIZE) ? CC112X_FIFO_SIZE : chLength;
+	ghRadioFifoStream.chRxDrained	= RESET_COUNTER;
+	
+	fnSpiRadioQueueAdd(RADIO_TRANSMIT_BYTES,CC112X_TXFIFO,ghRadioFifoStream.chTxLoaded,pchPacket);
+	fnSpiRadioQueueAdd(RADIO_RECEIVE_BYTES,CC112X_MARCSTATE,1,&gchRadioTxMarcState);
+	
+	return fnSpiRadioQueueStart();
+}
+
+//____ fnCC112xTxFifoLoadStatus  _________________________________________________________________
+//
+// @return	RADIO_SPI_QUEUE_BUSY while packet is loaded, RADIO_SPI_QUEUE_COMPLETE if packet is in TX FIFO
+//			and RADIO_SPI_QUEUE_ERROR if chip did not respond or TX FIFO went in error state
+
+int8_t fnCC112xTxFifoLoadStatus(void)
+{
+	int8_t chQueueStatus = fnSpiRadioQueueStatus();
+	
+	if((chQueueStatus == RADIO_SPI_QUEUE_COMPLETE) && ((gchRadioTxMarcState & CC1125_FIFO_ERR_CHECK_BM) == CC112X_STATE_TXFIFO_ERROR))
+	{
+		return RADIO_SPI_QUEUE_ERROR;
+	}
+	
+	return chQueueStatus;
+}
+
+//____ fnCC112xFifoThresholdReached  _________________________________________________________________
+//
+// @brief	Checks gchFifoFlagCC1125 which is set by GPIO2/GPIO3 threshold interrupt and resets it
+// @return	TRUE if FIFO threshold is reached since last call
+
+int8_t fnCC112xFifoThresholdReached(void)
+{
+	if(gchFifoFlagCC1125 == SET_FLAG)
+	{
+		gchFifoFlagCC1125 = RESET_FLAG;
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//____ fnCC112xTxFifoRefill  _________________________________________________________________
+//
+// @brief	Queues next CC112X_TX_FIFO_REFILL bytes of packet being sent on SPIC interrupt (EVENT_RADIO_SPI_COMPLETE is posted when done).
+//			It is called when TX FIFO is drained below 127-CC112X_FIFO_THR bytes so refill always fits in FIFO
+//			and it is written long before remaining bytes of FIFO are sent (64 bytes last 128ms on air).
+// @return	TRUE if refill is started, FALSE if whole packet is already in TX FIFO or chip does not respond
+
+int8_t fnCC112xTxFifoRefill(void)
+{
+	uint8_t chCount = ghRadioFifoStream.chTxLength - ghRadioFifoStream.chTxLoaded;
+	
+	if(chCount == RESET_VALUE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if(chCount > CC112X_TX_FIFO_REFILL)
+	{
+		chCount = CC112X_TX_FIFO_REFILL;
+	}
+	
+	fnSpiRadioQueueAdd(RADIO_TRANSMIT_BYTES,CC112X_TXFIFO,chCount,&ghRadioFifoStream.pchTxPacket[ghRadioFifoStream.chTxLoaded]);
+	ghRadioFifoStream.chTxLoaded += chCount;
+	
+	return fnSpiRadioQueueStart();
+}
+
+//____ fnCC112xRxFifoDrain  _________________________________________________________________
+//
+// @brief	Reads CC112X_RX_FIFO_DRAIN bytes of packet being received and appends them to pchBuff.
+//			It is called when RX FIFO holds more than CC112X_FIFO_THR bytes so at least one byte remains in FIFO.
+// @param	pchBuff		Receive buffer of MAX_COMM_PACKET_SIZE bytes (Must be the same till fnCC112xRxFifoRead)
+// @return	FALSE if packet does not fit in pchBuff or chip does not respond
+
+int8_t fnCC112xRxFifoDrain(uint8_t *pchBuff)
+{
+	//Packet is left in RX FIFO which overflows and packet is dropped at the end of reception
+	if(ghRadioFifoStream.chRxDrained + CC112X_RX_FIFO_DRAIN > MAX_COMM_PACKET_SIZE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if(fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_RXFIFO,CC112X_RX_FIFO_DRAIN,&pchBuff[ghRadioFifoStream.chRxDrained]) == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	ghRadioFifoStream.chRxDrained += CC112X_RX_FIFO_DRAIN;
+	return RETURN_TRUE;
+}
+
+//____ fnCC112xRxFifoRead  _________________________________________________________________
+//
+// @brief	Reads rest of received packet from RX FIFO after the part read by fnCC112xRxFifoDrain
+// @param	pchBuff		Receive buffer of MAX_COMM_PACKET_SIZE bytes
+// @return	Bytes of packet in pchBuff (Length byte, data, RSSI and CRC status) or 0 if packet does not fit in pchBuff
+
+uint8_t fnCC112xRxFifoRead(uint8_t *pchBuff)
+{
+	uint8_t chDrained = ghRadioFifoStream.chRxDrained;
+	uint8_t chRxBytes = RESET_VALUE;
+	
+	ghRadioFifoStream.chRxDrained = RESET_COUNTER;
+	
+	//Get count of bytes left in RX FIFO
+	if(fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_NUM_RXBYTES,1,&chRxBytes) == RETURN_FALSE)
+	{
+		return RESET_VALUE;
+	}
+	
+	if((uint16_t)chDrained + chRxBytes > MAX_COMM_PACKET_SIZE)
+	{
+		fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SFRX,1,NULL);		//Flush the RX FIFO to drop the packet
+		return RESET_VALUE;
+	}
+	
+	fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_RXFIFO,chRxBytes,&pchBuff[chDrained]);
+	
+	return chDrained + chRxBytes;
+}
+
 //____ fnRegisterConfigurationCC112X  _________________________________________________________________
 //
 // @brief	Configure CC112x configuration registers with the value specified in hRegSet to establish a successful communication over RF at 154MHZ 
+//			Entries of consecutive register addresses form a run which is written with one burst access and verified with one burst read
 //			In the case of SENSOR_CC1125_REGISTER_INIT_FAIL, this function might stay in continuous loop
 // @return	FALSE if communication with chip fails
 
 inline int8_t  fnRegisterConfigurationCC112X(void)
 {
+	uint8_t chRunIndex			= RESET_COUNTER;		//First entry of run in hRegSet
+	uint8_t chRunLength			= RESET_COUNTER;
 	uint8_t chCounter			= RESET_COUNTER;
-	uint8_t chDummyByte			= RESET_VALUE;
 	uint8_t chRadioCheckFlag	= RESET_FLAG;
+	uint8_t chBurstBuff[CC112X_BURST_MAX_LENGTH];
 
 	//Put chip in reset mode before configuring the registers 
 	fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SRES,1,NULL);
 	
-	while(1)
+	while(chRunIndex < CC112X_REGSET_ENTRIES)
 	{
-		chRadioCheckFlag= RESET_FLAG;
-		chDummyByte=hRegSet[chCounter].chRegValue;
+		//Run ends at gap in register addresses (hRegSet is kept in address order), extended address space never continues a run of register space
+		chRunLength = 1;
+		while(((chRunIndex + chRunLength) < CC112X_REGSET_ENTRIES) && (chRunLength < CC112X_BURST_MAX_LENGTH) &&
+			  (hRegSet[chRunIndex + chRunLength].nRegAddr == (hRegSet[chRunIndex + chRunLength - 1].nRegAddr + 1)))
+		{
+			chRunLength++;
+		}
 		
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,hRegSet[chCounter].nRegAddr,1,&chDummyByte) != RETURN_TRUE)		//Write register value
+		for(chCounter = RESET_COUNTER; chCounter < chRunLength; chCounter++)
+		{
+			chBurstBuff[chCounter] = hRegSet[chRunIndex + chCounter].chRegValue;
+		}
+		
+		chRadioCheckFlag= RESET_FLAG;
+		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,hRegSet[chRunIndex].nRegAddr,chRunLength,chBurstBuff) != RETURN_TRUE)		//Write register values
 		{
 			return RETURN_FALSE;
 		}
 		
 		#if VERIFY_CC1125_REGISTERS
 		
-			chDummyByte=RESET_VALUE;
-			if(fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,hRegSet[chCounter].nRegAddr,1,&chDummyByte) != RETURN_TRUE)		//Read register value
+			if(fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,hRegSet[chRunIndex].nRegAddr,chRunLength,chBurstBuff) != RETURN_TRUE)		//Read register values
 			{
 				return RETURN_FALSE;
 			}
-		
-			if(chDummyByte == hRegSet[chCounter].chRegValue)				//Cross checking to avoid conflict and proper setup of radio chip for further communication
+			
+			//Cross checking to avoid conflict and proper setup of radio chip for further communication
+			chRadioCheckFlag=SET_FLAG;
+			for(chCounter = RESET_COUNTER; chCounter < chRunLength; chCounter++)
 			{
-				chRadioCheckFlag=SET_FLAG;
+				if(chBurstBuff[chCounter] != hRegSet[chRunIndex + chCounter].chRegValue)
+				{
+					chRadioCheckFlag=RESET_FLAG;
+				}
 			}
-			else
+			
+			if(chRadioCheckFlag==RESET_FLAG)
 			{
-				SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_REGISTER_INIT_FAIL);		//Register checking fail
+				SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_REGISTER_INIT_FAIL);		//Register checking fail, whole run is written again
 			}
 		
 		#else
@@ -215,13 +407,138 @@ inline int8_t  fnRegisterConfigurationCC112X(void)
 		
 		if(chRadioCheckFlag==SET_FLAG)
 		{
-			if(++chCounter >=  (sizeof(hRegSet)/sizeof(CC112X_REGSET)))
+			chRunIndex += chRunLength;
+		}
+	}
+	
+	return RETURN_TRUE;
+}
+
+//____ fnRadioCalibrationChecksum  _________________________________________________________________
+//
+// @brief	XOR of calibration record bytes which are covered by checksum
+// @return	Checksum of ghRadioCalibration.chRecord
+
+static uint8_t fnRadioCalibrationChecksum(void)
+{
+	uint8_t chCounter = RESET_COUNTER;
+	uint8_t chChecksum = RESET_VALUE;
+	
+	for(chCounter = RESET_COUNTER; chCounter < RADIO_CAL_CHECKSUM_INDEX; chCounter++)
+	{
+		chChecksum ^= ghRadioCalibration.chRecord[chCounter];
+	}
+	
+	return chChecksum;
+}
+
+//____ fnRadioCalibrationApply  _________________________________________________________________
+//
+// @brief	Writes VCO calibration results to CC112x (Result of calibration or cached result)
+// @param	pchCalResults	FS_VCO2, FS_VCO4 and FS_CHP values in order of FS_xxx_INDEX
+// @return	FALSE if communication with chip fails
+
+static int8_t fnRadioCalibrationApply(uint8_t *pchCalResults)
+{
+	if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_VCO2,1,&pchCalResults[FS_VCO2_INDEX]) == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_VCO4,1,&pchCalResults[FS_VCO4_INDEX]) == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_CHP,1,&pchCalResults[FS_CHP_INDEX]) == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	return RETURN_TRUE;
+}
+
+//____ fnRadioCalibrationStore  _________________________________________________________________
+//
+// @brief	Caches VCO calibration results tagged with frequency of hRegSet and last chamber temperature, record is saved to E2PROM by fnRadioCalibrationSync
+// @param	pchCalResults	FS_VCO2, FS_VCO4 and FS_CHP values in order of FS_xxx_INDEX
+
+static void fnRadioCalibrationStore(uint8_t *pchCalResults)
+{
+	uint8_t chCounter = RESET_COUNTER;
+	uint8_t chFreqIndex = RADIO_CAL_FREQ_INDEX;
+	int16_t nTemperature = fnLastChamberTemperature();
+	
+	ghRadioCalibration.chRecord[RADIO_CAL_MARK_INDEX] = RADIO_CAL_RECORD_MARK;
+	
+	for(chCounter = RESET_COUNTER; chCounter < RADIO_CAL_RESULTS_SIZE; chCounter++)
+	{
+		ghRadioCalibration.chRecord[RADIO_CAL_RESULTS_INDEX + chCounter] = pchCalResults[chCounter];
+	}
+	
+	//FREQ2, FREQ1 and FREQ0 are consecutive entries of hRegSet
+	for(chCounter = RESET_COUNTER; chCounter < CC112X_REGSET_ENTRIES; chCounter++)
+	{
+		if((hRegSet[chCounter].nRegAddr >= CC112X_FREQ2) && (hRegSet[chCounter].nRegAddr <= CC112X_FREQ0))
+		{
+			ghRadioCalibration.chRecord[chFreqIndex++] = hRegSet[chCounter].chRegValue;
+		}
+	}
+	
+	ghRadioCalibration.chRecord[RADIO_CAL_TEMPERATURE_INDEX]		= (uint16_t)nTemperature >> BIT_8_bp;
+	ghRadioCalibration.chRecord[RADIO_CAL_TEMPERATURE_INDEX + 1]	= (uint16_t)nTemperature;
+	ghRadioCalibration.chRecord[RADIO_CAL_CHECKSUM_INDEX]			= fnRadioCalibrationChecksum();
+	
+	ghRadioCalibration.chState		= RADIO_CAL_STATE_VALID;
+	ghRadioCalibration.chSaveDirty	= SET_FLAG;
+	ghRadioCalibration.chCrcErrors	= RESET_COUNTER;
+	return;
+}
+
+//____ fnRadioCalibrationUsable  _________________________________________________________________
+//
+// @brief	Checks whether cached calibration can be used instead of calibrating the chip:
+//				1> Chip was calibrated with frequency programmed by hRegSet
+//				2> Chamber temperature did not move by more than RADIO_CAL_TEMPERATURE_DRIFT since calibration
+//			Drift can not be judged before chamber temperature is sampled (Execution Table request after reset), cached calibration is used in that case.
+//			Calibration done before chamber temperature was known is not used once it is known so record gets tagged with temperature.
+// @return	TRUE if cached calibration is usable otherwise FALSE
+
+static int8_t fnRadioCalibrationUsable(void)
+{
+	uint8_t chCounter = RESET_COUNTER;
+	uint8_t chFreqIndex = RADIO_CAL_FREQ_INDEX;
+	int16_t nTemperature = fnLastChamberTemperature();
+	int16_t nCalTemperature = RESET_VALUE;
+	
+	if(ghRadioCalibration.chState != RADIO_CAL_STATE_VALID)
+	{
+		return RETURN_FALSE;
+	}
+	
+	for(chCounter = RESET_COUNTER; chCounter < CC112X_REGSET_ENTRIES; chCounter++)
+	{
+		if((hRegSet[chCounter].nRegAddr >= CC112X_FREQ2) && (hRegSet[chCounter].nRegAddr <= CC112X_FREQ0))
+		{
+			if(ghRadioCalibration.chRecord[chFreqIndex++] != hRegSet[chCounter].chRegValue)
 			{
-				break;
+				return RETURN_FALSE;
 			}
 		}
 	}
 	
+	if(nTemperature == CHAMBER_TEMPERATURE_UNKNOWN)
+	{
+		return RETURN_TRUE;
+	}
+	
+	nCalTemperature = (int16_t)(((uint16_t)ghRadioCalibration.chRecord[RADIO_CAL_TEMPERATURE_INDEX] << BIT_8_bp) | ghRadioCalibration.chRecord[RADIO_CAL_TEMPERATURE_INDEX + 1]);
+	
+	if((nCalTemperature == CHAMBER_TEMPERATURE_UNKNOWN) || (nTemperature > (nCalTemperature + RADIO_CAL_TEMPERATURE_DRIFT)) || (nCalTemperature > (nTemperature + RADIO_CAL_TEMPERATURE_DRIFT)))
+	{
+		return RETURN_FALSE;
+	}
+	
 	return RETURN_TRUE;
 }
 
@@ -238,6 +555,7 @@ inline int8_t  fnManualConfigurationCC112X(void)
 	//To hold multiple FS_VCO2, FS_VCO4 and FS_CHP register values during calibration
 	uint8_t chCalResultsStartHigh[3];	
 	uint8_t chCalResultsStartMid[3];	
+	uint8_t *pchCalResults = NULL;
 
 	// Set VCO cap-array to 0 (FS_VCO2 = 0x00)
 	chDummyByte=RESET_VALUE;
@@ -335,39 +653,20 @@ inline int8_t  fnManualConfigurationCC112X(void)
 	// Write back highest FS_VCO2 and corresponding FS_VCO, FS_CHP result
 	if (chCalResultsStartHigh[FS_VCO2_INDEX] > chCalResultsStartMid[FS_VCO2_INDEX])
 	{
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_VCO2,1,&chCalResultsStartHigh[FS_VCO2_INDEX]) == RETURN_FALSE)
-		{
-			return RETURN_FALSE;
-		}
-		
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_VCO4,1,&chCalResultsStartHigh[FS_VCO4_INDEX]) == RETURN_FALSE)
-		{
-			return RETURN_FALSE;
-		}
-		
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_CHP,1,&chCalResultsStartHigh[FS_CHP_INDEX]) == RETURN_FALSE)
-		{
-			return RETURN_FALSE;
-		}
+		pchCalResults = chCalResultsStartHigh;
 	}
 	else
 	{
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_VCO2,1,&chCalResultsStartMid[FS_VCO2_INDEX]) == RETURN_FALSE)
-		{
-			return RETURN_FALSE;
-		}
-		
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_VCO4,1,&chCalResultsStartMid[FS_VCO4_INDEX]) == RETURN_FALSE)
-		{
-			return RETURN_FALSE;
-		}
-		
-		if(fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_FS_CHP,1,&chCalResultsStartMid[FS_CHP_INDEX]) == RETURN_FALSE)
-		{
-			return RETURN_FALSE;
-		}
+		pchCalResults = chCalResultsStartMid;
 	}
 	
+	if(fnRadioCalibrationApply(pchCalResults) == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	//Results are cached so next initialization can skip calibration
+	fnRadioCalibrationStore(pchCalResults);
 	return RETURN_TRUE;
 }
 
@@ -417,14 +716,32 @@ int8_t fnCC112xReceiveDataAvail(void)
 //
 // @brief	Normally this function will get called from upper level when data were filled in TX FIFO of Radio chip
 //			As CC112x chip is configured to get the interruption on transmission complete, this function will check for gchDataCommFlagCC1125
+//			Chip enters RX by TXOFF_MODE, so reply may be received completely before this function is called (Both events are on the same flag).
+//			In that case flag is set again for fnCC112xReceiveDataAvail.
 // @return	FALSE if transmission complete interrupt is not triggered by chip
 
 int8_t fnCC112xSendDataComplete(void)
 {
+	uint8_t chMarcState	= RESET_VALUE;
+	uint8_t chRxBytes	= RESET_VALUE;
+	
 	if(gchDataCommFlagCC1125 == SET_FLAG)		//Check for transmission complete
 	{
 		gchDataCommFlagCC1125 = RESET_FLAG;
-		fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SRX,1,NULL);		//Put chip back in its default state (Receive)
+		ghRadioFifoStream.chTxLoaded = ghRadioFifoStream.chTxLength;		//Nothing is left to refill
+		
+		//Chip is back in IDLE (RXOFF_MODE) with bytes in RX FIFO only if reply is already received
+		if((fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_MARCSTATE,1,&chMarcState) == RETURN_TRUE) &&
+			((chMarcState & CC1125_FIFO_ERR_CHECK_BM) == CC112X_STATE_IDLE) &&
+			(fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_NUM_RXBYTES,1,&chRxBytes) == RETURN_TRUE) &&
+			(chRxBytes > RESET_VALUE))
+		{
+			gchDataCommFlagCC1125 = SET_FLAG;
+		}
+		else
+		{
+			fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SRX,1,NULL);		//Put chip back in its default state (Receive), chip is already in RX by TXOFF_MODE
+		}
 		return RETURN_TRUE;
 	}
 	
@@ -467,6 +784,7 @@ uint8_t fnRead8BitRssi(void)
 //____fnRadioCC1125Initialization _________________________________________________________________
 //
 // @brief	Function manages to configure and calibrate the CC112x chip by calling fnManualConfigurationCC112X and fnRegisterConfigurationCC112X
+//			Cached calibration results are written back instead of calibration while they are usable (fnRadioCalibrationUsable)
 // @return	FALSE if calibration or configuration fails otherwise returns TRUE
 
 SENSOR_MC_ERROR_CODES fnRadioCC1125Initialization(void)
@@ -476,6 +794,16 @@ SENSOR_MC_ERROR_CODES fnRadioCC1125Initialization(void)
 	{
 		return SENSOR_CC1125_CHIP_NOT_READY;
 	}
+	
+	if(fnRadioCalibrationUsable() == RETURN_TRUE)
+	{
+		if(fnRadioCalibrationApply(&ghRadioCalibration.chRecord[RADIO_CAL_RESULTS_INDEX]) == RETURN_FALSE)
+		{
+			return SENSOR_CC1125_CALIBRATION_FAIL;
+		}
+		
+		return SENSOR_NO_ERROR;
+	}
 
 	//Performs manual calibration operation with the Radio chip
 	if(fnManualConfigurationCC112X() == RETURN_FALSE)
@@ -486,3 +814,200 @@ SENSOR_MC_ERROR_CODES fnRadioCC1125Initialization(void)
 	return SENSOR_NO_ERROR;
 }
 
+//____fnRadioSessionOpen _________________________________________________________________
+//
+// @brief	Makes CC1125 ready for communication.
+//			If chip is retained in SLEEP, first SPI access wakes it up (MISO goes low once crystal is stable) and chip comes to IDLE with all the registers retained.
+//			One configured register is read back to catch the reset of chip which is not seen by fnRadioSessionInvalidate (e.g. brown out of radio).
+//			Retained chip is calibrated again if its calibration is not usable anymore (Temperature drift or rising CRC errors).
+//			Full initialization (SRES, register configuration and VCO calibration) is done only when configuration is not valid.
+// @return	NO_ERR if chip is ready otherwise returns specific error code of fnRadioCC1125Initialization
+
+SENSOR_MC_ERROR_CODES fnRadioSessionOpen(void)
+{
+	SENSOR_MC_ERROR_CODES chStatus = SENSOR_NO_ERROR;
+	uint8_t chDummyByte = RESET_VALUE;
+	
+	if(gchRadioSessionState == RADIO_SESSION_RETAINED)
+	{
+		if((fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SIDLE,1,NULL) == RETURN_TRUE) &&
+		   (fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,hRegSet[RADIO_SESSION_CHECK_INDEX].nRegAddr,1,&chDummyByte) == RETURN_TRUE) &&
+		   (chDummyByte == hRegSet[RADIO_SESSION_CHECK_INDEX].chRegValue))
+		{
+			if(fnRadioCalibrationUsable() == RETURN_FALSE)
+			{
+				SEND_DEBUG_STRING("CC1125 Calibration Stale\n");
+				if(fnManualConfigurationCC112X() == RETURN_FALSE)
+				{
+					gchRadioSessionState = RADIO_SESSION_INVALID;
+					return SENSOR_CC1125_CALIBRATION_FAIL;
+				}
+			}
+			
+			gchRadioSessionState = RADIO_SESSION_OPEN;
+			return SENSOR_NO_ERROR;
+		}
+		
+		SEND_DEBUG_STRING("CC1125 Configuration Lost\n");
+	}
+	
+	gchRadioSessionState = RADIO_SESSION_INVALID;
+	chStatus = fnRadioCC1125Initialization();
+	
+	if(chStatus == SENSOR_NO_ERROR)
+	{
+		gchRadioSessionState = RADIO_SESSION_OPEN;
+	}
+	
+	return chStatus;
+}
+
+//____fnRadioSessionClose _________________________________________________________________
+//
+// @brief	Puts CC1125 in SLEEP (SPWD) at the end of communication instead of leaving it in RX.
+//			FIFOs are flushed in IDLE as they are not retained in SLEEP. Configuration and calibration remain valid till 5V source is disabled.
+
+void fnRadioSessionClose(void)
+{
+	if(gchRadioSessionState != RADIO_SESSION_OPEN)
+	{
+		return;
+	}
+	
+	fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SIDLE,1,NULL);
+	fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SFRX,1,NULL);
+	fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SFTX,1,NULL);
+	
+	if(fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SPWD,1,NULL) == RETURN_TRUE)
+	{
+		gchRadioSessionState = RADIO_SESSION_RETAINED;
+	}
+	else
+	{
+		gchRadioSessionState = RADIO_SESSION_INVALID;
+	}
+	
+	return;
+}
+
+//____fnRadioSessionInvalidate _________________________________________________________________
+//
+// @brief	Configuration of CC1125 is lost when 5V source is disabled (Chip is kept in reset and powered down)
+
+void fnRadioSessionInvalidate(void)
+{
+	gchRadioSessionState = RADIO_SESSION_INVALID;
+	return;
+}
+
+//____fnRadioCalibrationSync _________________________________________________________________
+//
+// @brief	Keeps calibration record in E2PROM in sync with cache, one E2PROM transaction per call:
+//				1> After reset record is read from E2PROM (Record with bad mark or checksum leaves cache without calibration)
+//				2> Record of new calibration (or dropped calibration) is written to E2PROM
+//			Failed E2PROM transaction is reported and not retried, chip is calibrated as usual in that case.
+//			E2PROM transaction of another user (store-and-forward log) may be half done at entry, it is never taken over:
+//			Sync is skipped (record is not loaded or saved yet) and is done at a later entry.
+//			Cache is optional, so new transaction is not started while I2C is busy with sensors either (Radio is never held for it).
+// @return	TRUE if record is in sync or sync is skipped otherwise FALSE (E2PROM transaction in progress, its completion wakes the task)
+
+int8_t fnRadioCalibrationSync(void)
+{
+	int8_t chStatus = RESET_VALUE;
+	
+	if((gchStepIndexE2PROM != STEP_0_Val) && (ghRadioCalibration.chE2promActive == RESET_FLAG))
+	{
+		return RETURN_TRUE;
+	}
+	
+	if((gchStepIndexE2PROM == STEP_0_Val) && (fnCheckI2cAvailability() == RETURN_FALSE))
+	{
+		return RETURN_TRUE;
+	}
+	
+	if(ghRadioCalibration.chState == RADIO_CAL_STATE_LOAD)
+	{
+		chStatus = fnE2PROMReadOpeartion(ghRadioCalibration.chRecord,RADIO_CAL_RECORD_SIZE,E2PROM_RADIO_CAL_ADDR);
+		ghRadioCalibration.chE2promActive = (gchStepIndexE2PROM != STEP_0_Val) ? SET_FLAG : RESET_FLAG;
+		
+		if(chStatus == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		
+		ghRadioCalibration.chState = RADIO_CAL_STATE_NONE;
+		
+		if(chStatus != RETURN_TRUE)
+		{
+			SEND_DEBUG_ERROR_CODES(chStatus);
+		}
+		else if((ghRadioCalibration.chRecord[RADIO_CAL_MARK_INDEX] == RADIO_CAL_RECORD_MARK) &&
+				(ghRadioCalibration.chRecord[RADIO_CAL_CHECKSUM_INDEX] == fnRadioCalibrationChecksum()))
+		{
+			SEND_DEBUG_STRING("CC1125 Calibration Loaded\n");
+			ghRadioCalibration.chState = RADIO_CAL_STATE_VALID;
+		}
+		
+		return RETURN_TRUE;
+	}
+	
+	if(ghRadioCalibration.chSaveDirty == SET_FLAG)
+	{
+		chStatus = fnE2PROMWriteOperation(ghRadioCalibration.chRecord,RADIO_CAL_RECORD_SIZE,E2PROM_RADIO_CAL_ADDR);
+		ghRadioCalibration.chE2promActive = (gchStepIndexE2PROM != STEP_0_Val) ? SET_FLAG : RESET_FLAG;
+		
+		//I2C is released between transactions so sensors waiting for I2C get it before next ACK poll
+		if(chStatus == E2PROM_WRITE_YIELD)
+		{
+			WAKE_TASKS(DATA_SAMPLING_TASK | DATA_DOWNLOAD_TASK | EXECUTION_TABLE_REQ_TASK);
+			return RETURN_FALSE;
+		}
+		else if(chStatus == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		
+		ghRadioCalibration.chSaveDirty = RESET_FLAG;
+		
+		if(chStatus != RETURN_TRUE)
+		{
+			SEND_DEBUG_ERROR_CODES(chStatus);
+		}
+	}
+	
+	return RETURN_TRUE;
+}
+
+//____fnRadioCalibrationCrcResult _________________________________________________________________
+//
+// @brief	CRC errors are counted against good packets. Once errors exceed good packets by RADIO_CAL_CRC_ERROR_LIMIT cached calibration is dropped,
+//			record in E2PROM is invalidated as well and chip is calibrated at next session (fnRadioSessionOpen).
+// @param	chCrcOk		CRC_OK bit of status byte appended to received packet
+
+void fnRadioCalibrationCrcResult(uint8_t chCrcOk)
+{
+	if(ghRadioCalibration.chState != RADIO_CAL_STATE_VALID)
+	{
+		return;
+	}
+	
+	if(chCrcOk)
+	{
+		if(ghRadioCalibration.chCrcErrors != RESET_COUNTER)
+		{
+			ghRadioCalibration.chCrcErrors--;
+		}
+		return;
+	}
+	
+	if(++ghRadioCalibration.chCrcErrors >= RADIO_CAL_CRC_ERROR_LIMIT)
+	{
+		SEND_DEBUG_STRING("CC1125 Calibration Dropped\n");
+		ghRadioCalibration.chState = RADIO_CAL_STATE_NONE;
+		ghRadioCalibration.chRecord[RADIO_CAL_MARK_INDEX] = RESET_VALUE;
+		ghRadioCalibration.chSaveDirty = SET_FLAG;
+	}
+	
+	return;
+}
+
@@ -6,6 +6,27 @@ Date Created: 10/20/2014
 
 (NOTE: latest version is the top version)
 
+Author:	Aalok Shah
+Changes: Calibration record does not take over E2PROM transaction of another user (chE2promActive of CC112X_CALIBRATION)
+
+Author:	Aalok Shah
+Changes: Packets longer than FIFO are streamed on FIFO threshold interrupt (fnCC112xTxFifoRefill, fnCC112xRxFifoDrain, fnCC112xRxFifoRead)
+
+Author:	Aalok Shah
+Changes: TX FIFO is loaded by SPIC interrupt while CPU serves other tasks (fnCC112xTxFifoLoadStart, fnCC112xTxFifoLoadStatus)
+
+Author:	Aalok Shah
+Changes: VCO calibration results are cached in RAM and E2PROM and written back at initialization while frequency and temperature match (fnRadioCalibrationSync, fnRadioCalibrationCrcResult)
+
+Author:	Aalok Shah
+Changes: Consecutive registers of hRegSet are written and verified in burst access (fnRegisterConfigurationCC112X)
+
+Author:	Aalok Shah
+Changes: Session manager of CC1125 (fnRadioSessionOpen, fnRadioSessionClose, fnRadioSessionInvalidate) keeps configuration across downloads
+
+Author:	Aalok Shah
+Changes: CC1125 enters RX at the end of transmission by itself (TXOFF_MODE of RFEND_CFG0 in hRegSet)
+
 Author:	Aalok Shah
 Changes: Initial version
 
@@ -73,6 +94,44 @@ Test Results:
 	#define FS_VCO4_INDEX					1
 	#define FS_CHP_INDEX					2
 
+	//States of CC1125 session
+	#define RADIO_SESSION_INVALID			0		//Configuration is lost (Power on or 5V source disabled) so full initialization is required
+	#define RADIO_SESSION_RETAINED			1		//Chip is in SLEEP with configuration and calibration retained
+	#define RADIO_SESSION_OPEN				2		//Chip is configured and in use
+	#define RADIO_SESSION_CHECK_INDEX		3		//Entry of hRegSet read back to verify retained configuration (IOCFG0 differs from its reset value)
+
+	//Calibration record of CC1125 in configuration area of E2PROM (See E2PROM map in sample_log.h)
+	#define E2PROM_RADIO_CAL_ADDR			0x0005		//Right after anchor of store-and-forward log
+	#define RADIO_CAL_RECORD_MARK			0xCA
+	#define RADIO_CAL_MARK_INDEX			0
+	#define RADIO_CAL_RESULTS_INDEX			1			//FS_VCO2, FS_VCO4 and FS_CHP (In order of FS_xxx_INDEX)
+	#define RADIO_CAL_FREQ_INDEX			4			//FREQ2, FREQ1 and FREQ0 of hRegSet with which chip was calibrated
+	#define RADIO_CAL_TEMPERATURE_INDEX		7			//Chamber temperature at calibration (MSB first)
+	#define RADIO_CAL_CHECKSUM_INDEX		9			//XOR of previous bytes
+	#define RADIO_CAL_RECORD_SIZE			10
+	#define RADIO_CAL_RESULTS_SIZE			3
+	#define RADIO_CAL_FREQ_SIZE				3
+
+	//Cached calibration is dropped when chamber temperature moves by more than RADIO_CAL_TEMPERATURE_DRIFT (ADC counts)
+	//or CRC errors of received packets exceed good packets by RADIO_CAL_CRC_ERROR_LIMIT
+	#define RADIO_CAL_TEMPERATURE_DRIFT		64
+	#define RADIO_CAL_CRC_ERROR_LIMIT		8
+
+	//States of calibration cache
+	#define RADIO_CAL_STATE_LOAD			0			//Record is not read from E2PROM yet (After reset)
+	#define RADIO_CAL_STATE_NONE			1			//No usable calibration, chip is calibrated at next initialization
+	#define RADIO_CAL_STATE_VALID			2			//Record holds calibration results of chip
+
+	//FIFO threshold streaming: Packets up to 255 bytes (Variable length mode) do not fit in 128 byte FIFOs of CC112x so the rest of packet
+	//is written in TX FIFO when GPIO2 (TXFIFO_THR) signals that TX FIFO is drained below 127-CC112X_FIFO_THR bytes
+	//and received part is read from RX FIFO when GPIO3 (RXFIFO_THR, inverted) signals that RX FIFO holds more than CC112X_FIFO_THR bytes
+	#define CC112X_FIFO_SIZE				128
+	#define CC112X_FIFO_THR					63			//FIFO_THR of FIFO_CFG: Both thresholds at the middle of FIFO
+	#define CC112X_TX_FIFO_REFILL			64			//Bytes written at TX threshold (Free space of TX FIFO is more than 127-CC112X_FIFO_THR)
+	#define CC112X_RX_FIFO_DRAIN			63			//Bytes read at RX threshold (Last byte of RX FIFO is never read before end of packet: CC112x errata)
+	#define CC112X_GPIO_TXFIFO_THR			0x02		//IOCFGx: Asserted while TX FIFO is filled above 127-CC112X_FIFO_THR
+	#define CC112X_GPIO_RXFIFO_THR_INV		0x40		//IOCFGx: RXFIFO_THR with GPIOx_INV, low while RX FIFO is filled above CC112X_FIFO_THR
+
 	//CC1125 error checking bit mask
 	#define CC1125_CRC_ERR_CHECK_BM			0x80	
 	#define CC1125_FIFO_ERR_CHECK_BM		0x1f	
@@ -300,6 +359,25 @@ Test Results:
 		uint8_t  chRegValue;
 	}CC112X_REGSET;
 
+	//Structure to cache VCO calibration results of CC112X
+	typedef struct
+	{
+		uint8_t  chRecord[RADIO_CAL_RECORD_SIZE];		//Record as kept in E2PROM (Buffer of E2PROM transaction as well)
+		uint8_t  chState;								//RADIO_CAL_STATE_xxx
+		uint8_t  chSaveDirty;							//SET_FLAG if record in E2PROM is older than chRecord
+		uint8_t  chE2promActive;						//SET_FLAG while E2PROM transaction of record is half done (Step index of E2PROM is ours)
+		uint8_t  chCrcErrors;							//CRC errors in excess of good packets since calibration
+	}CC112X_CALIBRATION;
+
+	//Structure to stream packet longer than FIFO of CC112X
+	typedef struct
+	{
+		uint8_t  *pchTxPacket;							//Packet being sent (Must remain unchanged till end of transmission)
+		uint8_t  chTxLength;							//Bytes of packet including length byte
+		uint8_t  chTxLoaded;							//Bytes of packet written in TX FIFO
+		uint8_t  chRxDrained;							//Bytes of packet read from RX FIFO at threshold
+	}CC112X_FIFO_STREAM;
+
 	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
 
 	//____ fnCC112xReceiveDataAvail  _________________________________________________________________
@@ -330,6 +408,53 @@ Test Results:
 
 	int8_t fnCC112xSendReceiveHandler(uint8_t chOperationType,uint16_t nRadioAddress,uint8_t chCommLength,uint8_t *pchDataBytes);
 
+	//____ fnCC112xTxFifoLoadStart  _________________________________________________________________
+	//
+	// @brief	Queues the packet for TX FIFO followed by read of MARCSTATE and starts the queue on SPIC interrupt.
+	//			EVENT_RADIO_SPI_COMPLETE is posted when both are done, no other SPI access to CC112x is allowed till than.
+	// @param	pchPacket		Packet including length byte (Must remain unchanged till load is complete)
+	//			chLength		No of bytes to write in TX FIFO
+	// @return	FALSE if chip does not respond
+
+	int8_t fnCC112xTxFifoLoadStart(uint8_t *pchPacket,uint8_t chLength);
+
+	//____ fnCC112xTxFifoLoadStatus  _________________________________________________________________
+	//
+	// @return	RADIO_SPI_QUEUE_BUSY while packet is loaded, RADIO_SPI_QUEUE_COMPLETE if packet is in TX FIFO
+	//			and RADIO_SPI_QUEUE_ERROR if chip did not respond or TX FIFO went in error state
+
+	int8_t fnCC112xTxFifoLoadStatus(void);
+
+	//____ fnCC112xFifoThresholdReached  _________________________________________________________________
+	//
+	// @brief	Checks gchFifoFlagCC1125 which is set by GPIO2/GPIO3 threshold interrupt and resets it
+	// @return	TRUE if FIFO threshold is reached since last call
+
+	int8_t fnCC112xFifoThresholdReached(void);
+
+	//____ fnCC112xTxFifoRefill  _________________________________________________________________
+	//
+	// @brief	Queues next CC112X_TX_FIFO_REFILL bytes of packet being sent on SPIC interrupt (EVENT_RADIO_SPI_COMPLETE is posted when done)
+	// @return	TRUE if refill is started, FALSE if whole packet is already in TX FIFO or chip does not respond
+
+	int8_t fnCC112xTxFifoRefill(void);
+
+	//____ fnCC112xRxFifoDrain  _________________________________________________________________
+	//
+	// @brief	Reads CC112X_RX_FIFO_DRAIN bytes of packet being received and appends them to pchBuff
+	// @param	pchBuff		Receive buffer of MAX_COMM_PACKET_SIZE bytes (Must be the same till fnCC112xRxFifoRead)
+	// @return	FALSE if packet does not fit in pchBuff or chip does not respond
+
+	int8_t fnCC112xRxFifoDrain(uint8_t *pchBuff);
+
+	//____ fnCC112xRxFifoRead  _________________________________________________________________
+	//
+	// @brief	Reads rest of received packet from RX FIFO after the part read by fnCC112xRxFifoDrain
+	// @param	pchBuff		Receive buffer of MAX_COMM_PACKET_SIZE bytes
+	// @return	Bytes of packet in pchBuff (Length byte, data, RSSI and CRC status) or 0 if packet does not fit in pchBuff
+
+	uint8_t fnCC112xRxFifoRead(uint8_t *pchBuff);
+
 	//____ fnRead8BitRssi  _________________________________________________________________
 	//
 	// @brief	This function can be called to fetch the fresh and valid RSSI value from CC112x chip
@@ -343,5 +468,40 @@ Test Results:
 	// @return	NO_ERR if calibration and configuration is successful otherwise returns specific error code
 	
 	SENSOR_MC_ERROR_CODES fnRadioCC1125Initialization(void);
+	
+	//____fnRadioSessionOpen _________________________________________________________________
+	//
+	// @brief	Makes CC1125 ready for communication. Chip retained in SLEEP by fnRadioSessionClose is woken up and one register is verified,
+	//			full initialization (fnRadioCC1125Initialization) is done only if configuration is not valid anymore.
+	// @return	NO_ERR if chip is ready otherwise returns specific error code of fnRadioCC1125Initialization
+	
+	SENSOR_MC_ERROR_CODES fnRadioSessionOpen(void);
+	
+	//____fnRadioSessionClose _________________________________________________________________
+	//
+	// @brief	Flushes the FIFOs and puts CC1125 in SLEEP (SPWD) at the end of communication. Configuration and calibration are retained while 5V source is on.
+	
+	void fnRadioSessionClose(void);
+	
+	//____fnRadioSessionInvalidate _________________________________________________________________
+	//
+	// @brief	Marks configuration of CC1125 as lost. Must be called whenever 5V source of radio is disabled.
+	
+	void fnRadioSessionInvalidate(void);
+	
+	//____fnRadioCalibrationSync _________________________________________________________________
+	//
+	// @brief	Keeps calibration record in E2PROM in sync with cache: Record is loaded once after reset and saved after every new calibration.
+	//			One E2PROM transaction per call, must be called only when no other E2PROM operation is in progress (Entry of radio tasks).
+	// @return	TRUE if record is in sync otherwise FALSE (E2PROM transaction in progress, its completion wakes the task)
+	
+	int8_t fnRadioCalibrationSync(void);
+	
+	//____fnRadioCalibrationCrcResult _________________________________________________________________
+	//
+	// @brief	Tracks CRC result of received packets. Cached calibration is dropped (chip is calibrated at next session) once CRC errors keep rising.
+	// @param	chCrcOk		CRC_OK bit of status byte appended to received packet
+	
+	void fnRadioCalibrationCrcResult(uint8_t chCrcOk);
 
 #endif /* RADIO_COMMUNICATION_H_ */
@@ -7,9 +7,27 @@ Date Created: 11/27/2014
 Purpose: All the mechanisms for data sampling and data collection task
 
 Functions:
+fnExecuteSensorDriver					Executes the steps of sensor driver as per sensor state
 fnData_Sampling_Task					This task performs operations to fetch the sampled data from sensors by following current tasking table 
+fnPayloadZigzagDelta					Zigzag mapped difference of data word from its reference
+fnPayloadEntryLength					Bytes of delta encoded sensor entry
+fnPayloadEncodeEntry					Writes delta encoded sensor entry into data packet
+fnPayloadRequestKeys					Every sensor sends key entry next time
+fnPayloadPackedBits						Bits of bit packed sensor entry
+fnPayloadPackEntry						Packs sensor entry into bit stream of data packet
+fnAllocateCollectionSlot				Finds free slot of collection queue (drops oldest generation if required)
+fnCollectSmartSensors					Fetches measurements of due smart sensors (all the groups at once)
 fnData_Collection_Task					This task performs operations to prepare the data packet ready for transmission
 fnResetFirmwareResourceAllocations		Reset all the resources shared in middle and lower level design
+fnDivisorLCM							Extends hyperperiod of divisor schedule with divisor of sensor
+fnScheduleDivisor						Divisor of sensor entry used by divisor schedule
+fnScheduleExcludes						Sensor entry which is not served by divisor schedule (smart sensors on sample clock)
+fnCompileDivisorSchedule				Compiles divisors of all the sensors into divisor schedule
+fnCompileDivisorSchedules				Compiles sample and radio clock divisor schedules of new Execution Table
+fnResetKeyData							Resets key data of delta encoding for new Execution Table
+fnFetchDueSensors						Fetch sensor entries due at current clock tick
+fnFetchCollectionGeneration				Oldest generation of collection queue for Data Download Task
+fnReleaseCollectionGeneration			Frees slot of downloaded generation
 
 
 Author: Aalok Shah
@@ -64,7 +82,10 @@ Test Results:
 //_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
 
 //Memory resources allocated to support all the sensor related operations
-volatile SMART_SENSORS_STRUCT		ghSensorControl[MAX_SENSOR_COUNT];	
+//Configuration from Execution Table, sampled data and per clock counters/states are kept apart so per clock scans touch only hot bytes
+SENSOR_CONFIG_STRUCT		ghSensorConfig[MAX_SENSOR_COUNT];
+SENSOR_SAMPLE_STRUCT		ghSensorSample[MAX_SENSOR_COUNT];
+SENSOR_RUNTIME_STRUCT		ghSensorRuntime;
 	
 //Flag to find out current Sample Clock Occurrence in Data Sampling Task
 // Will get set at every Master Sample Clock
@@ -74,9 +95,110 @@ volatile uint8_t gchSampleClockIndicator;
 // Will get set at every Master Radio Clock
 volatile uint8_t gchRadioClockIndicator;	
 
-//Indexes to maintain the communication packet generation in Data Collection Task
-static uint8_t gchCollectionPacketIndex;
-static uint8_t gchCollectionDataIndex;
+//Generations of collected packets waiting for Data Download Task
+static COLLECTION_QUEUE_STRUCT ghCollectionQueue;
+
+//Active sensor worklist of Data Sampling Task: One bit per sensor entry which is not in SAMPLE_STATE_OFF and count of those entries
+static uint8_t gchActiveSensorMap[ACTIVE_SENSOR_MAP_SIZE];
+static uint8_t gchActiveSensorCount;
+
+//Divisor schedules of sample and radio clocks compiled from Execution Table
+static DIVISOR_SCHEDULE_STRUCT ghSampleSchedule;
+static DIVISOR_SCHEDULE_STRUCT ghRadioSchedule;
+
+//List of due sensors filled by sequential counters when divisor schedule is not compiled
+static uint8_t gchDueSensorList[MAX_SENSOR_COUNT];
+
+//Key data of delta encoding for first MAX_KEY_SENSOR_COUNT sensor entries (Execution Table of default MAX_COMM_PACKET_SIZE holds 20 entries)
+static SENSOR_KEY_STRUCT ghSensorKey[MAX_KEY_SENSOR_COUNT];
+
+//_____ fnExecuteSensorDriver ____________________________________________________________________
+//
+// @brief	Executes the steps of sensor driver (fetched from sensor driver registry by Sensor ID) as per current state of sensor
+//			Steps are executed in sequence till one of them is waiting (Missing step is considered as completed)
+// @param	chSensorCounter		Index of sensor entry in ghSensorConfig
+
+inline void fnExecuteSensorDriver(uint8_t chSensorCounter)
+{
+	uint16_t nSampleBuff[MAX_SENSOR_DATA_LENGTH];							//Measurement of averaged sensor fetched by sensor driver
+	uint16_t *pnSampleBuff = nSampleBuff;
+	const SENSOR_DRIVER_STRUCT *phSensorDriver = NULL;
+	
+	phSensorDriver = fnFetchSensorDriver(ghSensorConfig[chSensorCounter].chSensorID);
+	
+	if(phSensorDriver == NULL)
+	{
+		//Sensor of Execution Table is not supported, skip its sampling
+		ghSensorRuntime.chSensorStatusFlag[chSensorCounter] = SAMPLE_STATE_OFF;
+		SEND_ERROR_CODE_OVER_RF(SENSOR_INVALID_EXECUTION_DEVELOPER_ERROR);
+		SEND_DEBUG_ERROR_CODES(SENSOR_INVALID_EXECUTION_DEVELOPER_ERROR);
+		return;
+	}
+	
+	if(ghSensorRuntime.chSensorStatusFlag[chSensorCounter]==SAMPLE_STATE_START)
+	{
+		if((phSensorDriver->chPowerSourceIdentity == NO_POWER_SOURCE_IDENTITY) || (RETURN_TRUE==fnPowerSourceManager(POWER_SOURCE_ENABLE,phSensorDriver->chPowerSourceIdentity)))
+		{
+			ghSensorRuntime.chSensorStatusFlag[chSensorCounter]=SAMPLE_STATE_RUN_LVL0;
+		}
+	}
+	
+	if(ghSensorRuntime.chSensorStatusFlag[chSensorCounter]==SAMPLE_STATE_RUN_LVL0)
+	{
+		if((phSensorDriver->pfnStartSensor == NULL) || (RETURN_TRUE==phSensorDriver->pfnStartSensor()))
+		{
+			ghSensorRuntime.chSensorStatusFlag[chSensorCounter]=SAMPLE_STATE_RUN_LVL1;
+		}
+	}
+	
+	if(ghSensorRuntime.chSensorStatusFlag[chSensorCounter]==SAMPLE_STATE_RUN_LVL1)
+	{
+		if((phSensorDriver->pfnPollSensor == NULL) || (RETURN_TRUE==phSensorDriver->pfnPollSensor()))
+		{
+			ghSensorRuntime.chSensorStatusFlag[chSensorCounter]=SAMPLE_STATE_RUN;
+		}
+	}
+	
+	if(ghSensorRuntime.chSensorStatusFlag[chSensorCounter]==SAMPLE_STATE_RUN)
+	{
+		//Sensor with multiple measurements is not averaged so its measurements are fetched straight into the payload of sensor entry
+		if(phSensorDriver->chSensorDataLen != SENSOR_AVERAGED_DATA_LEN)
+		{
+			pnSampleBuff = ghSensorSample[chSensorCounter].nSensorData;
+		}
+		
+		if(RETURN_TRUE==phSensorDriver->pfnFetchSensor(pnSampleBuff))
+		{
+			if(phSensorDriver->chSensorDataLen == SENSOR_AVERAGED_DATA_LEN)
+			{
+				ghSensorSample[chSensorCounter].nSensorAvgData += nSampleBuff[0];
+				
+				if(++ghSensorRuntime.chSensorSampleAvgCounter[chSensorCounter]>=ghSensorConfig[chSensorCounter].chSensorSampleAvgTotalCount)
+				{
+					ghSensorSample[chSensorCounter].nSensorData[0]= (ghSensorSample[chSensorCounter].nSensorAvgData/ghSensorConfig[chSensorCounter].chSensorSampleAvgTotalCount);
+				}
+			}
+			else
+			{
+				ghSensorRuntime.chSensorSampleAvgCounter[chSensorCounter]=ghSensorConfig[chSensorCounter].chSensorSampleAvgTotalCount;
+			}
+			
+			ghSensorRuntime.chSensorStatusFlag[chSensorCounter] = SAMPLE_STATE_OFF;		//This indicates sampling is done
+			
+			if(phSensorDriver->pfnReleaseSensor != NULL)
+			{
+				phSensorDriver->pfnReleaseSensor();
+			}
+			
+			if(phSensorDriver->chPowerSourceIdentity != NO_POWER_SOURCE_IDENTITY)
+			{
+				fnPowerSourceManager(POWER_SOURCE_DISABLE,phSensorDriver->chPowerSourceIdentity);
+			}
+		}
+	}
+	
+	return;
+}
 
 //_____ fnData_Sampling_Task ____________________________________________________________________
 //
@@ -89,237 +211,424 @@ static uint8_t gchCollectionDataIndex;
 //				If match is found and sensor is in off mode than it will be put in a operation mode.
 //				If match is found and sensor is already in operation mode than sensor sampling overrun error will get raised.
 //
+//				Sensor put in operation mode is added to active sensor worklist (gchActiveSensorMap, gchActiveSensorCount)
+//
 //			STEP-2:
-//				In FOR loop each sensor's current status will get checked and depend on it all the sensors will get access of middle and lower level resources
+//				Each sensor of active sensor worklist will get access of middle and lower level resources (Sensors in off mode are not visited)
+//				Steps of every sensor are executed by its driver fetched from sensor driver registry by Sensor ID (fnFetchSensorDriver)
 //				The same will be performed till the sensor data will be fetched successfully than sensor will again be put in a off mode.
 //			
 //			STEP-3:
-//				At the ending of task status of all the sensors will get checked.
-//				If all sensors in off mode than this task will finally terminated till next availability of sample clock
+//				Sensor which completes the sampling is removed from active sensor worklist.
+//				If worklist is empty (all sensors in off mode) than this task will finally terminated till next availability of sample clock
 //
 // @return	TRUE if data sampling task is completed or all sensors are in off mode otherwise it returns FALSE
 
 int8_t fnData_Sampling_Task(void)
 {
 	uint8_t	chSensorCounter	= RESET_COUNTER;
-	uint8_t chCheckFlag		= RESET_FLAG;
-	int16_t nDummyValue	= RESET_VALUE;
+	uint8_t chDueIndex		= RESET_COUNTER;
+	uint8_t chDueCount		= RESET_COUNTER;
+	uint8_t *pchDueList		= NULL;
+	uint8_t chMapIndex		= RESET_COUNTER;
+	uint8_t chMapBit		= RESET_VALUE;
+	uint8_t chPendingCount	= RESET_COUNTER;
+	uint8_t chSensorState	= RESET_VALUE;
+	uint8_t chProgressFlag	= RESET_FLAG;
+	uint8_t chLvl1StepIndex	= gchLvl1StepIndexI2C;
+	uint8_t chLvl2StepIndex	= gchLvl2StepIndexI2C;
 	
 	if(gchSampleClockIndicator == SET_FLAG)
 	{
 		gchSampleClockIndicator= RESET_FLAG;
-		chCheckFlag = RESET_FLAG;
 		
-		for(chSensorCounter = RESET_COUNTER;chSensorCounter<gchTotalSensorEntry;chSensorCounter++)
+		//Only the sensors due at this sample clock are visited
+		chDueCount = fnFetchDueSensors(SAMPLE_CLOCK_SCHEDULE,&pchDueList);
+		
+		for(chDueIndex = RESET_COUNTER;chDueIndex < chDueCount;chDueIndex++)
 		{
-			//This will check if the sensor current sample counter is less then sensor's sample clock divisor then don't process further
-			if(++ghSensorControl[chSensorCounter].chSampleClockCounter >= ghSensorControl[chSensorCounter].chSampleClockDivisor)
+			chSensorCounter = pchDueList[chDueIndex];
+			
+			//If sampling in already running than ignore its next sampling (Mismatch in ExecutionTable design)
+			if(ghSensorRuntime.chSensorStatusFlag[chSensorCounter]==SAMPLE_STATE_OFF)
 			{
-				ghSensorControl[chSensorCounter].chSampleClockCounter = RESET_COUNTER;
-				chCheckFlag = SET_FLAG;
-				
-				//If sampling in already running than ignore its next sampling (Mismatch in ExecutionTable design)
-				if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_OFF)
+				if(ghSensorRuntime.chSensorSampleAvgCounter[chSensorCounter] < ghSensorConfig[chSensorCounter].chSensorSampleAvgTotalCount)
 				{
-					if(ghSensorControl[chSensorCounter].chSensorSampleAvgCounter < ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount)
-					{
-						ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_START;
-					}
-					else
-					{
-						//Require Samples already taken
-					}
+					ghSensorRuntime.chSensorStatusFlag[chSensorCounter]=SAMPLE_STATE_START;
+					gchActiveSensorMap[chSensorCounter >> 3] |= (1 << (chSensorCounter & 0x07));		//Add the sensor in active sensor worklist
+					gchActiveSensorCount++;
 				}
 				else
 				{
-					SEND_ERROR_CODE_OVER_RF(SENSOR_SENSOR_SAMPLING_OVERRUN);
-					SEND_DEBUG_ERROR_CODES(SENSOR_SENSOR_SAMPLING_OVERRUN);
+					//Require Samples already taken
 				}
 			}
-		}
-		
-		if(chCheckFlag == RESET_FLAG)
-		{
-			return RETURN_TRUE;
+			else
+			{
+				PHASE_ANALYZER_OVERRUN(SENSOR_SENSOR_SAMPLING_OVERRUN);
+				SEND_ERROR_CODE_OVER_RF(SENSOR_SENSOR_SAMPLING_OVERRUN);
+				SEND_DEBUG_ERROR_CODES(SENSOR_SENSOR_SAMPLING_OVERRUN);
+			}
 		}
 	}
 	
-	for(chSensorCounter = RESET_COUNTER;chSensorCounter<gchTotalSensorEntry;chSensorCounter++)
+	//No sensor is started at this clock and no sampling is pending from previous clock
+	if(gchActiveSensorCount == RESET_COUNTER)
 	{
-		if(ghSensorControl[chSensorCounter].chSensorStatusFlag  != SAMPLE_STATE_OFF)
+		return RETURN_TRUE;
+	}
+	
+	//Only the sensors of active sensor worklist are visited, scanning stops once all of them are executed
+	chPendingCount = gchActiveSensorCount;
+	
+	for(chMapIndex = RESET_COUNTER;(chMapIndex < ACTIVE_SENSOR_MAP_SIZE) && (chPendingCount != RESET_COUNTER);chMapIndex++)
+	{
+		if(gchActiveSensorMap[chMapIndex] == RESET_VALUE)
 		{
-			switch (ghSensorControl[chSensorCounter].chSensorID)
+			continue;
+		}
+		
+		chSensorCounter = (chMapIndex << 3);
+		
+		for(chMapBit = 0x01;chMapBit != RESET_VALUE;chMapBit <<= 1,chSensorCounter++)
+		{
+			if(gchActiveSensorMap[chMapIndex] & chMapBit)
 			{
-				case CHAMBER_TEMPERATURE:
-				
-					if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_START)
-					{
-						if(RETURN_TRUE==fnPowerSourceManager(POWER_SOURCE_ENABLE,TEMPERATURE_POWER_IDENTITY))
-						{
-							ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_RUN_LVL0;
-						}
-					}
-					else if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_RUN_LVL0)
-					{
-						if(RETURN_TRUE==fnStartChamberTemperature())
-						{
-							ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_RUN;
-						}
-						else
-						{
-							SEND_ERROR_CODE_OVER_RF(SENSOR_ADC_RESOURCES_ARE_NOT_FREE);
-							SEND_DEBUG_ERROR_CODES(SENSOR_ADC_RESOURCES_ARE_NOT_FREE);
-						}
-					}
-					else if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_RUN)
-					{
-						nDummyValue=fnFetchChamberTemperature();
-					
-						if(RETURN_FALSE!=nDummyValue)
-						{
-							ghSensorControl[chSensorCounter].nSensorAvgData += nDummyValue;
-						
-							if(++ghSensorControl[chSensorCounter].chSensorSampleAvgCounter>=ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount)
-							{
-								ghSensorControl[chSensorCounter].nSensorData[0]= (ghSensorControl[chSensorCounter].nSensorAvgData/ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount);
-							}
-						
-							ghSensorControl[chSensorCounter].chSensorStatusFlag = SAMPLE_STATE_OFF;		//This indicates sampling is done
-							SEND_DEBUG_STRING("Chamber Temperature Data Available\n");
-							fnPowerSourceManager(POWER_SOURCE_DISABLE,TEMPERATURE_POWER_IDENTITY);
-						}
-					}
-				break;
-				
-				case GYRO_METER:
-				
-					if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_START)
-					{
-						if(fnCheckI2cAvailability()==RETURN_TRUE)
-						{
-							ACQUIRE_I2C_INTERFACE;
-							ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_RUN_LVL0;
-						}
-					}
-					else if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_RUN_LVL0)
-					{
-						if(fnInitializeGyrometer()==RETURN_TRUE)
-						{
-							SEND_DEBUG_STRING("Gyrometer Initialized\n");
-							ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_RUN;
-						}
-					}
-					else if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_RUN)
-					{
-						if(RETURN_TRUE==fnFetchGyrometerMeasurements((uint16_t*)ghSensorControl[chSensorCounter].nSensorData))
-						{
-							ghSensorControl[chSensorCounter].chSensorSampleAvgCounter=ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount;
-							SEND_DEBUG_STRING("Gyrometer Data Available\n");
-							ghSensorControl[chSensorCounter].chSensorStatusFlag = SAMPLE_STATE_OFF;			//This will indicate sampling is done
-							RELEASE_I2C_INTERFACE;
-						}
-					}
-				break;
-				
-				case CHAMBER_PRESSURE:
+				chPendingCount--;
+				chSensorState = ghSensorRuntime.chSensorStatusFlag[chSensorCounter];
 				
-					if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_START)
-					{
-						if(RETURN_TRUE==fnPowerSourceManager(POWER_SOURCE_ENABLE,PRESSURE_POWER_IDENTITY))
-						{
-							ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_RUN_LVL0;
-						}
-					}
-					else if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_RUN_LVL0)
-					{
-						if(fnCheckI2cAvailability()==RETURN_TRUE)
-						{
-							ACQUIRE_I2C_INTERFACE;
-							ghSensorControl[chSensorCounter].chSensorStatusFlag=SAMPLE_STATE_RUN;
-						}
-					}
-					else if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_RUN)
-					{
-						nDummyValue=fnFetchChamberPressure();
-					
-						if(RETURN_FALSE!=nDummyValue)
-						{
-							ghSensorControl[chSensorCounter].nSensorAvgData += nDummyValue;
-						
-							if(++ghSensorControl[chSensorCounter].chSensorSampleAvgCounter>=ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount)
-							{
-								ghSensorControl[chSensorCounter].nSensorData[0]= (ghSensorControl[chSensorCounter].nSensorAvgData/ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount);
-							}
-						
-							SEND_DEBUG_STRING("Pressure Sensor Data Available\n");
-							ghSensorControl[chSensorCounter].chSensorStatusFlag = SAMPLE_STATE_OFF;		//This will indicate sampling is done
-							fnPowerSourceManager(POWER_SOURCE_DISABLE,PRESSURE_POWER_IDENTITY);
-							RELEASE_I2C_INTERFACE;
-						}
-					}
-				break;
-				
-				case UPLINK_RADIO_RSSI:
-					
-					if(ghSensorControl[chSensorCounter].chSensorStatusFlag==SAMPLE_STATE_START)
-					{
-						ghSensorControl[chSensorCounter].nSensorAvgData += gchUplinkRSSI;
-
-						if(++ghSensorControl[chSensorCounter].chSensorSampleAvgCounter>=ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount)
-						{
-							ghSensorControl[chSensorCounter].nSensorData[0]= (ghSensorControl[chSensorCounter].nSensorAvgData/ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount);
-						}
-
-						SEND_DEBUG_STRING("RSSI Measurement Data Available\n");
-						ghSensorControl[chSensorCounter].chSensorStatusFlag = SAMPLE_STATE_OFF;		//This will indicate sampling is done
-					}
-				break;
-				
-				case BATTERY_TEMPERATURE:
-				break;
-				
-				case TEG_TEMPERATURE_COLD:
-				break;
+				fnExecuteSensorDriver(chSensorCounter);
 				
-				case TEG_TEMPERATURE_HOT:
-				break;
+				if(chSensorState != ghSensorRuntime.chSensorStatusFlag[chSensorCounter])
+				{
+					chProgressFlag = SET_FLAG;
+				}
 				
-				default:
-					SEND_ERROR_CODE_OVER_RF(SENSOR_INVALID_EXECUTION_DEVELOPER_ERROR);
-					SEND_DEBUG_ERROR_CODES(SENSOR_INVALID_EXECUTION_DEVELOPER_ERROR);
-				break;
+				//Sampling is done, remove the sensor from worklist
+				if(ghSensorRuntime.chSensorStatusFlag[chSensorCounter] == SAMPLE_STATE_OFF)
+				{
+					gchActiveSensorMap[chMapIndex] &= ~chMapBit;
+					gchActiveSensorCount--;
+				}
 			}
 		}
 	}
 	
-	//This loop will check the sampling status of every sensors, If sampling is not done then it will return false
-	for(chSensorCounter = RESET_COUNTER;chSensorCounter < gchTotalSensorEntry;chSensorCounter++)
+	//If sampling of any sensor is not done then it will return false
+	if(gchActiveSensorCount != RESET_COUNTER)
 	{
-		if(ghSensorControl[chSensorCounter].chSensorStatusFlag != SAMPLE_STATE_OFF)
+		//Sensor state or I2C step is moved without starting hardware operation (register access completed and next one not yet started)
+		//so no event will arrive for it, execute the task again in next pass
+		if((chProgressFlag == SET_FLAG) || (chLvl1StepIndex != gchLvl1StepIndexI2C) || ((chLvl2StepIndex != gchLvl2StepIndexI2C) && (gchLvl2StepIndexI2C == STEP_0_Val)))
 		{
-			return RETURN_FALSE;
+			WAKE_TASKS(DATA_SAMPLING_TASK);
 		}
+		
+		return RETURN_FALSE;
 	}
 	
 	return RETURN_TRUE;
 }
 
+//_____ fnPayloadZigzagDelta ____________________________________________________________________
+//
+// @brief	Difference of data word from its reference mapped by zigzag encoding (0,-1,1,-2,2.. gives 0,1,2,3,4..)
+//			so small changes of either sign give small values which need one or two varint bytes
+// @param	nData			Data word of sensor
+//			nReference		Data word of key entry (0 for key entry itself)
+// @return	Zigzag mapped difference
+
+static uint16_t fnPayloadZigzagDelta(uint16_t nData,uint16_t nReference)
+{
+	int16_t nDelta = (int16_t)(nData - nReference);
+	
+	return ((uint16_t)nDelta << 1) ^ (uint16_t)(nDelta >> 15);
+}
+
+//_____ fnPayloadEntryLength ____________________________________________________________________
+//
+// @brief	Bytes of delta encoded sensor entry (header followed by varint of every data word) so exact space can be reserved in data packet
+// @param	chSensorCounter		Index of sensor entry
+// @return	Length of encoded sensor entry
+
+static uint8_t fnPayloadEntryLength(uint8_t chSensorCounter)
+{
+	uint8_t chLength = SET_COUNTER;					//Header of sensor entry
+	uint8_t chLoopIndex = RESET_COUNTER;
+	uint16_t nZigzag = RESET_VALUE;
+	
+	for(chLoopIndex = RESET_COUNTER;chLoopIndex<ghSensorConfig[chSensorCounter].chSensorDataLength;chLoopIndex++)
+	{
+		if((chSensorCounter >= MAX_KEY_SENSOR_COUNT) || (ghSensorKey[chSensorCounter].chKeyCountdown == RESET_COUNTER))
+		{
+			nZigzag = fnPayloadZigzagDelta(ghSensorSample[chSensorCounter].nSensorData[chLoopIndex],RESET_VALUE);
+		}
+		else
+		{
+			nZigzag = fnPayloadZigzagDelta(ghSensorSample[chSensorCounter].nSensorData[chLoopIndex],ghSensorKey[chSensorCounter].nKeyData[chLoopIndex]);
+		}
+		
+		chLength++;
+		while(nZigzag > PAYLOAD_VARINT_DATA_BM)
+		{
+			nZigzag >>= 7;
+			chLength++;
+		}
+	}
+	
+	return chLength;
+}
+
+//_____ fnPayloadEncodeEntry ____________________________________________________________________
+//
+// @brief	Writes delta encoded sensor entry into the space reserved in data packet (fnPayloadEntryLength bytes).
+//			Key entry starts new key epoch of sensor and its data becomes reference of next entries.
+//			Sensor entry without key data writes key entry of epoch 0 every time.
+// @param	chSensorCounter		Index of sensor entry
+//			pchData				Reserved space in data packet
+// @return	SET_FLAG if key entry is written otherwise RESET_FLAG (Key entry of sensor without key data is not referred so it is not reported)
+
+static uint8_t fnPayloadEncodeEntry(uint8_t chSensorCounter,uint8_t *pchData)
+{
+	SENSOR_SAMPLE_STRUCT *phSample = &ghSensorSample[chSensorCounter];
+	SENSOR_KEY_STRUCT *phKey = NULL;
+	uint8_t chKeyEntry = SET_FLAG;
+	uint8_t chKeyEpoch = RESET_VALUE;
+	uint8_t chLoopIndex = RESET_COUNTER;
+	uint16_t nZigzag = RESET_VALUE;
+	
+	if(chSensorCounter < MAX_KEY_SENSOR_COUNT)
+	{
+		phKey = &ghSensorKey[chSensorCounter];
+		
+		if(phKey->chKeyCountdown == RESET_COUNTER)
+		{
+			phKey->chKeyEpoch = (phKey->chKeyEpoch + 1) & (PAYLOAD_KEY_EPOCH_BM >> PAYLOAD_KEY_EPOCH_bp);
+			phKey->chKeyCountdown = PAYLOAD_KEY_INTERVAL;
+		}
+		else
+		{
+			chKeyEntry = RESET_FLAG;
+		}
+		phKey->chKeyCountdown--;
+		chKeyEpoch = phKey->chKeyEpoch;
+	}
+	
+	*pchData++ = (ghSensorConfig[chSensorCounter].chSensorID & PAYLOAD_SENSOR_ID_BM) | (chKeyEpoch << PAYLOAD_KEY_EPOCH_bp) | (chKeyEntry ? PAYLOAD_KEY_FLAG_BM : RESET_VALUE);
+	
+	for(chLoopIndex = RESET_COUNTER;chLoopIndex<ghSensorConfig[chSensorCounter].chSensorDataLength;chLoopIndex++)
+	{
+		if(chKeyEntry)
+		{
+			nZigzag = fnPayloadZigzagDelta(phSample->nSensorData[chLoopIndex],RESET_VALUE);
+			if(phKey != NULL)
+			{
+				phKey->nKeyData[chLoopIndex] = phSample->nSensorData[chLoopIndex];
+			}
+		}
+		else
+		{
+			nZigzag = fnPayloadZigzagDelta(phSample->nSensorData[chLoopIndex],phKey->nKeyData[chLoopIndex]);
+		}
+		
+		//Varint: 7 bits per byte, least significant first
+		while(nZigzag > PAYLOAD_VARINT_DATA_BM)
+		{
+			*pchData++ = (nZigzag & PAYLOAD_VARINT_DATA_BM) | PAYLOAD_VARINT_MORE_BM;
+			nZigzag >>= 7;
+		}
+		*pchData++ = nZigzag;
+	}
+	
+	return (phKey != NULL) ? chKeyEntry : RESET_FLAG;
+}
+
+//_____ fnPayloadRequestKeys ____________________________________________________________________
+//
+// @brief	Called when generation carrying key entries is lost (dropped from collection queue or not delivered).
+//			Every sensor sends key entry next time so receiver gets new reference for the following delta entries.
+
+static void fnPayloadRequestKeys(void)
+{
+	uint8_t chKeyIndex = RESET_COUNTER;
+	
+	for(chKeyIndex = RESET_COUNTER;chKeyIndex < MAX_KEY_SENSOR_COUNT;chKeyIndex++)
+	{
+		ghSensorKey[chKeyIndex].chKeyCountdown = RESET_COUNTER;
+	}
+	
+	return;
+}
+
+//_____ fnPayloadPackedBits ____________________________________________________________________
+//
+// @brief	Bits of bit packed sensor entry (Sensor ID followed by data words of width declared in sensor driver registry)
+// @param	chSensorCounter		Index of sensor entry
+// @return	Length of packed sensor entry in bits
+
+static uint16_t fnPayloadPackedBits(uint8_t chSensorCounter)
+{
+	return PAYLOAD_PACKED_ID_BITS + ((uint16_t)ghSensorConfig[chSensorCounter].chSensorDataLength * ghSensorConfig[chSensorCounter].chSensorDataBits);
+}
+
+//_____ fnPayloadPackEntry ____________________________________________________________________
+//
+// @brief	Packs sensor entry into bit stream of data packet, caller makes sure that fnPayloadPackedBits of entry are free in the packet
+// @param	phBuilder			Packet builder of current packet
+//			chSensorCounter		Index of sensor entry
+
+static void fnPayloadPackEntry(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chSensorCounter)
+{
+	uint8_t chLoopIndex = RESET_COUNTER;
+	
+	fnPacketBuilderPackBits(phBuilder,ghSensorConfig[chSensorCounter].chSensorID,PAYLOAD_PACKED_ID_BITS);
+	
+	for(chLoopIndex = RESET_COUNTER;chLoopIndex<ghSensorConfig[chSensorCounter].chSensorDataLength;chLoopIndex++)
+	{
+		fnPacketBuilderPackBits(phBuilder,ghSensorSample[chSensorCounter].nSensorData[chLoopIndex],ghSensorConfig[chSensorCounter].chSensorDataBits);
+	}
+	
+	return;
+}
+
+//_____ fnAllocateCollectionSlot ____________________________________________________________________
+//
+// @brief	Finds free slot of collection queue for the packets of current radio clock.
+//			If all the slots are occupied than oldest generation waiting for download is dropped to make room for the new one.
+//			Generation which is being downloaded is never dropped.
+//			Generation carrying key entries of delta encoding is dropped only if all the others carry them as well (Newer delta entries refer to it).
+// @param	pchSlot		Returns the free slot
+// @return	FALSE if only the generation being downloaded occupies the slots otherwise TRUE
+
+static int8_t fnAllocateCollectionSlot(uint8_t *pchSlot)
+{
+	uint8_t chOrderIndex = RESET_COUNTER;
+	uint8_t chSlot = RESET_COUNTER;
+	
+	if(ghCollectionQueue.chQueuedCount >= ghCollectionQueue.chSlotCount)
+	{
+		//Oldest generation which is not in flight
+		chOrderIndex = (ghCollectionQueue.chInFlight == SET_FLAG) ? SET_COUNTER : RESET_COUNTER;
+		
+		if(chOrderIndex >= ghCollectionQueue.chQueuedCount)
+		{
+			return RETURN_FALSE;
+		}
+		
+		//Oldest one without key entries
+		for(chSlot = chOrderIndex;chSlot < ghCollectionQueue.chQueuedCount;chSlot++)
+		{
+			if(ghCollectionQueue.chKeyEntries[ghCollectionQueue.chSlotOrder[chSlot]] == RESET_FLAG)
+			{
+				chOrderIndex = chSlot;
+				break;
+			}
+		}
+		
+		ghCollectionQueue.chPacketCount[ghCollectionQueue.chSlotOrder[chOrderIndex]] = RESET_COUNTER;
+		
+		if(ghCollectionQueue.chKeyEntries[ghCollectionQueue.chSlotOrder[chOrderIndex]] == SET_FLAG)
+		{
+			fnPayloadRequestKeys();
+		}
+		
+		for(;(chOrderIndex + 1) < ghCollectionQueue.chQueuedCount;chOrderIndex++)
+		{
+			ghCollectionQueue.chSlotOrder[chOrderIndex] = ghCollectionQueue.chSlotOrder[chOrderIndex + 1];
+		}
+		
+		ghCollectionQueue.chQueuedCount--;
+		SEND_ERROR_CODE_OVER_RF(SENSOR_COLLECTION_QUEUE_DROP);
+		SEND_DEBUG_ERROR_CODES(SENSOR_COLLECTION_QUEUE_DROP);
+	}
+	
+	for(chSlot = RESET_COUNTER;chSlot < ghCollectionQueue.chSlotCount;chSlot++)
+	{
+		if(ghCollectionQueue.chPacketCount[chSlot] == RESET_COUNTER)
+		{
+			*pchSlot = chSlot;
+			return RETURN_TRUE;
+		}
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnCollectSmartSensors ____________________________________________________________________
+//
+// @brief	Smart Sensors sample on their own, so at radio clock their measurements are shifted straight into sample slots of due entries.
+//			Sensors of SPID, SPIE and SPIF groups are fetched in one run (fnSmartSensorsAcquisitionRun).
+//			Measurement word is received MSB first and is turned into data word after the run.
+// @param	pchDueList		Sensor entries due at this radio clock
+//			chDueCount		No of due sensor entries
+
+static void fnCollectSmartSensors(uint8_t *pchDueList,uint8_t chDueCount)
+{
+	uint8_t chDueIndex = RESET_COUNTER;
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chAddress = RESET_VALUE;
+	uint8_t chQueued = RESET_FLAG;
+	uint8_t *pchSample = NULL;
+	
+	for(chDueIndex = RESET_COUNTER;chDueIndex < chDueCount;chDueIndex++)
+	{
+		chSensorCounter = pchDueList[chDueIndex];
+		
+		if(!IS_SMART_SENSOR_ID(ghSensorConfig[chSensorCounter].chSensorID))
+		{
+			continue;
+		}
+		
+		chAddress = ghSensorConfig[chSensorCounter].chSmartSensorAddress;
+		if(fnSmartSensorsAcquisitionAdd(SMART_SENSOR_ADDRESS_GROUP(chAddress),SMART_SENSOR_ADDRESS_VALUE(chAddress),
+										(uint8_t *)ghSensorSample[chSensorCounter].nSensorData,SMART_SENSOR_DATA_LEN*2) == RETURN_TRUE)
+		{
+			chQueued = SET_FLAG;
+		}
+	}
+	
+	if(chQueued == RESET_FLAG)
+	{
+		return;
+	}
+	
+	fnSmartSensorsAcquisitionRun();
+	
+	for(chDueIndex = RESET_COUNTER;chDueIndex < chDueCount;chDueIndex++)
+	{
+		chSensorCounter = pchDueList[chDueIndex];
+		
+		if(IS_SMART_SENSOR_ID(ghSensorConfig[chSensorCounter].chSensorID))
+		{
+			pchSample = (uint8_t *)ghSensorSample[chSensorCounter].nSensorData;
+			ghSensorSample[chSensorCounter].nSensorData[0] = ((uint16_t)pchSample[0] << BIT_8_bp) | pchSample[1];
+		}
+	}
+	
+	return;
+}
+
 //_____ fnData_Collection_Task ____________________________________________________________________
 //
 // @brief	This function performs all the data collection related operations on the basis of available tasking table
 //			The entire mechanism can be explained in listed steps:
 //			STEP1:
-//				If last Data Download packet is not sent and request for new Data collection packet occurs than radio divisor overrun error will raised.
+//				Packets of every radio clock are collected in free slot of collection queue so data download of older ones may continue.
+//				If no slot is free than oldest generation waiting for download is dropped.
+//				If slot is occupied by generation being downloaded only than radio divisor overrun error will raised and this radio clock is dropped.
 //
 //			STEP-2: 
 //				Every sensor's radio clock counter is compared with its radio clock divisor.
 //				If match is not found than particular sensor is skipped from collection packet in existing clock cycle.
 //				But If match found than data for that sensor will get appended in the collection packet.
+//				Measurements of due Smart Sensors are fetched in one run of all the groups (fnCollectSmartSensors).
 //
 //			STEP3:
-//				Before filling the data into the SENSOR communication buffer function will check whether the sufficient space is available or not in current packet.
-//				If sufficient space is available in the packet then it will simply store the data into the same packet.
-//				if sufficient space is not available than new packet will get created for the remaining data.
+//				Space for the data of sensor is reserved in current packet of slot (fnPacketBuilderReserve) and data is written straight into it.
+//				If sufficient space is not available than current packet is closed and new packet will get created for the remaining data.
+//				Packet header is filled once when packet is closed and the same packet is later handed to radio by Data Download Task.
+//				If Execution Table selects delta encoding than sensor entry is written by fnPayloadEncodeEntry instead of raw data words.
+//				If Execution Table selects bit packed encoding than sensor entry is packed by fnPayloadPackEntry if its bits fit in the packet.
 //
 //			STEP-4: 
 //				After successful collection of the data packet Data Collection will get terminated till next radio clock availability. 
@@ -330,106 +639,113 @@ int8_t fnData_Collection_Task(void)
 {
 	uint8_t	chSensorCounter = RESET_COUNTER;
 	uint8_t chLoopIndex = RESET_COUNTER;
-	uint8_t chCheckFlag = RESET_FLAG;
-	uint8_t chSensorAvail = RESET_FLAG;
+	uint8_t chDueIndex = RESET_COUNTER;
+	uint8_t chDueCount = RESET_COUNTER;
+	uint8_t *pchDueList = NULL;
+	uint8_t chSlot = RESET_COUNTER;
+	uint8_t chFirstPacket = RESET_COUNTER;
+	uint8_t chDataLength = RESET_COUNTER;
+	uint8_t *pchData = NULL;
+	uint8_t chKeyEntries = RESET_FLAG;
+	uint16_t nEntryBits = RESET_VALUE;
+	PACKET_BUILDER_STRUCT hPacketBuilder;
 	
-	if(gchDataDownloadPacketReady)					//If data download task is already running than ignore this request
+	//Sensors due at this radio clock (schedule moves ahead even if this radio clock is dropped)
+	chDueCount = fnFetchDueSensors(RADIO_CLOCK_SCHEDULE,&pchDueList);
+	
+	if(chDueCount == RESET_COUNTER)
 	{
+		return RETURN_TRUE;
+	}
+	
+	if(fnAllocateCollectionSlot(&chSlot) == RETURN_FALSE)		//If data download task still holds the only slot than ignore this request
+	{
+		PHASE_ANALYZER_OVERRUN(SENSOR_RADIO_DIVISOR_OVERRUN);
 		SEND_ERROR_CODE_OVER_RF(SENSOR_RADIO_DIVISOR_OVERRUN);
 		SEND_DEBUG_ERROR_CODES(SENSOR_RADIO_DIVISOR_OVERRUN);
 		return RETURN_TRUE;
 	}
 	
-	//?????????????????
 	//Fetch data from smart sensors before filing the data packets
-	//?????????????????
-
-	//Initialization of data index from where data filling can be start in the packet
-	gchCollectionDataIndex		= PACKET_DATA_MESSAGE_INDEX;
-	gchCollectionPacketIndex	= RESET_VALUE;			//reset packet index
-	chCheckFlag		= RESET_FLAG;			//reset flag
-	chSensorCounter	= RESET_COUNTER;		//reset counter
-	chSensorAvail	= RESET_FLAG;			//reset  flag
+	fnCollectSmartSensors(pchDueList,chDueCount);
 	
-	while(1)
+	//First packet of slot
+	chFirstPacket = COLLECTION_FIRST_PACKET_INDEX + (chSlot * ghCollectionQueue.chSlotPackets);
+	fnPacketBuilderOpen(&hPacketBuilder,chFirstPacket,SET_COUNTER);
+	
+	for(chDueIndex = RESET_COUNTER;chDueIndex < chDueCount;chDueIndex++)
 	{
-		//This will compare the current radio clock counter with radio clock divisor of particular sensor.
-		if(++ghSensorControl[chSensorCounter].chRadioClockCounter >= ghSensorControl[chSensorCounter].chRadioClockDivisor)
-		{
-			chSensorAvail = SET_FLAG;
-			ghSensorControl[chSensorCounter].chRadioClockCounter = RESET_COUNTER;
-			
-			//This will add the sensor ID before its data
-			gchSensorCommBuff[gchCollectionPacketIndex][gchCollectionDataIndex++] = ghSensorControl[chSensorCounter].chSensorID;
-			
-			//This loop will fill the SENSOR communication buffer with the data
-			for(chLoopIndex = RESET_COUNTER;chLoopIndex<ghSensorControl[chSensorCounter].chSensorDataLength;chLoopIndex++)
-			{
-				gchSensorCommBuff[gchCollectionPacketIndex][gchCollectionDataIndex++]=ghSensorControl[chSensorCounter].nSensorData[chLoopIndex] >> BIT_8_bp;
-				gchSensorCommBuff[gchCollectionPacketIndex][gchCollectionDataIndex++]=ghSensorControl[chSensorCounter].nSensorData[chLoopIndex];
-				ghSensorControl[chSensorCounter].nSensorData[chLoopIndex] = RESET_VALUE;
-			}
-			
-			if(ghSensorControl[chSensorCounter].chSensorSampleAvgCounter>=ghSensorControl[chSensorCounter].chSensorSampleAvgTotalCount)
-			{
-				ghSensorControl[chSensorCounter].chSensorSampleAvgCounter = RESET_COUNTER;
-				ghSensorControl[chSensorCounter].nSensorAvgData = RESET_VALUE;
-			}
-		}
+		chSensorCounter = pchDueList[chDueIndex];
 		
-		if(++chSensorCounter>=gchTotalSensorEntry)
+		if(ghMasterTaskTable.chPayloadEncoding == PAYLOAD_ENCODING_PACKED)
 		{
-			if(chSensorAvail)
-			{
-				chCheckFlag = SET_FLAG;
-			}
-			else
+			//If the packet does not have enough bits for the entry of sensor then pack it in the next coming packet
+			nEntryBits = fnPayloadPackedBits(chSensorCounter);
+			if(fnPacketBuilderFreeBits(&hPacketBuilder) < nEntryBits)
 			{
-				return RETURN_TRUE;
+				fnPacketBuilderClose(&hPacketBuilder,RESET_FLAG);
+				fnPacketBuilderOpen(&hPacketBuilder,chFirstPacket + hPacketBuilder.chPacketSeqNo,hPacketBuilder.chPacketSeqNo + 1);
 			}
+			
+			fnPayloadPackEntry(&hPacketBuilder,chSensorCounter);
+			PACKET_COPY_PROFILE((nEntryBits + 7) >> 3);
 		}
-		
-		//If the packet is full and not able to fill the total data of sensor then fill the next coming packet
-		if(chCheckFlag || (gchCollectionDataIndex + (ghSensorControl[chSensorCounter].chSensorDataLength*2) + 1 > PACKET_LAST_DATA_BYTE_INDEX))		//1 is used to add Offset of SensorID
+		else
 		{
-			if (ghMasterTaskTable.chDataDownloadChannel == RADIO_CH_FAST_DOWNLINK_CC2520)
+			chDataLength = (ghSensorConfig[chSensorCounter].chSensorDataLength*2) + 1;		//1 is used to add Offset of SensorID
+			
+			if(ghMasterTaskTable.chPayloadEncoding == PAYLOAD_ENCODING_DELTA)
 			{
-				gchSensorCommBuff[gchCollectionPacketIndex][PACKET_HEADER_INDEX]=FAST_DL_DATA_PACKET;	//fast down link
-				ghSensorCommManager.hPacketDescriptor.chTransmitterID=RADIO_CH_FAST_DOWNLINK_CC2520;
+				chDataLength = fnPayloadEntryLength(chSensorCounter);
 			}
-			else
+			
+			//If the packet is full and not able to fill the total data of sensor then fill the next coming packet
+			pchData = fnPacketBuilderReserve(&hPacketBuilder,chDataLength);
+			if(pchData == NULL)
 			{
-				gchSensorCommBuff[gchCollectionPacketIndex][PACKET_HEADER_INDEX]=SLOW_DL_DATA_PACKET;	//slow down link
-				ghSensorCommManager.hPacketDescriptor.chTransmitterID=RADIO_CH_SLOW_DOWNLINK_CC1125;
+				fnPacketBuilderClose(&hPacketBuilder,RESET_FLAG);
+				fnPacketBuilderOpen(&hPacketBuilder,chFirstPacket + hPacketBuilder.chPacketSeqNo,hPacketBuilder.chPacketSeqNo + 1);
+				pchData = fnPacketBuilderReserve(&hPacketBuilder,chDataLength);
 			}
 			
-			if(chCheckFlag)
+			if(ghMasterTaskTable.chPayloadEncoding == PAYLOAD_ENCODING_DELTA)
 			{
-				ghSensorCommManager.hPacketDescriptor.chLastPacket = SET_FLAG;	//last packet indication
+				chKeyEntries |= fnPayloadEncodeEntry(chSensorCounter,pchData);
 			}
 			else
 			{
-				ghSensorCommManager.hPacketDescriptor.chLastPacket = RESET_FLAG;
-			}
-			
-			gchCollectionDataIndex--;
-			ghSensorCommManager.hPacketDescriptor.chPacketSeqNo=gchCollectionPacketIndex+1;
-			gchSensorCommBuff[gchCollectionPacketIndex][PACKET_DESCRIPTOR_INDEX]=ghSensorCommManager.hPacketDescriptor.chPacketDescriptor;
-			gchSensorCommBuff[gchCollectionPacketIndex][PACKET_DATA_LENGTH_INDEX]=gchCollectionDataIndex;
-			gchSensorCommBuff[gchCollectionPacketIndex][CC1125_DATA_PACKET_LENGTH]=gchCollectionDataIndex;
-			gchSensorCommBuff[gchCollectionPacketIndex][PACKET_DOWNLOAD_DATA_SIZE]=gchCollectionDataIndex - PACKET_DATA_MESSAGE_INDEX + 2;	//download data size
-			gchCollectionDataIndex=PACKET_DATA_MESSAGE_INDEX;
-			
-			if(chCheckFlag)
-			{
-				break;
+				//This will add the sensor ID before its data
+				*pchData++ = ghSensorConfig[chSensorCounter].chSensorID;
+				
+				//This loop will fill the reserved bytes of packet with the data
+				for(chLoopIndex = RESET_COUNTER;chLoopIndex<ghSensorConfig[chSensorCounter].chSensorDataLength;chLoopIndex++)
+				{
+					*pchData++ = ghSensorSample[chSensorCounter].nSensorData[chLoopIndex] >> BIT_8_bp;
+					*pchData++ = ghSensorSample[chSensorCounter].nSensorData[chLoopIndex];
+				}
 			}
+			PACKET_COPY_PROFILE(chDataLength);
+		}
+		
+		for(chLoopIndex = RESET_COUNTER;chLoopIndex<ghSensorConfig[chSensorCounter].chSensorDataLength;chLoopIndex++)
+		{
+			ghSensorSample[chSensorCounter].nSensorData[chLoopIndex] = RESET_VALUE;
+		}
+		
+		if(ghSensorRuntime.chSensorSampleAvgCounter[chSensorCounter]>=ghSensorConfig[chSensorCounter].chSensorSampleAvgTotalCount)
+		{
+			ghSensorRuntime.chSensorSampleAvgCounter[chSensorCounter] = RESET_COUNTER;
+			ghSensorSample[chSensorCounter].nSensorAvgData = RESET_VALUE;
 		}
 	}
 	
-	ghSensorCommManager.chTotalPacketCount=gchCollectionPacketIndex+1;
-	gchCollectionPacketIndex	= RESET_COUNTER;		//Resetting of packet index
-	gchCollectionDataIndex		= RESET_COUNTER;			//Resetting of Data index
+	fnPacketBuilderClose(&hPacketBuilder,SET_FLAG);
+	
+	//Put the generation at the end of collection queue
+	ghCollectionQueue.chPacketCount[chSlot] = hPacketBuilder.chPacketSeqNo;
+	ghCollectionQueue.chKeyEntries[chSlot] = chKeyEntries;
+	ghCollectionQueue.chSlotOrder[ghCollectionQueue.chQueuedCount++] = chSlot;
+	
 	gchDataDownloadPacketReady = SET_FLAG;
 	
 	SEND_DEBUG_STRING("Data Collection Completed\n");
@@ -448,6 +764,8 @@ int8_t fnData_Collection_Task(void)
 
 void fnResetFirmwareResourceAllocations(void)
 {
+	uint8_t chMapIndex = RESET_COUNTER;
+	
 	//ADC Resources
 	fnResetAdcResources();
 	
@@ -461,17 +779,408 @@ void fnResetFirmwareResourceAllocations(void)
 	gchLvl2StepIndexI2C=RESET_VALUE;
 	gchStepIndexE2PROM=RESET_VALUE;
 	
+	//E2PROM transaction of store-and-forward log is discarded with I2C so log is scanned again
+	fnSampleLogInit();
+	
 	//Power Resources
 	ghPowerManager.chCheckFlag=RESET_FLAG;
 	ghPowerManager.chPowerUsageCounter=RESET_COUNTER;
 	
-	//Data Collection Task
-	gchCollectionDataIndex=RESET_VALUE;
-	gchCollectionPacketIndex=RESET_VALUE;
+	//Collection queue is divided in slots again when new Execution Table is accepted
+	for(chMapIndex = RESET_COUNTER;chMapIndex < COLLECTION_QUEUE_DEPTH;chMapIndex++)
+	{
+		ghCollectionQueue.chPacketCount[chMapIndex] = RESET_COUNTER;
+	}
+	
+	ghCollectionQueue.chSlotCount = RESET_COUNTER;
+	ghCollectionQueue.chQueuedCount = RESET_COUNTER;
+	ghCollectionQueue.chInFlight = RESET_FLAG;
 	
 	//System Global Definitions
 	gchDataDownloadPacketReady=RESET_FLAG;
+	ghSensorCommManager.chDownloadMode=DOWNLOAD_MODE_LIVE;
+	ghSensorCommManager.chUplinkDown=RESET_FLAG;
 	gchTotalSensorEntry=RESET_COUNTER;
 	
+	//Data Sampling Task
+	for(chMapIndex = RESET_COUNTER;chMapIndex < ACTIVE_SENSOR_MAP_SIZE;chMapIndex++)
+	{
+		gchActiveSensorMap[chMapIndex] = RESET_VALUE;
+	}
+	
+	gchActiveSensorCount = RESET_COUNTER;
+	
+	//Divisor schedules are compiled again when new Execution Table is accepted
+	ghSampleSchedule.chHyperPeriod = RESET_VALUE;
+	ghRadioSchedule.chHyperPeriod = RESET_VALUE;
+	
+	return;
+}
+
+//_____ fnDivisorLCM ____________________________________________________________________
+//
+// @brief	Extends the hyperperiod of divisor schedule with the divisor of one more sensor
+// @param	chHyperPeriod	Hyperperiod of sensors added so far
+//			chDivisor		Divisor of sensor to add
+// @return	LCM of both values or 0 if it exceeds MAX_SCHEDULE_HYPERPERIOD
+
+static uint8_t fnDivisorLCM(uint8_t chHyperPeriod,uint8_t chDivisor)
+{
+	uint8_t chFirst = chHyperPeriod;
+	uint8_t chSecond = chDivisor;
+	uint8_t chRemainder = RESET_VALUE;
+	uint16_t nLCM = RESET_VALUE;
+	
+	//Euclid's algorithm for GCD
+	while(chSecond != RESET_VALUE)
+	{
+		chRemainder = chFirst % chSecond;
+		chFirst = chSecond;
+		chSecond = chRemainder;
+	}
+	
+	nLCM = (uint16_t)(chHyperPeriod / chFirst) * chDivisor;
+	
+	if(nLCM > MAX_SCHEDULE_HYPERPERIOD)
+	{
+		return RESET_VALUE;
+	}
+	
+	return (uint8_t)nLCM;
+}
+
+//_____ fnScheduleDivisor ____________________________________________________________________
+//
+// @brief	Divisor of sensor entry used by divisor schedule (Divisor 0 is served at every tick same as the sequential counters)
+// @param	chScheduleType		SAMPLE_CLOCK_SCHEDULE or RADIO_CLOCK_SCHEDULE
+//			chSensorCounter		Index of sensor entry in ghSensorConfig
+// @return	Divisor of sensor
+
+static uint8_t fnScheduleDivisor(uint8_t chScheduleType,uint8_t chSensorCounter)
+{
+	uint8_t chDivisor = ghSensorConfig[chSensorCounter].chSampleClockDivisor;
+	
+	if(chScheduleType == RADIO_CLOCK_SCHEDULE)
+	{
+		chDivisor = ghSensorConfig[chSensorCounter].chRadioClockDivisor;
+	}
+	
+	if(chDivisor == RESET_VALUE)
+	{
+		chDivisor = SET_VALUE;
+	}
+	
+	return chDivisor;
+}
+
+//_____ fnScheduleExcludes ____________________________________________________________________
+//
+// @brief	Smart Sensors sample on their own with divisor pushed by fnStartSmartSensorSampling, so they are left out of sample clock schedule
+//			and Data Sampling Task never executes them. They stay in radio clock schedule for collection.
+// @param	chScheduleType		SAMPLE_CLOCK_SCHEDULE or RADIO_CLOCK_SCHEDULE
+//			chSensorCounter		Index of sensor entry in ghSensorConfig
+// @return	SET_FLAG if sensor entry is not served by the schedule otherwise RESET_FLAG
+
+static uint8_t fnScheduleExcludes(uint8_t chScheduleType,uint8_t chSensorCounter)
+{
+	if((chScheduleType == SAMPLE_CLOCK_SCHEDULE) && IS_SMART_SENSOR_ID(ghSensorConfig[chSensorCounter].chSensorID))
+	{
+		return SET_FLAG;
+	}
+	
+	return RESET_FLAG;
+}
+
+//_____ fnCompileDivisorSchedule ____________________________________________________________________
+//
+// @brief	Compiles the divisors of all the sensor entries into divisor schedule.
+//			Ticks are matched with the sequential counters loaded by fnET_Upload_Task:
+//				Sample clock counter starts from divisor so sensor is due at tick 0, divisor, 2*divisor, ...
+//				Radio clock counter starts from 0 so sensor is due at tick divisor-1, 2*divisor-1, ...
+//			Entries of every tick are kept in order of sensor entries to keep the same order of data in collection packet.
+//			Smart Sensors are left out of sample clock schedule (fnScheduleExcludes).
+// @param	phSchedule		Divisor schedule to compile
+//			chScheduleType	SAMPLE_CLOCK_SCHEDULE or RADIO_CLOCK_SCHEDULE
+
+static void fnCompileDivisorSchedule(DIVISOR_SCHEDULE_STRUCT *phSchedule,uint8_t chScheduleType)
+{
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chTick = RESET_COUNTER;
+	uint8_t chDivisor = RESET_VALUE;
+	uint8_t chHyperPeriod = SET_VALUE;
+	uint8_t chEntryCount = RESET_COUNTER;
+	uint8_t chDueOffset = RESET_VALUE;
+	
+	//Sequential counters are used till the schedule is compiled, worst case all sensors are due at same tick
+	phSchedule->chHyperPeriod = RESET_VALUE;
+	phSchedule->chTickIndex = RESET_COUNTER;
+	phSchedule->chPeakDueCount = gchTotalSensorEntry;
+	
+	for(chSensorCounter = RESET_COUNTER;chSensorCounter < gchTotalSensorEntry;chSensorCounter++)
+	{
+		if(fnScheduleExcludes(chScheduleType,chSensorCounter))
+		{
+			continue;
+		}
+		
+		chHyperPeriod = fnDivisorLCM(chHyperPeriod,fnScheduleDivisor(chScheduleType,chSensorCounter));
+		
+		if(chHyperPeriod == RESET_VALUE)
+		{
+			return;
+		}
+	}
+	
+	if(chScheduleType == RADIO_CLOCK_SCHEDULE)
+	{
+		chDueOffset = SET_VALUE;
+	}
+	
+	phSchedule->chPeakDueCount = RESET_COUNTER;
+	
+	for(chTick = RESET_COUNTER;chTick < chHyperPeriod;chTick++)
+	{
+		phSchedule->chTickStart[chTick] = chEntryCount;
+		
+		for(chSensorCounter = RESET_COUNTER;chSensorCounter < gchTotalSensorEntry;chSensorCounter++)
+		{
+			chDivisor = fnScheduleDivisor(chScheduleType,chSensorCounter);
+			
+			if(!fnScheduleExcludes(chScheduleType,chSensorCounter) && (((chTick + chDueOffset) % chDivisor) == RESET_VALUE))
+			{
+				if(chEntryCount >= MAX_SCHEDULE_ENTRIES)
+				{
+					phSchedule->chPeakDueCount = gchTotalSensorEntry;
+					return;
+				}
+				
+				phSchedule->chEntries[chEntryCount++] = chSensorCounter;
+			}
+		}
+		
+		if((chEntryCount - phSchedule->chTickStart[chTick]) > phSchedule->chPeakDueCount)
+		{
+			phSchedule->chPeakDueCount = chEntryCount - phSchedule->chTickStart[chTick];
+		}
+	}
+	
+	phSchedule->chTickStart[chHyperPeriod] = chEntryCount;
+	phSchedule->chHyperPeriod = chHyperPeriod;						//Schedule is valid from now
+	
+	return;
+}
+
+//_____ fnCompileDivisorSchedules ____________________________________________________________________
+//
+// @brief	Called when new Execution Table is accepted to compile sample and radio clock divisors of all the sensor entries into divisor schedules.
+//			Schedule holds the list of sensors due at every tick over the hyperperiod (LCM of divisors) so every tick costs only as much as the sensors due.
+//			If hyperperiod exceeds MAX_SCHEDULE_HYPERPERIOD or entries exceed MAX_SCHEDULE_ENTRIES than sequential counters of sensors are used.
+//			Load of the busiest radio clock is predicted and Execution Table is rejected if its data can not fit in MAX_COMM_PACKET_COUNT packets.
+//			Otherwise packets of collection queue are divided in slots of the size of busiest radio clock.
+// @return	FALSE if Execution Table overloads the data collection otherwise TRUE
+
+int8_t fnCompileDivisorSchedules(void)
+{
+	uint8_t chTick = RESET_COUNTER;
+	uint8_t chBusyTick = RESET_COUNTER;
+	uint8_t chEntryIndex = RESET_COUNTER;
+	uint8_t chEntryLast = gchTotalSensorEntry;
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chPacketCount = SET_COUNTER;
+	uint8_t chDataLength = RESET_COUNTER;
+	uint16_t nDataIndex = PACKET_DATA_MESSAGE_INDEX;
+	
+	fnCompileDivisorSchedule(&ghSampleSchedule,SAMPLE_CLOCK_SCHEDULE);
+	fnCompileDivisorSchedule(&ghRadioSchedule,RADIO_CLOCK_SCHEDULE);
+	
+	//Busiest radio clock tick (all the sensors if schedule is not compiled)
+	if(ghRadioSchedule.chHyperPeriod != RESET_VALUE)
+	{
+		for(chTick = RESET_COUNTER;chTick < ghRadioSchedule.chHyperPeriod;chTick++)
+		{
+			if((ghRadioSchedule.chTickStart[chTick + 1] - ghRadioSchedule.chTickStart[chTick]) == ghRadioSchedule.chPeakDueCount)
+			{
+				chBusyTick = chTick;
+				break;
+			}
+		}
+		
+		chEntryIndex = ghRadioSchedule.chTickStart[chBusyTick];
+		chEntryLast = ghRadioSchedule.chTickStart[chBusyTick + 1];
+	}
+	
+	//Same packing as fnData_Collection_Task
+	//Delta encoded entries are packed with their worst case length, actual entries are never longer so generation never needs more packets
+	for(;chEntryIndex < chEntryLast;chEntryIndex++)
+	{
+		chSensorCounter = chEntryIndex;
+		
+		if(ghRadioSchedule.chHyperPeriod != RESET_VALUE)
+		{
+			chSensorCounter = ghRadioSchedule.chEntries[chEntryIndex];
+		}
+		
+		chDataLength = (ghSensorConfig[chSensorCounter].chSensorDataLength*2) + 1;
+		
+		if(ghMasterTaskTable.chPayloadEncoding == PAYLOAD_ENCODING_DELTA)
+		{
+			chDataLength = (ghSensorConfig[chSensorCounter].chSensorDataLength*PAYLOAD_VARINT_MAX_BYTES) + 1;
+		}
+		else if(ghMasterTaskTable.chPayloadEncoding == PAYLOAD_ENCODING_PACKED)
+		{
+			chDataLength = (fnPayloadPackedBits(chSensorCounter) + 7) >> 3;		//Entry rounded up to bytes (bit stream never needs more packets)
+		}
+		
+		if(nDataIndex + chDataLength > PACKET_LAST_DATA_BYTE_INDEX)
+		{
+			chPacketCount++;
+			nDataIndex = PACKET_DATA_MESSAGE_INDEX;
+		}
+		
+		nDataIndex += chDataLength;
+		
+		if((chPacketCount > MAX_COMM_PACKET_COUNT) || (nDataIndex > PACKET_LAST_DATA_BYTE_INDEX))
+		{
+			SEND_ERROR_CODE_OVER_RF(SENSOR_EXECUTION_TABLE_OVERLOAD);
+			SEND_DEBUG_ERROR_CODES(SENSOR_EXECUTION_TABLE_OVERLOAD);
+			return RETURN_FALSE;
+		}
+	}
+	
+	//Slots of collection queue are sized for the busiest radio clock
+	ghCollectionQueue.chSlotPackets = chPacketCount;
+	ghCollectionQueue.chSlotCount = COLLECTION_PACKET_POOL / chPacketCount;
+	
+	if(ghCollectionQueue.chSlotCount > COLLECTION_QUEUE_DEPTH)
+	{
+		ghCollectionQueue.chSlotCount = COLLECTION_QUEUE_DEPTH;
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnResetKeyData ____________________________________________________________________
+//
+// @brief	Called when new Execution Table is accepted so first entry of every sensor with key data is key entry of epoch 1.
+//			Sensor entries beyond MAX_KEY_SENSOR_COUNT have no key data and send key entry every time.
+
+void fnResetKeyData(void)
+{
+	uint8_t chKeyIndex = RESET_COUNTER;
+	
+	for(chKeyIndex = RESET_COUNTER;chKeyIndex < MAX_KEY_SENSOR_COUNT;chKeyIndex++)
+	{
+		ghSensorKey[chKeyIndex].chKeyCountdown	= RESET_COUNTER;
+		ghSensorKey[chKeyIndex].chKeyEpoch		= RESET_VALUE;
+	}
+	
 	return;
 }
+
+//_____ fnFetchCollectionGeneration ____________________________________________________________________
+//
+// @brief	Called by Data Download Task when it starts download of the oldest generation of collection queue.
+//			Generation is marked in flight so it is not dropped by Data Collection Task till it is released.
+// @param	pchPacketCount		Returns no of packets of generation
+// @return	Index of first packet of generation in gchSensorCommBuff
+
+uint8_t fnFetchCollectionGeneration(uint8_t *pchPacketCount)
+{
+	uint8_t chSlot = ghCollectionQueue.chSlotOrder[RESET_COUNTER];
+	
+	ghCollectionQueue.chInFlight = SET_FLAG;
+	*pchPacketCount = ghCollectionQueue.chPacketCount[chSlot];
+	
+	return COLLECTION_FIRST_PACKET_INDEX + (chSlot * ghCollectionQueue.chSlotPackets);
+}
+
+//_____ fnReleaseCollectionGeneration ____________________________________________________________________
+//
+// @brief	Called by Data Download Task when download of the oldest generation is over (delivered or retry out) to free its slot
+//			If generation carrying key entries of delta encoding is not delivered than every sensor sends key entry again.
+// @param	chDelivered		SET_FLAG if all the packets of generation are acknowledged
+// @return	No of generations still waiting for download
+
+uint8_t fnReleaseCollectionGeneration(uint8_t chDelivered)
+{
+	uint8_t chOrderIndex = RESET_COUNTER;
+	
+	if(ghCollectionQueue.chInFlight == SET_FLAG)
+	{
+		ghCollectionQueue.chPacketCount[ghCollectionQueue.chSlotOrder[RESET_COUNTER]] = RESET_COUNTER;
+		
+		if((chDelivered == RESET_FLAG) && (ghCollectionQueue.chKeyEntries[ghCollectionQueue.chSlotOrder[RESET_COUNTER]] == SET_FLAG))
+		{
+			fnPayloadRequestKeys();
+		}
+		
+		for(chOrderIndex = RESET_COUNTER;(chOrderIndex + 1) < ghCollectionQueue.chQueuedCount;chOrderIndex++)
+		{
+			ghCollectionQueue.chSlotOrder[chOrderIndex] = ghCollectionQueue.chSlotOrder[chOrderIndex + 1];
+		}
+		
+		ghCollectionQueue.chQueuedCount--;
+		ghCollectionQueue.chInFlight = RESET_FLAG;
+	}
+	
+	return ghCollectionQueue.chQueuedCount;
+}
+
+//_____ fnFetchDueSensors ____________________________________________________________________
+//
+// @brief	Fetches the sensor entries due at current clock tick and moves the schedule to next tick
+//			If schedule is not compiled than sequential counter of every sensor is compared with its divisor.
+// @param	chScheduleType	SAMPLE_CLOCK_SCHEDULE or RADIO_CLOCK_SCHEDULE
+//			ppchDueList		Returns pointer to the list of due sensor entries (valid till next call)
+// @return	No of sensor entries due at current clock tick
+
+uint8_t fnFetchDueSensors(uint8_t chScheduleType,uint8_t **ppchDueList)
+{
+	DIVISOR_SCHEDULE_STRUCT *phSchedule = &ghSampleSchedule;
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chDueCount = RESET_COUNTER;
+	uint8_t chTick = RESET_COUNTER;
+	
+	if(chScheduleType == RADIO_CLOCK_SCHEDULE)
+	{
+		phSchedule = &ghRadioSchedule;
+	}
+	
+	if(phSchedule->chHyperPeriod != RESET_VALUE)
+	{
+		chTick = phSchedule->chTickIndex;
+		
+		if(++phSchedule->chTickIndex >= phSchedule->chHyperPeriod)
+		{
+			phSchedule->chTickIndex = RESET_COUNTER;
+		}
+		
+		*ppchDueList = &phSchedule->chEntries[phSchedule->chTickStart[chTick]];
+		return (phSchedule->chTickStart[chTick + 1] - phSchedule->chTickStart[chTick]);
+	}
+	
+	for(chSensorCounter = RESET_COUNTER;chSensorCounter < gchTotalSensorEntry;chSensorCounter++)
+	{
+		if(chScheduleType == RADIO_CLOCK_SCHEDULE)
+		{
+			//This will compare the current radio clock counter with radio clock divisor of particular sensor.
+			if(++ghSensorRuntime.chRadioClockCounter[chSensorCounter] >= ghSensorConfig[chSensorCounter].chRadioClockDivisor)
+			{
+				ghSensorRuntime.chRadioClockCounter[chSensorCounter] = RESET_COUNTER;
+				gchDueSensorList[chDueCount++] = chSensorCounter;
+			}
+		}
+		else if(!fnScheduleExcludes(chScheduleType,chSensorCounter))
+		{
+			//This will check if the sensor current sample counter is less then sensor's sample clock divisor then don't process further
+			if(++ghSensorRuntime.chSampleClockCounter[chSensorCounter] >= ghSensorConfig[chSensorCounter].chSampleClockDivisor)
+			{
+				ghSensorRuntime.chSampleClockCounter[chSensorCounter] = RESET_COUNTER;
+				gchDueSensorList[chDueCount++] = chSensorCounter;
+			}
+		}
+	}
+	
+	*ppchDueList = gchDueSensorList;
+	return chDueCount;
+}
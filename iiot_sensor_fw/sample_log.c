@@ -0,0 +1,749 @@
+/* -------------------------------------------------------------------------
+Filename: sample_log.c
+
+Job#: 20473
+Date Created: 10/16/2026
+
+Purpose: Store-and-forward log of data packets in external E2PROM.
+		 When uplink to RFC Console is down Data Download Task appends the packets which are not acknowledged as records of a ring in E2PROM
+		 and replays them (oldest first) once uplink is back. Every record carries sequence no, so log is found again after reset
+		 by walking the record headers from the tail saved in anchor till sequence breaks.
+		 Records are copied into a RAM copy of the head block and E2PROM is written one block (E2PROM_LOG_BLOCK_SIZE bytes, never crossing page) per transaction.
+		 Small appends are coalesced: Block is written when it is full, partially filled block only when it is flushed (before probe of uplink and before fetch),
+		 so a page sees one write cycle per block instead of one per append. Records of head block which are not flushed are lost with reset.
+		 Every call executes at most one E2PROM transaction and returns, so Data Download Task gives way to sampling till I2C completion wakes it.
+		 Delivery is at least once: record is released only after it is acknowledged and anchor is saved when catch up is over,
+		 so records replayed after last save of anchor are replayed again after reset.
+
+Functions:
+fnSampleLogAdvance					Moves offset of ring
+fnSampleLogRead						Reads bytes of ring in E2PROM transactions of one block
+fnSampleLogWrite					Writes bytes to E2PROM (Wakes the task when I2C is released between transactions)
+fnSampleLogWriteBlock				Writes bytes of head block which are not yet in E2PROM
+fnSampleLogFault					Stops log after failed E2PROM transaction
+fnSampleLogHeaderValid				Checks header of record
+fnSampleLogChecksum					XOR of packet bytes
+fnSampleLogInit						Discards job in progress and schedules scan of log
+fnSampleLogReady					Scans log from anchor after reset
+fnSampleLogPending					Checks for records waiting for catch up
+fnSampleLogBusy						Checks for E2PROM job of log in progress
+fnSampleLogAppend					Appends packets at head of log
+fnSampleLogFlush					Writes partially filled head block
+fnSampleLogFetch					Reads oldest record of log
+fnSampleLogRelease					Removes oldest record of log
+fnSampleLogSaveAnchor				Writes tail of log to anchor
+
+Interrupts:
+-NA-
+
+
+Author: Aalok Shah
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+--------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+
+//_____  I N C L U D E S ______________________________________________________________
+
+#include "system_globals.h"						//Contains definitions related to various system level task
+#include "sensor_management.h"					//E2PROM read and write operations
+
+//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+//Store-and-forward log
+SAMPLE_LOG_STRUCT ghSampleLog;
+
+//_____ fnSampleLogAdvance ____________________________________________________________________
+//
+// @brief	Moves offset of ring ahead (wraps at the end of ring)
+// @param	nOffset		Offset from E2PROM_LOG_FIRST_ADDR
+//			nBytes		No of bytes to move
+// @return	New offset
+
+static uint16_t fnSampleLogAdvance(uint16_t nOffset,uint16_t nBytes)
+{
+	uint32_t lOffset = (uint32_t)nOffset + nBytes;
+	
+	if(lOffset >= E2PROM_LOG_SIZE)
+	{
+		lOffset -= E2PROM_LOG_SIZE;
+	}
+	
+	return (uint16_t)lOffset;
+}
+
+//_____ fnSampleLogRead ____________________________________________________________________
+//
+// @brief	Reads bytes of ring from nIoOffset in E2PROM transactions of at most one block (transaction is split at the end of ring)
+//			nIoOffset and nIoDone must be set before first call and caller calls again with same arguments till it gets TRUE.
+// @param	pchBuff		Memory resources to hold the bytes
+//			nLength		No of bytes to read
+// @return	TRUE if all the bytes are read, FALSE if E2PROM transaction is in progress otherwise error code of failed transaction
+
+static int8_t fnSampleLogRead(uint8_t *pchBuff,uint16_t nLength)
+{
+	int8_t chStatus = RESET_VALUE;
+	uint16_t nChunk = RESET_VALUE;
+	
+	while(ghSampleLog.nIoDone < nLength)
+	{
+		if(ghSampleLog.chIoLength == RESET_VALUE)
+		{
+			nChunk = nLength - ghSampleLog.nIoDone;
+			
+			if(nChunk > E2PROM_LOG_BLOCK_SIZE)
+			{
+				nChunk = E2PROM_LOG_BLOCK_SIZE;
+			}
+			
+			if(nChunk > (E2PROM_LOG_SIZE - ghSampleLog.nIoOffset))
+			{
+				nChunk = E2PROM_LOG_SIZE - ghSampleLog.nIoOffset;
+			}
+			
+			ghSampleLog.chIoLength = (uint8_t)nChunk;
+		}
+		
+		chStatus = fnE2PROMReadOpeartion(&pchBuff[ghSampleLog.nIoDone],ghSampleLog.chIoLength,E2PROM_LOG_FIRST_ADDR + ghSampleLog.nIoOffset);
+		if(chStatus == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		
+		nChunk = ghSampleLog.chIoLength;
+		ghSampleLog.chIoLength = RESET_VALUE;
+		
+		if(chStatus != RETURN_TRUE)
+		{
+			return chStatus;
+		}
+		
+		ghSampleLog.nIoDone += nChunk;
+		ghSampleLog.nIoOffset = fnSampleLogAdvance(ghSampleLog.nIoOffset,nChunk);
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSampleLogWrite ____________________________________________________________________
+//
+// @brief	Writes bytes to E2PROM. E2PROM write operation releases I2C between its transactions (ACK polling of write cycle),
+//			Data Download Task is woken again in that case along with Data Sampling Task, so sensor waiting for I2C gets it before next ACK poll.
+// @param	pchBuff		Bytes to write
+//			chLength	No of bytes
+//			nAddress	E2PROM address
+// @return	TRUE if bytes are written, FALSE if E2PROM transaction is in progress otherwise error code of failed transaction
+
+static int8_t fnSampleLogWrite(uint8_t *pchBuff,uint8_t chLength,uint16_t nAddress)
+{
+	int8_t chStatus = fnE2PROMWriteOperation(pchBuff,chLength,nAddress);
+	
+	if(chStatus == E2PROM_WRITE_YIELD)
+	{
+		WAKE_TASKS(DATA_SAMPLING_TASK | DATA_DOWNLOAD_TASK);
+		return RETURN_FALSE;
+	}
+	
+	return chStatus;
+}
+
+//_____ fnSampleLogWriteBlock ____________________________________________________________________
+//
+// @brief	Writes bytes of head block which are not yet in E2PROM (Bytes after head are never written so records at tail of a full ring are not touched)
+//			Full block is left behind once it is written and next block becomes head block.
+// @return	TRUE if block is written, FALSE if E2PROM transaction is in progress otherwise error code of failed transaction
+
+static int8_t fnSampleLogWriteBlock(void)
+{
+	int8_t chStatus = RESET_VALUE;
+	
+	if(ghSampleLog.chIoLength == RESET_VALUE)
+	{
+		ghSampleLog.chIoLength = ghSampleLog.chBlockFill - ghSampleLog.chBlockSaved;
+	}
+	
+	chStatus = fnSampleLogWrite(&ghSampleLog.chBlock[ghSampleLog.chBlockSaved],ghSampleLog.chIoLength,E2PROM_LOG_FIRST_ADDR + ghSampleLog.nBlockOffset + ghSampleLog.chBlockSaved);
+	if(chStatus == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	ghSampleLog.chIoLength = RESET_VALUE;
+	
+	if(chStatus == RETURN_TRUE)
+	{
+		ghSampleLog.chBlockSaved = ghSampleLog.chBlockFill;
+		
+		if(ghSampleLog.chBlockFill >= E2PROM_LOG_BLOCK_SIZE)
+		{
+			ghSampleLog.nBlockOffset = fnSampleLogAdvance(ghSampleLog.nBlockOffset,E2PROM_LOG_BLOCK_SIZE);
+			ghSampleLog.chBlockFill = RESET_COUNTER;
+			ghSampleLog.chBlockSaved = RESET_COUNTER;
+		}
+	}
+	
+	return chStatus;
+}
+
+//_____ fnSampleLogFault ____________________________________________________________________
+//
+// @brief	Stops the log after failed E2PROM transaction, it is scanned again at next append
+
+static void fnSampleLogFault(void)
+{
+	SEND_DEBUG_ERROR_CODES(SENSOR_E2PROM_LOG_FAULT);
+	SEND_ERROR_CODE_OVER_RF(SENSOR_E2PROM_LOG_FAULT);
+	
+	ghSampleLog.chState = SAMPLE_LOG_STATE_FAULT;
+	ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+	ghSampleLog.chIoLength = RESET_VALUE;
+	ghSampleLog.nRecordCount = RESET_COUNTER;
+	
+	return;
+}
+
+//_____ fnSampleLogHeaderValid ____________________________________________________________________
+//
+// @brief	Checks header of record read in chHeader
+// @param	nSeqNo		Expected sequence no of record
+//			nMaxSize	Maximum size of record
+// @return	TRUE if header is valid otherwise FALSE
+
+static int8_t fnSampleLogHeaderValid(uint16_t nSeqNo,uint16_t nMaxSize)
+{
+	uint8_t *pchHeader = ghSampleLog.chHeader;
+	
+	if((pchHeader[SAMPLE_LOG_MARK_INDEX] != SAMPLE_LOG_RECORD_MARK) ||
+	   (((uint16_t)(pchHeader[SAMPLE_LOG_SEQ_NO_INDEX] << BIT_8_bp) | pchHeader[SAMPLE_LOG_SEQ_NO_INDEX + 1]) != nSeqNo) ||
+	   (pchHeader[SAMPLE_LOG_LENGTH_INDEX] < PACKET_DOWNLOAD_DATA_SIZE) || (pchHeader[SAMPLE_LOG_LENGTH_INDEX] > PACKET_LAST_DATA_BYTE_INDEX) ||
+	   ((SAMPLE_LOG_HEADER_SIZE + pchHeader[SAMPLE_LOG_LENGTH_INDEX]) > nMaxSize))
+	{
+		return RETURN_FALSE;
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSampleLogChecksum ____________________________________________________________________
+//
+// @brief	XOR of payload bytes of packet
+// @param	pchPacket	Packet (Length byte followed by payload)
+// @return	Checksum of packet
+
+static uint8_t fnSampleLogChecksum(uint8_t *pchPacket)
+{
+	uint8_t chChecksum = RESET_VALUE;
+	uint8_t chIndex = RESET_COUNTER;
+	
+	for(chIndex = PACKET_HEADER_INDEX;chIndex <= pchPacket[CC1125_DATA_PACKET_LENGTH];chIndex++)
+	{
+		chChecksum ^= pchPacket[chIndex];
+	}
+	
+	return chChecksum;
+}
+
+//_____ fnSampleLogInit ____________________________________________________________________
+//
+// @brief	Discards E2PROM job in progress and schedules scan of log from its anchor (Executed with every new Execution Table as I2C is reset)
+
+void fnSampleLogInit(void)
+{
+	ghSampleLog.chState = SAMPLE_LOG_STATE_RECOVER;
+	ghSampleLog.chScanStep = SAMPLE_LOG_SCAN_ANCHOR;
+	ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+	ghSampleLog.chIoLength = RESET_VALUE;
+	ghSampleLog.nRecordCount = RESET_COUNTER;
+	ghSampleLog.nUsedBytes = RESET_COUNTER;
+	
+	return;
+}
+
+//_____ fnSampleLogReady ____________________________________________________________________
+//
+// @brief	Executes one step of log scan (One E2PROM transaction per call) till records in E2PROM are known:
+//				1> Anchor gives offset and sequence no of tail (Log is empty if anchor is not valid)
+//				2> Headers of records are read from tail while sequence no is continuous
+//				3> Bytes of head block used by records are read into RAM copy of head block
+// @return	TRUE if scan is over (log is ready or faulty) otherwise FALSE
+
+int8_t fnSampleLogReady(void)
+{
+	int8_t chStatus = RESET_VALUE;
+	uint16_t nHeadOffset = RESET_VALUE;
+	
+	if(ghSampleLog.chState != SAMPLE_LOG_STATE_RECOVER)
+	{
+		return RETURN_TRUE;
+	}
+	
+	if(ghSampleLog.chScanStep == SAMPLE_LOG_SCAN_ANCHOR)
+	{
+		chStatus = fnE2PROMReadOpeartion(ghSampleLog.chHeader,SAMPLE_LOG_ANCHOR_SIZE,E2PROM_LOG_ANCHOR_ADDR);
+		if(chStatus == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		else if(chStatus != RETURN_TRUE)
+		{
+			fnSampleLogFault();
+			return RETURN_TRUE;
+		}
+		
+		ghSampleLog.nTailOffset = ((uint16_t)ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_OFFSET_INDEX] << BIT_8_bp) | ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_OFFSET_INDEX + 1];
+		ghSampleLog.nTailSeqNo = ((uint16_t)ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_SEQ_NO_INDEX] << BIT_8_bp) | ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_SEQ_NO_INDEX + 1];
+		ghSampleLog.chAnchorDirty = RESET_FLAG;
+		
+		//E2PROM which never held log starts with empty log
+		if((ghSampleLog.chHeader[SAMPLE_LOG_MARK_INDEX] != SAMPLE_LOG_RECORD_MARK) || (ghSampleLog.nTailOffset >= E2PROM_LOG_SIZE))
+		{
+			ghSampleLog.nTailOffset = RESET_VALUE;
+			ghSampleLog.nTailSeqNo = RESET_VALUE;
+			ghSampleLog.chAnchorDirty = SET_FLAG;
+		}
+		
+		ghSampleLog.nUsedBytes = RESET_COUNTER;
+		ghSampleLog.nRecordCount = RESET_COUNTER;
+		ghSampleLog.nIoOffset = ghSampleLog.nTailOffset;
+		ghSampleLog.nIoDone = RESET_COUNTER;
+		ghSampleLog.chScanStep = SAMPLE_LOG_SCAN_RECORDS;
+	}
+	
+	while(ghSampleLog.chScanStep == SAMPLE_LOG_SCAN_RECORDS)
+	{
+		if((ghSampleLog.nUsedBytes + SAMPLE_LOG_HEADER_SIZE) <= E2PROM_LOG_SIZE)
+		{
+			chStatus = fnSampleLogRead(ghSampleLog.chHeader,SAMPLE_LOG_HEADER_SIZE);
+			if(chStatus == RETURN_FALSE)
+			{
+				return RETURN_FALSE;
+			}
+			else if(chStatus != RETURN_TRUE)
+			{
+				fnSampleLogFault();
+				return RETURN_TRUE;
+			}
+			
+			if(fnSampleLogHeaderValid(ghSampleLog.nTailSeqNo + ghSampleLog.nRecordCount,E2PROM_LOG_SIZE - ghSampleLog.nUsedBytes) == RETURN_TRUE)
+			{
+				ghSampleLog.nUsedBytes += SAMPLE_LOG_HEADER_SIZE + ghSampleLog.chHeader[SAMPLE_LOG_LENGTH_INDEX];
+				ghSampleLog.nRecordCount++;
+				ghSampleLog.nIoOffset = fnSampleLogAdvance(ghSampleLog.nTailOffset,ghSampleLog.nUsedBytes);
+				ghSampleLog.nIoDone = RESET_COUNTER;
+				continue;
+			}
+		}
+		
+		//Sequence breaks at head of log
+		nHeadOffset = fnSampleLogAdvance(ghSampleLog.nTailOffset,ghSampleLog.nUsedBytes);
+		ghSampleLog.nBlockOffset = nHeadOffset & (~(E2PROM_LOG_BLOCK_SIZE - 1));
+		ghSampleLog.chBlockFill = (uint8_t)(nHeadOffset - ghSampleLog.nBlockOffset);
+		ghSampleLog.nIoOffset = ghSampleLog.nBlockOffset;
+		ghSampleLog.nIoDone = RESET_COUNTER;
+		ghSampleLog.chScanStep = SAMPLE_LOG_SCAN_HEAD_BLOCK;
+	}
+	
+	chStatus = fnSampleLogRead(ghSampleLog.chBlock,ghSampleLog.chBlockFill);
+	if(chStatus == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	else if(chStatus != RETURN_TRUE)
+	{
+		fnSampleLogFault();
+		return RETURN_TRUE;
+	}
+	
+	ghSampleLog.chBlockSaved = ghSampleLog.chBlockFill;
+	ghSampleLog.chState = SAMPLE_LOG_STATE_READY;
+	ghSampleLog.chScanStep = SAMPLE_LOG_SCAN_ANCHOR;
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSampleLogPending ____________________________________________________________________
+//
+// @brief	Called by Data Download Task to decide whether it has to start catch up of backlog
+// @return	TRUE if log holds records or it is not scanned yet otherwise FALSE
+
+int8_t fnSampleLogPending(void)
+{
+	if((ghSampleLog.chState == SAMPLE_LOG_STATE_RECOVER) || ((ghSampleLog.chState == SAMPLE_LOG_STATE_READY) && (ghSampleLog.nRecordCount != RESET_COUNTER)))
+	{
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnSampleLogBusy ____________________________________________________________________
+//
+// @brief	Called by Data Download Task before it leaves catch up, job of log keeps I2C occupied till its E2PROM transaction is over.
+//			Step index of E2PROM is checked as well, so next E2PROM user never takes over a transaction which is half done.
+// @return	TRUE if append, flush, fetch or anchor write is in progress or E2PROM transaction is half done otherwise FALSE
+
+int8_t fnSampleLogBusy(void)
+{
+	if((ghSampleLog.chJob != SAMPLE_LOG_JOB_IDLE) || (gchStepIndexE2PROM != STEP_0_Val))
+	{
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnSampleLogAppend ____________________________________________________________________
+//
+// @brief	Appends the packets at head of log. Packets are copied into head block which is written as one E2PROM transaction when it is full,
+//			partially filled block stays in RAM till fnSampleLogFlush (Appends are coalesced into full block writes). Caller must keep the packets and call again with the same arguments till it gets TRUE.
+//			If log is full remaining packets are dropped with SENSOR_E2PROM_LOG_FULL.
+// @param	chFirstPacketIndex	Index of first packet in gchSensorCommBuff
+//			chPacketCount		No of packets to append
+// @return	TRUE if append is over otherwise FALSE (E2PROM transaction in progress)
+
+int8_t fnSampleLogAppend(uint8_t chFirstPacketIndex,uint8_t chPacketCount)
+{
+	uint8_t *pchPacket = NULL;
+	uint16_t nSeqNo = RESET_VALUE;
+	int8_t chStatus = RESET_VALUE;
+	
+	if(ghSampleLog.chJob == SAMPLE_LOG_JOB_IDLE)
+	{
+		//Faulty log is scanned again once for every append
+		if(ghSampleLog.chState == SAMPLE_LOG_STATE_FAULT)
+		{
+			ghSampleLog.chState = SAMPLE_LOG_STATE_RECOVER;
+		}
+		
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_APPEND;
+		ghSampleLog.chPacketIndex = chFirstPacketIndex;
+		ghSampleLog.chPacketsLeft = chPacketCount;
+		ghSampleLog.nRecordByte = RESET_COUNTER;
+	}
+	
+	//Anchor must be up to date before space released after its last save is written again (Scan after reset starts from anchor)
+	if((fnSampleLogReady() == RETURN_FALSE) || (fnSampleLogSaveAnchor() == RETURN_FALSE))
+	{
+		return RETURN_FALSE;
+	}
+	
+	//Block write in progress
+	if(ghSampleLog.chIoLength != RESET_VALUE)
+	{
+		chStatus = fnSampleLogWriteBlock();
+		if(chStatus == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		else if(chStatus != RETURN_TRUE)
+		{
+			fnSampleLogFault();
+		}
+	}
+	
+	if(ghSampleLog.chState != SAMPLE_LOG_STATE_READY)
+	{
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+		return RETURN_TRUE;							//Packets are dropped
+	}
+	
+	while((ghSampleLog.chJob == SAMPLE_LOG_JOB_APPEND) && (ghSampleLog.chPacketsLeft != RESET_COUNTER))
+	{
+		pchPacket = gchSensorCommBuff[ghSampleLog.chPacketIndex];
+		
+		//Header of record is prepared once the free space is confirmed
+		if(ghSampleLog.nRecordByte == RESET_COUNTER)
+		{
+			ghSampleLog.nRecordSize = SAMPLE_LOG_HEADER_SIZE + pchPacket[CC1125_DATA_PACKET_LENGTH];
+			
+			if((ghSampleLog.nUsedBytes + ghSampleLog.nRecordSize) > E2PROM_LOG_SIZE)
+			{
+				SEND_DEBUG_ERROR_CODES(SENSOR_E2PROM_LOG_FULL);
+				SEND_ERROR_CODE_OVER_RF(SENSOR_E2PROM_LOG_FULL);
+				ghSampleLog.chPacketsLeft = RESET_COUNTER;
+				break;
+			}
+			
+			nSeqNo = ghSampleLog.nTailSeqNo + ghSampleLog.nRecordCount;
+			ghSampleLog.chHeader[SAMPLE_LOG_MARK_INDEX]			= SAMPLE_LOG_RECORD_MARK;
+			ghSampleLog.chHeader[SAMPLE_LOG_SEQ_NO_INDEX]		= nSeqNo >> BIT_8_bp;
+			ghSampleLog.chHeader[SAMPLE_LOG_SEQ_NO_INDEX + 1]	= nSeqNo;
+			ghSampleLog.chHeader[SAMPLE_LOG_CHECKSUM_INDEX]		= fnSampleLogChecksum(pchPacket);
+			ghSampleLog.chHeader[SAMPLE_LOG_LENGTH_INDEX]		= pchPacket[CC1125_DATA_PACKET_LENGTH];
+		}
+		
+		//Header of record followed by packet bytes after its length byte
+		while((ghSampleLog.nRecordByte < ghSampleLog.nRecordSize) && (ghSampleLog.chBlockFill < E2PROM_LOG_BLOCK_SIZE))
+		{
+			if(ghSampleLog.nRecordByte < SAMPLE_LOG_HEADER_SIZE)
+			{
+				ghSampleLog.chBlock[ghSampleLog.chBlockFill++] = ghSampleLog.chHeader[ghSampleLog.nRecordByte];
+			}
+			else
+			{
+				ghSampleLog.chBlock[ghSampleLog.chBlockFill++] = pchPacket[ghSampleLog.nRecordByte - SAMPLE_LOG_LENGTH_INDEX];
+			}
+			
+			ghSampleLog.nRecordByte++;
+		}
+		
+		if(ghSampleLog.nRecordByte >= ghSampleLog.nRecordSize)
+		{
+			ghSampleLog.nUsedBytes += ghSampleLog.nRecordSize;
+			ghSampleLog.nRecordCount++;
+			ghSampleLog.nRecordByte = RESET_COUNTER;
+			ghSampleLog.chPacketIndex++;
+			ghSampleLog.chPacketsLeft--;
+		}
+		
+		if(ghSampleLog.chBlockFill >= E2PROM_LOG_BLOCK_SIZE)
+		{
+			chStatus = fnSampleLogWriteBlock();
+			if(chStatus == RETURN_FALSE)
+			{
+				return RETURN_FALSE;
+			}
+			else if(chStatus != RETURN_TRUE)
+			{
+				fnSampleLogFault();
+				return RETURN_TRUE;
+			}
+		}
+	}
+	
+	ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+	return RETURN_TRUE;
+}
+
+//_____ fnSampleLogFlush ____________________________________________________________________
+//
+// @brief	Writes the records coalesced in head block which are not yet in E2PROM
+// @return	TRUE if head block is written (or nothing to write) otherwise FALSE (E2PROM transaction in progress)
+
+int8_t fnSampleLogFlush(void)
+{
+	int8_t chStatus = RESET_VALUE;
+	
+	if((ghSampleLog.chState != SAMPLE_LOG_STATE_READY) || (ghSampleLog.chBlockFill == ghSampleLog.chBlockSaved))
+	{
+		return RETURN_TRUE;
+	}
+	
+	ghSampleLog.chJob = SAMPLE_LOG_JOB_FLUSH;
+	
+	chStatus = fnSampleLogWriteBlock();
+	if(chStatus == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+	
+	if(chStatus != RETURN_TRUE)
+	{
+		fnSampleLogFault();
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSampleLogFetch ____________________________________________________________________
+//
+// @brief	Reads the oldest record of log into the packet (Head block is flushed first). Record stays in log till fnSampleLogRelease is called.
+//			Record with checksum mismatch is released and packet is returned with length 0.
+//			If header of oldest record is not valid than records are lost (E2PROM is modified outside of log) and log is started again from its head.
+// @param	pchPacket	Packet of gchSensorCommBuff (Length byte followed by payload)
+// @return	TRUE if fetch is over otherwise FALSE (E2PROM transaction in progress)
+
+int8_t fnSampleLogFetch(uint8_t *pchPacket)
+{
+	int8_t chStatus = RESET_VALUE;
+	
+	pchPacket[CC1125_DATA_PACKET_LENGTH] = RESET_VALUE;
+	
+	if(fnSampleLogReady() == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	if((ghSampleLog.chState != SAMPLE_LOG_STATE_READY) || (ghSampleLog.nRecordCount == RESET_COUNTER))
+	{
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+		return RETURN_TRUE;
+	}
+	
+	if((ghSampleLog.chJob == SAMPLE_LOG_JOB_IDLE) || (ghSampleLog.chJob == SAMPLE_LOG_JOB_FLUSH))
+	{
+		//Oldest record may be in the part of head block which is not yet written
+		if(fnSampleLogFlush() == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		
+		if(ghSampleLog.chState != SAMPLE_LOG_STATE_READY)
+		{
+			return RETURN_TRUE;
+		}
+		
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_FETCH_HEADER;
+		ghSampleLog.nIoOffset = ghSampleLog.nTailOffset;
+		ghSampleLog.nIoDone = RESET_COUNTER;
+	}
+	
+	if(ghSampleLog.chJob == SAMPLE_LOG_JOB_FETCH_HEADER)
+	{
+		chStatus = fnSampleLogRead(ghSampleLog.chHeader,SAMPLE_LOG_HEADER_SIZE);
+		if(chStatus == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		else if(chStatus != RETURN_TRUE)
+		{
+			fnSampleLogFault();
+			return RETURN_TRUE;
+		}
+		
+		if(fnSampleLogHeaderValid(ghSampleLog.nTailSeqNo,ghSampleLog.nUsedBytes) == RETURN_FALSE)
+		{
+			SEND_DEBUG_ERROR_CODES(SENSOR_E2PROM_LOG_FAULT);
+			ghSampleLog.nTailOffset = fnSampleLogAdvance(ghSampleLog.nTailOffset,ghSampleLog.nUsedBytes);
+			ghSampleLog.nTailSeqNo += ghSampleLog.nRecordCount;
+			ghSampleLog.nUsedBytes = RESET_COUNTER;
+			ghSampleLog.nRecordCount = RESET_COUNTER;
+			ghSampleLog.chAnchorDirty = SET_FLAG;
+			ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+			return RETURN_TRUE;
+		}
+		
+		ghSampleLog.nRecordSize = SAMPLE_LOG_HEADER_SIZE + ghSampleLog.chHeader[SAMPLE_LOG_LENGTH_INDEX];
+		ghSampleLog.nIoDone = RESET_COUNTER;
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_FETCH_DATA;
+	}
+	
+	//Payload of packet follows header of record
+	chStatus = fnSampleLogRead(&pchPacket[PACKET_HEADER_INDEX],ghSampleLog.nRecordSize - SAMPLE_LOG_HEADER_SIZE);
+	if(chStatus == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	else if(chStatus != RETURN_TRUE)
+	{
+		fnSampleLogFault();
+		return RETURN_TRUE;
+	}
+	
+	ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+	pchPacket[CC1125_DATA_PACKET_LENGTH] = ghSampleLog.chHeader[SAMPLE_LOG_LENGTH_INDEX];
+	
+	if(fnSampleLogChecksum(pchPacket) != ghSampleLog.chHeader[SAMPLE_LOG_CHECKSUM_INDEX])
+	{
+		SEND_DEBUG_STRING("Log Record Checksum Mismatch\n");
+		pchPacket[CC1125_DATA_PACKET_LENGTH] = RESET_VALUE;
+		fnSampleLogRelease();
+	}
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnSampleLogRelease ____________________________________________________________________
+//
+// @brief	Removes the oldest record (fetched by fnSampleLogFetch) from log after it is delivered
+
+void fnSampleLogRelease(void)
+{
+	if(ghSampleLog.nRecordCount != RESET_COUNTER)
+	{
+		ghSampleLog.nTailOffset = fnSampleLogAdvance(ghSampleLog.nTailOffset,ghSampleLog.nRecordSize);
+		ghSampleLog.nTailSeqNo++;
+		ghSampleLog.nUsedBytes -= ghSampleLog.nRecordSize;
+		ghSampleLog.nRecordCount--;
+		ghSampleLog.chAnchorDirty = SET_FLAG;
+	}
+	
+	return;
+}
+
+//_____ fnSampleLogSaveAnchor ____________________________________________________________________
+//
+// @brief	Writes tail of log to anchor in E2PROM if it is moved since last save.
+//			Write which is not part of append is tracked as SAMPLE_LOG_JOB_ANCHOR till it is over (fnSampleLogBusy).
+// @return	TRUE if anchor is saved (or nothing to save) otherwise FALSE (E2PROM transaction in progress)
+
+int8_t fnSampleLogSaveAnchor(void)
+{
+	int8_t chStatus = RESET_VALUE;
+	
+	if((ghSampleLog.chState != SAMPLE_LOG_STATE_READY) || (ghSampleLog.chAnchorDirty == RESET_FLAG))
+	{
+		return RETURN_TRUE;
+	}
+	
+	ghSampleLog.chHeader[SAMPLE_LOG_MARK_INDEX]					= SAMPLE_LOG_RECORD_MARK;
+	ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_OFFSET_INDEX]		= ghSampleLog.nTailOffset >> BIT_8_bp;
+	ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_OFFSET_INDEX + 1]	= ghSampleLog.nTailOffset;
+	ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_SEQ_NO_INDEX]		= ghSampleLog.nTailSeqNo >> BIT_8_bp;
+	ghSampleLog.chHeader[SAMPLE_LOG_ANCHOR_SEQ_NO_INDEX + 1]	= ghSampleLog.nTailSeqNo;
+	
+	if(ghSampleLog.chJob == SAMPLE_LOG_JOB_IDLE)
+	{
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_ANCHOR;
+	}
+	
+	chStatus = fnSampleLogWrite(ghSampleLog.chHeader,SAMPLE_LOG_ANCHOR_SIZE,E2PROM_LOG_ANCHOR_ADDR);
+	if(chStatus == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	else if(chStatus != RETURN_TRUE)
+	{
+		fnSampleLogFault();
+		return RETURN_TRUE;
+	}
+	
+	if(ghSampleLog.chJob == SAMPLE_LOG_JOB_ANCHOR)
+	{
+		ghSampleLog.chJob = SAMPLE_LOG_JOB_IDLE;
+	}
+	
+	ghSampleLog.chAnchorDirty = RESET_FLAG;
+	return RETURN_TRUE;
+}
@@ -0,0 +1,214 @@
+/* -------------------------------------------------------------------------
+Filename: sample_log.h
+
+Job#: 20473
+Purpose: Store-and-forward log of data packets in external E2PROM (Ring of records kept while uplink to RFC Console is down)
+Date Created: 10/16/2026
+
+(NOTE: latest version is the top version)
+
+Author: Aalok Shah
+Changes: Byte counter of record being appended is 16 bit (nRecordByte), record of 255 byte packet is 256 bytes long
+
+Author: Aalok Shah
+Changes: Anchor write is tracked as job of log (SAMPLE_LOG_JOB_ANCHOR), fnSampleLogBusy reports E2PROM transaction of any user in progress
+
+Author: Aalok Shah
+Changes: Appends are coalesced in head block (only full blocks are written), partially filled block is written by fnSampleLogFlush
+
+Author: Aalok Shah
+Changes: Initial version
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+Note: See document 000xxxx for complete project requirements
+Input: None
+Output: None
+
+-----------------------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+#ifndef SAMPLE_LOG_H_
+#define SAMPLE_LOG_H_
+
+	//_____ M A C R O S ____________________________________________________________________
+
+	//E2PROM map: 0x0000-0x00FF is configuration area (Anchor of log is at its start followed by calibration record of CC1125), rest of the memory is ring of log records
+	#define E2PROM_LOG_ANCHOR_ADDR				0x0000		//Anchor: Offset and sequence no of oldest record (Saved when log is drained)
+	#define E2PROM_LOG_FIRST_ADDR				0x0100		//First byte of ring
+	#define E2PROM_LOG_SIZE						0xFF00		//Bytes of ring (Multiple of E2PROM_LOG_BLOCK_SIZE)
+	#define E2PROM_LOG_BLOCK_SIZE				32			//Bytes written in one E2PROM transaction (Divides E2PROM page so block never crosses page boundary)
+
+	//Record: Mark, sequence no (MSB first), XOR of packet bytes and length byte of packet followed by packet bytes
+	#define SAMPLE_LOG_RECORD_MARK				0xA5
+	#define SAMPLE_LOG_MARK_INDEX				0
+	#define SAMPLE_LOG_SEQ_NO_INDEX				1
+	#define SAMPLE_LOG_CHECKSUM_INDEX			3
+	#define SAMPLE_LOG_LENGTH_INDEX				4
+	#define SAMPLE_LOG_HEADER_SIZE				5
+
+	//Anchor: Mark, offset of oldest record and its sequence no (MSB first)
+	#define SAMPLE_LOG_ANCHOR_OFFSET_INDEX		1
+	#define SAMPLE_LOG_ANCHOR_SEQ_NO_INDEX		3
+	#define SAMPLE_LOG_ANCHOR_SIZE				5
+
+	//While uplink is down every generation goes straight to log, only every SAMPLE_LOG_PROBE_INTERVAL-th one is sent to find out whether link is back
+	#define SAMPLE_LOG_PROBE_INTERVAL			4
+
+	//State of log
+	#define SAMPLE_LOG_STATE_RECOVER			0			//Records are not known, anchor and record headers are read from E2PROM
+	#define SAMPLE_LOG_STATE_READY				1			//Log is ready for append and fetch
+	#define SAMPLE_LOG_STATE_FAULT				2			//E2PROM transaction failed, log is scanned again at next append
+
+	//Step of log scan
+	#define SAMPLE_LOG_SCAN_ANCHOR				0			//Reading anchor
+	#define SAMPLE_LOG_SCAN_RECORDS				1			//Reading header of records from tail till sequence breaks
+	#define SAMPLE_LOG_SCAN_HEAD_BLOCK			2			//Reading bytes of head block used by records
+
+	//E2PROM job in progress
+	#define SAMPLE_LOG_JOB_IDLE					0
+	#define SAMPLE_LOG_JOB_APPEND				1			//Copying packets into head block
+	#define SAMPLE_LOG_JOB_FLUSH					2			//Writing partially filled head block (before probe of uplink and fetch)
+	#define SAMPLE_LOG_JOB_FETCH_HEADER			3			//Reading header of oldest record
+	#define SAMPLE_LOG_JOB_FETCH_DATA			4			//Reading packet bytes of oldest record
+	#define SAMPLE_LOG_JOB_ANCHOR				5			//Writing tail of log to anchor (when it is not part of append)
+
+	//_____ D A T A   S T R U C T U R E S ________________________________________________________
+
+	//Ring of records in E2PROM: Records are appended at head and fetched from tail (Offsets are from E2PROM_LOG_FIRST_ADDR)
+	typedef struct
+	{
+		uint16_t	nTailOffset;						//Offset of oldest record
+		uint16_t	nTailSeqNo;							//Sequence no of oldest record (Records are numbered sequentially)
+		uint16_t	nUsedBytes;							//Bytes of records from tail to head
+		uint16_t	nRecordCount;						//No of records in log
+		uint16_t	nBlockOffset;						//Offset of head block (Block holding head of log)
+		uint8_t		chBlockFill;						//Bytes of head block used by records (Head is nBlockOffset + chBlockFill)
+		uint8_t		chBlockSaved;						//Bytes of head block already written to E2PROM
+		uint8_t		chBlock[E2PROM_LOG_BLOCK_SIZE];		//Copy of head block, written to E2PROM when it is full or flushed
+		uint8_t		chState;							//SAMPLE_LOG_STATE_xxx
+		uint8_t		chAnchorDirty;						//SET_FLAG if anchor in E2PROM is older than tail
+		uint8_t		chScanStep;							//SAMPLE_LOG_SCAN_xxx
+		uint8_t		chJob;								//SAMPLE_LOG_JOB_xxx
+		uint8_t		chIoLength;							//Bytes of E2PROM transaction in progress (0 if none)
+		uint16_t	nIoOffset;							//Offset of next byte to transfer
+		uint16_t	nIoDone;							//Bytes transferred of current transfer
+		uint16_t	nRecordSize;						//Size of record being appended, scanned or fetched
+		uint16_t	nRecordByte;						//Next byte of record being appended (Record of longest packet is longer than 255 bytes)
+		uint8_t		chPacketIndex;						//Packet of gchSensorCommBuff being appended
+		uint8_t		chPacketsLeft;						//Packets of append job not yet copied
+		uint8_t		chHeader[SAMPLE_LOG_HEADER_SIZE];	//Header of record (or anchor) being read
+	}SAMPLE_LOG_STRUCT;
+
+	//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+	//Store-and-forward log (Accessed by Data Download Task only)
+	extern SAMPLE_LOG_STRUCT ghSampleLog;
+
+	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
+
+	//_____ fnSampleLogInit ____________________________________________________________________
+	//
+	// @brief	Discards E2PROM job in progress and schedules scan of log from its anchor (Executed with every new Execution Table as I2C is reset)
+
+	void fnSampleLogInit(void);
+
+	//_____ fnSampleLogReady ____________________________________________________________________
+	//
+	// @brief	Executes one step of log scan (One E2PROM transaction per call) till records in E2PROM are known
+	// @return	TRUE if scan is over (log is ready or faulty) otherwise FALSE
+
+	int8_t fnSampleLogReady(void);
+
+	//_____ fnSampleLogPending ____________________________________________________________________
+	//
+	// @brief	Called by Data Download Task to decide whether it has to start catch up of backlog
+	// @return	TRUE if log holds records or it is not scanned yet otherwise FALSE
+
+	int8_t fnSampleLogPending(void);
+
+	//_____ fnSampleLogBusy ____________________________________________________________________
+	//
+	// @brief	Called by Data Download Task before it leaves catch up, job of log keeps I2C occupied till its E2PROM transaction is over
+	// @return	TRUE if append, flush, fetch or anchor write is in progress or E2PROM transaction is half done otherwise FALSE
+
+	int8_t fnSampleLogBusy(void);
+
+	//_____ fnSampleLogAppend ____________________________________________________________________
+	//
+	// @brief	Appends the packets at head of log. Packets are copied into head block which is written as one E2PROM transaction when it is full,
+	//			partially filled block stays in RAM till fnSampleLogFlush. Caller must keep the packets and call again with the same arguments till it gets TRUE.
+	//			If log is full remaining packets are dropped with SENSOR_E2PROM_LOG_FULL.
+	// @param	chFirstPacketIndex	Index of first packet in gchSensorCommBuff
+	//			chPacketCount		No of packets to append
+	// @return	TRUE if append is over otherwise FALSE (E2PROM transaction in progress)
+
+	int8_t fnSampleLogAppend(uint8_t chFirstPacketIndex,uint8_t chPacketCount);
+
+	//_____ fnSampleLogFlush ____________________________________________________________________
+	//
+	// @brief	Writes the records coalesced in head block which are not yet in E2PROM
+	// @return	TRUE if head block is written (or nothing to write) otherwise FALSE (E2PROM transaction in progress)
+
+	int8_t fnSampleLogFlush(void);
+
+	//_____ fnSampleLogFetch ____________________________________________________________________
+	//
+	// @brief	Reads the oldest record of log into the packet (Head block is flushed first). Record stays in log till fnSampleLogRelease is called.
+	//			Record with checksum mismatch is released and packet is returned with length 0.
+	// @param	pchPacket	Packet of gchSensorCommBuff (Length byte followed by payload)
+	// @return	TRUE if fetch is over otherwise FALSE (E2PROM transaction in progress)
+
+	int8_t fnSampleLogFetch(uint8_t *pchPacket);
+
+	//_____ fnSampleLogRelease ____________________________________________________________________
+	//
+	// @brief	Removes the oldest record (fetched by fnSampleLogFetch) from log after it is delivered
+
+	void fnSampleLogRelease(void);
+
+	//_____ fnSampleLogSaveAnchor ____________________________________________________________________
+	//
+	// @brief	Writes tail of log to anchor in E2PROM if it is moved since last save
+	// @return	TRUE if anchor is saved (or nothing to save) otherwise FALSE (E2PROM transaction in progress)
+
+	int8_t fnSampleLogSaveAnchor(void);
+
+#endif /* SAMPLE_LOG_H_ */
@@ -7,7 +7,6 @@ Date Created: 11/04/2014
 Purpose: All the sensors access functionality is given in this file
 
 Functions:
-fnFetchSensorDataLength						Fetch data length for sensor passed in argument
 fnCheckI2cAvailability						Check for availability of I2C resources
 fnFetchChamberPressure						Fetch chamber pressure sensor measurements
 fnWriteGyrometerRegister					Perform write operation with Gyroscope
@@ -16,11 +15,25 @@ fnInitializeGyrometer						Initialize Gyroscope for operations
 fnFetchGyrometerMeasurements				Fetch Gyroscope measurements
 fnStartChamberTemperature					Start sampling ADC input of chamber temperature sensor
 fnFetchChamberTemperature					Fetch chamber temperature sensor measurements
-fnE2PROMWriteOperation						Perform sequential write with E2PROM
+fnLastChamberTemperature					Last chamber temperature fetched
+fnAcquireSensorI2c							Sensor driver: Take control over I2C interface
+fnReleaseSensorI2c							Sensor driver: Release I2C interface
+fnFetchChamberTemperatureSample				Sensor driver: Fetch chamber temperature sample
+fnFetchChamberPressureSample				Sensor driver: Fetch chamber pressure sample
+fnPollGyrometer								Sensor driver: Initialize Gyroscope
+fnFetchGyrometerSample						Sensor driver: Fetch Gyroscope measurements
+fnFetchUplinkRSSISample						Sensor driver: Fetch RSSI of last received packet
+fnFetchSensorDriver							Fetch driver of sensor from sensor driver registry
+fnFetchSensorDataLength						Fetch data length for sensor passed in argument
+fnFetchSensorDataBits						Fetch width of measurement for sensor passed in argument
+fnE2PROMWriteOperation						Perform sequential write with E2PROM (Page split and ACK polling)
 fnE2PROMReadOpeartion						Perform sequential read with E2PROM
 fnSetResetSmartSensorSelectlines			Set environments for specific smart sensor operation
-fnStartSmartSensorSampling					Notify smart sensor to start sampling 
+fnSmartSensorSelectCode						Select code of smart sensor on select lines of its group
+fnStartSmartSensorSampling					Push configuration of smart sensors of sensor tasking table
 fnSmartSensorsDataCollection				Fetch smart sensor measurements
+fnSmartSensorsAcquisitionAdd				Queue smart sensor for concurrent acquisition
+fnSmartSensorsAcquisitionRun				Fetch queued smart sensors of all the groups at once
 fnDebug_Serial_Task						---- Not Implemented ---
 fnWatch_Dog_Manage_Task						---- Not Implemented ---
 
@@ -74,7 +87,9 @@ Test Results:
 
 //_____  I N C L U D E S ______________________________________________________________
 
+#include "system_globals.h"			//Contains definitions related to various system level task
 #include "sensor_management.h"		//Contains scenarios to manage the communication with various sensors available on SENSOR MC Hardware
+#include "system_profiler.h"		//Task manager profiling report
 
 //_____ G L O B A L   D E F I N I T I O N S _________________________________________________
 
@@ -86,42 +101,14 @@ volatile uint8_t gchLvl1StepIndexI2C;
 volatile uint8_t gchLvl2StepIndexI2C;
 volatile uint8_t gchStepIndexE2PROM;
 
-//List of sensors supported in SENSOR MC design 
-SENSOR_MC_SENSOR_LIST ghSensorList;
+//Last chamber temperature fetched from ADC
+static int16_t gnLastChamberTemperature = CHAMBER_TEMPERATURE_UNKNOWN;
 
-//_____  G L O B A L   C O N S T A N T S ______________________________________________________________
+//Write operation of E2PROM in progress
+E2PROM_WRITER_STRUCT ghE2promWriter;
 
-//This structure holds sensor id along with the data length of individual sensor's data
-//All sensors must needs to be included in this structure to provide application an abstract idea about the no of data it has to manage for it
-//??????  
-static const SENSOR_DETAILS ghSensorInfo[]=
-{
-	{CHAMBER_TEMPERATURE		,	1},
-	{CHAMBER_PRESSURE			,	1},
-	{UPLINK_RADIO_RSSI			,	1},
-	{GYRO_METER					,	3}
-};
-
-//_____ fnFetchSensorDataLength ____________________________________________________________________
-//
-// @brief	It will perform linear search in all the entries of SENSOR_DETAILS to find out the data length of the sensor passed in argument
-// @param	chSensorID		Sensor ID for which searching for the data length
-// @return	FALSE if no entry found for given Sensor ID otherwise returns data length specific to provided Sensor ID
-
-int8_t fnFetchSensorDataLength(uint8_t chSensorID)
-{
-	uint8_t chCounter = RESET_COUNTER;
-	
-	for(chCounter = RESET_COUNTER;chCounter<(sizeof(ghSensorInfo)/sizeof(SENSOR_DETAILS));chCounter++)
-	{
-		if(chSensorID==ghSensorInfo[chCounter].chSensorID)
-		{
-			return ghSensorInfo[chCounter].chSensorDataLen;
-		}
-	}
-	
-	return RETURN_FALSE;			//If no entry found for provided ID
-}
+//List of sensors supported in SENSOR MC design 
+SENSOR_MC_SENSOR_LIST ghSensorList;
 
 //_____ fnCheckI2cAvailability ____________________________________________________________________
 //
@@ -339,7 +326,9 @@ int8_t fnFetchGyrometerMeasurements(uint16_t *pnBuff)
 
 int8_t fnStartChamberTemperature(void)
 {
+	if(fnADCStartConversion(CHAMBER_TEMPERATURE_ADC_INDEX) == RETURN_FALSE)
 	{
+		SEND_ERROR_CODE_OVER_RF(SENSOR_ADC_RESOURCES_ARE_NOT_FREE);
 		SEND_DEBUG_ERROR_CODES(SENSOR_ADC_RESOURCES_ARE_NOT_FREE);
 		return RETURN_FALSE;
 	}
@@ -378,55 +367,331 @@ int16_t fnFetchChamberTemperature(void)
 		}	
 	}
 	
+	gnLastChamberTemperature=nResolutionValue;
 	return nResolutionValue;
 }
 
+//_____ fnLastChamberTemperature ____________________________________________________________________
+//
+// @brief	Gives last chamber temperature fetched by fnFetchChamberTemperature (ADC is not touched so it can be called while sampling is running)
+// @return	Last sampled data value or CHAMBER_TEMPERATURE_UNKNOWN if chamber temperature is not sampled since reset
+
+int16_t fnLastChamberTemperature(void)
+{
+	return gnLastChamberTemperature;
+}
+
+//_____ fnAcquireSensorI2c ____________________________________________________________________
+//
+// @brief	Sensor driver step to take control over I2C related software resources
+// @return	TRUE if I2C is acquired otherwise FALSE
+
+static int8_t fnAcquireSensorI2c(void)
+{
+	if(fnCheckI2cAvailability() == RETURN_TRUE)
+	{
+		ACQUIRE_I2C_INTERFACE;
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnReleaseSensorI2c ____________________________________________________________________
+//
+// @brief	Sensor driver step to release I2C related software resources acquired by fnAcquireSensorI2c
+
+static void fnReleaseSensorI2c(void)
+{
+	RELEASE_I2C_INTERFACE;
+	return;
+}
+
+//_____ fnFetchChamberTemperatureSample ____________________________________________________________________
+//
+// @brief	Sensor driver step to fetch the chamber temperature sample started by fnStartChamberTemperature
+// @param	pnData		Memory resources to store the sample
+// @return	TRUE if sample is available otherwise FALSE
+
+static int8_t fnFetchChamberTemperatureSample(uint16_t *pnData)
+{
+	int16_t nSampleValue = fnFetchChamberTemperature();
+	
+	if(nSampleValue == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	pnData[0] = nSampleValue;
+	SEND_DEBUG_STRING("Chamber Temperature Data Available\n");
+	return RETURN_TRUE;
+}
+
+//_____ fnFetchChamberPressureSample ____________________________________________________________________
+//
+// @brief	Sensor driver step to fetch the chamber pressure sample over I2C
+// @param	pnData		Memory resources to store the sample
+// @return	TRUE if sample is available otherwise FALSE
+
+static int8_t fnFetchChamberPressureSample(uint16_t *pnData)
+{
+	int16_t nSampleValue = fnFetchChamberPressure();
+	
+	if(nSampleValue == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	pnData[0] = nSampleValue;
+	SEND_DEBUG_STRING("Pressure Sensor Data Available\n");
+	return RETURN_TRUE;
+}
+
+//_____ fnPollGyrometer ____________________________________________________________________
+//
+// @brief	Sensor driver step to initialize the Gyroscope before every measurement
+// @return	TRUE if Gyroscope is initialized otherwise FALSE
+
+static int8_t fnPollGyrometer(void)
+{
+	if(fnInitializeGyrometer() == RETURN_TRUE)
+	{
+		SEND_DEBUG_STRING("Gyrometer Initialized\n");
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnFetchGyrometerSample ____________________________________________________________________
+//
+// @brief	Sensor driver step to fetch the measurements of all 3 axes of Gyroscope
+// @param	pnData		Memory resources to store the measurements
+// @return	TRUE if measurements are available otherwise FALSE
+
+static int8_t fnFetchGyrometerSample(uint16_t *pnData)
+{
+	if(fnFetchGyrometerMeasurements(pnData) == RETURN_TRUE)
+	{
+		SEND_DEBUG_STRING("Gyrometer Data Available\n");
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnFetchUplinkRSSISample ____________________________________________________________________
+//
+// @brief	Sensor driver step to fetch the RSSI of last packet received from RFCM (No hardware operation required)
+// @param	pnData		Memory resources to store the sample
+// @return	TRUE always
+
+static int8_t fnFetchUplinkRSSISample(uint16_t *pnData)
+{
+	pnData[0] = gchUplinkRSSI;
+	SEND_DEBUG_STRING("RSSI Measurement Data Available\n");
+	return RETURN_TRUE;
+}
+
+//_____ S E N S O R   D R I V E R   R E G I S T R Y ______________________________________________________________
+
+//Driver of every sensor indexed by its Sensor ID (SENSOR_MC_SENSOR_LIST), entry without pfnFetchSensor is not supported
+//New sensor (e.g. BATTERY_STAVE_B1_UNLOADED to BATTERY_STAVE_B4_LOADED once battery test input is mapped to ADC) is added here only
+//Width of measurement must cover every value driver can fetch: 12 bit ADC result, 14 bit pressure, 8 bit RSSI and signed 16 bit Gyroscope axes
+static const SENSOR_DRIVER_STRUCT ghSensorDriver[TOTAL_SENSOR_IDS]=
+{
+	[CHAMBER_TEMPERATURE]	=	{1,	12,	TEMPERATURE_POWER_IDENTITY,	NULL,				fnStartChamberTemperature,	fnFetchChamberTemperatureSample,	NULL},
+	[CHAMBER_PRESSURE]		=	{1,	14,	PRESSURE_POWER_IDENTITY,	fnAcquireSensorI2c,	NULL,						fnFetchChamberPressureSample,		fnReleaseSensorI2c},
+	[UPLINK_RADIO_RSSI]		=	{1,	8,	NO_POWER_SOURCE_IDENTITY,	NULL,				NULL,						fnFetchUplinkRSSISample,			NULL},
+	[GYRO_METER]			=	{3,	16,	NO_POWER_SOURCE_IDENTITY,	fnAcquireSensorI2c,	fnPollGyrometer,			fnFetchGyrometerSample,				fnReleaseSensorI2c}
+};
+
+//_____ fnFetchSensorDriver ____________________________________________________________________
+//
+// @brief	Returns the driver of sensor from sensor driver registry (Registry is indexed by Sensor ID)
+// @param	chSensorID		Sensor ID (SENSOR_MC_SENSOR_LIST)
+// @return	NULL if sensor is not supported otherwise pointer to the driver of sensor
+
+const SENSOR_DRIVER_STRUCT *fnFetchSensorDriver(uint8_t chSensorID)
+{
+	if((chSensorID >= TOTAL_SENSOR_IDS) || (ghSensorDriver[chSensorID].pfnFetchSensor == NULL))
+	{
+		return NULL;
+	}
+	
+	return &ghSensorDriver[chSensorID];
+}
+
+//_____ fnFetchSensorDataLength ____________________________________________________________________
+//
+// @brief	It will find out the data length of the sensor passed in argument from sensor driver registry (SMART_SENSOR_DATA_LEN for Smart Sensor IDs)
+// @param	chSensorID		Sensor ID for which searching for the data length
+// @return	FALSE if no entry found for given Sensor ID otherwise returns data length specific to provided Sensor ID
+
+int8_t fnFetchSensorDataLength(uint8_t chSensorID)
+{
+	const SENSOR_DRIVER_STRUCT *phSensorDriver = NULL;
+	
+	if(IS_SMART_SENSOR_ID(chSensorID))
+	{
+		return SMART_SENSOR_DATA_LEN;
+	}
+	
+	phSensorDriver = fnFetchSensorDriver(chSensorID);
+	
+	if(phSensorDriver == NULL)
+	{
+		return RETURN_FALSE;			//If no entry found for provided ID
+	}
+	
+	return phSensorDriver->chSensorDataLen;
+}
+
+//_____ fnFetchSensorDataBits ____________________________________________________________________
+//
+// @brief	It will find out the significant bits of every measurement of the sensor passed in argument from sensor driver registry
+// @param	chSensorID		Sensor ID for which searching for the width of measurement
+// @return	SENSOR_DATA_WORD_BITS if no entry found for given Sensor ID otherwise width of measurement specific to provided Sensor ID
+
+uint8_t fnFetchSensorDataBits(uint8_t chSensorID)
+{
+	const SENSOR_DRIVER_STRUCT *phSensorDriver = fnFetchSensorDriver(chSensorID);
+	
+	if(phSensorDriver == NULL)
+	{
+		return SENSOR_DATA_WORD_BITS;
+	}
+	
+	return phSensorDriver->chSensorDataBits;
+}
+
 //_____ fnE2PROMWriteOperation ____________________________________________________________________
 //
-// @brief	Use this function to write block of data sequentially in to E2PROM
+// @brief	Use this function to write block of data sequentially in to E2PROM. Block is written in chunks which end at page boundary or fill I2C buffer.
+//			Every call starts at most one I2C transaction and I2C is released between transactions so sensors on I2C are not blocked by E2PROM:
+//				STEP_1: Write chunk (Write cycle of page starts with stop condition)
+//				STEP_2: Wait for end of chunk transaction
+//				STEP_3: Send address to E2PROM (ACK polling)
+//				STEP_4: Address is not acknowledged till write cycle is over, next chunk is written once it is acknowledged
 // @param	pchBuff		Pointer to the memory resources to hold the data bytes needed to write in E2PROM
 //			chLength	Specifies value of count for which to perform write operation
 //			nAddress	Base address in E2PROM from where to perform sequential write of data
-// @return	FALSE if operation is not completed otherwise sampled data value
-//			In the case of overflow function will return SENSOR_I2C_COMM_BUFF_OVERFLOW
+// @return	TRUE if data is written and write cycle is over, FALSE if I2C transaction is running (its completion wakes the task)
+//			E2PROM_WRITE_YIELD if I2C is released between transactions (caller wakes its task)
+//			SENSOR_I2C_BUS_ARBITRATION if I2C transaction fails and SENSOR_E2PROM_WRITE_CYCLE_TIMEOUT if write cycle does not end
 
 SENSOR_MC_ERROR_CODES fnE2PROMWriteOperation(uint8_t *pchBuff, uint8_t chLength, uint16_t nAddress)
 {
 	uint8_t chLoopVar = RESET_COUNTER;
+	int8_t chCheckStatus = RESET_VALUE;
+	uint16_t nPageSpace = RESET_VALUE;
 	
+	//New write operation
 	if(gchStepIndexE2PROM==STEP_0_Val)
+	{
+		ghE2promWriter.nAddress=nAddress;
+		ghE2promWriter.chDone=RESET_COUNTER;
+		gchStepIndexE2PROM=STEP_1_Val;
+	}
+	
+	if(gchStepIndexE2PROM==STEP_1_Val)
 	{
 		if(fnCheckI2cAvailability()==RETURN_TRUE)
 		{
 			ACQUIRE_I2C_INTERFACE;
 			
-			if(chLength>I2C_COMM_BUFFER_SIZE-2)				//2-Bytes are Occupied for Address
+			//Chunk ends at page boundary as page write rolls over within the page
+			ghE2promWriter.chChunk=chLength-ghE2promWriter.chDone;
+			nPageSpace=E2PROM_PAGE_SIZE-(ghE2promWriter.nAddress & (E2PROM_PAGE_SIZE-1));
+			
+			if(ghE2promWriter.chChunk>E2PROM_WRITE_CHUNK_SIZE)
 			{
-				return SENSOR_I2C_COMM_BUFF_OVERFLOW;
+				ghE2promWriter.chChunk=E2PROM_WRITE_CHUNK_SIZE;
 			}
 			
-			ghI2cCommData.chCommBuff[0]=nAddress >> 8;
-			ghI2cCommData.chCommBuff[1]=nAddress & 0xff;
+			if(ghE2promWriter.chChunk>nPageSpace)
+			{
+				ghE2promWriter.chChunk=(uint8_t)nPageSpace;
+			}
+			
+			ghI2cCommData.chCommBuff[0]=ghE2promWriter.nAddress >> 8;
+			ghI2cCommData.chCommBuff[1]=ghE2promWriter.nAddress & 0xff;
 			
-			for(chLoopVar=RESET_COUNTER;chLoopVar<chLength;chLoopVar++)
+			for(chLoopVar=RESET_COUNTER;chLoopVar<ghE2promWriter.chChunk;chLoopVar++)
 			{
-				ghI2cCommData.chCommBuff[chLoopVar+2]=pchBuff[chLoopVar];
+				ghI2cCommData.chCommBuff[chLoopVar+2]=pchBuff[ghE2promWriter.chDone+chLoopVar];
 			}
 			
 			E2PROM_WR_CONTROL_ACTIVE;
-			fnI2cSendReceiveOperation(E2PROM_MEMORY_I2C_ADDR,chLength+2,0);		//2- Bytes of address are also included in communication buffer
-			gchStepIndexE2PROM=STEP_1_Val;
+			fnI2cSendReceiveOperation(E2PROM_MEMORY_I2C_ADDR,ghE2promWriter.chChunk+2,0);		//2- Bytes of address are also included in communication buffer
+			gchStepIndexE2PROM=STEP_2_Val;
+		}
+	}
+	else if(gchStepIndexE2PROM==STEP_2_Val)
+	{
+		chCheckStatus=fnI2cFreeForOperation();
+		
+		if(chCheckStatus!=I2C_RUNNING)
+		{
+			E2PROM_WR_CONTROL_DEACTIVE;
+			RELEASE_I2C_INTERFACE;
+			
+			if(chCheckStatus!=I2C_OP_COMPLETE)
+			{
+				gchStepIndexE2PROM=STEP_0_Val;
+				return SENSOR_I2C_BUS_ARBITRATION;
+			}
+			
+			ghE2promWriter.chDone+=ghE2promWriter.chChunk;
+			ghE2promWriter.nAddress+=ghE2promWriter.chChunk;
+			ghE2promWriter.chPollCount=RESET_COUNTER;
+			gchStepIndexE2PROM=STEP_3_Val;
+			return E2PROM_WRITE_YIELD;			//Write cycle of page is running
 		}
-		else if(gchStepIndexE2PROM==STEP_1_Val)
+	}
+	else if(gchStepIndexE2PROM==STEP_3_Val)
+	{
+		if(fnCheckI2cAvailability()==RETURN_TRUE)
 		{
-			if(fnI2cFreeForOperation()!=I2C_RUNNING)
+			ACQUIRE_I2C_INTERFACE;
+			
+			//Address of next chunk (Address without data does not start write cycle)
+			ghI2cCommData.chCommBuff[0]=ghE2promWriter.nAddress >> 8;
+			ghI2cCommData.chCommBuff[1]=ghE2promWriter.nAddress & 0xff;
+			
+			fnI2cSendReceiveOperation(E2PROM_MEMORY_I2C_ADDR,2,0);
+			gchStepIndexE2PROM=STEP_4_Val;
+		}
+	}
+	else if(gchStepIndexE2PROM==STEP_4_Val)
+	{
+		chCheckStatus=fnI2cFreeForOperation();
+		
+		if(chCheckStatus!=I2C_RUNNING)
+		{
+			RELEASE_I2C_INTERFACE;
+			
+			//Address is not acknowledged while write cycle is running
+			if(chCheckStatus!=I2C_OP_COMPLETE)
+			{
+				if(++ghE2promWriter.chPollCount>=E2PROM_ACK_POLL_LIMIT)
+				{
+					gchStepIndexE2PROM=STEP_0_Val;
+					return SENSOR_E2PROM_WRITE_CYCLE_TIMEOUT;
+				}
+				
+				gchStepIndexE2PROM=STEP_3_Val;
+				return E2PROM_WRITE_YIELD;
+			}
+			
+			if(ghE2promWriter.chDone>=chLength)
 			{
 				gchStepIndexE2PROM=STEP_0_Val;
-				fnWait_uSecond(50);			//Wait required after successful write operation to E2PROM
-				E2PROM_WR_CONTROL_DEACTIVE;
-				RELEASE_I2C_INTERFACE;
 				return RETURN_TRUE;
 			}
+			
+			gchStepIndexE2PROM=STEP_1_Val;
+			return E2PROM_WRITE_YIELD;			//Next chunk
 		}
 	}
 	
@@ -439,13 +704,18 @@ SENSOR_MC_ERROR_CODES fnE2PROMWriteOperation(uint8_t *pchBuff, uint8_t chLength,
 // @param	pchBuff		Pointer to the memory resources to hold the data bytes after reading from the E2PROM
 //			chLength	Specifies value of count for which to perform read operation
 //			nAddress	Base address in E2PROM from where to perform sequential read of data
-// @return	FALSE if operation is not completed otherwise sampled data value
-//			In the case of overflow function will return SENSOR_I2C_COMM_BUFF_OVERFLOW
+// @return	FALSE if operation is not completed otherwise TRUE
+//			In the case of overflow function will return SENSOR_I2C_COMM_BUFF_OVERFLOW and SENSOR_I2C_BUS_ARBITRATION if I2C transaction fails
 
 SENSOR_MC_ERROR_CODES fnE2PROMReadOpeartion(uint8_t *pchBuff, uint8_t chLength, uint16_t nAddress)
 {
 	uint8_t chLoopVar = RESET_COUNTER;
-	uint8_t chCheckStatus = RESET_VALUE;
+	int8_t chCheckStatus = RESET_VALUE;
+	
+	if(chLength>I2C_COMM_BUFFER_SIZE-2)				//2-Bytes are Occupied for Address
+	{
+		return SENSOR_I2C_COMM_BUFF_OVERFLOW;
+	}
 	
 	if(gchStepIndexE2PROM==STEP_0_Val)
 	{
@@ -453,11 +723,6 @@ SENSOR_MC_ERROR_CODES fnE2PROMReadOpeartion(uint8_t *pchBuff, uint8_t chLength,
 		{
 			ACQUIRE_I2C_INTERFACE;
 			
-			if(chLength>I2C_COMM_BUFFER_SIZE-2)		//2-Bytes are Occupied for Address
-			{
-				return SENSOR_I2C_COMM_BUFF_OVERFLOW;
-			}
-			
 			ghI2cCommData.chCommBuff[0]=nAddress >> 8;
 			ghI2cCommData.chCommBuff[1]=nAddress & 0xff;
 
@@ -471,16 +736,19 @@ SENSOR_MC_ERROR_CODES fnE2PROMReadOpeartion(uint8_t *pchBuff, uint8_t chLength,
 		
 		if(chCheckStatus!=I2C_RUNNING)
 		{
-			if(chCheckStatus==I2C_OP_COMPLETE)
+			gchStepIndexE2PROM=STEP_0_Val;
+			RELEASE_I2C_INTERFACE;
+			
+			if(chCheckStatus!=I2C_OP_COMPLETE)
 			{
-				for(chLoopVar=0;chLoopVar<chLength;chLoopVar++)
-				{
-					pchBuff[chLoopVar]=ghI2cCommData.chCommBuff[chLoopVar];
-				}
+				return SENSOR_I2C_BUS_ARBITRATION;
+			}
+			
+			for(chLoopVar=0;chLoopVar<chLength;chLoopVar++)
+			{
+				pchBuff[chLoopVar]=ghI2cCommData.chCommBuff[chLoopVar];
 			}
 			
-			gchStepIndexE2PROM=STEP_0_Val;
-			RELEASE_I2C_INTERFACE;
 			return RETURN_TRUE;
 		}
 	}
@@ -635,47 +903,113 @@ inline int8_t fnSetResetSmartSensorSelectlines(uint8_t chSensorGroup,uint8_t chS
 	return RETURN_TRUE;
 }
 
-//_____ fnStartSmartSensorSampling ____________________________________________________________________
+//_____ fnSmartSensorSelectCode ____________________________________________________________________
 //
-// @brief	This function will notify the Smart Sensor to start sampling with the provided sensor tasking table
-//			fnSetResetSmartSensorSelectlines() must needs to be executed to make communication path (SPI interface) between MCU and Smart Sensor through various select lines 
-//			?????
+// @brief	Sensor values are numbered from 1 and select lines (S2:S1:S0) of sensor carry its value minus 1 (See fnSetResetSmartSensorSelectlines)
 // @param	chSensorGroup	It indicates the group/interface to which this Sensor is connected
 //			chSensorValue	It indicates the Sensor to which communication will be established
-// @return FALSE if Sensor Group or Sensor Value is invalid otherwise returns TRUE
+// @return	FALSE if Sensor Group or Sensor Value is invalid otherwise select code of the sensor
 
-int8_t fnStartSmartSensorSampling(uint8_t chSensorGroup,uint8_t chSensorValue)
+static int8_t fnSmartSensorSelectCode(uint8_t chSensorGroup,uint8_t chSensorValue)
 {
-	//Definitions required to upload the sensor control byte in the sensor
+	uint8_t chLastSensorValue = RESET_VALUE;
 	
-	//????????????????????? This is just for the overview for future design - All the scenarios will get change on the basis of requirement in Smart Sensor Communication
+	switch(chSensorGroup)
+	{
+		case SMART_SENSOR_SPID_GROUP:
+			chLastSensorValue = SMART_SENSOR_SPID4;
+		break;
+		
+		case SMART_SENSOR_SPIE_GROUP:
+			chLastSensorValue = SMART_SENSOR_SPIE4;
+		break;
+		
+		case SMART_SENSOR_SPIF_GROUP:
+			chLastSensorValue = SMART_SENSOR_SPIF5;
+		break;
+		
+		default:
+			return RETURN_FALSE;
+		break;
+	}
+	
+	if((chSensorValue < SMART_SENSOR_SPID0) || (chSensorValue > chLastSensorValue))
+	{
+		return RETURN_FALSE;
+	}
+	
+	return (int8_t)(chSensorValue - SMART_SENSOR_SPID0);
+}
+
+//_____ fnStartSmartSensorSampling ____________________________________________________________________
+//
+// @brief	This function will notify the Smart Sensors of sensor tasking table to start sampling: Configuration frame with control byte,
+//			sample clock divisor and average count of the entry is queued for every Smart Sensor and frames of all the groups are sent in one run.
+//			Select lines of a group address one sensor at a time so every Smart Sensor gets its own frame (No broadcast frame).
+//			Addresses of all the entries are validated before any frame is queued, so rejected table does not leave frames in queue.
+// @return FALSE if Smart Sensor address of any entry is invalid or used by another entry otherwise returns TRUE
+
+int8_t fnStartSmartSensorSampling(void)
+{
+	uint8_t chConfigFrame[MAX_SMART_SENSORS][SMART_SENSOR_CONFIG_FRAME_SIZE];
+	uint8_t chAddressMap[MAX_SMART_SENSOR_GROUPS] = {RESET_VALUE};		//Select codes used in every group
+	uint8_t *pchFrame = NULL;
+	uint8_t chSensorCounter = RESET_COUNTER;
+	uint8_t chFrameCount = RESET_COUNTER;
+	uint8_t chAddress = RESET_VALUE;
+	int8_t  chSelectCode = RESET_VALUE;
 	
-	if(RETURN_TRUE==fnSetResetSmartSensorSelectlines(chSensorGroup,chSensorValue))
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < gchTotalSensorEntry; chSensorCounter++)
 	{
-		if(chSensorGroup==SMART_SENSOR_SPID_GROUP)
+		if(!IS_SMART_SENSOR_ID(ghSensorConfig[chSensorCounter].chSensorID))
 		{
-			//Upload sampling related Sensor Execution Table
+			continue;
 		}
-		else if(chSensorGroup==SMART_SENSOR_SPIE_GROUP)
+		
+		chAddress = ghSensorConfig[chSensorCounter].chSmartSensorAddress;
+		chSelectCode = fnSmartSensorSelectCode(SMART_SENSOR_ADDRESS_GROUP(chAddress),SMART_SENSOR_ADDRESS_VALUE(chAddress));
+		
+		if((chSelectCode == RETURN_FALSE) || (chAddressMap[SMART_SENSOR_ADDRESS_GROUP(chAddress)] & (1 << chSelectCode)))
 		{
-			//Upload sampling related Sensor Execution Table
+			return RETURN_FALSE;
 		}
-		else if(chSensorGroup==SMART_SENSOR_SPIF_GROUP)
+		
+		chAddressMap[SMART_SENSOR_ADDRESS_GROUP(chAddress)] |= (1 << chSelectCode);
+	}
+	
+	//Addresses are unique so every group has at most as many frames as its sensors (SMART_SENSOR_SPI_QUEUE_SIZE)
+	for(chSensorCounter = RESET_COUNTER; chSensorCounter < gchTotalSensorEntry; chSensorCounter++)
+	{
+		if(!IS_SMART_SENSOR_ID(ghSensorConfig[chSensorCounter].chSensorID))
 		{
-			//Upload sampling related Sensor Execution Table
+			continue;
 		}
 		
-		return RETURN_TRUE;
+		chAddress = ghSensorConfig[chSensorCounter].chSmartSensorAddress;
+		chSelectCode = fnSmartSensorSelectCode(SMART_SENSOR_ADDRESS_GROUP(chAddress),SMART_SENSOR_ADDRESS_VALUE(chAddress));
+		
+		pchFrame = chConfigFrame[chFrameCount++];
+		pchFrame[SMART_SENSOR_CONFIG_COMMAND_INDEX]	= SMART_SENSOR_CONFIG_COMMAND;
+		pchFrame[SMART_SENSOR_CONFIG_CTRL_INDEX]	= ghSensorConfig[chSensorCounter].chSensorCtrlByte;
+		pchFrame[SMART_SENSOR_CONFIG_DIVISOR_INDEX]	= ghSensorConfig[chSensorCounter].chSampleClockDivisor;
+		pchFrame[SMART_SENSOR_CONFIG_AVERAGE_INDEX]	= ghSensorConfig[chSensorCounter].chSensorSampleAvgTotalCount;
+		
+		fnSpiSmartSensorQueueAdd(SMART_SENSOR_ADDRESS_GROUP(chAddress),SMART_SENSOR_SPI_TRANSMIT,(uint8_t)chSelectCode,pchFrame,SMART_SENSOR_CONFIG_FRAME_SIZE);
 	}
 	
-	return RETURN_FALSE;
+	if(chFrameCount != RESET_COUNTER)
+	{
+		fnSpiSmartSensorQueueRun();
+	}
+	
+	return RETURN_TRUE;
 }
 
 //_____ fnSmartSensorsDataCollection ____________________________________________________________________
 //
 // @brief	This function will fetch the sampled data from the Smart Sensor
-//			fnSetResetSmartSensorSelectlines() must needs to be executed to make communication path (SPI interface) between MCU and Smart Sensor through various select lines
-//			?????
+//			Frame goes through the queue of fnSmartSensorsAcquisitionRun, so measurements are shifted directly in pchSampledData
+//			Single Smart Sensor is fetched at once, sensors due at the same sample clock are queued by fnSmartSensorsAcquisitionAdd instead
 // @param	chSensorGroup	It indicates the group/interface to which this Sensor is connected
 //			chSensorValue	It indicates the Sensor to which communication will be established
 //			pchSampledData	Pointer to memory resources where wants to put the sample data after receiving
@@ -684,48 +1018,60 @@ int8_t fnStartSmartSensorSampling(uint8_t chSensorGroup,uint8_t chSensorValue)
 
 int8_t fnSmartSensorsDataCollection(uint8_t chSensorGroup,uint8_t chSensorValue,uint8_t *pchSampledData,uint8_t chSanpledlength)
 {
-	uint8_t chSensorDataLength = RESET_VALUE;
-	uint8_t chLoopCounter = RESET_COUNTER;
-	uint8_t chSensorDataBuff[SPI_SMART_SENSOR_COMM_BUF_SIZE];
-	
-	//????????????????????? This is just for the overview for future design - All the scenarios will get change on the basis of requirement in Smart Sensor Communication
-	
-	if(RETURN_TRUE==fnSetResetSmartSensorSelectlines(chSensorGroup,chSensorValue))
+	if(RETURN_TRUE==fnSmartSensorsAcquisitionAdd(chSensorGroup,chSensorValue,pchSampledData,chSanpledlength))
 	{
-		chSensorDataLength=chSanpledlength;
-		fnMemSetToValue(chSensorDataBuff,0,chSensorDataLength);
-		
-		if(chSensorGroup==SMART_SENSOR_SPID_GROUP)
-		{
-			fnSPID_SendReceiveOperation(chSensorDataBuff,chSensorDataLength);
-		}
-		else if(chSensorGroup==SMART_SENSOR_SPIE_GROUP)
-		{
-			fnSPIE_SendReceiveOperation(chSensorDataBuff,chSensorDataLength);
-		}
-		else if(chSensorGroup==SMART_SENSOR_SPIF_GROUP)
-		{
-			fnSPIF_SendReceiveOperation(chSensorDataBuff,chSensorDataLength);
-		}
-		
-		for(chLoopCounter=0;chLoopCounter<chSanpledlength;chLoopCounter++)
-		{
-			pchSampledData[chLoopCounter]=chSensorDataBuff[chLoopCounter];
-		}
-		
+		fnSmartSensorsAcquisitionRun();
 		return RETURN_TRUE;
 	}
 	
 	return RETURN_FALSE;
 }
 
+//_____ fnSmartSensorsAcquisitionAdd ____________________________________________________________________
+//
+// @brief	Queues the Smart Sensor for next fnSmartSensorsAcquisitionRun, measurements are shifted directly in pchSampledData
+// @param	chSensorGroup	It indicates the group/interface to which this Sensor is connected
+//			chSensorValue	It indicates the Sensor to which communication will be established
+//			pchSampledData	Pointer to memory resources where wants to put the sample data (Sample slot of sensor)
+//			chSampledlength	No of sampled data to fetch from the Smart Sensor
+// @return	FALSE if Sensor Group or Sensor Value is invalid or group has no free frame otherwise returns TRUE
+
+int8_t fnSmartSensorsAcquisitionAdd(uint8_t chSensorGroup,uint8_t chSensorValue,uint8_t *pchSampledData,uint8_t chSampledlength)
+{
+	int8_t chSelectCode = fnSmartSensorSelectCode(chSensorGroup,chSensorValue);
+	
+	if(chSelectCode == RETURN_FALSE)
+	{
+		return RETURN_FALSE;
+	}
+	
+	return fnSpiSmartSensorQueueAdd(chSensorGroup,SMART_SENSOR_SPI_RECEIVE,(uint8_t)chSelectCode,pchSampledData,chSampledlength);
+}
+
+//_____ fnSmartSensorsAcquisitionRun ____________________________________________________________________
+//
+// @brief	Fetches all the queued Smart Sensors, SPID, SPIE and SPIF groups are shifted at the same time
+//			(Sampling 16 Smart Sensors takes the time of the 6 sensors of SPIF group instead of all the 16 sensors)
+// @return	Bit mask (SMART_SENSOR_GROUP_BM) of groups whose sensors are fetched
+
+uint8_t fnSmartSensorsAcquisitionRun(void)
+{
+	return fnSpiSmartSensorQueueRun();
+}
+
 //_____ fnDebug_Serial_Task ____________________________________________________________________
 //
 //	?????Implementation pending
+//	When task profiler is enabled it sends the task profile on debug UART.
 
 int8_t fnDebug_Serial_Task(void)
 {
 	SEND_DEBUG_STRING("Serial Task");
+	
+	#if TASK_PROFILER_ENABLE
+		fnTaskProfilerDump();
+	#endif
+	
 	return RETURN_TRUE;
 }
 
@@ -7,6 +7,31 @@ Date Created: 11/04/2014
 
 (NOTE: latest version is the top version)
 
+Author: Aalok Shah
+Changes: Smart Sensor IDs end at PAYLOAD_SENSOR_ID_BM (Execution Table with higher ID is rejected as undefined sensor)
+
+Author: Aalok Shah
+Changes: Configuration of Smart Sensors (control byte, sample clock divisor, average count) is pushed when Execution Table is accepted (fnStartSmartSensorSampling),
+		 Sensor IDs from SMART_SENSOR_ID_FIRST are measurements of Smart Sensors
+
+Author: Aalok Shah
+Changes: Smart Sensors of SPID, SPIE and SPIF groups are acquired concurrently (fnSmartSensorsAcquisitionAdd/Run), measurements are shifted directly in sample slot
+
+Author: Aalok Shah
+Changes: Last chamber temperature reading kept for calibration of CC1125 (fnLastChamberTemperature)
+
+Author: Aalok Shah
+Changes: E2PROM write operation splits the buffer at page boundaries and polls the end of write cycle (ACK polling) instead of fixed wait
+
+Author: Aalok Shah
+Changes: E2PROM write operation completes its transaction (step 1 was nested in step 0) and E2PROM operations report failed I2C transaction
+
+Author: Aalok Shah
+Changes: Significant bits of measurement (chSensorDataBits) declared in sensor driver registry for bit packed payload
+
+Author: Aalok Shah
+Changes: Sensor driver registry indexed by sensor ID (SENSOR_DRIVER_STRUCT) replaces SENSOR_DETAILS
+
 Author: , Aalok Shah
 Changes: Initial version
 
@@ -65,8 +90,6 @@ Test Results:
 
 	//_________________ M A C R O S _______________________________________________
 	
-	#define SPI_SMART_SENSOR_COMM_BUF_SIZE		40
-
 	//I2C Addresses
 	//E2PROM ADDRESSES ARE VARIABLE (BUT ALWAYS SET E2 BIT HIGH)
 	#define PRESSURE_SENSOR_I2C_ADDR			0x28
@@ -74,6 +97,13 @@ Test Results:
 	#define E2PROM_MEMORY_I2C_ADDR				0x54		//A16=A17=0
 	#define E2PROM_PAGE_I2C_ADDR				0x5C		//A16=A17=0
 
+	//E2PROM write operation: Data is written in chunks which never cross page and fit I2C buffer, every chunk starts write cycle (tW) of page
+	//E2PROM does not acknowledge its address till write cycle is over, so end of write cycle is found by sending address (ACK polling)
+	#define E2PROM_PAGE_SIZE					256			//Bytes of page (Page write rolls over at page boundary)
+	#define E2PROM_WRITE_CHUNK_SIZE				(I2C_COMM_BUFFER_SIZE-2)	//2-Bytes are Occupied for Address
+	#define E2PROM_ACK_POLL_LIMIT				250			//ACK polls (about 100us each) after which write cycle is considered failed (tW is 10ms max)
+	#define E2PROM_WRITE_YIELD					(-2)		//I2C is released between transactions of write operation, caller wakes its task and calls again
+
 	//Only useful register addresses are mentioned in here for communicating with the Gyroscope
 	//Gyroscope is used in Normal Mode- Values will be read from Gyro Data Register
 	#define GYRO_MAX21000_DEVICE_ID				0x20
@@ -88,6 +118,9 @@ Test Results:
 	#define GYRO_MAX21000_I2C_CFG				0x15
 	#define GYRO_MAX21000_DATA_START_ADDR		0x23
 
+	//Chamber temperature is not sampled since reset
+	#define CHAMBER_TEMPERATURE_UNKNOWN			RETURN_FALSE
+
 	//Pressure Sensor
 	#define PRESSURE_MAX_RESOLUTION_VALUE		14745		//90% of 2^14 (14bit Resolution of Pressure Sensor)
 	#define PRESSURE_MIN_RESOLUTION_VALUE		1638		//10% of 2^14 (14bit Resolution of Pressure Sensor)
@@ -95,10 +128,11 @@ Test Results:
 	#define PRESSURE_MIN_VALUE					0
 
 	//Smart Sensor Scenarios
-	#define MAX_SMART_SENSOR_GROUPS				3
-	#define SMART_SENSOR_SPID_GROUP				0
-	#define SMART_SENSOR_SPIE_GROUP				1
-	#define SMART_SENSOR_SPIF_GROUP				2
+	#define MAX_SMART_SENSOR_GROUPS				SMART_SENSOR_SPI_CHANNELS
+	#define SMART_SENSOR_SPID_GROUP				SMART_SENSOR_SPID_CHANNEL
+	#define SMART_SENSOR_SPIE_GROUP				SMART_SENSOR_SPIE_CHANNEL
+	#define SMART_SENSOR_SPIF_GROUP				SMART_SENSOR_SPIF_CHANNEL
+	#define SMART_SENSOR_GROUP_BM(chGroup)		SMART_SENSOR_CHANNEL_BM(chGroup)
 
 	//SPID (SPID0-SPID4)
 	#define SMART_SENSOR_SPID0				0x01
@@ -122,14 +156,56 @@ Test Results:
 	#define SMART_SENSOR_SPIF4				0x05
 	#define SMART_SENSOR_SPIF5				0x06
 
+	//Smart Sensor address of sensor entry: Group in upper nibble and sensor value in lower nibble (0 for sensors sampled by SENSOR MC)
+	#define SMART_SENSOR_ADDRESS_GROUP(chAddress)	((chAddress) >> 4)
+	#define SMART_SENSOR_ADDRESS_VALUE(chAddress)	((chAddress) & 0x0F)
+	#define MAX_SMART_SENSORS						16			//SPID0-SPID4, SPIE0-SPIE4 and SPIF0-SPIF5
+
+	//Smart Sensor IDs follow sensor driver registry, Smart Sensor samples on its own and returns one averaged measurement word (MSB first)
+	//(IDs end at PAYLOAD_SENSOR_ID_BM so delta and bit packed entries stay unique, higher ID has no driver and is rejected as undefined)
+	#define SMART_SENSOR_ID_FIRST					TOTAL_SENSOR_IDS
+	#define IS_SMART_SENSOR_ID(chSensorID)			(((chSensorID) >= SMART_SENSOR_ID_FIRST) && ((chSensorID) <= PAYLOAD_SENSOR_ID_BM))
+	#define SMART_SENSOR_DATA_LEN					1
+
+	//Configuration frame of Smart Sensor (Sent to every Smart Sensor of Execution Table when it is accepted)
+	#define SMART_SENSOR_CONFIG_COMMAND				0xC5
+	#define SMART_SENSOR_CONFIG_COMMAND_INDEX		0
+	#define SMART_SENSOR_CONFIG_CTRL_INDEX			1
+	#define SMART_SENSOR_CONFIG_DIVISOR_INDEX		2
+	#define SMART_SENSOR_CONFIG_AVERAGE_INDEX		3
+	#define SMART_SENSOR_CONFIG_FRAME_SIZE			4
+
+	//Sensor Driver Registry
+	#define SENSOR_AVERAGED_DATA_LEN			1			//Sensor with single measurement is averaged over chSensorSampleAvgTotalCount samples
+	#define NO_POWER_SOURCE_IDENTITY			0			//Sensor does not require 5V power source
+	#define SENSOR_DATA_WORD_BITS				16			//Width of measurement word in sensor data
+
 	//_____ D A T A   S T R U C T U R E S _________________________________________________
 
-	//Holds sensor static details including data length and sensor ID of all the supported sensors on SENSOR MC
+	//Driver of sensor executed by Data Sampling Task, every step is optional (NULL) except pfnFetchSensor
+	//	SAMPLE_STATE_START		Request 5V power source for chPowerSourceIdentity
+	//	SAMPLE_STATE_RUN_LVL0	pfnStartSensor: Take control over the interface used by sensor (TRUE when acquired)
+	//	SAMPLE_STATE_RUN_LVL1	pfnPollSensor: Start conversion or initialize the sensor (TRUE when sensor is ready)
+	//	SAMPLE_STATE_RUN		pfnFetchSensor: Fetch chSensorDataLen measurements (TRUE when available) followed by pfnReleaseSensor and power release
+	typedef struct
+	{
+		uint8_t	chSensorDataLen;						//No of measurements of sensor (Length of the sensor data in collection packet in words)
+		uint8_t	chSensorDataBits;						//Significant bits of every measurement (Width of measurement in bit packed payload)
+		uint8_t	chPowerSourceIdentity;					//Identity used with fnPowerSourceManager or NO_POWER_SOURCE_IDENTITY
+		int8_t	(*pfnStartSensor)(void);
+		int8_t	(*pfnPollSensor)(void);
+		int8_t	(*pfnFetchSensor)(uint16_t *pnData);
+		void	(*pfnReleaseSensor)(void);
+	}SENSOR_DRIVER_STRUCT;
+	
+	//Write operation of E2PROM in progress (Steps in gchStepIndexE2PROM)
 	typedef struct
 	{
-		uint8_t chSensorID;
-		uint8_t chSensorDataLen;
-	}SENSOR_DETAILS;
+		uint16_t	nAddress;							//E2PROM address of chunk being written
+		uint8_t		chDone;								//Bytes of caller buffer written
+		uint8_t		chChunk;							//Bytes of chunk being written
+		uint8_t		chPollCount;						//ACK polls not acknowledged in write cycle of chunk
+	}E2PROM_WRITER_STRUCT;
 	
 	//_____ E N U M E R A T I O N S _________________________________________________
 	
@@ -151,7 +227,8 @@ Test Results:
 		BATTERY_STAVE_B3_UNLOADED,
 		BATTERY_STAVE_B3_LOADED,
 		BATTERY_STAVE_B4_UNLOADED,
-		BATTERY_STAVE_B4_LOADED
+		BATTERY_STAVE_B4_LOADED,
+		TOTAL_SENSOR_IDS								//Size of sensor driver registry
 	}SENSOR_MC_SENSOR_LIST;
 
 	//_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
@@ -162,17 +239,34 @@ Test Results:
 	extern volatile uint8_t gchLvl1StepIndexI2C;
 	extern volatile uint8_t gchLvl2StepIndexI2C;
 	extern volatile uint8_t gchStepIndexE2PROM;
+	extern E2PROM_WRITER_STRUCT ghE2promWriter;
 
 	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
 
+	//_____ fnFetchSensorDriver ____________________________________________________________________
+	//
+	// @brief	Returns the driver of sensor from sensor driver registry (Registry is indexed by Sensor ID)
+	// @param	chSensorID		Sensor ID (SENSOR_MC_SENSOR_LIST)
+	// @return	NULL if sensor is not supported otherwise pointer to the driver of sensor
+	
+	const SENSOR_DRIVER_STRUCT *fnFetchSensorDriver(uint8_t chSensorID);
+
 	//_____ fnFetchSensorDataLength ____________________________________________________________________
 	//
-	// @brief	It will perform linear search in all the entries of SENSOR_DETAILS to find out the data length of the sensor passed in argument
+	// @brief	It will find out the data length of the sensor passed in argument from sensor driver registry (SMART_SENSOR_DATA_LEN for Smart Sensor IDs)
 	// @param	chSensorID		Sensor ID for which searching for the data length
 	// @return	FALSE if no entry found for given Sensor ID otherwise returns data length specific to provided Sensor ID
 	
 	int8_t fnFetchSensorDataLength(uint8_t chSensorID);
 
+	//_____ fnFetchSensorDataBits ____________________________________________________________________
+	//
+	// @brief	It will find out the significant bits of every measurement of the sensor passed in argument from sensor driver registry
+	// @param	chSensorID		Sensor ID for which searching for the width of measurement
+	// @return	SENSOR_DATA_WORD_BITS if no entry found for given Sensor ID otherwise width of measurement specific to provided Sensor ID
+	
+	uint8_t fnFetchSensorDataBits(uint8_t chSensorID);
+
 	//_____ fnCheckI2cAvailability ____________________________________________________________________
 	//
 	// @brief It will just call	lower level function fnCheckI2CStatus() to find out I2C availability for operation
@@ -219,38 +313,46 @@ Test Results:
 	
 	int16_t fnFetchChamberTemperature(void);
 
+	//_____ fnLastChamberTemperature ____________________________________________________________________
+	//
+	// @brief	Gives last chamber temperature fetched by fnFetchChamberTemperature without starting ADC conversion
+	// @return	Last sampled data value or CHAMBER_TEMPERATURE_UNKNOWN if chamber temperature is not sampled since reset
+	
+	int16_t fnLastChamberTemperature(void);
+
 	//_____ fnE2PROMWriteOperation ____________________________________________________________________
 	//
-	// @brief	Use this function to write block of data sequentially in to E2PROM
+	// @brief	Use this function to write block of data sequentially in to E2PROM. Block is split in chunks which end at page boundary or fill I2C buffer,
+	//			every call starts at most one I2C transaction: Chunk write followed by ACK polls till write cycle of chunk is over.
+	//			Caller must keep the buffer and call again with same arguments till it gets TRUE or error code.
 	// @param	pchBuff		Pointer to the memory resources to hold the data bytes needed to write in E2PROM
 	//			chLength	Specifies value of count for which to perform write operation
 	//			nAddress	Base address in E2PROM from where to perform sequential write of data
-	// @return	FALSE if operation is not completed otherwise sampled data value
-	//			In the case of overflow function will return SENSOR_I2C_COMM_BUFF_OVERFLOW
+	// @return	TRUE if data is written and write cycle is over, FALSE if I2C transaction is running (its completion wakes the task)
+	//			E2PROM_WRITE_YIELD if I2C is released between transactions (caller wakes its task)
+	//			SENSOR_I2C_BUS_ARBITRATION if I2C transaction fails and SENSOR_E2PROM_WRITE_CYCLE_TIMEOUT if write cycle does not end
 	
 	SENSOR_MC_ERROR_CODES fnE2PROMWriteOperation(uint8_t *pchBuff, uint8_t chLength, uint16_t nAddress);
 
 	//_____ fnE2PROMReadOpeartion ____________________________________________________________________
 	//
-	// @brief	Use this function to read block of data sequentially from E2PROM
+	// @brief	Use this function to read block of data sequentially from E2PROM (Must not be called while write operation is in progress)
 	// @param	pchBuff		Pointer to the memory resources to hold the data bytes after reading from the E2PROM
 	//			chLength	Specifies value of count for which to perform read operation
 	//			nAddress	Base address in E2PROM from where to perform sequential read of data
-	// @return	FALSE if operation is not completed otherwise sampled data value
-	//			In the case of overflow function will return SENSOR_I2C_COMM_BUFF_OVERFLOW
+	// @return	FALSE if operation is not completed otherwise TRUE
+	//			In the case of overflow function will return SENSOR_I2C_COMM_BUFF_OVERFLOW and SENSOR_I2C_BUS_ARBITRATION if I2C transaction fails
 	
 	SENSOR_MC_ERROR_CODES fnE2PROMReadOpeartion(uint8_t *pchBuff, uint8_t chLength, uint16_t nAddress);
 
 	//_____ fnStartSmartSensorSampling ____________________________________________________________________
 	//
-	// @brief	This function will notify the Smart Sensor to start sampling with the provided sensor tasking table
-	//			fnSetResetSmartSensorSelectlines() must needs to be executed to make communication path (SPI interface) between MCU and Smart Sensor through various select lines
-	//			?????
-	// @param	chSensorGroup	It indicates the group/interface to which this Sensor is connected
-	//			chSensorValue	It indicates the Sensor to which communication will be established
-	// @return FALSE if Sensor Group or Sensor Value is invalid otherwise returns TRUE
+	// @brief	This function will notify the Smart Sensors of sensor tasking table to start sampling: Configuration frame with control byte,
+	//			sample clock divisor and average count of the entry is queued for every Smart Sensor and frames of all the groups are sent in one run.
+	//			Smart Sensors sample on their own on sample clock (ENABLE_SMART_SENSOR_SAMPLE_CLOCK), SENSOR MC only collects their measurements.
+	// @return FALSE if Smart Sensor address of any entry is invalid or used by another entry otherwise returns TRUE
 	
-	int8_t fnStartSmartSensorSampling(uint8_t chSensorGroup,uint8_t chSensorValue);
+	int8_t fnStartSmartSensorSampling(void);
 
 	//_____ fnSmartSensorsDataCollection ____________________________________________________________________
 	//
@@ -265,4 +367,22 @@ Test Results:
 	
 	int8_t fnSmartSensorsDataCollection(uint8_t chSensorGroup,uint8_t chSensorValue,uint8_t *pchSampledData,uint8_t chSanpledlength);
 
+	//_____ fnSmartSensorsAcquisitionAdd ____________________________________________________________________
+	//
+	// @brief	Queues the Smart Sensor for next fnSmartSensorsAcquisitionRun, measurements are shifted directly in pchSampledData
+	// @param	chSensorGroup	It indicates the group/interface to which this Sensor is connected
+	//			chSensorValue	It indicates the Sensor to which communication will be established
+	//			pchSampledData	Pointer to memory resources where wants to put the sample data (Sample slot of sensor)
+	//			chSampledlength	No of sampled data to fetch from the Smart Sensor
+	// @return	FALSE if Sensor Group or Sensor Value is invalid or group has no free frame otherwise returns TRUE
+	
+	int8_t fnSmartSensorsAcquisitionAdd(uint8_t chSensorGroup,uint8_t chSensorValue,uint8_t *pchSampledData,uint8_t chSampledlength);
+
+	//_____ fnSmartSensorsAcquisitionRun ____________________________________________________________________
+	//
+	// @brief	Fetches all the queued Smart Sensors, SPID, SPIE and SPIF groups are shifted at the same time
+	// @return	Bit mask (SMART_SENSOR_GROUP_BM) of groups whose sensors are fetched
+	
+	uint8_t fnSmartSensorsAcquisitionRun(void);
+
 #endif /* SENSOR_MANAGEMENT_H_ */
\ No newline at end of file
@@ -8,8 +8,19 @@ Purpose: To manages all the required mechanism to maintain the reliable communic
 
 Functions:
 fnData_ET_Request_Task			Execution Table Request task (It will execute when SENSOR in IDLE mode)
+fnDownloadWindowNext			Finds next packet of generation which is not acknowledged in selective repeat
+fnDownloadWindowRewind			Moves selective repeat back to first packet which is not acknowledged
+fnResponseTimeSample			Updates smoothed response time and variance of RF exchange and derives response wait time
+fnResponseWaitBackoff			Doubles response wait time on time out (Limited to nCommTimeout of Execution Table)
 fnRadioTxRxHandler				It includes all the required scenarios to manage the communication over RF
 fnData_Download_Task			Data Download Task (It will execute when SENSOR in Data mode)
+fnDownloadNextGeneration		Frees downloaded generation and selects next work of Data Download Task
+fnDownloadLogCatchUp			Replays backlog of store-and-forward log once uplink is back
+fnPacketBuilderOpen				Starts assembly of data packet in place in gchSensorCommBuff
+fnPacketBuilderReserve			Reserves bytes of data message in packet being assembled
+fnPacketBuilderFreeBits			Bits of data message left in packet being assembled
+fnPacketBuilderPackBits			Appends value to bit stream of data message in packet being assembled
+fnPacketBuilderClose			Fills header, descriptor and length fields of assembled packet
 fnET_Upload_Task				It verifies the received tasking table and initialize the allocated memory resources for the same
 
 Interrupts:
@@ -70,12 +81,16 @@ Test Results:
 volatile SENSOR_COMM_MANAGER			ghSensorCommManager;
 
 //Memory resources for the data with multi packet support
-uint8_t					gchSensorCommBuff[MAX_COMM_PACKET_COUNT][MAX_COMM_PACKET_SIZE];
+//Packet 0 is used by Execution Table request/reply and loop back, rest of them are slots of collection queue
+uint8_t					gchSensorCommBuff[COMM_PACKET_POOL_SIZE][MAX_COMM_PACKET_SIZE];
+
+//Receive buffer for RF communication (Packet longer than RX FIFO of CC1125 is filled over several passes of fnRadioTxRxHandler)
+static uint8_t							gchSensorRxBuff[MAX_COMM_PACKET_SIZE];
 
 //Holds current state of RF communication
 volatile Radio_Handler_Step_Enum_t		gchRadioCommStepMode;
 
-//Flag used to signal the data download task that data collection task is completed and data packet are ready
+//Flag used to signal the data download task that collection queue holds data packets ready for download
 volatile uint8_t					gchDataDownloadPacketReady;
 
 //Holds the value for no of sensors available in current tasking table
@@ -87,11 +102,8 @@ volatile uint8_t					gchCommunicationTimeOut;
 //Flag to indicate SENSOR loop back is ON or OFF
 volatile Loop_Back_Step_Enum_t		gchSensorLoopBack;
 
-//Variable used to support the communication wait time doubling scenarios
-volatile uint8_t					gchCommWaitTimeDoubleCounter;
-
-//Holds default value of communication wait time
-volatile uint16_t					gnDefaultCommWaitTimeValue;
+//Rounds of retries done after retry out before operation is terminated
+volatile uint8_t					gchCommRetryRoundCounter;
 
 //Variable used to indicate the reply type - ACK/NACK after receiving the data from RFC
 uint8_t								gchAckReplyType;
@@ -108,11 +120,12 @@ uint8_t								gchAckReplyType;
 //				In the case of mismatch it will also raise the overrun errors indicating for the same.
 //				After successfully loading the Master Controller this function will load all the sensor's individual tasking table in the same way.
 // @param	pchSensorRxBuff	Pointer to memory resources used to hold the received data over RF
+//			chRxBytes		No of bytes received in pchSensorRxBuff (Including RSSI and CRC status)
 // @return	FALSE if boundary mismatch in any of the parameter will get found in received data otherwise returns TRUE
 
-inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff)
+inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff,uint8_t chRxBytes)
 {
-	uint8_t chSensorCounter;
+	uint16_t nEntryIndex;
 	
 	//Disable Sample Clock
 	fnStopSampleClock();
@@ -120,6 +133,14 @@ inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff)
 	//Release all the shared resources to avoid conflict
 	fnResetFirmwareResourceAllocations();
 		
+	//Length of Execution Table must cover its fields before sensor entries and must not exceed the bytes actually received
+	if((pchSensorRxBuff[PACKET_LENGTH_INDEX] < SENSORS_START_INDEX) || (((uint16_t)pchSensorRxBuff[PACKET_LENGTH_INDEX] + RX_PACKET_STATUS_BYTES) > chRxBytes))
+	{
+		SEND_ERROR_CODE_OVER_RF(SENSOR_EXECUTION_TABLE_LENGTH_MISMATCH);
+		SEND_DEBUG_ERROR_CODES(SENSOR_EXECUTION_TABLE_LENGTH_MISMATCH);
+		return RETURN_FALSE;
+	}
+	
 	if(pchSensorRxBuff[PACKET_MASTER_ID_INDEX] != ID_MASTER_CONTROLLER)		//Master Controller ID
 	{
 		return RETURN_FALSE;
@@ -147,6 +168,24 @@ inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff)
 		ghMasterTaskTable.chDataDownloadChannel=RADIO_CH_SLOW_DOWNLINK_CC1125;
 	}
 	
+	//Payload encoding of data packets (Reserved value falls back to raw encoding)
+	ghMasterTaskTable.chPayloadEncoding=(pchSensorRxBuff[PACKET_CONTROL_BYTE1] & PAYLOAD_ENCODING_BM) >> PAYLOAD_ENCODING_bp;
+	
+	if(ghMasterTaskTable.chPayloadEncoding > PAYLOAD_ENCODING_PACKED)
+	{
+		ghMasterTaskTable.chPayloadEncoding=PAYLOAD_ENCODING_RAW;
+	}
+	
+	//ARQ of multi packet generations
+	if(pchSensorRxBuff[PACKET_CONTROL_BYTE1] & DOWNLOAD_WINDOW_BM)
+	{
+		ghMasterTaskTable.chDownloadWindow=DOWNLOAD_WINDOW_ON;
+	}
+	else
+	{
+		ghMasterTaskTable.chDownloadWindow=DOWNLOAD_WINDOW_OFF;
+	}
+	
 	//Radio Clock Divisor
 	ghMasterTaskTable.nRadioClockDivisor =((uint16_t)(pchSensorRxBuff[PACKET_CONTROL_BYTE1] & BIT_0_bm) << BIT_8_bp) | pchSensorRxBuff[PACKET_CONTROL_BYTE2];				
 	
@@ -168,7 +207,10 @@ inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff)
 	}
 	else
 	{
-		gnDefaultCommWaitTimeValue=ghMasterTaskTable.nCommTimeout;
+		//Response time estimate starts again from the upper bound given by Execution Table
+		ghSensorCommManager.lSmoothedRtt	= RESET_VALUE;
+		ghSensorCommManager.lRttVariance	= RESET_VALUE;
+		ghSensorCommManager.nResponseWait	= ghMasterTaskTable.nCommTimeout;
 	}
 	
 	//If sample clock is greater then minimum sample clock value to keep 5v source on then 5v source remains on
@@ -186,38 +228,60 @@ inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff)
 		gchPowerSourceMode=POWER_SOURCE_AT_REQUIRE;
 	}
 	
-	for(chSensorCounter=SENSORS_START_INDEX; chSensorCounter<pchSensorRxBuff[PACKET_LENGTH_INDEX] ;chSensorCounter += SENSOR_ENTRY_OFFSET)
+	//Only complete sensor entries are loaded
+	for(nEntryIndex=SENSORS_START_INDEX; (nEntryIndex + SENSOR_ENTRY_OFFSET) <= pchSensorRxBuff[PACKET_LENGTH_INDEX] ;nEntryIndex += SENSOR_ENTRY_OFFSET)
 	{
 		//Skip Sensors with the Sample Clock divisor value zero
-		if(pchSensorRxBuff[chSensorCounter + SAMPLE_CLOCK_DIVISOR_OFFSET] == RESET_VALUE)
+		if(pchSensorRxBuff[nEntryIndex + SAMPLE_CLOCK_DIVISOR_OFFSET] == RESET_VALUE)
 		{
 			continue;
 		}
 		
-		ghSensorControl[gchTotalSensorEntry].chSensorID					= pchSensorRxBuff[chSensorCounter + SENSOR_EXECUTION_TABLE_ID_OFFSET];			//sensor id
-		ghSensorControl[gchTotalSensorEntry].chSensorCtrlByte 			= pchSensorRxBuff[chSensorCounter + SENSOR_CONTROL_BYTE_OFFSET];				//sensor control byte
-		ghSensorControl[gchTotalSensorEntry].chSampleClockDivisor 		= pchSensorRxBuff[chSensorCounter + SAMPLE_CLOCK_DIVISOR_OFFSET];				//sample clock divisor
-		ghSensorControl[gchTotalSensorEntry].chRadioClockDivisor 		= pchSensorRxBuff[chSensorCounter + RADIO_CLOCK_DIVISOR_OFFSET];				//radio clock divisor
-		ghSensorControl[gchTotalSensorEntry].chSensorSampleAvgTotalCount= pchSensorRxBuff[chSensorCounter + SAMPLES_IN_AVERAGE_OFFSET];				//sensor sample clock averages
+		ghSensorConfig[gchTotalSensorEntry].chSensorID					= pchSensorRxBuff[nEntryIndex + SENSOR_EXECUTION_TABLE_ID_OFFSET];			//sensor id
+		ghSensorConfig[gchTotalSensorEntry].chSmartSensorAddress		= pchSensorRxBuff[nEntryIndex + SMART_SENSOR_ADDRESS_OFFSET];				//smart sensor address
+		ghSensorConfig[gchTotalSensorEntry].chSensorCtrlByte 			= pchSensorRxBuff[nEntryIndex + SENSOR_CONTROL_BYTE_OFFSET];				//sensor control byte
+		ghSensorConfig[gchTotalSensorEntry].chSampleClockDivisor 		= pchSensorRxBuff[nEntryIndex + SAMPLE_CLOCK_DIVISOR_OFFSET];				//sample clock divisor
+		ghSensorConfig[gchTotalSensorEntry].chRadioClockDivisor 		= pchSensorRxBuff[nEntryIndex + RADIO_CLOCK_DIVISOR_OFFSET];				//radio clock divisor
+		ghSensorConfig[gchTotalSensorEntry].chSensorSampleAvgTotalCount= pchSensorRxBuff[nEntryIndex + SAMPLES_IN_AVERAGE_OFFSET];				//sensor sample clock averages
 	
-		ghSensorControl[gchTotalSensorEntry].chSensorDataLength 		= fnFetchSensorDataLength(ghSensorControl[gchTotalSensorEntry].chSensorID);	//sensor data length
+		ghSensorConfig[gchTotalSensorEntry].chSensorDataLength 		= fnFetchSensorDataLength(ghSensorConfig[gchTotalSensorEntry].chSensorID);	//sensor data length
+		ghSensorConfig[gchTotalSensorEntry].chSensorDataBits 			= fnFetchSensorDataBits(ghSensorConfig[gchTotalSensorEntry].chSensorID);	//width of data word
 		
-		if(ghSensorControl[gchTotalSensorEntry].chSensorSampleAvgTotalCount == RESET_VALUE || ghSensorControl[gchTotalSensorEntry].chSensorSampleAvgTotalCount>MAX_SAMPLE_AVERAGE_SUPPORTED)
+		if(ghSensorConfig[gchTotalSensorEntry].chSensorSampleAvgTotalCount == RESET_VALUE || ghSensorConfig[gchTotalSensorEntry].chSensorSampleAvgTotalCount>MAX_SAMPLE_AVERAGE_SUPPORTED)
 		{
-			ghSensorControl[gchTotalSensorEntry].chSensorSampleAvgTotalCount = MIN_SAMPLE_AVG_COUNT;
+			ghSensorConfig[gchTotalSensorEntry].chSensorSampleAvgTotalCount = MIN_SAMPLE_AVG_COUNT;
 			SEND_ERROR_CODE_OVER_RF(SENSOR_SAMPLE_AVERAGE_COUNT_EXCEEDS);		
 			SEND_DEBUG_ERROR_CODES(SENSOR_SAMPLE_AVERAGE_COUNT_EXCEEDS);
 		}
 		
 		//Reset various sequential counters to its initial value
-		ghSensorControl[gchTotalSensorEntry].chSampleClockCounter 		= ghSensorControl[gchTotalSensorEntry].chSampleClockDivisor;	//sample all requested sensors for the first time
-		ghSensorControl[gchTotalSensorEntry].chRadioClockCounter		= RESET_VALUE;
-		ghSensorControl[gchTotalSensorEntry].chSensorSampleAvgCounter	= RESET_VALUE;
-		ghSensorControl[gchTotalSensorEntry].nSensorAvgData				= RESET_VALUE;
-		ghSensorControl[gchTotalSensorEntry].chSensorStatusFlag 		= SAMPLE_STATE_OFF;
+		ghSensorRuntime.chSampleClockCounter[gchTotalSensorEntry] 		= ghSensorConfig[gchTotalSensorEntry].chSampleClockDivisor;	//sample all requested sensors for the first time
+		ghSensorRuntime.chRadioClockCounter[gchTotalSensorEntry]		= RESET_VALUE;
+		ghSensorRuntime.chSensorSampleAvgCounter[gchTotalSensorEntry]	= RESET_VALUE;
+		ghSensorSample[gchTotalSensorEntry].nSensorAvgData				= RESET_VALUE;
+		ghSensorRuntime.chSensorStatusFlag[gchTotalSensorEntry] 		= SAMPLE_STATE_OFF;
 		gchTotalSensorEntry++;	//Increment sensor counter on every successful fetch
 	}
 	
+	//Compile divisors into schedules and reject the Execution Table if its busiest radio clock overloads the collection packets
+	if(fnCompileDivisorSchedules() == RETURN_FALSE)
+	{
+		gchTotalSensorEntry = RESET_COUNTER;
+		return RETURN_FALSE;
+	}
+	
+	//First entry of every sensor is key entry
+	fnResetKeyData();
+	
+	//Smart Sensors sample on their own with control byte, sample clock divisor and average count of their entries
+	if(fnStartSmartSensorSampling() == RETURN_FALSE)
+	{
+		SEND_ERROR_CODE_OVER_RF(SENSOR_SENSOR_ID_UNDEFINED);
+		SEND_DEBUG_ERROR_CODES(SENSOR_SENSOR_ID_UNDEFINED);
+		gchTotalSensorEntry = RESET_COUNTER;
+		return RETURN_FALSE;
+	}
+	
 	//Configure the sample clock scenarios with the new available data
 	fnConfigureSampleClock(ghMasterTaskTable.nSampleClock);
 	SEND_DEBUG_STRING("TT Uploaded Successfully\n");
@@ -225,15 +289,109 @@ inline int8_t fnET_Upload_Task(uint8_t *pchSensorRxBuff)
 	return RETURN_TRUE;
 }
 
+//____fnDownloadWindowNext _________________________________________________________________
+//
+// @brief	Finds next packet of generation which is not acknowledged yet when generation is sent with selective repeat (chWindowPending)
+// @param	chFromPacket	Packet of generation (offset from chFirstPacketIndex) to start the search from
+// @return	Packet of generation which is not acknowledged or chTotalPacketCount if all the packets from chFromPacket are acknowledged
+
+static uint8_t fnDownloadWindowNext(uint8_t chFromPacket)
+{
+	while((chFromPacket < ghSensorCommManager.chTotalPacketCount) && !(ghSensorCommManager.chWindowPending & (1 << chFromPacket)))
+	{
+		chFromPacket++;
+	}
+	
+	return chFromPacket;
+}
+
+//____fnDownloadWindowRewind _________________________________________________________________
+//
+// @brief	On retry of selective repeat the burst starts again from first packet which is not acknowledged.
+//			So packet counter always points to a packet before which all the packets are acknowledged (Stop-and-wait is not affected).
+
+static void fnDownloadWindowRewind(void)
+{
+	if(ghSensorCommManager.chWindowPending)
+	{
+		ghSensorCommManager.chPacketCounter = fnDownloadWindowNext(RESET_COUNTER);
+	}
+	
+	return;
+}
+
+//____fnResponseTimeSample _________________________________________________________________
+//
+// @brief	Updates smoothed response time (SRTT) and its variance (RTTVAR) with the response time of last RF exchange and derives the response wait time.
+//			SRTT = 7/8 SRTT + 1/8 R, RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, Wait = SRTT + 4 RTTVAR (At least RESPONSE_WAIT_MARGIN above SRTT)
+//			SRTT is kept scaled by 8 and RTTVAR by 4 so the filter needs only shifts and adds. First sample sets SRTT = R and RTTVAR = R/2.
+//			Wait time is limited to nCommTimeout of Execution Table.
+// @param	nResponseTime	Time from start of communication timer till reception of reply (ms)
+
+static void fnResponseTimeSample(uint16_t nResponseTime)
+{
+	int32_t lError = RESET_VALUE;
+	uint32_t lWait = RESET_VALUE;
+	
+	if(ghSensorCommManager.lSmoothedRtt == RESET_VALUE)
+	{
+		ghSensorCommManager.lSmoothedRtt	= (uint32_t)nResponseTime << 3;
+		ghSensorCommManager.lRttVariance	= (uint32_t)nResponseTime << 1;
+	}
+	else
+	{
+		lError = (int32_t)nResponseTime - (int32_t)(ghSensorCommManager.lSmoothedRtt >> 3);
+		ghSensorCommManager.lSmoothedRtt += lError;
+		
+		if(lError < 0)
+		{
+			lError = -lError;
+		}
+		ghSensorCommManager.lRttVariance -= ghSensorCommManager.lRttVariance >> 2;
+		ghSensorCommManager.lRttVariance += lError;
+	}
+	
+	lWait = ghSensorCommManager.lRttVariance;
+	if(lWait < RESPONSE_WAIT_MARGIN)
+	{
+		lWait = RESPONSE_WAIT_MARGIN;
+	}
+	lWait += ghSensorCommManager.lSmoothedRtt >> 3;
+	
+	ghSensorCommManager.nResponseWait = (lWait < ghMasterTaskTable.nCommTimeout) ? (uint16_t)lWait : ghMasterTaskTable.nCommTimeout;
+	
+	return;
+}
+
+//____fnResponseWaitBackoff _________________________________________________________________
+//
+// @brief	Reply is not received within response wait time so wait time is doubled for the retry (Limited to nCommTimeout of Execution Table).
+//			Backed off value is kept till next response time sample so one bad period does not inflate the wait time of rest of the download.
+
+static void fnResponseWaitBackoff(void)
+{
+	if(ghSensorCommManager.nResponseWait < (ghMasterTaskTable.nCommTimeout >> 1))
+	{
+		ghSensorCommManager.nResponseWait <<= 1;
+	}
+	else
+	{
+		ghSensorCommManager.nResponseWait = ghMasterTaskTable.nCommTimeout;
+	}
+	
+	return;
+}
+
 //____fnRadioTxRxHandler _________________________________________________________________
 //
 // @brief	Function is designed to handle all the RF communication between SENSOR and RFCM.
 //			Entire communication is divided in several steps as listed below:
 //				1> Turn On the power for Radio chip
 //				2> Initialize the Radio for communication operations
-//				3> Transmit the packet to the Radio chip
+//				3> Transmit the packet to the Radio chip (TX FIFO is loaded by SPIC interrupt, task waits for EVENT_RADIO_SPI_COMPLETE)
 //				4> Wait for chip to complete the transmission
 //				5> Turn On the communication wait timer and wait for the reception till time out ocurs
+//				   (In selective repeat all the packets which are not acknowledged are sent back to back and only last one of burst waits for bitmap ACK)
 //				6> If time out occurs than follow the steps again till retry out condittion
 //				7> Segregate the received data and if necessary then send back the ACK or NACK
 //				8> Turn OFF the radio power
@@ -243,8 +401,11 @@ inline int8_t fnRadioTxRxHandler(void)
 {
 	uint8_t chNextPacket			= RESET_FLAG;							//Used to execute multiple iteration of loop where it requires to execute multiple steps at once
 	uint8_t chRxBytes				= RESET_VALUE;
+	uint16_t nResponseTime			= RESET_VALUE;
 	uint8_t chStatusByte			= RESET_VALUE;
-	uint8_t chSensorRxBuff[MAX_COMM_PACKET_SIZE];								//Resources to hold receive buffer for RF communication
+	uint8_t chWindowNext			= RESET_COUNTER;							//Next packet of selective repeat burst
+	uint8_t *pchSensorRxBuff		= gchSensorRxBuff;							//Receive buffer in use (Control packet of gchSensorCommBuff in Loop back mode)
+	Radio_Handler_Step_Enum_t hEntryStepMode = gchRadioCommStepMode;			//To find out whether step is moved without waiting for any event
 	
 	do
 	{
@@ -282,7 +443,7 @@ inline int8_t fnRadioTxRxHandler(void)
 				else
 				{
 					SELECT_CC1125_RADIO;
-					chStatusByte=fnRadioCC1125Initialization();
+					chStatusByte=fnRadioSessionOpen();
 					
 					if(chStatusByte == SENSOR_NO_ERROR)
 					{
@@ -309,20 +470,56 @@ inline int8_t fnRadioTxRxHandler(void)
 				//Fill up the Send Retry for the same packet which will going to send next
 				if(gchSensorLoopBack==LB_STEP_0)
 				{
-					gchSensorCommBuff[ghSensorCommManager.chPacketCounter][PACKET_ERROR_CONTROL_INDEX]=ghSensorCommManager.hPacketCheck.chPacketCheck;
+					gchSensorCommBuff[ghSensorCommManager.chFirstPacketIndex + ghSensorCommManager.chPacketCounter][PACKET_ERROR_CONTROL_INDEX]=ghSensorCommManager.hPacketCheck.chPacketCheck;
 					SEND_ERROR_CODE_OVER_RF(SENSOR_NO_ERROR);		//Error Sending Successful
+					
+					//Last packet of selective repeat burst asks RFC Console for bitmap ACK
+					if(ghSensorCommManager.chWindowPending)
+					{
+						if(fnDownloadWindowNext(ghSensorCommManager.chPacketCounter + 1) >= ghSensorCommManager.chTotalPacketCount)
+						{
+							gchSensorCommBuff[ghSensorCommManager.chFirstPacketIndex + ghSensorCommManager.chPacketCounter][PACKET_DESCRIPTOR_INDEX] |= PACKET_ACK_REQUEST_BM;
+						}
+						else
+						{
+							gchSensorCommBuff[ghSensorCommManager.chFirstPacketIndex + ghSensorCommManager.chPacketCounter][PACKET_DESCRIPTOR_INDEX] &= ~PACKET_ACK_REQUEST_BM;
+						}
+					}
 				}
 				
-				//Start sending data to Radio Chip
-				fnCC112xSendReceiveHandler(RADIO_TRANSMIT_BYTES,CC112X_TXFIFO,gchSensorCommBuff[ghSensorCommManager.chPacketCounter][CC1125_DATA_PACKET_LENGTH]+1,gchSensorCommBuff[ghSensorCommManager.chPacketCounter]);		//Transmit bytes to TX FIFO of Radio chip
+				//Start sending data to Radio Chip: Bytes are shifted to TX FIFO by SPIC interrupt and CPU is free for higher priority tasks till EVENT_RADIO_SPI_COMPLETE
+				if(fnCC112xTxFifoLoadStart(gchSensorCommBuff[ghSensorCommManager.chFirstPacketIndex + ghSensorCommManager.chPacketCounter],gchSensorCommBuff[ghSensorCommManager.chFirstPacketIndex + ghSensorCommManager.chPacketCounter][CC1125_DATA_PACKET_LENGTH]+1) == RETURN_FALSE)
+				{
+					chNextPacket = SET_FLAG;		//Chip did not respond, no event will arrive and error is handled in next step
+				}
+				
+				gchRadioCommStepMode=RADIO_TX_LOAD_MODE;
+			break;
 			
-				//Check for the status of transmit operation
-				fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_MARCSTATE,1,&chStatusByte);		//Check the Radio chip status
-				if((chStatusByte & CC1125_FIFO_ERR_CHECK_BM) == CC112X_STATE_TXFIFO_ERROR)
+			//Wait for TX FIFO load and check for the status of transmit operation (MARCSTATE is read at the end of load)
+			case RADIO_TX_LOAD_MODE:
+				chStatusByte = (uint8_t)fnCC112xTxFifoLoadStatus();
+				
+				if(chStatusByte == (uint8_t)RADIO_SPI_QUEUE_BUSY)
 				{
-					//If error related to TX FIFO than flush the FIFO
+					break;
+				}
+				else if(chStatusByte == RADIO_SPI_QUEUE_ERROR)
+				{
+					//If error related to TX FIFO than flush the FIFO and send the same packet again till retry out condition
 					fnCC112xSendReceiveHandler(RADIO_COMMAND_STROBE,CC112X_SFTX,1,NULL);
 					SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_TX_FIIO_ERR);
+					
+					if(++ghSensorCommManager.chPacketSendRetryCounter < MAX_RF_COMM_RETRY)
+					{
+						chNextPacket = SET_FLAG;
+						gchRadioCommStepMode = RADIO_TX_MODE;
+					}
+					else
+					{
+						SEND_DEBUG_STRING("Retry Out-TX\n");
+						return RETURN_TRUE;			//Terminate the operation
+					}
 				}
 				else
 				{
@@ -338,15 +535,45 @@ inline int8_t fnRadioTxRxHandler(void)
 			//Time out for transmit operation of Radio chip
 			case TX_TIME_OUT_MODE:
 				
+				//Refill of TX FIFO is still shifted by SPIC interrupt (EVENT_RADIO_SPI_COMPLETE)
+				if(fnSpiRadioQueueStatus() == RADIO_SPI_QUEUE_BUSY)
+				{
+					break;
+				}
+				
+				//Packet longer than TX FIFO: Next part is written when TX FIFO is drained to threshold
+				if(fnCC112xFifoThresholdReached() == RETURN_TRUE)
+				{
+					if(fnCC112xTxFifoRefill() == RETURN_TRUE)
+					{
+						break;
+					}
+				}
+				
 				//Check for the interrupt from CC1125 indicating data transmission complete
 				if(fnCC112xSendDataComplete()==RETURN_TRUE)
 				{
+					//Rest of selective repeat burst is sent back to back without waiting for the reply
+					if(ghSensorCommManager.chWindowPending)
+					{
+						chWindowNext = fnDownloadWindowNext(ghSensorCommManager.chPacketCounter + 1);
+						
+						if(chWindowNext < ghSensorCommManager.chTotalPacketCount)
+						{
+							fnRadioCommunicationTimerDisable();
+							ghSensorCommManager.chPacketCounter = chWindowNext;
+							gchRadioCommStepMode = RADIO_TX_MODE;
+							chNextPacket = SET_FLAG;
+							break;
+						}
+					}
+					
 					gchRadioCommStepMode=RADIO_RX_MODE;
 					fnRadioCommunicationTimerDisable();									//Data send complete before time out so disable the communication timer
 				
 					if (gchSensorLoopBack==LB_STEP_0)
 					{
-						fnStartCommunicationTimer(ghMasterTaskTable.nCommTimeout);			//Start communication timer and wait for data from RFCM
+						fnStartCommunicationTimer(ghSensorCommManager.nResponseWait);		//Start communication timer and wait for data from RFCM
 					}
 					else
 					{
@@ -382,31 +609,47 @@ inline int8_t fnRadioTxRxHandler(void)
 			//Receive data over RF
 			case RADIO_RX_MODE:
 			
+				//Packet of Loop back mode is received straight into control packet so it can be sent back without copy
+				if(gchSensorLoopBack != LB_STEP_0)
+				{
+					pchSensorRxBuff = gchSensorCommBuff[BASE_INDEX];
+				}
+				
+				//Packet longer than RX FIFO: Received part is read out when RX FIFO is filled to threshold
+				if(fnCC112xFifoThresholdReached() == RETURN_TRUE)
+				{
+					fnCC112xRxFifoDrain(pchSensorRxBuff);
+				}
+				
 				//Check for the interrupt from CC1125 indicating new data received
 				if (RETURN_TRUE == fnCC112xReceiveDataAvail())
 				{
 					//As data received successfully disable the communication wait timer
 					fnRadioCommunicationTimerDisable();
+					nResponseTime = fnReadCommunicationTimer();
 				
-					//Get count of total bytes received
-					fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_NUM_RXBYTES,1,&chRxBytes);
-				
-					//Fill the SENSOR receive buffer with the received data
-					fnCC112xSendReceiveHandler(RADIO_RECEIVE_BYTES,CC112X_RXFIFO,chRxBytes,chSensorRxBuff);
+					//Fill the SENSOR receive buffer with the rest of received data
+					chRxBytes = fnCC112xRxFifoRead(pchSensorRxBuff);
 				
 					//Variable length mode is used in CC1125 so the received data will be like:
 					//First received byte will be data length
 					//Data will be appended after second byte
 					//Second last byte will be RSSI value
 					//Last byte will be control flag with the indication of CRC check
+					//Packet which does not fit in receive buffer is dropped and handled like CRC error
+					chStatusByte = (chRxBytes > RESET_VALUE) ? (pchSensorRxBuff[chRxBytes-1] & CC1125_CRC_ERR_CHECK_BM) : RESET_VALUE;
 				
-					if(!(chSensorRxBuff[chRxBytes-1] & CC1125_CRC_ERR_CHECK_BM))				//Check for CRC
+					//CRC errors which keep rising drop cached calibration of CC1125
+					fnRadioCalibrationCrcResult(chStatusByte);
+					
+					if(!chStatusByte)				//Check for CRC
 					{
 						//Increment the retry counter and send the same packet again if supported retry value not reached otherwise terminate the operation
 						if(++ghSensorCommManager.chPacketSendRetryCounter < MAX_RF_COMM_RETRY)
 						{
 							SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_CRC_MISMATCH_ERR);
 							SEND_DEBUG_STRING("Next Retry-CRC\n");
+							fnDownloadWindowRewind();
 							chNextPacket = SET_FLAG;
 							gchRadioCommStepMode = RADIO_TX_MODE;
 						}
@@ -420,7 +663,13 @@ inline int8_t fnRadioTxRxHandler(void)
 					else
 					{
 						//Fill up the current RSSI value it may require in sensor tasking table
-						gchUplinkRSSI= chSensorRxBuff[chRxBytes-2];
+						gchUplinkRSSI= pchSensorRxBuff[chRxBytes-2];
+						
+						//Response time of retried packet is ambiguous (Reply may belong to earlier transmission) so it is not sampled
+						if((gchSensorLoopBack == LB_STEP_0) && (ghSensorCommManager.chPacketSendRetryCounter == RESET_COUNTER))
+						{
+							fnResponseTimeSample(nResponseTime);
+						}
 						ghSensorCommManager.chPacketSendRetryCounter=0;		//Reset Retry Counter on Successful Reception
 					
 						//If SENSOR loop back mode is enabled then skip the remaining execution
@@ -432,7 +681,7 @@ inline int8_t fnRadioTxRxHandler(void)
 						else
 						{
 							//On successful reception of the packet check for the received packet type
-							switch(chSensorRxBuff[1])
+							switch(pchSensorRxBuff[1])
 							{
 								//Acknowledge received for the last downloaded data packet
 								case ACK_RECEIPT_LAST_DATA_PACKET:
@@ -449,6 +698,25 @@ inline int8_t fnRadioTxRxHandler(void)
 										return RETURN_TRUE;						//Terminate the task as execution completed
 									}
 								break;
+								
+								//Bitmap of packets of generation received by RFC Console (Selective repeat)
+								case ACK_BITMAP_DATA_PACKETS:
+								
+									ghSensorCommManager.chWindowPending &= ~pchSensorRxBuff[PACKET_ACK_BITMAP_INDEX];
+									
+									if(ghSensorCommManager.chWindowPending)
+									{
+										SEND_DEBUG_STRING("Bitmap ACK- Sending Missing Packets\n");
+										ghSensorCommManager.chPacketCounter = fnDownloadWindowNext(RESET_COUNTER);
+										gchRadioCommStepMode=RADIO_TX_MODE;		//Send packets which are not acknowledged
+									}
+									else
+									{
+										SEND_DEBUG_STRING("Bitmap ACK- Data Download Complete\n");
+										ghSensorCommManager.chPacketCounter = ghSensorCommManager.chTotalPacketCount;
+										return RETURN_TRUE;						//Terminate the task as execution completed
+									}
+								break;
 							
 								//Mismatch in the last downloaded packet
 								case NACK_OUT_OF_SEQUENCE:
@@ -460,6 +728,7 @@ inline int8_t fnRadioTxRxHandler(void)
 									{
 										SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_NACK_RECEIVED);
 										SEND_DEBUG_STRING("Next Retry-NACK\n");
+										fnDownloadWindowRewind();
 										chNextPacket = SET_FLAG;
 										gchRadioCommStepMode = RADIO_TX_MODE;
 									}
@@ -493,7 +762,7 @@ inline int8_t fnRadioTxRxHandler(void)
 									SEND_DEBUG_STRING("New Execution Table Query Received\n");
 							
 									//Fill up the memory resources assigned for master controller and sensor operations with the received buff
-									if(RETURN_TRUE==fnET_Upload_Task(chSensorRxBuff))	//passing address of SENSOR receive buffer
+									if(RETURN_TRUE==fnET_Upload_Task(pchSensorRxBuff,chRxBytes))	//passing address of SENSOR receive buffer
 									{
 										//Send ACK if uploaded data are fine
 										gchAckReplyType= SET_FLAG;
@@ -551,11 +820,14 @@ inline int8_t fnRadioTxRxHandler(void)
 							return RETURN_TRUE;
 						}
 					
+						fnResponseWaitBackoff();
+						
 						//Increment the retry counter and send the same packet again if supported retry value not reached otherwise terminate the operation
 						if(++ghSensorCommManager.chPacketSendRetryCounter < MAX_RF_COMM_RETRY)
 						{
 							SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_COMMUNICATION_WAIT_TIMEOUT);
 							SEND_DEBUG_STRING("Next Retry-TimeOut\n");
+							fnDownloadWindowRewind();
 							chNextPacket = SET_FLAG;
 							gchRadioCommStepMode = RADIO_TX_MODE;
 						}
@@ -564,19 +836,14 @@ inline int8_t fnRadioTxRxHandler(void)
 							SEND_DEBUG_ERROR_CODES(SENSOR_CC1125_COMMUNICATION_WAIT_TIMEOUT);
 							SEND_DEBUG_STRING("Retry Out-TimeOut\n");
 						
-							if(gchCommWaitTimeDoubleCounter++ < COMM_WAIT_TIME_DOUBLE_RETRY)
+							if(gchCommRetryRoundCounter++ < COMM_RETRY_ROUNDS)
 							{
-								SEND_DEBUG_STRING("Increasing Comm Wait Time\n");
-								ghMasterTaskTable.nCommTimeout *= 2;
+								SEND_DEBUG_STRING("Next Retry Round\n");
+								fnDownloadWindowRewind();
 								chNextPacket = SET_FLAG;
 								gchRadioCommStepMode = RADIO_TX_MODE;
 								ghSensorCommManager.chPacketSendRetryCounter=RESET_COUNTER;
 								SEND_ERROR_CODE_OVER_RF(SENSOR_COMM_WAIT_TIME_MISMATCH);
-							
-								if(ghMasterTaskTable.nCommTimeout>MAX_COMM_WAIT_TIME_VALUE)
-								{
-									ghMasterTaskTable.nCommTimeout=MAX_COMM_WAIT_TIME_VALUE;
-								}
 							}
 							else
 							{
@@ -593,7 +860,7 @@ inline int8_t fnRadioTxRxHandler(void)
 				fnRadioCommunicationTimerDisable();
 			
 				// Get response to load IDLE TT
-				if(chSensorRxBuff[1] == STOP_LOOP_BACK_LOAD_IDLE)
+				if(pchSensorRxBuff[1] == STOP_LOOP_BACK_LOAD_IDLE)
 				{
 					gchSensorLoopBack = LB_STEP_2;
 					fnEnableWDT();
@@ -604,7 +871,7 @@ inline int8_t fnRadioTxRxHandler(void)
 				}
 			
 				//If start active tasking table command received
-				else if(chSensorRxBuff[1] == STOP_LOOP_BACK_LOAD_ACTIVE)
+				else if(pchSensorRxBuff[1] == STOP_LOOP_BACK_LOAD_ACTIVE)
 				{
 					gchSensorLoopBack = LB_STEP_2;
 					fnEnableWDT();
@@ -615,9 +882,10 @@ inline int8_t fnRadioTxRxHandler(void)
 			
 				else
 				{
-					fnMemCopy((uint8_t*)gchSensorCommBuff[BASE_INDEX],chSensorRxBuff,chSensorRxBuff[CC1125_DATA_PACKET_LENGTH]+1);	//copy all received data into transmit buffer
-					SEND_DEBUG_DATA_BYTES(&chSensorRxBuff[1],chSensorRxBuff[CC1125_DATA_PACKET_LENGTH]);
+					//Received packet is already in control packet (transmit buffer)
+					SEND_DEBUG_DATA_BYTES(&pchSensorRxBuff[1],pchSensorRxBuff[CC1125_DATA_PACKET_LENGTH]);
 					SEND_DEBUG_STRING("\n");
+					ghSensorCommManager.chFirstPacketIndex = BASE_INDEX;
 					ghSensorCommManager.chPacketCounter = RESET_COUNTER;
 					gchRadioCommStepMode = RADIO_TX_MODE;							//enable transmit mode
 				}
@@ -732,8 +1000,264 @@ inline int8_t fnRadioTxRxHandler(void)
 			break;
 		}
 		
+		//Preemption point: Before executing next step give way to higher priority task (Data Sampling/Collection) which got ready
+		//Step is already saved in gchRadioCommStepMode so calling task resumes from it in next pass (Not applicable in Loop back mode)
+		if((chNextPacket == SET_FLAG) && (gchSensorLoopBack == LB_STEP_0) && (fnHigherPriorityTaskReady(DATA_DOWNLOAD_TASK) == RETURN_TRUE))
+		{
+			WAKE_TASKS(DATA_DOWNLOAD_TASK | EXECUTION_TABLE_REQ_TASK);
+			break;
+		}
+		
 	}while(chNextPacket);		//Check for the next iteration
 	
+	//Step is moved (for example RX to TX on ACK) without starting radio operation so no event will arrive for it, execute the calling task again in next pass
+	if(hEntryStepMode != gchRadioCommStepMode)
+	{
+		WAKE_TASKS(DATA_DOWNLOAD_TASK | EXECUTION_TABLE_REQ_TASK);
+	}
+	
+	return RETURN_FALSE;
+}
+
+//____fnPacketBuilderOpen _________________________________________________________________
+//
+// @brief	Starts assembly of data packet in place in gchSensorCommBuff.
+//			Data message is written straight into the packet (fnPacketBuilderReserve) and header fields are filled once when it is closed,
+//			same buffer is than handed to radio for transmission and retries.
+// @param	phBuilder		Packet builder
+//			chPacketIndex	Packet of gchSensorCommBuff to fill
+//			chPacketSeqNo	Sequence no of packet in its generation
+
+void fnPacketBuilderOpen(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chPacketIndex,uint8_t chPacketSeqNo)
+{
+	phBuilder->pchPacket		= gchSensorCommBuff[chPacketIndex];
+	phBuilder->chPacketSeqNo	= chPacketSeqNo;
+	phBuilder->chDataIndex		= PACKET_DATA_MESSAGE_INDEX;
+	phBuilder->chFreeBits		= RESET_COUNTER;
+	
+	return;
+}
+
+//____fnPacketBuilderReserve _________________________________________________________________
+//
+// @brief	Reserves bytes of data message in packet being assembled, caller writes its data straight into the reserved bytes
+// @param	phBuilder		Packet builder
+//			chLength		No of bytes to reserve
+// @return	Pointer to reserved bytes or NULL if packet does not have enough space (packet needs to be closed and next one opened)
+
+uint8_t *fnPacketBuilderReserve(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chLength)
+{
+	uint8_t *pchData = NULL;
+	
+	if(phBuilder->chDataIndex + chLength > PACKET_LAST_DATA_BYTE_INDEX)
+	{
+		return NULL;
+	}
+	
+	pchData = &phBuilder->pchPacket[phBuilder->chDataIndex];
+	phBuilder->chDataIndex += chLength;
+	phBuilder->chFreeBits = RESET_COUNTER;
+	
+	return pchData;
+}
+
+//____fnPacketBuilderFreeBits _________________________________________________________________
+//
+// @brief	Bits of data message left in packet being assembled, so caller can check that its bit packed entry fits before packing it
+// @param	phBuilder		Packet builder
+// @return	No of bits which can still be packed with fnPacketBuilderPackBits
+
+uint16_t fnPacketBuilderFreeBits(PACKET_BUILDER_STRUCT *phBuilder)
+{
+	return ((uint16_t)(PACKET_LAST_DATA_BYTE_INDEX - phBuilder->chDataIndex) << 3) + phBuilder->chFreeBits;
+}
+
+//____fnPacketBuilderPackBits _________________________________________________________________
+//
+// @brief	Appends least significant bits of value to bit stream of data message (Most significant bit first, crossing byte boundaries).
+//			Caller checks the space with fnPacketBuilderFreeBits, new byte is cleared before its first bit is packed.
+// @param	phBuilder		Packet builder
+//			nValue			Value to pack (bits above chBits are ignored)
+//			chBits			No of bits to pack (1 to 16)
+
+void fnPacketBuilderPackBits(PACKET_BUILDER_STRUCT *phBuilder,uint16_t nValue,uint8_t chBits)
+{
+	uint8_t chChunk = RESET_COUNTER;
+	
+	while(chBits)
+	{
+		if(phBuilder->chFreeBits == RESET_COUNTER)
+		{
+			phBuilder->pchPacket[phBuilder->chDataIndex++] = RESET_VALUE;
+			phBuilder->chFreeBits = 8;
+		}
+		
+		//Bits going in free part of last byte
+		chChunk = (chBits < phBuilder->chFreeBits) ? chBits : phBuilder->chFreeBits;
+		chBits -= chChunk;
+		phBuilder->chFreeBits -= chChunk;
+		phBuilder->pchPacket[phBuilder->chDataIndex - 1] |= ((uint8_t)(nValue >> chBits) & ((1 << chChunk) - 1)) << phBuilder->chFreeBits;
+	}
+	
+	return;
+}
+
+//____fnPacketBuilderClose _________________________________________________________________
+//
+// @brief	Fills the header, descriptor and length fields of assembled packet as per data download channel
+// @param	phBuilder		Packet builder
+//			chLastPacket	SET_FLAG if it is the last packet of generation
+
+void fnPacketBuilderClose(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chLastPacket)
+{
+	uint8_t chLastDataIndex = phBuilder->chDataIndex - 1;		//Length byte of CC1125 counts the bytes after it
+	
+	if (ghMasterTaskTable.chDataDownloadChannel == RADIO_CH_FAST_DOWNLINK_CC2520)
+	{
+		phBuilder->pchPacket[PACKET_HEADER_INDEX]=FAST_DL_DATA_PACKET;	//fast down link
+		ghSensorCommManager.hPacketDescriptor.chTransmitterID=RADIO_CH_FAST_DOWNLINK_CC2520;
+	}
+	else
+	{
+		phBuilder->pchPacket[PACKET_HEADER_INDEX]=SLOW_DL_DATA_PACKET;	//slow down link
+		ghSensorCommManager.hPacketDescriptor.chTransmitterID=RADIO_CH_SLOW_DOWNLINK_CC1125;
+	}
+	
+	if(chLastPacket)
+	{
+		ghSensorCommManager.hPacketDescriptor.chLastPacket = SET_FLAG;	//last packet indication
+	}
+	else
+	{
+		ghSensorCommManager.hPacketDescriptor.chLastPacket = RESET_FLAG;
+	}
+	
+	ghSensorCommManager.hPacketDescriptor.chPacketSeqNo=phBuilder->chPacketSeqNo;
+	phBuilder->pchPacket[PACKET_DESCRIPTOR_INDEX]=ghSensorCommManager.hPacketDescriptor.chPacketDescriptor;
+	phBuilder->pchPacket[PACKET_DATA_LENGTH_INDEX]=chLastDataIndex;
+	phBuilder->pchPacket[CC1125_DATA_PACKET_LENGTH]=chLastDataIndex;
+	phBuilder->pchPacket[PACKET_DOWNLOAD_DATA_SIZE]=chLastDataIndex - PACKET_DATA_MESSAGE_INDEX + 2;	//download data size
+	
+	return;
+}
+
+//____fnDownloadNextGeneration _________________________________________________________________
+//
+// @brief	Frees the slot of generation which is over (delivered, stored in log or dropped) and selects next work of Data Download Task:
+//				1> Next generation of collection queue
+//				2> Catch up of store-and-forward log once queue is empty and uplink is up
+// @param	chDelivered		SET_FLAG if all the packets of generation are acknowledged
+// @return	TRUE if Data Download Task is complete otherwise FALSE
+
+static int8_t fnDownloadNextGeneration(uint8_t chDelivered)
+{
+	//Drain the generations collected while this one was downloaded
+	if(fnReleaseCollectionGeneration(chDelivered) != RESET_COUNTER)
+	{
+		WAKE_TASKS(DATA_DOWNLOAD_TASK);
+		return RETURN_FALSE;	//Task is running with next generation
+	}
+	
+	gchDataDownloadPacketReady= RESET_FLAG;
+	
+	if((ghSensorCommManager.chUplinkDown == RESET_FLAG) && (fnSampleLogPending() == RETURN_TRUE))
+	{
+		SEND_DEBUG_STRING("Log Catch Up Entry\n");
+		ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_CATCH_UP;
+		WAKE_TASKS(DATA_DOWNLOAD_TASK);
+		return RETURN_FALSE;	//Task is running with backlog of log
+	}
+	
+	SEND_DEBUG_STRING("Data Download Task Exit\n");
+	return RETURN_TRUE;			//Task is complete
+}
+
+//____fnDownloadLogCatchUp _________________________________________________________________
+//
+// @brief	Replays the records of store-and-forward log (oldest first) back to back once uplink is back.
+//			Replayed packet is sent from control packet (BASE_INDEX) with LOGGED_DL_DATA_PACKET header and record is released only when it is acknowledged.
+//			Fresh generation of collection queue is sent first, catch up is started again after queue is empty.
+// @return	TRUE if Data Download Task is complete otherwise FALSE
+
+static int8_t fnDownloadLogCatchUp(void)
+{
+	uint8_t *pchPacket = gchSensorCommBuff[BASE_INDEX];
+	
+	if(gchRadioCommStepMode == COMM_ENTRY_POINT)
+	{
+		if(fnSampleLogReady() == RETURN_FALSE)
+		{
+			return RETURN_FALSE;		//Log scan is running, E2PROM transaction wakes the task
+		}
+		
+		if(gchDataDownloadPacketReady && (fnSampleLogBusy() == RETURN_FALSE))		//Job of log holds E2PROM, catch up yields after its E2PROM transaction
+		{
+			ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_LIVE;
+			WAKE_TASKS(DATA_DOWNLOAD_TASK);
+			return RETURN_FALSE;		//Task is running with fresh generation
+		}
+		
+		//Catch up is over when backlog is empty or uplink is down again (Tail of log is saved so records are not replayed again after reset)
+		if((ghSensorCommManager.chUplinkDown == SET_FLAG) || (fnSampleLogPending() == RETURN_FALSE))
+		{
+			if(fnSampleLogSaveAnchor() == RETURN_FALSE)
+			{
+				return RETURN_FALSE;
+			}
+			
+			ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_LIVE;
+			SEND_DEBUG_STRING("Log Catch Up Exit\n");
+			return RETURN_TRUE;			//Task is complete
+		}
+		
+		if(fnSampleLogFetch(pchPacket) == RETURN_FALSE)
+		{
+			return RETURN_FALSE;
+		}
+		
+		//Record with checksum mismatch is skipped
+		if(pchPacket[CC1125_DATA_PACKET_LENGTH] == RESET_VALUE)
+		{
+			WAKE_TASKS(DATA_DOWNLOAD_TASK);
+			return RETURN_FALSE;
+		}
+		
+		pchPacket[PACKET_HEADER_INDEX] = LOGGED_DL_DATA_PACKET;
+		pchPacket[PACKET_DESCRIPTOR_INDEX] &= ~PACKET_ACK_REQUEST_BM;		//Record is replayed with stop-and-wait
+		
+		ghSensorCommManager.chFirstPacketIndex			= BASE_INDEX;
+		ghSensorCommManager.chTotalPacketCount			= SET_COUNTER;
+		ghSensorCommManager.chPacketCounter				= RESET_COUNTER;
+		ghSensorCommManager.chPacketSendRetryCounter	= RESET_COUNTER;
+		ghSensorCommManager.chWindowPending				= RESET_VALUE;
+		gchRadioCommStepMode = RADIO_PWR_CHECK_MODE;
+	}
+	
+	if(fnRadioTxRxHandler()==RETURN_TRUE)
+	{
+		gchRadioCommStepMode = COMM_ENTRY_POINT;
+		fnRadioSessionClose();
+		fnPowerSourceManager(POWER_SOURCE_DISABLE,CC1125_POWER_IDENTITY);
+		
+		if(ghSensorCommManager.chPacketCounter >= ghSensorCommManager.chTotalPacketCount)
+		{
+			fnSampleLogRelease();
+		}
+		else if(ghSensorCommManager.chPacketSendRetryCounter >= MAX_RF_COMM_RETRY)
+		{
+			ghSensorCommManager.chUplinkDown = SET_FLAG;
+			ghSensorCommManager.chProbeCountdown = SAMPLE_LOG_PROBE_INTERVAL;
+		}
+		else
+		{
+			//RFC Console refused the packet: Catch up is started again after next generation
+			ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_LIVE;
+			return RETURN_TRUE;
+		}
+		
+		WAKE_TASKS(DATA_DOWNLOAD_TASK);
+	}
+	
 	return RETURN_FALSE;
 }
 
@@ -742,29 +1266,94 @@ inline int8_t fnRadioTxRxHandler(void)
 // @brief	Function will get call from the task manager itself when it wants to send data packets over RF on the basis of various Radio Clocks.
 //			Most of the contents of the packet which needs to send will get created in the data collection task.
 //			The only operation this task has to perform is to send those packets reliably over RF with the help of CC1125.
+//			If generation retries out uplink is considered down: Packets which are not acknowledged are appended to store-and-forward log in E2PROM
+//			and next generations go straight to log except every SAMPLE_LOG_PROBE_INTERVAL-th one which is sent to probe the uplink.
+//			Once a packet is acknowledged again backlog of log is replayed (fnDownloadLogCatchUp).
 // @return	TRUE if all the steps required to perform Data Download operations in fnRadioTxRxHandler completed successfully
 
 int8_t fnData_Download_Task(void)
 {
-	//Flag used to make data collection and data download task sequential
-	//It will get set from data collection task to notify that the packet is ready for the downloading
+	uint8_t chPacketCount = RESET_COUNTER;
+	uint8_t chDelivered = RESET_FLAG;
+	
+	if(ghSensorCommManager.chDownloadMode == DOWNLOAD_MODE_CATCH_UP)
+	{
+		return fnDownloadLogCatchUp();
+	}
+	
+	//Flag will get set from data collection task to notify that collection queue holds packets ready for the downloading
+	//Generations are downloaded oldest first and task keeps running till queue is empty
 	if(gchDataDownloadPacketReady)
 	{
+		//Packets which are not acknowledged are appended to log, one E2PROM transaction per pass so sampling is not stalled by E2PROM
+		if(ghSensorCommManager.chDownloadMode == DOWNLOAD_MODE_STORE)
+		{
+			if(fnSampleLogAppend(ghSensorCommManager.chFirstPacketIndex + ghSensorCommManager.chPacketCounter,ghSensorCommManager.chTotalPacketCount - ghSensorCommManager.chPacketCounter) == RETURN_FALSE)
+			{
+				return RETURN_FALSE;	//Task is running, E2PROM transaction wakes the task
+			}
+			
+			ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_LIVE;
+			return fnDownloadNextGeneration(RESET_FLAG);
+		}
+		
+		//While uplink is down generation goes straight to log, records coalesced in RAM are written to E2PROM before the probe
+		if((gchRadioCommStepMode == COMM_ENTRY_POINT) && (ghSensorCommManager.chUplinkDown == SET_FLAG))
+		{
+			if(ghSensorCommManager.chProbeCountdown > SET_COUNTER)
+			{
+				ghSensorCommManager.chProbeCountdown--;
+				
+				//Oldest generation of collection queue is appended to log as a whole
+				ghSensorCommManager.chFirstPacketIndex = fnFetchCollectionGeneration(&chPacketCount);
+				ghSensorCommManager.chTotalPacketCount = chPacketCount;
+				ghSensorCommManager.chPacketCounter = RESET_COUNTER;
+				ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_STORE;
+				WAKE_TASKS(DATA_DOWNLOAD_TASK);
+				return RETURN_FALSE;
+			}
+			
+			if(fnSampleLogFlush() == RETURN_FALSE)
+			{
+				return RETURN_FALSE;	//Task is running, E2PROM transaction wakes the task
+			}
+		}
+		
 		//First initial step for the data download operation
 		if(gchRadioCommStepMode == COMM_ENTRY_POINT)
 		{
+			//Calibration record of CC1125 is brought in sync with E2PROM before radio is used (Skipped while E2PROM transaction of log is half done)
+			if(fnRadioCalibrationSync() == RETURN_FALSE)
+			{
+				return RETURN_FALSE;	//Task is running, E2PROM transaction wakes the task
+			}
+			
 			SEND_DEBUG_STRING("Data Download Task Entry\n");
 			gchRadioCommStepMode=RADIO_PWR_CHECK_MODE;
 			
+			//Oldest generation of collection queue
+			ghSensorCommManager.chFirstPacketIndex = fnFetchCollectionGeneration(&chPacketCount);
+			ghSensorCommManager.chTotalPacketCount = chPacketCount;
+			
 			//Reset counter related fields
 			ghSensorCommManager.chPacketCounter			= RESET_COUNTER;
 			ghSensorCommManager.chPacketSendRetryCounter	= RESET_COUNTER;
 			
-			if(gchCommWaitTimeDoubleCounter>=COMM_WAIT_TIME_DOUBLE_RETRY)
+			//Generation with more than one packet is sent with selective repeat if Execution Table selects it
+			ghSensorCommManager.hPacketCheck.chMsgSeqNo++;
+			ghSensorCommManager.chWindowPending			= RESET_VALUE;
+			if((ghMasterTaskTable.chDownloadWindow == DOWNLOAD_WINDOW_ON) && (chPacketCount > SET_COUNTER))
+			{
+				ghSensorCommManager.chWindowPending		= (uint8_t)((1 << chPacketCount) - 1);
+			}
+			
+			gchCommRetryRoundCounter=RESET_COUNTER;
+			
+			//Probe of uplink is sent without further rounds of retries
+			if(ghSensorCommManager.chUplinkDown == SET_FLAG)
 			{
-				gchCommWaitTimeDoubleCounter=RESET_COUNTER;
-				ghMasterTaskTable.nCommTimeout=gnDefaultCommWaitTimeValue;
-				SEND_DEBUG_STRING("Comm Wait Time initialized to default\n");
+				SEND_DEBUG_STRING("Probing Uplink\n");
+				gchCommRetryRoundCounter = COMM_RETRY_ROUNDS;
 			}
 		}
 				
@@ -772,10 +1361,27 @@ int8_t fnData_Download_Task(void)
 		{
 			//Disable the Radio Power and initialize necessary fields for the future operation
 			gchRadioCommStepMode = COMM_ENTRY_POINT;
+			fnRadioSessionClose();
 			fnPowerSourceManager(POWER_SOURCE_DISABLE,CC1125_POWER_IDENTITY);
-			gchDataDownloadPacketReady= RESET_FLAG;
-			SEND_DEBUG_STRING("Data Download Task Exit\n");
-			return RETURN_TRUE;			//Task is complete
+			
+			if(ghSensorCommManager.chPacketCounter >= ghSensorCommManager.chTotalPacketCount)
+			{
+				chDelivered = SET_FLAG;
+				ghSensorCommManager.chUplinkDown = RESET_FLAG;
+			}
+			else if(ghSensorCommManager.chPacketSendRetryCounter >= MAX_RF_COMM_RETRY)
+			{
+				//Log starts from first packet which is not acknowledged (Later packets acknowledged by selective repeat are stored as well)
+				fnDownloadWindowRewind();
+				SEND_DEBUG_STRING("Uplink Down- Storing Packets in Log\n");
+				ghSensorCommManager.chUplinkDown = SET_FLAG;
+				ghSensorCommManager.chProbeCountdown = SAMPLE_LOG_PROBE_INTERVAL;
+				ghSensorCommManager.chDownloadMode = DOWNLOAD_MODE_STORE;
+				WAKE_TASKS(DATA_DOWNLOAD_TASK);
+				return RETURN_FALSE;	//Task is running with append to log
+			}
+			
+			return fnDownloadNextGeneration(chDelivered);
 		}
 	}
 	else
@@ -800,10 +1406,17 @@ int8_t fnData_ET_Request_Task(void)
 	//First initial step for the tasking table request operation
 	if(gchRadioCommStepMode == COMM_ENTRY_POINT)
 	{
+		//Calibration record of CC1125 is loaded from E2PROM after reset so Execution Table request need not calibrate the chip
+		if(fnRadioCalibrationSync() == RETURN_FALSE)
+		{
+			return RETURN_FALSE;		//Task is running, E2PROM transaction wakes the task
+		}
+		
 		SEND_DEBUG_STRING("TT Req Task Entry\n");
 		
 		//Create the packet for TT Request
 		ghSensorCommManager.chTotalPacketCount				= SET_COUNTER;	//Total no of packets
+		ghSensorCommManager.chFirstPacketIndex				= BASE_INDEX;	//Control packet
 		ghSensorCommManager.hPacketDescriptor.chPacketSeqNo	= SET_COUNTER;	//Packet sequence no
 		ghSensorCommManager.hPacketDescriptor.chLastPacket	= SET_FLAG;		//Last packet indicator
 		ghSensorCommManager.hPacketDescriptor.chTransmitterID	= RADIO_CH_SLOW_DOWNLINK_CC1125;	//communication link
@@ -818,19 +1431,15 @@ int8_t fnData_ET_Request_Task(void)
 		//Reset counter related fields
 		ghSensorCommManager.chPacketCounter			= RESET_COUNTER;
 		ghSensorCommManager.chPacketSendRetryCounter	= RESET_COUNTER;
-		
-		if(gchCommWaitTimeDoubleCounter>=COMM_WAIT_TIME_DOUBLE_RETRY)
-		{
-			gchCommWaitTimeDoubleCounter=RESET_COUNTER;
-			ghMasterTaskTable.nCommTimeout=gnDefaultCommWaitTimeValue;
-			SEND_DEBUG_STRING("Comm Wait Time initialized to default\n");
-		}
+		ghSensorCommManager.chWindowPending			= RESET_VALUE;
+		gchCommRetryRoundCounter					= RESET_COUNTER;
 	}
 	
 	if(fnRadioTxRxHandler()==RETURN_TRUE)
 	{
 		//Disable the Radio Power and initialize necessary fields for the future operation
 		gchRadioCommStepMode = COMM_ENTRY_POINT;
+		fnRadioSessionClose();
 		fnPowerSourceManager(POWER_SOURCE_DISABLE,CC1125_POWER_IDENTITY);
 		SEND_DEBUG_STRING("TT Req Task Exit\n");
 		return RETURN_TRUE;				//Task is complete
@@ -68,10 +68,13 @@ Test Results:
 	//________M A C R O S__________________________________________________________________
 
 	#define MAX_SAMPLE_CLOCK_FREQ				125		//Maximum limit of sample clock freq
-	#define MAX_COMM_WAIT_TIME_VALUE			65500
-	#define COMM_WAIT_TIME_DOUBLE_RETRY			3
+	#define COMM_RETRY_ROUNDS					3		//Rounds of MAX_RF_COMM_RETRY retries before operation is terminated
+	#define RESPONSE_WAIT_MARGIN				10		//Minimum response wait time above smoothed response time (ms)
 	#define ID_MASTER_CONTROLLER				0x00	//Master controller ID
 	#define DOWNLINK_BM							0xC0	//Down link channel select bit mask
+	#define PAYLOAD_ENCODING_BM					0x06	//Payload encoding of data packets (Control byte 1)
+	#define PAYLOAD_ENCODING_bp					1
+	#define DOWNLOAD_WINDOW_BM					0x08	//Selective repeat of multi packet generations (Control byte 1)
 	#define MIN_SAMPLE_AVG_COUNT				1		//Minimum samples for the average
 
 	//Indexes for Master Controller related fields in Execution Table
@@ -87,7 +90,9 @@ Test Results:
 	//Indexes for Sensor related fields in Execution Table
 	#define SENSOR_ENTRY_OFFSET					6		//Gap between two sensor TT entry
 	#define SENSORS_START_INDEX					13		//First Sensor entry in the Execution Table
+	#define RX_PACKET_STATUS_BYTES				2		//RSSI and CRC status appended by CC1125 to received packet
 	#define SENSOR_EXECUTION_TABLE_ID_OFFSET		0		//Sensor ID position from the current value of index counter
+	#define SMART_SENSOR_ADDRESS_OFFSET			1		//Smart Sensor address position (Group and sensor value, 0 for sensors sampled by SENSOR MC)
 	#define SENSOR_CONTROL_BYTE_OFFSET			2		//Sensor control byte position
 	#define SAMPLE_CLOCK_DIVISOR_OFFSET			3		//Sensor sample clock divisor byte position
 	#define SAMPLES_IN_AVERAGE_OFFSET			4		//Sensor sample in average position
@@ -106,6 +111,7 @@ Test Results:
 		RADIO_PWR_CHECK_MODE,						//radio power check mode
 		RADIO_LINK_SELECT_MODE,						//radio link select mode
 		RADIO_TX_MODE,								//Radio transmit mode
+		RADIO_TX_LOAD_MODE,							//TX FIFO load by SPIC interrupt
 		TX_TIME_OUT_MODE,							//transmission time out mode
 		RADIO_RX_MODE,								//radio receive mode
 		RADIO_ET_REPLY_MODE,						//send ACK/NACK mode
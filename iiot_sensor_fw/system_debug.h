@@ -61,16 +61,38 @@ Test Results:
 
 	//_____  I N C L U D E S ______________________________________________________________
 
-	#include <avr/io.h>					// Include file with definitions related to AVR-AXMEGAA1U Peripherals
-	#include <avr/interrupt.h>			// Interrupt definitions related to AVR-AXMEGAA1U Peripherals
+	#ifdef HOST_SIMULATION
+		#include "hal_simulation.h"		// Simulated AVR-AXMEGAA1U Peripherals for host build
+	#else
+		#include <avr/io.h>				// Include file with definitions related to AVR-AXMEGAA1U Peripherals
+		#include <avr/interrupt.h>		// Interrupt definitions related to AVR-AXMEGAA1U Peripherals
+	#endif
 	#include <string.h>					// String related generic APIs
 	#include "generic_macro.h"			// Generally used MACROS in entire SENSOR MC design
 
 	//_____ M A C R O S ____________________________________________________________________
 
-	#define		DEBUG_MESSAGE_PRINTS				1		//Controls sending of a lower level char strings on UART
-	#define		DEBUG_ERROR_PRINTS					1		//Controls sending of a middle level char strings on UART
-	#define		DEBUG_DATA_PRINTS					1		//Controls sending of hex bytes on UART
+	#ifndef DEBUG_MESSAGE_PRINTS
+		#define	DEBUG_MESSAGE_PRINTS				1		//Controls sending of a lower level char strings on UART
+	#endif
+	#ifndef DEBUG_ERROR_PRINTS
+		#define	DEBUG_ERROR_PRINTS					1		//Controls sending of a middle level char strings on UART
+	#endif
+	#ifndef DEBUG_DATA_PRINTS
+		#define	DEBUG_DATA_PRINTS					1		//Controls sending of hex bytes on UART
+	#endif
+
+	#ifndef PHASE_ANALYZER_ENABLE
+		#define	PHASE_ANALYZER_ENABLE				0		//Controls sample clock phase budget analyzer (See system_profiler.c)
+	#endif
+
+	#ifndef TASK_PROFILER_ENABLE
+		#define	TASK_PROFILER_ENABLE				PHASE_ANALYZER_ENABLE	//Controls per task cycle and latency profiling of task manager (Required by phase analyzer)
+	#endif
+
+	#if PHASE_ANALYZER_ENABLE && !TASK_PROFILER_ENABLE
+		#error "Phase budget analyzer works on top of task profiler: Set TASK_PROFILER_ENABLE"
+	#endif
 
 	//_____ E N U M E R A T I O N S ____________________________________________________________________
 	
@@ -101,7 +123,13 @@ Test Results:
 		SENSOR_CC1125_TXRX_UNDEFINED_STATE,
 		SENSOR_SAMPLE_AVERAGE_COUNT_EXCEEDS,
 		SENSOR_INVALID_EXECUTION_DEVELOPER_ERROR,
-		SENSOR_CC1125_CALIBRATION_FAIL
+		SENSOR_CC1125_CALIBRATION_FAIL,
+		SENSOR_EXECUTION_TABLE_OVERLOAD,			// Data of sensors due at single radio clock does not fit in communication packets
+		SENSOR_COLLECTION_QUEUE_DROP,				// Oldest generation of collection queue dropped before download
+		SENSOR_E2PROM_LOG_FULL,						// Store-and-forward log in E2PROM is full, packets which are not delivered are dropped
+		SENSOR_E2PROM_LOG_FAULT,					// E2PROM transaction of store-and-forward log failed or its records are lost
+		SENSOR_E2PROM_WRITE_CYCLE_TIMEOUT,			// E2PROM did not acknowledge ACK polls within E2PROM_ACK_POLL_LIMIT after page write
+		SENSOR_EXECUTION_TABLE_LENGTH_MISMATCH		// Length field of Execution Table exceeds the bytes received
 	}SENSOR_MC_ERROR_CODES;
 
 	//_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
@@ -109,9 +137,6 @@ Test Results:
 	//List of error codes available in SENSOR MC firmware
 	extern SENSOR_MC_ERROR_CODES	ghSensorErrCodes;
 	
-	//Flag will get set in all the ISRs
-	extern volatile uint8_t		gchNewInterrupt;
-
 	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
 
 	//_____ fnSendDebugMessageStringUART ____________________________________________________________________
@@ -7,6 +7,24 @@ Date Created: 11/13/2014
 
 (NOTE: latest version is the top version)
 
+Author: Aalok Shah
+Changes: Build time check of SRAM budget (buffers sized by build time options against 8 KB SRAM of ATxmega128A1U)
+
+Author: Aalok Shah
+Changes: Build time check of PACKET_LAST_DATA_BYTE_INDEX against MAX_COMM_PACKET_SIZE and variable length limit of CC1125
+
+Author: Aalok Shah
+Changes: gnDefaultCommWaitTimeValue is removed (nCommTimeout is not modified anymore, response wait time is in ghSensorCommManager)
+
+Author: Aalok Shah
+Changes: Bitmap ACK of RFC Console (ACK_BITMAP_DATA_PACKETS) and ACK request bit of packet descriptor for selective repeat of data packets
+
+Author: Aalok Shah
+Changes: Store-and-forward log of data packets (sample_log.h) and LOGGED_DL_DATA_PACKET header of replayed packets
+
+Author: Aalok Shah
+Changes: ghSensorControl is replaced by ghSensorConfig, ghSensorSample and ghSensorRuntime (none of them is accessed from interrupt)
+
 Author: Aalok Shah
 Changes: Initial version
 
@@ -62,8 +80,10 @@ Test Results:
 	//_____  I N C L U D E S ______________________________________________________________
 
 	#include "mc_system.h"				//Basic functionality for ATXMEGA MCU system
-	#include "task_manager.h"			//Definitions of all the upper level functions
 	#include "data_structure.h"			//All structure definitions used across SENSOR MC design
+	#include "task_manager.h"			//Definitions of all the upper level functions
+	#include "system_profiler.h"		//Task manager profiling hooks
+	#include "sample_log.h"				//Store-and-forward log of data packets in E2PROM
 
 	//_____ M A C R O S ____________________________________________________________________
 
@@ -87,6 +107,7 @@ Test Results:
 	#define SLOW_LOOP_BACK_PACKET_FROM_SENSOR		0x88
 	#define RFCM_LOOP_BACK_PACKET				0X89
 	#define RFCM_STATUS_PACKET					0X8A
+	#define LOGGED_DL_DATA_PACKET				0X8B		//Data packet replayed from store-and-forward log (sample_log.c)
 
 	//Packet Header IDs: Rig Floor Console
 	#define SENSOR_HARD_RESET_COMMAND_1			0x01
@@ -100,6 +121,7 @@ Test Results:
 	#define NACK_INVALID_MSG_FORMAT				0x09
 	#define NACK_OUT_OF_SEQUENCE				0x0A
 	#define NACK_STOP_SENDING_DATA_MESSAGE		0x0B
+	#define ACK_BITMAP_DATA_PACKETS				0x0C		//Packets of generation received by RFC Console (PACKET_ACK_BITMAP_INDEX)
 	#define SENSOR_LOOP_BACK_PACKET_SLOW			0x7D
 	#define SENSOR_LOOP_BACK_PACKET_FAST			0x7E
 	#define STOP_LOOP_BACK_LOAD_ACTIVE			0x77		//???? ID needs to change
@@ -125,8 +147,32 @@ Test Results:
 	#define PACKET_ERROR_CONTROL_INDEX			4
 	#define PACKET_DOWNLOAD_DATA_SIZE			5
 	#define PACKET_DATA_MESSAGE_INDEX			6
+	#define PACKET_ACK_BITMAP_INDEX				5			//Bitmap of received packets in ACK_BITMAP_DATA_PACKETS
+	#define PACKET_ACK_REQUEST_BM				0x02		//Descriptor: Last packet of burst, RFC Console replies with bitmap ACK
 	#define PACKET_FIRST_SENSOR_ET_INDEX		12
-	#define PACKET_LAST_DATA_BYTE_INDEX			128			//Maximum no of data can be stored in one packet
+	#ifndef PACKET_LAST_DATA_BYTE_INDEX
+		#define PACKET_LAST_DATA_BYTE_INDEX		128			//Maximum no of data can be stored in one packet (Lower value at build time gives multi packet generations)
+	#endif
+	
+	//Received packet is length byte, data, RSSI and CRC status: Byte counts of packet are 8 bit and receive buffer is a row of gchSensorCommBuff
+	#if (PACKET_LAST_DATA_BYTE_INDEX + 3) > MAX_COMM_PACKET_SIZE
+		#error "PACKET_LAST_DATA_BYTE_INDEX does not fit in MAX_COMM_PACKET_SIZE"
+	#endif
+	#if MAX_COMM_PACKET_SIZE > 255
+		#error "MAX_COMM_PACKET_SIZE is limited to 255 bytes (Variable length mode of CC1125)"
+	#endif
+	
+	//SRAM budget of ATxmega128A1U: Packet buffers (gchSensorCommBuff and gchSensorRxBuff), sensor entries and key data are sized at build time,
+	//rest of the globals (sensor driver registry, divisor schedules, log, peripheral drivers) and stack are reserved as estimate
+	#define SRAM_TOTAL_BYTES					8192
+	#define SRAM_STACK_RESERVE_BYTES			1024
+	#define SRAM_OTHER_GLOBALS_BYTES			1536
+	#define SENSOR_ENTRY_SRAM_BYTES				(8 + (4 + (2 * MAX_SENSOR_DATA_LENGTH)) + 4 + 1)		//ghSensorConfig, ghSensorSample, ghSensorRuntime and due list of one sensor entry
+	#define KEY_ENTRY_SRAM_BYTES				((2 * MAX_SENSOR_DATA_LENGTH) + 2)							//Key data of one delta encoded sensor entry
+	#define SRAM_BUDGET_BYTES					(((COMM_PACKET_POOL_SIZE + 1) * MAX_COMM_PACKET_SIZE) + (MAX_SENSOR_COUNT * SENSOR_ENTRY_SRAM_BYTES) + (MAX_KEY_SENSOR_COUNT * KEY_ENTRY_SRAM_BYTES) + SRAM_OTHER_GLOBALS_BYTES + SRAM_STACK_RESERVE_BYTES)
+	#if SRAM_BUDGET_BYTES > SRAM_TOTAL_BYTES
+		#error "Buffers sized by build time options exceed SRAM of ATxmega128A1U (MAX_COMM_PACKET_COUNT, MAX_COMM_PACKET_SIZE, MAX_SENSOR_COUNT, MAX_KEY_SENSOR_COUNT)"
+	#endif
 
 	//5V Power Control
 	#define  POWER_SOURCE_ENABLE				0
@@ -152,10 +198,13 @@ Test Results:
 	//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
 
 	//Memory resources to generate the packet for RF communication
-	extern uint8_t gchSensorCommBuff[MAX_COMM_PACKET_COUNT][MAX_COMM_PACKET_SIZE];
+	extern uint8_t gchSensorCommBuff[COMM_PACKET_POOL_SIZE][MAX_COMM_PACKET_SIZE];
 	
 	//Memory resources required to manage the all sensor related data collection operations
-	extern volatile SMART_SENSORS_STRUCT ghSensorControl[MAX_SENSOR_COUNT];
+	//Only task level code accesses them so they are not volatile
+	extern SENSOR_CONFIG_STRUCT ghSensorConfig[MAX_SENSOR_COUNT];
+	extern SENSOR_SAMPLE_STRUCT ghSensorSample[MAX_SENSOR_COUNT];
+	extern SENSOR_RUNTIME_STRUCT ghSensorRuntime;
 	
 	//Memory resources required to manage the successful SENSOR to RFC communication
 	extern volatile SENSOR_COMM_MANAGER ghSensorCommManager;
@@ -193,7 +242,4 @@ Test Results:
 	//Holds current software defined power source mode
 	extern volatile uint8_t	gchPowerSourceMode;
 	
-	//Holds default value of communication wait time
-	extern volatile uint16_t	gnDefaultCommWaitTimeValue;
-	
 #endif /* SYSTEM_GLOBALS_H_ */
\ No newline at end of file
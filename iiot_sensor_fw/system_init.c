@@ -69,12 +69,10 @@ Test Results:
 
 #include "system_globals.h"						//Contains definitions related to various system level task
 #include "hardware_abstraction_layer.h"			//Contains headers of hardware dependent programming functionality
+#include "radio_communication.h"				//Contains scenarios to manage the RF communication
 
 //_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
 
-//Flag to indicate the occurrence of new interrupt (It is used to avoid missing interrupt while putting controller to sleep mode)
-volatile uint8_t	gchNewInterrupt;
-
 //To indicate the task manager to go in to deep sleep mode (Will get set when receiving "OFF" from Debug Serial Interface)						
 volatile uint8_t	gchControllerOff;
 
@@ -196,6 +194,17 @@ inline void fnSoftwareInit(void)
 	gchControllerOff=RESET_FLAG;
 	gchPowerSourceMode=POWER_SOURCE_ALWAYS_ON;
 	
+	//Event subscriptions of task manager (Every blocked task must subscribe the events on which it waits)
+	fnSchedulerInit();
+	fnSubscribeSystemEvents(DATA_SAMPLING_TASK,EVENT_BM(EVENT_ADC_COMPLETE) | EVENT_BM(EVENT_I2C_COMPLETE) | EVENT_BM(EVENT_VOL_STABLE));
+	fnSubscribeSystemEvents(DATA_DOWNLOAD_TASK | EXECUTION_TABLE_REQ_TASK,EVENT_BM(EVENT_RADIO_GPIO) | EVENT_BM(EVENT_RADIO_FIFO_THRESHOLD) | EVENT_BM(EVENT_COMM_TIMEOUT) | EVENT_BM(EVENT_VOL_STABLE) | EVENT_BM(EVENT_RADIO_SPI_COMPLETE));
+	fnSubscribeSystemEvents(DATA_DOWNLOAD_TASK | EXECUTION_TABLE_REQ_TASK,EVENT_BM(EVENT_I2C_COMPLETE));		//E2PROM transactions of store-and-forward log and calibration record of CC1125
+	fnSubscribeSystemEvents(DEBUG_SERIAL_TASK,EVENT_BM(EVENT_UART_RX_FRAME));
+	
+	#if TASK_PROFILER_ENABLE
+		fnTaskProfilerReset();
+	#endif
+	
 	return;
 }
 
@@ -243,12 +252,16 @@ void fnDefaultExecutionTableInit(void)
 	
 	fnStopSampleClock();
 		
-	//Holds default value of communication wait time in case of no response
-	gnDefaultCommWaitTimeValue=DEFAULT_ET_COMM_WAIT_TIME;				
+	//Response wait time of RF exchange starts from upper bound till response time is measured
 	ghMasterTaskTable.nCommTimeout=DEFAULT_ET_COMM_WAIT_TIME;
+	ghSensorCommManager.lSmoothedRtt=RESET_VALUE;
+	ghSensorCommManager.lRttVariance=RESET_VALUE;
+	ghSensorCommManager.nResponseWait=DEFAULT_ET_COMM_WAIT_TIME;
 	
 	ghMasterTaskTable.nRadioClockDivisor=DEFAULT_ET_RADIO_CLOCK;
 	ghMasterTaskTable.chDataDownloadChannel=RADIO_CH_SLOW_DOWNLINK_CC1125;
+	ghMasterTaskTable.chPayloadEncoding=PAYLOAD_ENCODING_RAW;
+	ghMasterTaskTable.chDownloadWindow=DOWNLOAD_WINDOW_OFF;
 	fnConfigureSampleClock(DEFAULT_ET_SAMPLE_CLOCK);
 	return;
 }
@@ -281,6 +294,7 @@ int8_t fnPowerSourceManager(uint8_t chOperation,uint8_t chSourceIdentity)
 			ACTIVATE_RADIO_RESET;
 			fnWait_uSecond(10);
 			DISABLE_5VOLT_POWER;
+			fnRadioSessionInvalidate();									//CC1125 has to be configured again
 			ghPowerManager.chPowerLevelIndicator=POWER_STATE_OFF;
 			ghPowerManager.chPowerUsageCounter=RESET_COUNTER;							//For Safety
 			SEND_DEBUG_STRING("5V Source Disable\n");
@@ -0,0 +1,857 @@
+/* -------------------------------------------------------------------------
+Filename: system_profiler.c
+
+Job#: 20473
+Date Created: 10/16/2026
+
+Purpose: Per task cycle and latency profiler for the task manager (Enabled with TASK_PROFILER_ENABLE in system_debug.h)
+		 For every task bit it records invocation count, cycles per call (min/avg/max/p99), no of blocked passes (returned FALSE)
+		 and latency from the RTC phase which activated the task till its completion.
+		 Distributions are kept in log2 histograms of 16 buckets so whole profile of 6 tasks fits in less than 700 bytes of SRAM.
+		 Cycles are read from 32 bit cycle counter of mc_timer.c (fnReadCycleCounter).
+
+		 Phase budget analyzer (PHASE_ANALYZER_ENABLE) works on top of the profiler. It stamps entry of every RTC phase and tracks two windows of work
+		 which must complete before their phase fires again: sampling (Phase-0 till sampling task is done) and radio (Phase-6 till download task is done).
+		 When SENSOR_SENSOR_SAMPLING_OVERRUN or SENSOR_RADIO_DIVISOR_OVERRUN is raised the timings of the window which overran are captured,
+		 and the worst case windows are used to estimate maximum sample clock which current execution table can sustain.
+
+Functions:
+fnTaskProfilerReset					Clears statistics of all the tasks
+fnTaskProfilerIndex					Converts task bit mask into profile index
+fnTaskProfilerBucket				Histogram bucket of cycle value
+fnTaskProfilerRecord				Adds cycle value to histogram
+fnTaskProfilerPercentile			Estimates percentile from histogram
+fnTaskProfilerActivate				Stamps activation time of task (called from RTC ISR)
+fnTaskProfilerExecute				Calls task function and records its cost
+fnTaskProfilerAppendNumber			Converts unsigned value into decimal string
+fnTaskProfilerAppendStats			Appends min/avg/max/p99 of a distribution
+fnTaskProfilerFormat				Generates line of profiling report
+fnTaskProfilerDump					Sends profiling report on debug UART
+fnPhaseAnalyzerStartWindow			Starts window of work on activation of its task
+fnPhaseAnalyzerActivate				Records phase of task activation
+fnPhaseAnalyzerComplete				Records phases spilled by task and closes its window
+fnPhaseAnalyzerPhaseEntry			Stamps entry of RTC phase (called from RTC ISR)
+fnPhaseAnalyzerOverrun				Captures root cause timings of overrun
+fnPhaseAnalyzerMaxSampleClock		Estimates maximum sustainable sample clock
+fnPhaseAnalyzerFormat				Generates line of phase budget report
+
+Interrupts:
+-NA-
+
+
+Author: Aalok Shah
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+--------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+
+//_____  I N C L U D E S ______________________________________________________________
+
+#include "system_globals.h"						//Contains definitions related to various system level task
+#include "hardware_abstraction_layer.h"			//Contains headers of hardware dependent programming functionality
+
+#if TASK_PROFILER_ENABLE
+
+//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+//Profiling statistics of every task bit
+volatile TASK_PROFILE_STRUCT ghTaskProfile[TOTAL_PROFILED_TASKS];
+
+//Bytes of sample data copied between memory buffers (PACKET_COPY_PROFILE)
+uint32_t glPacketBytesCopied;
+
+#if PHASE_ANALYZER_ENABLE
+	//Phase budget of task manager
+	volatile PHASE_ANALYZER_STRUCT ghPhaseAnalyzer;
+	
+	static void fnPhaseAnalyzerActivate(uint8_t chIndex);
+	static void fnPhaseAnalyzerComplete(uint8_t chIndex);
+#endif
+
+//_____ fnTaskProfilerReset ____________________________________________________________________
+//
+// @brief	Clears statistics of all the tasks (and phase budget analyzer)
+
+void fnTaskProfilerReset(void)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	
+	fnMemSetToValue((volatile uint8_t*)ghTaskProfile,RESET_VALUE,sizeof(ghTaskProfile));
+	
+	for(chIndex = RESET_COUNTER; chIndex < TOTAL_PROFILED_TASKS; chIndex++)
+	{
+		ghTaskProfile[chIndex].lMinCycles = UINT32_MAX;
+		ghTaskProfile[chIndex].lMinLatency = UINT32_MAX;
+	}
+	
+	glPacketBytesCopied = RESET_VALUE;
+	
+	#if PHASE_ANALYZER_ENABLE
+		fnMemSetToValue((volatile uint8_t*)&ghPhaseAnalyzer,RESET_VALUE,sizeof(ghPhaseAnalyzer));
+		
+		for(chIndex = RESET_COUNTER; chIndex < PHASE_ANALYZER_WINDOWS; chIndex++)
+		{
+			ghPhaseAnalyzer.hWindow[chIndex].lMinPeriodPhases = UINT32_MAX;
+		}
+	#endif
+	
+	return;
+}
+
+//_____ fnTaskProfilerIndex ____________________________________________________________________
+//
+// @brief	Converts task bit mask into index of ghTaskProfile
+// @param	chTaskBit	Bit mask of task
+// @return	Index of task or TOTAL_PROFILED_TASKS if task is not profiled
+
+static uint8_t fnTaskProfilerIndex(uint8_t chTaskBit)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	
+	while((chIndex < TOTAL_PROFILED_TASKS) && (chTaskBit != (1 << chIndex)))
+	{
+		chIndex++;
+	}
+	
+	return chIndex;
+}
+
+//_____ fnTaskProfilerBucket ____________________________________________________________________
+//
+// @brief	Finds histogram bucket for cycle value. Bucket 0 holds values below 2^TASK_PROFILER_HIST_SHIFT and bucket N holds values from 2^(SHIFT+N-1) to 2^(SHIFT+N)-1.
+// @param	lCycles		Cycle value
+// @return	Bucket index
+
+static uint8_t fnTaskProfilerBucket(uint32_t lCycles)
+{
+	uint8_t chBucket = RESET_COUNTER;
+	
+	lCycles >>= TASK_PROFILER_HIST_SHIFT;
+	while(lCycles && (chBucket < (TASK_PROFILER_HIST_BUCKETS - 1)))
+	{
+		lCycles >>= 1;
+		chBucket++;
+	}
+	
+	return chBucket;
+}
+
+//_____ fnTaskProfilerRecord ____________________________________________________________________
+//
+// @brief	Adds cycle value in histogram.
+//			When bucket is about to overflow all the buckets are divided by 2, so distribution (and percentile) remains valid for long runs.
+// @param	pnHistogram		Histogram of TASK_PROFILER_HIST_BUCKETS entries
+//			lCycles			Cycle value
+
+static void fnTaskProfilerRecord(volatile uint16_t *pnHistogram,uint32_t lCycles)
+{
+	uint8_t chBucket = fnTaskProfilerBucket(lCycles);
+	uint8_t chIndex = RESET_COUNTER;
+	
+	if(pnHistogram[chBucket] == TASK_PROFILER_HIST_COUNT_MAX)
+	{
+		for(chIndex = RESET_COUNTER; chIndex < TASK_PROFILER_HIST_BUCKETS; chIndex++)
+		{
+			pnHistogram[chIndex] >>= 1;
+		}
+	}
+	pnHistogram[chBucket]++;
+	
+	return;
+}
+
+//_____ fnTaskProfilerPercentile ____________________________________________________________________
+//
+// @brief	Estimates percentile from histogram. Upper bound of the bucket in which percentile falls is returned (limited to maximum observed value).
+// @param	pnHistogram		Histogram of TASK_PROFILER_HIST_BUCKETS entries
+//			lMax			Maximum value recorded in histogram
+// @return	TASK_PROFILER_PERCENTILE percentile in cycles
+
+static uint32_t fnTaskProfilerPercentile(volatile uint16_t *pnHistogram,uint32_t lMax)
+{
+	uint32_t lTotal = RESET_COUNTER;
+	uint32_t lCount = RESET_COUNTER;
+	uint32_t lBound = RESET_VALUE;
+	uint8_t chBucket = RESET_COUNTER;
+	
+	for(chBucket = RESET_COUNTER; chBucket < TASK_PROFILER_HIST_BUCKETS; chBucket++)
+	{
+		lTotal += pnHistogram[chBucket];
+	}
+	
+	//Rank of percentile sample (Rounded up)
+	lTotal = ((lTotal * TASK_PROFILER_PERCENTILE) + 99) / 100;
+	
+	for(chBucket = RESET_COUNTER; chBucket < (TASK_PROFILER_HIST_BUCKETS - 1); chBucket++)
+	{
+		lCount += pnHistogram[chBucket];
+		if(lCount >= lTotal)
+		{
+			break;
+		}
+	}
+	
+	lBound = ((uint32_t)1 << (TASK_PROFILER_HIST_SHIFT + chBucket)) - 1;
+	if((chBucket == (TASK_PROFILER_HIST_BUCKETS - 1)) || (lBound > lMax))
+	{
+		lBound = lMax;
+	}
+	
+	return lBound;
+}
+
+//_____ fnTaskProfilerActivate ____________________________________________________________________
+//
+// @brief	Called from fnSystem_Timing_Task just before task bit gets set in gchTasks_Active.
+//			Activation time is stamped only when task is not already active so latency is measured from the RTC phase which started current run.
+// @param	chTaskBit	Bit mask of task (DATA_SAMPLING_TASK, DATA_COLLECTION_TASK, ...)
+
+void fnTaskProfilerActivate(uint8_t chTaskBit)
+{
+	uint8_t chIndex = fnTaskProfilerIndex(chTaskBit);
+	
+	if((chIndex < TOTAL_PROFILED_TASKS) && !(gchTasks_Active & chTaskBit))
+	{
+		ghTaskProfile[chIndex].lActivationStamp = fnReadCycleCounter();
+		ghTaskProfile[chIndex].chActivationPending = SET_FLAG;
+		
+		#if PHASE_ANALYZER_ENABLE
+			fnPhaseAnalyzerActivate(chIndex);
+		#endif
+	}
+	
+	return;
+}
+
+//_____ fnTaskProfilerExecute ____________________________________________________________________
+//
+// @brief	Calls task function and records its cycles and return value.
+//			When task returns TRUE the latency from its activation is recorded as well.
+//			Note: Cycles of the interrupt routines executed during the call are included in the task cycles.
+// @param	chTaskBit	Bit mask of task
+//			pfnTask		Task function called by task manager
+// @return	Value returned by task function
+
+int8_t fnTaskProfilerExecute(uint8_t chTaskBit,int8_t (*pfnTask)(void))
+{
+	volatile TASK_PROFILE_STRUCT *pTask = NULL;
+	uint8_t chIndex = fnTaskProfilerIndex(chTaskBit);
+	uint32_t lStart = RESET_VALUE;
+	uint32_t lCycles = RESET_VALUE;
+	int8_t chResult = RETURN_FALSE;
+	
+	if(chIndex >= TOTAL_PROFILED_TASKS)
+	{
+		return pfnTask();
+	}
+	pTask = &ghTaskProfile[chIndex];
+	
+	lStart = fnReadCycleCounter();
+	chResult = pfnTask();
+	lCycles = fnReadCycleCounter() - lStart;
+	
+	//Cost of the call
+	pTask->lInvocations++;
+	pTask->lTotalCycles += lCycles;
+	if(lCycles < pTask->lMinCycles)
+	{
+		pTask->lMinCycles = lCycles;
+	}
+	if(lCycles > pTask->lMaxCycles)
+	{
+		pTask->lMaxCycles = lCycles;
+	}
+	fnTaskProfilerRecord(pTask->nCycleHistogram,lCycles);
+	
+	if(chResult != RETURN_TRUE)
+	{
+		pTask->lBlockedPasses++;
+		return chResult;
+	}
+	
+	//Task is done: Latency from the RTC phase which activated it (Task bit is still set so RTC ISR can not restamp it here)
+	if(pTask->chActivationPending == SET_FLAG)
+	{
+		pTask->chActivationPending = RESET_FLAG;
+		lCycles = fnReadCycleCounter() - pTask->lActivationStamp;
+		
+		pTask->lCompletions++;
+		pTask->lTotalLatency += lCycles;
+		if(lCycles < pTask->lMinLatency)
+		{
+			pTask->lMinLatency = lCycles;
+		}
+		if(lCycles > pTask->lMaxLatency)
+		{
+			pTask->lMaxLatency = lCycles;
+		}
+		fnTaskProfilerRecord(pTask->nLatencyHistogram,lCycles);
+		
+		#if PHASE_ANALYZER_ENABLE
+			fnPhaseAnalyzerComplete(chIndex);
+		#endif
+	}
+	
+	return chResult;
+}
+
+//_____ fnTaskProfilerAppendNumber ____________________________________________________________________
+//
+// @brief	Converts unsigned value into decimal string
+// @param	pchStr	Location where to store the string
+//			lValue	Value to convert
+// @return	Pointer next to the last stored char
+
+static char* fnTaskProfilerAppendNumber(char *pchStr,uint32_t lValue)
+{
+	char chDigits[10];
+	uint8_t chCount = RESET_COUNTER;
+	
+	do
+	{
+		chDigits[chCount++] = (lValue % 10) + CONVERT_TO_ASCII;
+		lValue /= 10;
+	}while(lValue);
+	
+	while(chCount)
+	{
+		*(pchStr++) = chDigits[--chCount];
+	}
+	
+	return pchStr;
+}
+
+//_____ fnTaskProfilerAppendStats ____________________________________________________________________
+//
+// @brief	Appends min/avg/max/p99 of a distribution
+// @param	pchStr			Location where to store the string
+//			lCount			No of samples
+//			lMin			Minimum value
+//			lTotal			Sum of all the samples
+//			lMax			Maximum value
+//			pnHistogram		Histogram of samples
+// @return	Pointer next to the last stored char
+
+static char* fnTaskProfilerAppendStats(char *pchStr,uint32_t lCount,uint32_t lMin,uint64_t lTotal,uint32_t lMax,volatile uint16_t *pnHistogram)
+{
+	if(lCount == RESET_COUNTER)
+	{
+		*(pchStr++) = '-';
+		return pchStr;
+	}
+	
+	pchStr = fnTaskProfilerAppendNumber(pchStr,lMin);
+	*(pchStr++) = '/';
+	pchStr = fnTaskProfilerAppendNumber(pchStr,(uint32_t)(lTotal / lCount));
+	*(pchStr++) = '/';
+	pchStr = fnTaskProfilerAppendNumber(pchStr,lMax);
+	*(pchStr++) = '/';
+	pchStr = fnTaskProfilerAppendNumber(pchStr,fnTaskProfilerPercentile(pnHistogram,lMax));
+	
+	return pchStr;
+}
+
+//_____ fnTaskProfilerFormat ____________________________________________________________________
+//
+// @brief	Generates one line (NULL terminated, ends with new line char) of profiling report of a task
+// @param	chTaskIndex		Bit position of task (0 to TOTAL_PROFILED_TASKS-1)
+//			chLine			TASK_PROFILER_SUMMARY_LINE, TASK_PROFILER_CYCLE_HIST_LINE or TASK_PROFILER_LATENCY_HIST_LINE
+//			pchStr			Buffer of at least UART_COMM_BUF_SIZE bytes
+// @return	TRUE if line is generated otherwise FALSE (task never executed)
+
+int8_t fnTaskProfilerFormat(uint8_t chTaskIndex,uint8_t chLine,char *pchStr)
+{
+	volatile TASK_PROFILE_STRUCT *pTask = NULL;
+	volatile uint16_t *pnHistogram = NULL;
+	uint8_t chBucket = RESET_COUNTER;
+	
+	if((chTaskIndex >= TOTAL_PROFILED_TASKS) || (ghTaskProfile[chTaskIndex].lInvocations == RESET_COUNTER))
+	{
+		return RETURN_FALSE;
+	}
+	pTask = &ghTaskProfile[chTaskIndex];
+	
+	switch(chLine)
+	{
+		case TASK_PROFILER_SUMMARY_LINE:
+			*(pchStr++) = 'P';
+			*(pchStr++) = chTaskIndex + CONVERT_TO_ASCII;
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'N';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pTask->lInvocations);
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'B';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pTask->lBlockedPasses);
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'C';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendStats(pchStr,pTask->lInvocations,pTask->lMinCycles,pTask->lTotalCycles,pTask->lMaxCycles,pTask->nCycleHistogram);
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'L';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendStats(pchStr,pTask->lCompletions,pTask->lMinLatency,pTask->lTotalLatency,pTask->lMaxLatency,pTask->nLatencyHistogram);
+		break;
+		
+		case TASK_PROFILER_CYCLE_HIST_LINE:
+		case TASK_PROFILER_LATENCY_HIST_LINE:
+			pnHistogram = (chLine == TASK_PROFILER_CYCLE_HIST_LINE) ? pTask->nCycleHistogram : pTask->nLatencyHistogram;
+			*(pchStr++) = 'H';
+			*(pchStr++) = chTaskIndex + CONVERT_TO_ASCII;
+			*(pchStr++) = ' ';
+			*(pchStr++) = (chLine == TASK_PROFILER_CYCLE_HIST_LINE) ? 'C' : 'L';
+			*(pchStr++) = ':';
+			for(chBucket = RESET_COUNTER; chBucket < TASK_PROFILER_HIST_BUCKETS; chBucket++)
+			{
+				if(chBucket)
+				{
+					*(pchStr++) = ',';
+				}
+				pchStr = fnTaskProfilerAppendNumber(pchStr,pnHistogram[chBucket]);
+			}
+		break;
+		
+		default:
+			return RETURN_FALSE;
+	}
+	
+	*(pchStr++) = NEWLINE_CHAR;
+	*pchStr = NULL_CHAR;
+	
+	return RETURN_TRUE;
+}
+
+//_____ fnTaskProfilerDump ____________________________________________________________________
+//
+// @brief	Sends profiling report of all the executed tasks on debug UART.
+//			This function is blocking function (about 100ms per line at 9600 baud) so call it only when timing of task manager is not a concern.
+
+void fnTaskProfilerDump(void)
+{
+	char chLineBuff[UART_COMM_BUF_SIZE];
+	uint8_t chIndex = RESET_COUNTER;
+	uint8_t chLine = RESET_COUNTER;
+	
+	SEND_DEBUG_STRING("Task Profile (CPU cycles)\n");
+	for(chIndex = RESET_COUNTER; chIndex < TOTAL_PROFILED_TASKS; chIndex++)
+	{
+		for(chLine = RESET_COUNTER; chLine < TASK_PROFILER_TOTAL_LINES; chLine++)
+		{
+			if(fnTaskProfilerFormat(chIndex,chLine,chLineBuff) == RETURN_TRUE)
+			{
+				SEND_DEBUG_STRING(chLineBuff);
+			}
+		}
+	}
+	
+	#if PHASE_ANALYZER_ENABLE
+		for(chLine = RESET_COUNTER; chLine < PHASE_ANALYZER_TOTAL_LINES; chLine++)
+		{
+			if(fnPhaseAnalyzerFormat(chLine,chLineBuff) == RETURN_TRUE)
+			{
+				SEND_DEBUG_STRING(chLineBuff);
+			}
+		}
+	#endif
+	
+	return;
+}
+
+#if PHASE_ANALYZER_ENABLE
+
+//_____ fnPhaseAnalyzerStartWindow ____________________________________________________________________
+//
+// @brief	Starts window of work. Window which is still open is not restarted because its work is not done yet (It will end up in overrun).
+// @param	chWindow	PHASE_WINDOW_SAMPLING or PHASE_WINDOW_RADIO
+
+static void fnPhaseAnalyzerStartWindow(uint8_t chWindow)
+{
+	volatile PHASE_WINDOW_STRUCT *pWindow = &ghPhaseAnalyzer.hWindow[chWindow];
+	uint32_t lPhases = RESET_VALUE;
+	uint8_t chIndex = RESET_COUNTER;
+	
+	if(pWindow->chOpen == SET_FLAG)
+	{
+		return;
+	}
+	
+	//Distance from previous window gives the time available to the work (in phases)
+	if(pWindow->lStartPhaseCount != RESET_COUNTER)
+	{
+		lPhases = ghPhaseAnalyzer.lPhaseCount - pWindow->lStartPhaseCount;
+		if(lPhases < pWindow->lMinPeriodPhases)
+		{
+			pWindow->lMinPeriodPhases = lPhases;
+		}
+	}
+	
+	pWindow->chOpen = SET_FLAG;
+	pWindow->lStartStamp = fnReadCycleCounter();
+	pWindow->lStartPhaseCount = ghPhaseAnalyzer.lPhaseCount;
+	for(chIndex = RESET_COUNTER; chIndex < TOTAL_PROFILED_TASKS; chIndex++)
+	{
+		pWindow->lStartTaskCycles[chIndex] = (uint32_t)ghTaskProfile[chIndex].lTotalCycles;
+	}
+	
+	return;
+}
+
+//_____ fnPhaseAnalyzerActivate ____________________________________________________________________
+//
+// @brief	Called from fnTaskProfilerActivate (RTC ISR) when task gets activated
+// @param	chIndex		Index of task
+
+static void fnPhaseAnalyzerActivate(uint8_t chIndex)
+{
+	ghPhaseAnalyzer.lActivationPhase[chIndex] = ghPhaseAnalyzer.lPhaseCount;
+	
+	if(chIndex == fnTaskProfilerIndex(DATA_SAMPLING_TASK))
+	{
+		fnPhaseAnalyzerStartWindow(PHASE_WINDOW_SAMPLING);
+	}
+	else if(chIndex == fnTaskProfilerIndex(DATA_COLLECTION_TASK))
+	{
+		fnPhaseAnalyzerStartWindow(PHASE_WINDOW_RADIO);
+	}
+	
+	return;
+}
+
+//_____ fnPhaseAnalyzerComplete ____________________________________________________________________
+//
+// @brief	Called from fnTaskProfilerExecute when task returns TRUE.
+//			Task which completes after the next phase has fired spilled out of its phase. Sampling and download tasks close their windows.
+// @param	chIndex		Index of task
+
+static void fnPhaseAnalyzerComplete(uint8_t chIndex)
+{
+	volatile PHASE_WINDOW_STRUCT *pWindow = NULL;
+	uint32_t lValue = ghPhaseAnalyzer.lPhaseCount - ghPhaseAnalyzer.lActivationPhase[chIndex];
+	
+	if(lValue)
+	{
+		ghPhaseAnalyzer.lPhaseSpills[chIndex]++;
+		if(lValue > ghPhaseAnalyzer.lMaxSpillPhases[chIndex])
+		{
+			ghPhaseAnalyzer.lMaxSpillPhases[chIndex] = lValue;
+		}
+	}
+	
+	if(chIndex == fnTaskProfilerIndex(DATA_SAMPLING_TASK))
+	{
+		pWindow = &ghPhaseAnalyzer.hWindow[PHASE_WINDOW_SAMPLING];
+	}
+	else if(chIndex == fnTaskProfilerIndex(DATA_DOWNLOAD_TASK))
+	{
+		pWindow = &ghPhaseAnalyzer.hWindow[PHASE_WINDOW_RADIO];
+	}
+	
+	if((pWindow != NULL) && (pWindow->chOpen == SET_FLAG))
+	{
+		pWindow->chOpen = RESET_FLAG;
+		lValue = fnReadCycleCounter() - pWindow->lStartStamp;
+		if(lValue > pWindow->lMaxCycles)
+		{
+			pWindow->lMaxCycles = lValue;
+		}
+	}
+	
+	return;
+}
+
+//_____ fnPhaseAnalyzerPhaseEntry ____________________________________________________________________
+//
+// @brief	Called from fnSystem_Timing_Task at entry of every RTC phase to stamp it
+// @param	chPhase		RTC phase which just fired (RTC_PHASE0 to RTC_PHASE7)
+
+void fnPhaseAnalyzerPhaseEntry(uint8_t chPhase)
+{
+	if(chPhase >= PHASE_ANALYZER_PHASES)
+	{
+		return;
+	}
+	
+	ghPhaseAnalyzer.lPhaseCount++;
+	ghPhaseAnalyzer.chCurrentPhase = chPhase;
+	ghPhaseAnalyzer.lPhaseEntryStamp[chPhase] = fnReadCycleCounter();
+	
+	if(chPhase == RESET_VALUE)
+	{
+		ghPhaseAnalyzer.lSampleClocks++;
+	}
+	
+	return;
+}
+
+//_____ fnPhaseAnalyzerOverrun ____________________________________________________________________
+//
+// @brief	Called where SENSOR_SENSOR_SAMPLING_OVERRUN or SENSOR_RADIO_DIVISOR_OVERRUN is raised.
+//			It captures root cause timings: phase in progress, time and phases from start of overrun window and cycles consumed by every task in the window.
+// @param	hErrorCode	Overrun error which is raised
+
+void fnPhaseAnalyzerOverrun(SENSOR_MC_ERROR_CODES hErrorCode)
+{
+	volatile PHASE_WINDOW_STRUCT *pWindow = NULL;
+	uint32_t lNow = fnReadCycleCounter();
+	uint8_t chIndex = RESET_COUNTER;
+	
+	if(hErrorCode == SENSOR_SENSOR_SAMPLING_OVERRUN)
+	{
+		pWindow = &ghPhaseAnalyzer.hWindow[PHASE_WINDOW_SAMPLING];
+	}
+	else if(hErrorCode == SENSOR_RADIO_DIVISOR_OVERRUN)
+	{
+		pWindow = &ghPhaseAnalyzer.hWindow[PHASE_WINDOW_RADIO];
+	}
+	else
+	{
+		return;
+	}
+	
+	pWindow->lOverruns++;
+	pWindow->chOverrunPhase = ghPhaseAnalyzer.chCurrentPhase;
+	pWindow->lOverrunPhaseCycles = lNow - ghPhaseAnalyzer.lPhaseEntryStamp[ghPhaseAnalyzer.chCurrentPhase];
+	pWindow->chOverrunTasksActive = gchTasks_Active;
+	pWindow->lOverrunCycles = lNow - pWindow->lStartStamp;
+	pWindow->lOverrunPhases = ghPhaseAnalyzer.lPhaseCount - pWindow->lStartPhaseCount;
+	for(chIndex = RESET_COUNTER; chIndex < TOTAL_PROFILED_TASKS; chIndex++)
+	{
+		pWindow->lOverrunTaskCycles[chIndex] = (uint32_t)ghTaskProfile[chIndex].lTotalCycles - pWindow->lStartTaskCycles[chIndex];
+	}
+	
+	return;
+}
+
+//_____ fnPhaseAnalyzerMaxSampleClock ____________________________________________________________________
+//
+// @brief	Estimates the maximum sample clock which current execution table can sustain from the worst case timings measured so far:
+//				1> Sampling task must complete within one sample clock
+//				2> Collection and download tasks must complete within the radio clock (less one phase between Phase-6 and Phase-7)
+//				3> Cycles of all the tasks in one sample clock must fit in one sample clock
+//				4> Phase can not be shorter than one RTC tick
+// @return	Sample clock in HZ
+
+uint16_t fnPhaseAnalyzerMaxSampleClock(void)
+{
+	volatile PHASE_WINDOW_STRUCT *pRadio = &ghPhaseAnalyzer.hWindow[PHASE_WINDOW_RADIO];
+	uint64_t lTotalCycles = RESET_VALUE;
+	uint32_t lClock = PHASE_ANALYZER_MAX_SAMPLE_CLOCK;
+	uint32_t lLimit = RESET_VALUE;
+	uint32_t lWork = RESET_VALUE;
+	uint8_t chIndex = RESET_COUNTER;
+	
+	//1> Sampling window
+	lWork = ghPhaseAnalyzer.hWindow[PHASE_WINDOW_SAMPLING].lMaxCycles;
+	if(lWork)
+	{
+		lLimit = TASK_PROFILER_CPU_CLOCK / lWork;
+		if(lLimit < lClock)
+		{
+			lClock = lLimit;
+		}
+	}
+	
+	//2> Radio window: Work + 1 phase <= Radio clock (phases) => Sample clock <= (Radio phases - 1) / (8 * Work)
+	lWork = ghTaskProfile[fnTaskProfilerIndex(DATA_COLLECTION_TASK)].lMaxLatency + ghTaskProfile[fnTaskProfilerIndex(DATA_DOWNLOAD_TASK)].lMaxLatency;
+	if(lWork && (pRadio->lMinPeriodPhases != UINT32_MAX) && (pRadio->lMinPeriodPhases > 1))
+	{
+		lLimit = (uint32_t)(((uint64_t)(pRadio->lMinPeriodPhases - 1) * TASK_PROFILER_CPU_CLOCK) / ((uint64_t)PHASE_ANALYZER_PHASES * lWork));
+		if(lLimit < lClock)
+		{
+			lClock = lLimit;
+		}
+	}
+	
+	//3> CPU load of one sample clock
+	if(ghPhaseAnalyzer.lSampleClocks)
+	{
+		for(chIndex = RESET_COUNTER; chIndex < TOTAL_PROFILED_TASKS; chIndex++)
+		{
+			lTotalCycles += ghTaskProfile[chIndex].lTotalCycles;
+		}
+		
+		lWork = (uint32_t)(lTotalCycles / ghPhaseAnalyzer.lSampleClocks);
+		if(lWork)
+		{
+			lLimit = TASK_PROFILER_CPU_CLOCK / lWork;
+			if(lLimit < lClock)
+			{
+				lClock = lLimit;
+			}
+		}
+	}
+	
+	return (uint16_t)lClock;
+}
+
+//_____ fnPhaseAnalyzerFormat ____________________________________________________________________
+//
+// @brief	Generates one line (NULL terminated, ends with new line char) of phase budget report
+// @param	chLine		PHASE_ANALYZER_SUMMARY_LINE, PHASE_ANALYZER_SPILL_LINE + task index or PHASE_ANALYZER_OVERRUN_LINE + (2 * window) + 0/1
+//			pchStr		Buffer of at least UART_COMM_BUF_SIZE bytes
+// @return	TRUE if line is generated otherwise FALSE (nothing to report)
+
+int8_t fnPhaseAnalyzerFormat(uint8_t chLine,char *pchStr)
+{
+	volatile PHASE_WINDOW_STRUCT *pWindow = NULL;
+	uint8_t chIndex = RESET_COUNTER;
+	uint8_t chErrorCode = RESET_VALUE;
+	
+	if(chLine == PHASE_ANALYZER_SUMMARY_LINE)
+	{
+		if(ghPhaseAnalyzer.lSampleClocks == RESET_COUNTER)
+		{
+			return RETURN_FALSE;
+		}
+		
+		*(pchStr++) = 'A';
+		*(pchStr++) = ' ';
+		*(pchStr++) = 'F';
+		*(pchStr++) = ':';
+		pchStr = fnTaskProfilerAppendNumber(pchStr,fnPhaseAnalyzerMaxSampleClock());
+		*(pchStr++) = ' ';
+		*(pchStr++) = 'S';
+		*(pchStr++) = ':';
+		pchStr = fnTaskProfilerAppendNumber(pchStr,ghPhaseAnalyzer.hWindow[PHASE_WINDOW_SAMPLING].lMaxCycles);
+		*(pchStr++) = ' ';
+		*(pchStr++) = 'R';
+		*(pchStr++) = ':';
+		pchStr = fnTaskProfilerAppendNumber(pchStr,ghTaskProfile[fnTaskProfilerIndex(DATA_COLLECTION_TASK)].lMaxLatency + ghTaskProfile[fnTaskProfilerIndex(DATA_DOWNLOAD_TASK)].lMaxLatency);
+		*(pchStr++) = '/';
+		if(ghPhaseAnalyzer.hWindow[PHASE_WINDOW_RADIO].lMinPeriodPhases == UINT32_MAX)
+		{
+			*(pchStr++) = '-';
+		}
+		else
+		{
+			pchStr = fnTaskProfilerAppendNumber(pchStr,ghPhaseAnalyzer.hWindow[PHASE_WINDOW_RADIO].lMinPeriodPhases);
+		}
+		*(pchStr++) = ' ';
+		*(pchStr++) = 'W';
+		*(pchStr++) = ':';
+		pchStr = fnTaskProfilerAppendNumber(pchStr,ghPhaseAnalyzer.hWindow[PHASE_WINDOW_RADIO].lMaxCycles);
+	}
+	else if(chLine < PHASE_ANALYZER_OVERRUN_LINE)
+	{
+		chIndex = chLine - PHASE_ANALYZER_SPILL_LINE;
+		if(ghTaskProfile[chIndex].lCompletions == RESET_COUNTER)
+		{
+			return RETURN_FALSE;
+		}
+		
+		*(pchStr++) = 'A';
+		*(pchStr++) = chIndex + CONVERT_TO_ASCII;
+		*(pchStr++) = ' ';
+		*(pchStr++) = 'X';
+		*(pchStr++) = ':';
+		pchStr = fnTaskProfilerAppendNumber(pchStr,ghPhaseAnalyzer.lPhaseSpills[chIndex]);
+		*(pchStr++) = ' ';
+		*(pchStr++) = 'M';
+		*(pchStr++) = ':';
+		pchStr = fnTaskProfilerAppendNumber(pchStr,ghPhaseAnalyzer.lMaxSpillPhases[chIndex]);
+	}
+	else if(chLine < PHASE_ANALYZER_TOTAL_LINES)
+	{
+		chIndex = (chLine - PHASE_ANALYZER_OVERRUN_LINE) / 2;
+		pWindow = &ghPhaseAnalyzer.hWindow[chIndex];
+		if(pWindow->lOverruns == RESET_COUNTER)
+		{
+			return RETURN_FALSE;
+		}
+		
+		chErrorCode = (chIndex == PHASE_WINDOW_SAMPLING) ? SENSOR_SENSOR_SAMPLING_OVERRUN : SENSOR_RADIO_DIVISOR_OVERRUN;
+		*(pchStr++) = 'O';
+		*(pchStr++) = (chErrorCode / 10) + CONVERT_TO_ASCII;
+		*(pchStr++) = (chErrorCode % 10) + CONVERT_TO_ASCII;
+		*(pchStr++) = ' ';
+		
+		if(((chLine - PHASE_ANALYZER_OVERRUN_LINE) % 2) == RESET_VALUE)
+		{
+			*(pchStr++) = 'N';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pWindow->lOverruns);
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'P';
+			*(pchStr++) = ':';
+			*(pchStr++) = pWindow->chOverrunPhase + CONVERT_TO_ASCII;
+			*(pchStr++) = '+';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pWindow->lOverrunPhaseCycles);
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'A';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pWindow->chOverrunTasksActive);
+			*(pchStr++) = ' ';
+			*(pchStr++) = 'E';
+			*(pchStr++) = ':';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pWindow->lOverrunCycles);
+			*(pchStr++) = '/';
+			pchStr = fnTaskProfilerAppendNumber(pchStr,pWindow->lOverrunPhases);
+		}
+		else
+		{
+			*(pchStr++) = 'C';
+			*(pchStr++) = ':';
+			for(chIndex = RESET_COUNTER; chIndex < TOTAL_PROFILED_TASKS; chIndex++)
+			{
+				if(chIndex)
+				{
+					*(pchStr++) = ',';
+				}
+				pchStr = fnTaskProfilerAppendNumber(pchStr,pWindow->lOverrunTaskCycles[chIndex]);
+			}
+		}
+	}
+	else
+	{
+		return RETURN_FALSE;
+	}
+	
+	*(pchStr++) = NEWLINE_CHAR;
+	*pchStr = NULL_CHAR;
+	
+	return RETURN_TRUE;
+}
+
+#endif /* PHASE_ANALYZER_ENABLE */
+
+#endif /* TASK_PROFILER_ENABLE */
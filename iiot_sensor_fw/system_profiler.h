@@ -0,0 +1,277 @@
+/* -------------------------------------------------------------------------
+Filename: system_profiler.h
+
+Job#: 20473
+Purpose: Per task cycle and latency profiling of SENSOR MC task manager (super loop in main.c)
+		 and sample clock phase budget analyzer (overruns of RTC phases)
+Date Created: 10/16/2026
+
+(NOTE: latest version is the top version)
+
+Author: Aalok Shah
+Changes: Counter of sample data bytes copied on the way to radio (PACKET_COPY_PROFILE)
+
+Author: Aalok Shah
+Changes: Phase budget analyzer (PHASE_ANALYZER_ENABLE)
+
+Author: Aalok Shah
+Changes: Initial version
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+Note: See document 000xxxx for complete project requirements
+Input: None
+Output: None
+
+-----------------------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+#ifndef SYSTEM_PROFILER_H_
+#define SYSTEM_PROFILER_H_
+
+	//_____  I N C L U D E S ______________________________________________________________
+
+	#include "mc_system.h"				//Basic functionality for ATXMEGA MCU system
+
+	//_____ M A C R O S ____________________________________________________________________
+
+	#define TOTAL_PROFILED_TASKS				6			//Task bits 0 to 5 of gchTasks_Active (DATA_SAMPLING_TASK to WATCHDOG_MANAGEMENT_TASK)
+
+	//Histogram: Bucket 0 holds values below 2^TASK_PROFILER_HIST_SHIFT cycles and every next bucket doubles the range
+	//			 With 16MHZ CPU clock bucket 0 is <16us and last bucket is >=262ms
+	#define TASK_PROFILER_HIST_BUCKETS			16
+	#define TASK_PROFILER_HIST_SHIFT			8
+	#define TASK_PROFILER_HIST_COUNT_MAX		0xFFFF		//Histogram is scaled down by 2 when any bucket reaches this value
+	#define TASK_PROFILER_PERCENTILE			99
+
+	//Lines generated by fnTaskProfilerFormat for every task
+	#define TASK_PROFILER_SUMMARY_LINE			0			//P<bit> N:<calls> B:<blocked> C:<min>/<avg>/<max>/<p99> L:<min>/<avg>/<max>/<p99>
+	#define TASK_PROFILER_CYCLE_HIST_LINE		1			//H<bit> C:<bucket0>,<bucket1>,...
+	#define TASK_PROFILER_LATENCY_HIST_LINE		2			//H<bit> L:<bucket0>,<bucket1>,...
+	#define TASK_PROFILER_TOTAL_LINES			3
+
+	#define TASK_PROFILER_CPU_CLOCK				16000000UL	//Cycle counter runs on CPU clock (See fnInitializeClock)
+
+	//Phase Budget Analyzer
+	#define PHASE_ANALYZER_PHASES				8			//RTC phases in one sample clock (TOTAL_SAMPLE_CLOCK_PHASE)
+	#define PHASE_ANALYZER_MAX_SAMPLE_CLOCK		125			//RTC runs at 1KHZ so a phase can not be shorter than 1ms
+	#define PHASE_WINDOW_SAMPLING				0			//From sampling task activation (Phase-0) to its completion. Overrun: SENSOR_SENSOR_SAMPLING_OVERRUN
+	#define PHASE_WINDOW_RADIO					1			//From collection task activation (Phase-6) to completion of download task. Overrun: SENSOR_RADIO_DIVISOR_OVERRUN
+	#define PHASE_ANALYZER_WINDOWS				2
+
+	//Lines generated by fnPhaseAnalyzerFormat
+	#define PHASE_ANALYZER_SUMMARY_LINE			0											//A F:<max sample clock> S:<sampling window> R:<radio work>/<radio clock phases> W:<radio window>
+	#define PHASE_ANALYZER_SPILL_LINE			1											//A<bit> X:<completions after next phase> M:<max phases>  (One line per task)
+	#define PHASE_ANALYZER_OVERRUN_LINE			(PHASE_ANALYZER_SPILL_LINE + TOTAL_PROFILED_TASKS)	//O<error> N:<count> P:<phase>+<cycles> A:<active tasks> E:<cycles>/<phases>
+																							//O<error> C:<cycles of task 0>,<cycles of task 1>,...  (Two lines per window)
+	#define PHASE_ANALYZER_TOTAL_LINES			(PHASE_ANALYZER_OVERRUN_LINE + (2 * PHASE_ANALYZER_WINDOWS))
+
+	//_____ I N L I N E   M A C R O S ____________________________________________________________
+
+	//Profiling hooks used by task manager and fnSystem_Timing_Task. They vanish completely when TASK_PROFILER_ENABLE is 0.
+	#if TASK_PROFILER_ENABLE
+		#define PROFILE_TASK(chTaskBit,pfnTask)			fnTaskProfilerExecute(chTaskBit,pfnTask)
+		#define TASK_PROFILER_ACTIVATE(chTaskBit)		fnTaskProfilerActivate(chTaskBit)
+	#else
+		#define PROFILE_TASK(chTaskBit,pfnTask)			pfnTask()
+		#define TASK_PROFILER_ACTIVATE(chTaskBit)		_NOP
+	#endif
+
+	//Phase budget analyzer hooks used by fnSystem_Timing_Task and the tasks which raise overrun errors
+	#if PHASE_ANALYZER_ENABLE
+		#define PHASE_ANALYZER_PHASE_ENTRY(chPhase)		fnPhaseAnalyzerPhaseEntry(chPhase)
+		#define PHASE_ANALYZER_OVERRUN(hErrorCode)		fnPhaseAnalyzerOverrun(hErrorCode)
+	#else
+		#define PHASE_ANALYZER_PHASE_ENTRY(chPhase)		_NOP
+		#define PHASE_ANALYZER_OVERRUN(hErrorCode)		_NOP
+	#endif
+
+	//Counts bytes of sample data written from one memory buffer to another between sensor driver and TX FIFO of radio
+	#if TASK_PROFILER_ENABLE
+		#define PACKET_COPY_PROFILE(chBytes)			(glPacketBytesCopied += (chBytes))
+	#else
+		#define PACKET_COPY_PROFILE(chBytes)			_NOP
+	#endif
+
+	//_____ S T R U C T U R E S ____________________________________________________________
+
+	//Statistics collected for single task of task manager (All times are in CPU cycles)
+	typedef struct
+	{
+		uint32_t	lInvocations;										//No of times task function got called by task manager
+		uint32_t	lBlockedPasses;										//No of calls which returned FALSE (task waiting for something)
+		uint32_t	lMinCycles;
+		uint32_t	lMaxCycles;
+		uint64_t	lTotalCycles;										//Used to compute average cycles per call
+		uint16_t	nCycleHistogram[TASK_PROFILER_HIST_BUCKETS];
+
+		uint32_t	lActivationStamp;									//Cycle counter value when RTC phase activated the task
+		uint8_t		chActivationPending;								//Set by fnTaskProfilerActivate and cleared when task returns TRUE
+		uint32_t	lCompletions;										//No of activations for which latency got recorded
+		uint32_t	lMinLatency;
+		uint32_t	lMaxLatency;
+		uint64_t	lTotalLatency;
+		uint16_t	nLatencyHistogram[TASK_PROFILER_HIST_BUCKETS];
+	}TASK_PROFILE_STRUCT;
+
+	//Work which has to complete before next occurrence of its phase (Sampling or Radio chain)
+	typedef struct
+	{
+		uint8_t		chOpen;												//Set while work of the window is in progress
+		uint32_t	lStartStamp;										//Cycle counter value at start of window
+		uint32_t	lStartPhaseCount;									//Phase count at start of window
+		uint32_t	lStartTaskCycles[TOTAL_PROFILED_TASKS];				//Total cycles of every task at start of window
+		uint32_t	lMaxCycles;											//Longest completed window
+		uint32_t	lMinPeriodPhases;									//Shortest distance between start of two windows (in phases)
+
+		//Root cause timings of last overrun
+		uint32_t	lOverruns;											//No of overrun errors raised for this window
+		uint8_t		chOverrunPhase;										//Phase in progress when overrun got raised
+		uint32_t	lOverrunPhaseCycles;								//Cycles from entry of that phase
+		uint8_t		chOverrunTasksActive;								//gchTasks_Active when overrun got raised
+		uint32_t	lOverrunCycles;										//Cycles from start of window
+		uint32_t	lOverrunPhases;										//Phases from start of window
+		uint32_t	lOverrunTaskCycles[TOTAL_PROFILED_TASKS];			//Cycles consumed by every task from start of window
+	}PHASE_WINDOW_STRUCT;
+
+	//Phase budget of task manager
+	typedef struct
+	{
+		uint32_t	lPhaseCount;										//RTC phases since reset of analyzer
+		uint32_t	lSampleClocks;										//Phase-0 occurrences since reset of analyzer
+		uint8_t		chCurrentPhase;
+		uint32_t	lPhaseEntryStamp[PHASE_ANALYZER_PHASES];			//Cycle counter value at latest entry of every phase
+		uint32_t	lActivationPhase[TOTAL_PROFILED_TASKS];				//Phase count at activation of task
+		uint32_t	lPhaseSpills[TOTAL_PROFILED_TASKS];					//Completions after the next phase already fired
+		uint32_t	lMaxSpillPhases[TOTAL_PROFILED_TASKS];				//Most phases fired between activation and completion
+		PHASE_WINDOW_STRUCT	hWindow[PHASE_ANALYZER_WINDOWS];
+	}PHASE_ANALYZER_STRUCT;
+
+	//_____ G L O B A L   D E F I N I T I O N S ______________________________________________________________
+
+	//Profiling statistics of every task bit
+	extern volatile TASK_PROFILE_STRUCT ghTaskProfile[TOTAL_PROFILED_TASKS];
+
+	//Phase budget of task manager
+	extern volatile PHASE_ANALYZER_STRUCT ghPhaseAnalyzer;
+
+	//Bytes of sample data copied between memory buffers (PACKET_COPY_PROFILE)
+	extern uint32_t glPacketBytesCopied;
+
+	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
+
+	//_____ fnTaskProfilerReset ____________________________________________________________________
+	//
+	// @brief	Clears statistics of all the tasks (and phase budget analyzer)
+
+	void fnTaskProfilerReset(void);
+
+	//_____ fnTaskProfilerActivate ____________________________________________________________________
+	//
+	// @brief	Called from fnSystem_Timing_Task just before task bit gets set in gchTasks_Active.
+	//			Activation time is stamped only when task is not already active so latency is measured from the RTC phase which started current run.
+	// @param	chTaskBit	Bit mask of task (DATA_SAMPLING_TASK, DATA_COLLECTION_TASK, ...)
+
+	void fnTaskProfilerActivate(uint8_t chTaskBit);
+
+	//_____ fnTaskProfilerExecute ____________________________________________________________________
+	//
+	// @brief	Calls task function and records its cycles and return value.
+	//			When task returns TRUE the latency from its activation is recorded as well.
+	//			Note: Cycles of the interrupt routines executed during the call are included in the task cycles.
+	// @param	chTaskBit	Bit mask of task
+	//			pfnTask		Task function called by task manager
+	// @return	Value returned by task function
+
+	int8_t fnTaskProfilerExecute(uint8_t chTaskBit,int8_t (*pfnTask)(void));
+
+	//_____ fnTaskProfilerFormat ____________________________________________________________________
+	//
+	// @brief	Generates one line (NULL terminated, ends with new line char) of profiling report of a task
+	// @param	chTaskIndex		Bit position of task (0 to TOTAL_PROFILED_TASKS-1)
+	//			chLine			TASK_PROFILER_SUMMARY_LINE, TASK_PROFILER_CYCLE_HIST_LINE or TASK_PROFILER_LATENCY_HIST_LINE
+	//			pchStr			Buffer of at least UART_COMM_BUF_SIZE bytes
+	// @return	TRUE if line is generated otherwise FALSE (task never executed)
+
+	int8_t fnTaskProfilerFormat(uint8_t chTaskIndex,uint8_t chLine,char *pchStr);
+
+	//_____ fnTaskProfilerDump ____________________________________________________________________
+	//
+	// @brief	Sends profiling report of all the executed tasks on debug UART.
+	//			This function is blocking function (about 100ms per line at 9600 baud) so call it only when timing of task manager is not a concern.
+
+	void fnTaskProfilerDump(void);
+
+	//_____ fnPhaseAnalyzerPhaseEntry ____________________________________________________________________
+	//
+	// @brief	Called from fnSystem_Timing_Task at entry of every RTC phase to stamp it
+	// @param	chPhase		RTC phase which just fired (RTC_PHASE0 to RTC_PHASE7)
+
+	void fnPhaseAnalyzerPhaseEntry(uint8_t chPhase);
+
+	//_____ fnPhaseAnalyzerOverrun ____________________________________________________________________
+	//
+	// @brief	Called where SENSOR_SENSOR_SAMPLING_OVERRUN or SENSOR_RADIO_DIVISOR_OVERRUN is raised.
+	//			It captures root cause timings: phase in progress, time and phases from start of overrun window and cycles consumed by every task in the window.
+	// @param	hErrorCode	Overrun error which is raised
+
+	void fnPhaseAnalyzerOverrun(SENSOR_MC_ERROR_CODES hErrorCode);
+
+	//_____ fnPhaseAnalyzerMaxSampleClock ____________________________________________________________________
+	//
+	// @brief	Estimates the maximum sample clock which current execution table can sustain from the worst case timings measured so far:
+	//				1> Sampling task must complete within one sample clock
+	//				2> Collection and download tasks must complete within the radio clock (less one phase between Phase-6 and Phase-7)
+	//				3> Cycles of all the tasks in one sample clock must fit in one sample clock
+	//				4> Phase can not be shorter than one RTC tick
+	// @return	Sample clock in HZ
+
+	uint16_t fnPhaseAnalyzerMaxSampleClock(void);
+
+	//_____ fnPhaseAnalyzerFormat ____________________________________________________________________
+	//
+	// @brief	Generates one line (NULL terminated, ends with new line char) of phase budget report
+	// @param	chLine		PHASE_ANALYZER_SUMMARY_LINE, PHASE_ANALYZER_SPILL_LINE + task index or PHASE_ANALYZER_OVERRUN_LINE + (2 * window) + 0/1
+	//			pchStr		Buffer of at least UART_COMM_BUF_SIZE bytes
+	// @return	TRUE if line is generated otherwise FALSE (nothing to report)
+
+	int8_t fnPhaseAnalyzerFormat(uint8_t chLine,char *pchStr);
+
+#endif /* SYSTEM_PROFILER_H_ */
@@ -0,0 +1,236 @@
+/* -------------------------------------------------------------------------
+Filename: system_scheduler.c
+
+Job#: 20473
+Date Created: 10/16/2026
+
+Purpose: Event driven scheduler of task manager.
+		 Interrupt routines post typed events (SYSTEM_EVENT_IDS) into a ring of SYSTEM_EVENT_QUEUE_SIZE entries.
+		 Task manager drains the ring and executes only the active tasks subscribed to the collected events (gchTasks_Ready)
+		 instead of executing every active task on every interrupt. Task activated by fnSystem_Timing_Task is made ready by EVENT_TASK_ACTIVATED.
+		 Ring has single producer (all ISRs are at low level so they never nest) and single consumer (task manager) so no locking is required.
+		 Tasks are prioritized by their bit position (DATA_SAMPLING_TASK is the highest), long running task can give way to higher priority task
+		 at its preemption points with fnHigherPriorityTaskReady.
+
+Functions:
+fnSchedulerInit						Flushes event ring and subscriptions
+fnSubscribeSystemEvents				Subscribes tasks to the events
+fnPostSystemEvent					Appends event into ring (called from ISRs)
+fnCollectSystemEvents				Drains ring and makes subscribed tasks ready
+fnSystemEventPending				Checks for events not yet collected
+fnHigherPriorityTaskReady			Preemption point for long running tasks
+
+Interrupts:
+-NA-
+
+
+Author: Aalok Shah
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+--------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+
+//_____  I N C L U D E S ______________________________________________________________
+
+#include "system_globals.h"						//Contains definitions related to various system level task
+
+//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+//Every bit maps to individual task indicating an event is pending for it
+volatile uint8_t gchTasks_Ready;
+
+//Argument of the latest occurrence of every event
+volatile uint8_t gchEventArgument[TOTAL_SYSTEM_EVENTS];
+
+//Event ring: Head is written by ISRs only and tail is written by task manager only
+static volatile SYSTEM_EVENT_STRUCT ghEventQueue[SYSTEM_EVENT_QUEUE_SIZE];
+static volatile uint8_t gchEventHead;
+static volatile uint8_t gchEventTail;
+
+//Set by ISR when ring is full
+static volatile uint8_t gchEventOverflow;
+
+//Bit mask of the tasks subscribed to every event
+static uint8_t gchEventSubscribers[TOTAL_SYSTEM_EVENTS];
+
+//_____ fnSchedulerInit ____________________________________________________________________
+//
+// @brief	Flushes the event ring, ready bits and subscriptions of all the tasks
+
+void fnSchedulerInit(void)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	
+	gchEventHead = RESET_COUNTER;
+	gchEventTail = RESET_COUNTER;
+	gchEventOverflow = RESET_FLAG;
+	gchTasks_Ready = DEACTIVATE_ALL_TASKS;
+	
+	for(chIndex = RESET_COUNTER; chIndex < TOTAL_SYSTEM_EVENTS; chIndex++)
+	{
+		gchEventSubscribers[chIndex] = DISABLE_ALL_TASKS;
+		gchEventArgument[chIndex] = RESET_VALUE;
+	}
+	
+	return;
+}
+
+//_____ fnSubscribeSystemEvents ____________________________________________________________________
+//
+// @brief	Subscribes the tasks to the events. Task is executed by task manager only when one of its events is collected.
+// @param	chTaskBits		Bit mask of tasks (DATA_SAMPLING_TASK, DATA_COLLECTION_TASK, ...)
+//			nEventMask		EVENT_BM() of the events
+
+void fnSubscribeSystemEvents(uint8_t chTaskBits,uint16_t nEventMask)
+{
+	uint8_t chIndex = RESET_COUNTER;
+	
+	for(chIndex = RESET_COUNTER; chIndex < TOTAL_SYSTEM_EVENTS; chIndex++)
+	{
+		if(nEventMask & EVENT_BM(chIndex))
+		{
+			gchEventSubscribers[chIndex] |= chTaskBits;
+		}
+	}
+	
+	return;
+}
+
+//_____ fnPostSystemEvent ____________________________________________________________________
+//
+// @brief	Appends the event into the ring. If ring is full overflow is recorded and all the active tasks are made ready at next collection.
+//			Must be called from interrupt routines only.
+// @param	chEventId		SYSTEM_EVENT_IDS
+//			chArgument		Event specific argument
+
+void fnPostSystemEvent(uint8_t chEventId,uint8_t chArgument)
+{
+	uint8_t chNextHead = (gchEventHead + 1) & SYSTEM_EVENT_QUEUE_MASK;
+	
+	if(chNextHead == gchEventTail)
+	{
+		gchEventOverflow = SET_FLAG;
+		return;
+	}
+	
+	ghEventQueue[gchEventHead].chEventId = chEventId;
+	ghEventQueue[gchEventHead].chArgument = chArgument;
+	gchEventHead = chNextHead;										//Publish the entry only after it is filled
+	
+	return;
+}
+
+//_____ fnCollectSystemEvents ____________________________________________________________________
+//
+// @brief	Drains the ring and sets gchTasks_Ready bits of the active tasks subscribed to collected events and of the activated tasks.
+//			Interrupts are kept enabled, new events posted during collection are collected in the same call.
+// @return	Bit mask of the tasks made ready
+
+uint8_t fnCollectSystemEvents(void)
+{
+	uint8_t chEventId = RESET_VALUE;
+	uint8_t chReadyTasks = DEACTIVATE_ALL_TASKS;
+	
+	while(gchEventTail != gchEventHead)
+	{
+		chEventId = ghEventQueue[gchEventTail].chEventId;
+		
+		if(chEventId < TOTAL_SYSTEM_EVENTS)
+		{
+			gchEventArgument[chEventId] = ghEventQueue[gchEventTail].chArgument;
+			chReadyTasks |= gchEventSubscribers[chEventId];
+			
+			if(chEventId == EVENT_TASK_ACTIVATED)
+			{
+				chReadyTasks |= gchEventArgument[chEventId];
+			}
+		}
+		
+		gchEventTail = (gchEventTail + 1) & SYSTEM_EVENT_QUEUE_MASK;		//Release the entry for ISRs
+	}
+	
+	//Some events are lost so no task can rely on its subscriptions
+	if(gchEventOverflow == SET_FLAG)
+	{
+		gchEventOverflow = RESET_FLAG;
+		chReadyTasks = ACTIVATE_ALL_TASKS;
+	}
+	
+	chReadyTasks &= gchTasks_Active;
+	gchTasks_Ready |= chReadyTasks;
+	
+	return chReadyTasks;
+}
+
+//_____ fnSystemEventPending ____________________________________________________________________
+//
+// @brief	Called by task manager with interrupts disabled to decide whether it can go for sleep
+// @return	TRUE if ring holds events not yet collected otherwise FALSE
+
+int8_t fnSystemEventPending(void)
+{
+	if((gchEventTail != gchEventHead) || (gchEventOverflow == SET_FLAG))
+	{
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
+
+//_____ fnHigherPriorityTaskReady ____________________________________________________________________
+//
+// @brief	Preemption point for long running tasks: Collects the posted events and checks whether a task with higher priority is ready.
+//			Task which gets TRUE must save its state, wake itself with WAKE_TASKS and return so task manager can execute the higher priority task first.
+// @param	chTaskBit	Bit mask of calling task
+// @return	TRUE if enabled and active task with higher priority is ready otherwise FALSE
+
+int8_t fnHigherPriorityTaskReady(uint8_t chTaskBit)
+{
+	fnCollectSystemEvents();
+	
+	if(gchTasks_Enable & gchTasks_Active & gchTasks_Ready & HIGHER_PRIORITY_TASKS(chTaskBit))
+	{
+		return RETURN_TRUE;
+	}
+	
+	return RETURN_FALSE;
+}
@@ -0,0 +1,165 @@
+/* -------------------------------------------------------------------------
+Filename: system_scheduler.h
+
+Job#: 20473
+Purpose: Event driven scheduling of SENSOR MC task manager (super loop in main.c)
+		 Interrupt routines post typed events into a lock free ring and only the tasks subscribed to those events are executed
+Date Created: 10/16/2026
+
+(NOTE: latest version is the top version)
+
+Author: Aalok Shah
+Changes: Priority dispatch of tasks (lower task bit is higher priority) and preemption point for long running tasks
+
+Author: Aalok Shah
+Changes: Initial version
+
+Naming Conventions:
+ALL CAPS =          MACRO, DEFINE
+ALL CAPS =          Structure Notation
+First Word Cap =    start of function or variable
+
+Table: Simplified Hungarian Notation. (Ref: http://vis.eng.uci.edu/standards/node19.html)
+Except were noted in the code
+
+Prefix         Type					Description							Example
+--------	---------------			--------------------------------	------------
+n            int					any integer type                    nCount
+ch           char					any character type                  chLetter
+f            float, double			floating point                      fPercent
+g            global					global scope variable               gnCount
+b            bool					any boolean type                    bDone
+l            long					any long type                       lDistance
+p            *   any				pointer                             pObject, pnCount
+sz           *   nul				terminated string of characters     szText
+pfn              *					function pointer                    pfnProgress
+h            handle					handle to something                 hMenu
+fn<*>        function				function call<return type>			fnnXmit(pchBuffer)
+
+Note: See document 000xxxx for complete project requirements
+Input: None
+Output: None
+
+-----------------------------------------------------------------------------
+NOTE: this is filled in by the tester  not the author
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-----------------------------------------------------------------------------
+NOTE: the test section repeats for each time the code is tested ...see the example below:
+-----------------------------------------------------------------------------
+Test:
+Tester:
+Test Date:
+Test Procedure:
+Test Results:
+
+-------------------------------------------------------------------------------------*/
+
+#ifndef SYSTEM_SCHEDULER_H_
+#define SYSTEM_SCHEDULER_H_
+
+	//_____ M A C R O S ____________________________________________________________________
+
+	#define SYSTEM_EVENT_QUEUE_SIZE				16			//Must be power of 2 (Ring holds SYSTEM_EVENT_QUEUE_SIZE-1 events)
+	#define SYSTEM_EVENT_QUEUE_MASK				(SYSTEM_EVENT_QUEUE_SIZE - 1)
+
+	//_____ E N U M E R A T I O N S ____________________________________________________________
+
+	//Events posted by interrupt routines
+	typedef enum
+	{
+		EVENT_TASK_ACTIVATED,					//fnSystem_Timing_Task (RTC_OVF_vect): Tasks are activated (Argument: Bit mask of activated tasks, no subscription required)
+		EVENT_ADC_COMPLETE,						//ADCA/ADCB CH0-3: Conversion complete (Argument: ADC virtual channel)
+		EVENT_I2C_COMPLETE,						//TWIF_TWIM_vect: I2C transaction terminated (Argument: RETURN_TRUE on success otherwise RETURN_FALSE)
+		EVENT_RADIO_GPIO,						//PORTH_INT0_vect: CC1125 transmit/receive complete
+		EVENT_RADIO_FIFO_THRESHOLD,				//PORTH_INT1_vect: CC1125 TX FIFO drained or RX FIFO filled up to threshold
+		EVENT_COMM_TIMEOUT,						//TCC1_OVF_vect: Communication wait time out
+		EVENT_VOL_STABLE,						//TCE1_OVF_vect: Voltage regulator is stable
+		EVENT_UART_RX_FRAME,					//TCE0_OVF_vect: Frame received on debug UART
+		EVENT_RADIO_SPI_COMPLETE,				//SPIC_INT_vect: Queue of CC1125 transactions terminated (Argument: RETURN_TRUE on success otherwise RETURN_FALSE)
+		TOTAL_SYSTEM_EVENTS
+	}SYSTEM_EVENT_IDS;
+
+	//_____ I N L I N E   M A C R O S ____________________________________________________________
+
+	#define EVENT_BM(chEventId)						(1 << (chEventId))
+
+	//Priority of task is its bit position in gchTasks_Active: Lower bit is higher priority (DATA_SAMPLING_TASK is the highest)
+	#define HIGHER_PRIORITY_TASKS(chTaskBit)		((uint8_t)((chTaskBit) - 1))
+
+	//Called from interrupt routines only (All the interrupts of SENSOR MC are at low level so ring has single producer)
+	#define POST_SYSTEM_EVENT(chEventId,chArgument)	fnPostSystemEvent(chEventId,chArgument)
+
+	//Called from task context to make tasks ready without any hardware event (Task which moved its state machine without starting hardware operation)
+	#define WAKE_TASKS(chTaskBits)					gchTasks_Ready |= (chTaskBits)
+
+	//_____ D A T A   S T R U C T U R E S ________________________________________________________
+
+	//Entry of event ring
+	typedef struct
+	{
+		uint8_t		chEventId;					//SYSTEM_EVENT_IDS
+		uint8_t		chArgument;					//Event specific argument
+	}SYSTEM_EVENT_STRUCT;
+
+	//_____ G L O B A L   D E F I N I T I O N S _________________________________________________
+
+	//Every bit maps to individual task indicating an event is pending for it (Written in task context only)
+	extern volatile uint8_t gchTasks_Ready;
+
+	//Argument of the latest occurrence of every event
+	extern volatile uint8_t gchEventArgument[TOTAL_SYSTEM_EVENTS];
+
+	//_____ F U N C T I O N   D E F I N I T I O N S ___________________________________________________________
+
+	//_____ fnSchedulerInit ____________________________________________________________________
+	//
+	// @brief	Flushes the event ring, ready bits and subscriptions of all the tasks
+
+	void fnSchedulerInit(void);
+
+	//_____ fnSubscribeSystemEvents ____________________________________________________________________
+	//
+	// @brief	Subscribes the tasks to the events. Task is executed by task manager only when one of its events is collected.
+	// @param	chTaskBits		Bit mask of tasks (DATA_SAMPLING_TASK, DATA_COLLECTION_TASK, ...)
+	//			nEventMask		EVENT_BM() of the events
+
+	void fnSubscribeSystemEvents(uint8_t chTaskBits,uint16_t nEventMask);
+
+	//_____ fnPostSystemEvent ____________________________________________________________________
+	//
+	// @brief	Appends the event into the ring. If ring is full overflow is recorded and all the active tasks are made ready at next collection.
+	// @param	chEventId		SYSTEM_EVENT_IDS
+	//			chArgument		Event specific argument
+
+	void fnPostSystemEvent(uint8_t chEventId,uint8_t chArgument);
+
+	//_____ fnCollectSystemEvents ____________________________________________________________________
+	//
+	// @brief	Drains the ring and sets gchTasks_Ready bits of the active tasks subscribed to collected events and of the activated tasks
+	// @return	Bit mask of the tasks made ready
+
+	uint8_t fnCollectSystemEvents(void);
+
+	//_____ fnSystemEventPending ____________________________________________________________________
+	//
+	// @brief	Called by task manager with interrupts disabled to decide whether it can go for sleep
+	// @return	TRUE if ring holds events not yet collected otherwise FALSE
+
+	int8_t fnSystemEventPending(void);
+
+	//_____ fnHigherPriorityTaskReady ____________________________________________________________________
+	//
+	// @brief	Preemption point for long running tasks: Collects the posted events and checks whether a task with higher priority is ready.
+	//			Task which gets TRUE must save its state, wake itself with WAKE_TASKS and return so task manager can execute the higher priority task first.
+	// @param	chTaskBit	Bit mask of calling task
+	// @return	TRUE if enabled and active task with higher priority is ready otherwise FALSE
+
+	int8_t fnHigherPriorityTaskReady(uint8_t chTaskBit);
+
+#endif /* SYSTEM_SCHEDULER_H_ */
@@ -169,6 +169,8 @@ void fnStopSampleClock(void)
 
 inline void fnSystem_Timing_Task(void)
 {
+	PHASE_ANALYZER_PHASE_ENTRY(gchSampleClockPhase);						//Stamp entry of phase for phase budget analysis
+	
 	if(gchClockPhase)
 	{
 		gchClockPhase=0;
@@ -192,7 +194,9 @@ inline void fnSystem_Timing_Task(void)
 				gchSampleClockIndicator=SET_FLAG;				//Used in data sampling task to indicate the new interruption of RTC
 			
 				//Enable sampling task for execution
+				TASK_PROFILER_ACTIVATE(DATA_SAMPLING_TASK);		//Stamp activation time for latency profiling
 				gchTasks_Active |= DATA_SAMPLING_TASK;			//Activate the task
+				POST_SYSTEM_EVENT(EVENT_TASK_ACTIVATED,DATA_SAMPLING_TASK);
 			}
 		break;
 		
@@ -208,7 +212,9 @@ inline void fnSystem_Timing_Task(void)
 					ghMasterTaskTable.nRadioClockCounter=RESET_COUNTER;			//Counter value zero when data collection task will get active so use it in checking of data download task
 				
 					//Enable tasking table request task for execution
+					TASK_PROFILER_ACTIVATE(EXECUTION_TABLE_REQ_TASK);
 					gchTasks_Active |= EXECUTION_TABLE_REQ_TASK;					//Activate the task
+					POST_SYSTEM_EVENT(EVENT_TASK_ACTIVATED,EXECUTION_TABLE_REQ_TASK);
 				}
 			}
 		break;
@@ -225,7 +231,9 @@ inline void fnSystem_Timing_Task(void)
 					gchRadioClockIndicator=SET_FLAG;							//Used in data collection task to indicate the new interruption of RTC
 				
 					//Enable data collection task for execution
+					TASK_PROFILER_ACTIVATE(DATA_COLLECTION_TASK);
 					gchTasks_Active |= DATA_COLLECTION_TASK;					//Activate the task
+					POST_SYSTEM_EVENT(EVENT_TASK_ACTIVATED,DATA_COLLECTION_TASK);
 				}
 			}
 		break;
@@ -235,7 +243,9 @@ inline void fnSystem_Timing_Task(void)
 			if((ghMasterTaskTable.nRadioClockCounter==RESET_COUNTER) && (gchTasks_Enable & DATA_DOWNLOAD_TASK))
 			{
 				//Enable data download task for execution
+				TASK_PROFILER_ACTIVATE(DATA_DOWNLOAD_TASK);
 				gchTasks_Active |= DATA_DOWNLOAD_TASK;						//Activate the task
+				POST_SYSTEM_EVENT(EVENT_TASK_ACTIVATED,DATA_DOWNLOAD_TASK);
 				SET_PINS_HIGH(PORTA,PA_TEST_POINT);
 			}
 		break;
@@ -263,6 +273,5 @@ inline void fnSystem_Timing_Task(void)
 
 ISR(RTC_OVF_vect)
 {
-	gchNewInterrupt = SET_NEW_ISR_FLAG;
 	fnSystem_Timing_Task();
 }
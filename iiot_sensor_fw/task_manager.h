@@ -67,18 +67,17 @@ Test Results:
 	//			The entire mechanism can be explained in listed steps:
 	//			STEP-1:
 	//				gchSampleClockIndicator flag is set by the fnSystem_Timing_Task at the clock phase 0.
-	//				Flag is used to prevent re-comparison of sample clock divisor with the sensor sample clock counter.
-	//				It means for every clock cycle sample clock divisor of each sensor is compared with current sample clock counter just once.
-	//				If match is found and sensor is in off mode than it will be put in a operation mode.
-	//				If match is found and sensor is already in operation mode than sensor sampling overrun error will get raised.
+	//				Flag is used to fetch the sensors due at current clock from sample clock divisor schedule just once per clock (fnFetchDueSensors).
+	//				If sensor is due and in off mode than it will be put in a operation mode and added to active sensor worklist.
+	//				If sensor is due and already in operation mode than sensor sampling overrun error will get raised.
 	//
 	//			STEP-2:
-	//				In FOR loop each sensor's current status will get checked and depend on it all the sensors will get access of middle and lower level resources
+	//				Each sensor of active sensor worklist will get access of middle and lower level resources through its sensor driver
 	//				The same will be performed till the sensor data will be fetched successfully than sensor will again be put in a off mode.
 	//
 	//			STEP-3:
-	//				At the ending of task status of all the sensors will get checked.
-	//				If all sensors in off mode than this task will finally terminated till next availability of sample clock
+	//				Sensor which completes the sampling is removed from active sensor worklist.
+	//				If worklist is empty (all sensors in off mode) than this task will finally terminated till next availability of sample clock
 	//
 	// @return	TRUE if data sampling task is completed or all sensors are in off mode otherwise it returns FALSE
 	
@@ -89,12 +88,14 @@ Test Results:
 	// @brief	This function performs all the data collection related operations on the basis of available tasking table
 	//			The entire mechanism can be explained in listed steps:
 	//			STEP1:
-	//				If last Data Download packet is not sent and request for new Data collection packet occurs than radio divisor overrun error will raised.
+	//				Packets of every radio clock are collected in free slot of collection queue so data download of older ones may continue.
+	//				If no slot is free than oldest generation waiting for download is dropped.
+	//				If slot is occupied by generation being downloaded only than radio divisor overrun error will raised and this radio clock is dropped.
 	//
 	//			STEP-2:
-	//				Every sensor's radio clock counter is compared with its radio clock divisor.
-	//				If match is not found than particular sensor is skipped from collection packet in existing clock cycle.
-	//				But If match found than data for that sensor will get appended in the collection packet.
+	//				Sensors due at current radio clock are fetched from radio clock divisor schedule (fnFetchDueSensors).
+	//				Sensor which is not due is skipped from collection packet in existing clock cycle.
+	//				Data of every due sensor will get appended in the collection packet.
 	//
 	//			STEP3:
 	//				Before filling the data into the SENSOR communication buffer function will check whether the sufficient space is available or not in current packet.
@@ -119,6 +120,51 @@ Test Results:
 	//				4> Upper layer definitions used by system level task
 	
 	void fnResetFirmwareResourceAllocations(void);
+
+	//_____ fnCompileDivisorSchedules ____________________________________________________________________
+	//
+	// @brief	Called when new Execution Table is accepted to compile sample and radio clock divisors of all the sensor entries into divisor schedules.
+	//			Schedule holds the list of sensors due at every tick over the hyperperiod (LCM of divisors) so every tick costs only as much as the sensors due.
+	//			If hyperperiod exceeds MAX_SCHEDULE_HYPERPERIOD or entries exceed MAX_SCHEDULE_ENTRIES than sequential counters of sensors are used.
+	//			Load of the busiest radio clock is predicted and Execution Table is rejected if its data can not fit in MAX_COMM_PACKET_COUNT packets.
+	//			Otherwise packets of collection queue are divided in slots of the size of busiest radio clock.
+	// @return	FALSE if Execution Table overloads the data collection otherwise TRUE
+	
+	int8_t fnCompileDivisorSchedules(void);
+
+	//_____ fnResetKeyData ____________________________________________________________________
+	//
+	// @brief	Called when new Execution Table is accepted to reset key data of delta encoding, so first entry of every sensor is key entry.
+	//			Only first MAX_KEY_SENSOR_COUNT sensor entries have key data, others send key entry every time.
+	
+	void fnResetKeyData(void);
+
+	//_____ fnFetchDueSensors ____________________________________________________________________
+	//
+	// @brief	Fetches the sensor entries due at current clock tick and moves the schedule to next tick
+	// @param	chScheduleType	SAMPLE_CLOCK_SCHEDULE or RADIO_CLOCK_SCHEDULE
+	//			ppchDueList		Returns pointer to the list of due sensor entries (valid till next call)
+	// @return	No of sensor entries due at current clock tick
+	
+	uint8_t fnFetchDueSensors(uint8_t chScheduleType,uint8_t **ppchDueList);
+
+	//_____ fnFetchCollectionGeneration ____________________________________________________________________
+	//
+	// @brief	Called by Data Download Task when it starts download of the oldest generation of collection queue.
+	//			Generation is marked in flight so it is not dropped by Data Collection Task till it is released.
+	// @param	pchPacketCount		Returns no of packets of generation
+	// @return	Index of first packet of generation in gchSensorCommBuff
+	
+	uint8_t fnFetchCollectionGeneration(uint8_t *pchPacketCount);
+
+	//_____ fnReleaseCollectionGeneration ____________________________________________________________________
+	//
+	// @brief	Called by Data Download Task when download of the oldest generation is over (delivered or retry out) to free its slot
+	//			If generation carrying key entries of delta encoding is not delivered than every sensor sends key entry again.
+	// @param	chDelivered		SET_FLAG if all the packets of generation are acknowledged
+	// @return	No of generations still waiting for download
+	
+	uint8_t fnReleaseCollectionGeneration(uint8_t chDelivered);
 	
 	//_____ fnDebug_Serial_Task ____________________________________________________________________
 	//
@@ -189,6 +235,52 @@ Test Results:
 
 	int8_t fnData_Download_Task(void);
 
+	//____fnPacketBuilderOpen _________________________________________________________________
+	//
+	// @brief	Starts assembly of data packet in place in gchSensorCommBuff.
+	//			Data message is written straight into the packet (fnPacketBuilderReserve) and header fields are filled once when it is closed,
+	//			same buffer is than handed to radio for transmission and retries.
+	// @param	phBuilder		Packet builder
+	//			chPacketIndex	Packet of gchSensorCommBuff to fill
+	//			chPacketSeqNo	Sequence no of packet in its generation
+
+	void fnPacketBuilderOpen(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chPacketIndex,uint8_t chPacketSeqNo);
+
+	//____fnPacketBuilderReserve _________________________________________________________________
+	//
+	// @brief	Reserves bytes of data message in packet being assembled, caller writes its data straight into the reserved bytes
+	// @param	phBuilder		Packet builder
+	//			chLength		No of bytes to reserve
+	// @return	Pointer to reserved bytes or NULL if packet does not have enough space (packet needs to be closed and next one opened)
+
+	uint8_t *fnPacketBuilderReserve(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chLength);
+
+	//____fnPacketBuilderFreeBits _________________________________________________________________
+	//
+	// @brief	Bits of data message left in packet being assembled, so caller can check that its bit packed entry fits before packing it
+	// @param	phBuilder		Packet builder
+	// @return	No of bits which can still be packed with fnPacketBuilderPackBits
+
+	uint16_t fnPacketBuilderFreeBits(PACKET_BUILDER_STRUCT *phBuilder);
+
+	//____fnPacketBuilderPackBits _________________________________________________________________
+	//
+	// @brief	Appends least significant bits of value to bit stream of data message (Most significant bit first, crossing byte boundaries).
+	//			Caller checks the space with fnPacketBuilderFreeBits, new byte is cleared before its first bit is packed.
+	// @param	phBuilder		Packet builder
+	//			nValue			Value to pack (bits above chBits are ignored)
+	//			chBits			No of bits to pack (1 to 16)
+
+	void fnPacketBuilderPackBits(PACKET_BUILDER_STRUCT *phBuilder,uint16_t nValue,uint8_t chBits);
+
+	//____fnPacketBuilderClose _________________________________________________________________
+	//
+	// @brief	Fills the header, descriptor and length fields of assembled packet as per data download channel
+	// @param	phBuilder		Packet builder
+	//			chLastPacket	SET_FLAG if it is the last packet of generation
+
+	void fnPacketBuilderClose(PACKET_BUILDER_STRUCT *phBuilder,uint8_t chLastPacket);
+
 	//____fnData_ET_Request_Task _________________________________________________________________
 	//
 	// @brief	Function is called from the task manager itself when it wants to request for the new tasking table to RFC Console.